@@ -11,6 +11,8 @@
 #include "include/core/SkPath.h"
 #include "tools/ToolUtils.h"
 
+extern bool gSkUseSparseStrips;
+
 enum Align {
     kLeft_Align,
     kMiddle_Align,
@@ -25,13 +27,18 @@ class BigPathBench : public Benchmark {
     SkString    fName;
     Align       fAlign;
     bool        fRound;
+    bool        fSparseStrips;
 
 public:
-    BigPathBench(Align align, bool round) : fAlign(align), fRound(round) {
+    BigPathBench(Align align, bool round, bool sparseStrips = false)
+            : fAlign(align), fRound(round), fSparseStrips(sparseStrips) {
         fName.printf("bigpath_%s", gAlignName[fAlign]);
         if (round) {
             fName.append("_round");
         }
+        if (sparseStrips) {
+            fName.append("_sparse_strips");
+        }
     }
 
 protected:
@@ -67,9 +74,12 @@ protected:
                 break;
         }
 
+        const bool useSparseStrips = gSkUseSparseStrips;
+        gSkUseSparseStrips = useSparseStrips || fSparseStrips;
         for (int i = 0; i < loops; i++) {
             canvas->drawPath(fPath, paint);
         }
+        gSkUseSparseStrips = useSparseStrips;
     }
 
 private:
@@ -83,3 +93,11 @@ DEF_BENCH( return new BigPathBench(kRight_Align,    false); )
 DEF_BENCH( return new BigPathBench(kLeft_Align,     true); )
 DEF_BENCH( return new BigPathBench(kMiddle_Align,   true); )
 DEF_BENCH( return new BigPathBench(kRight_Align,    true); )
+
+DEF_BENCH( return new BigPathBench(kLeft_Align,     false, true); )
+DEF_BENCH( return new BigPathBench(kMiddle_Align,   false, true); )
+DEF_BENCH( return new BigPathBench(kRight_Align,    false, true); )
+
+DEF_BENCH( return new BigPathBench(kLeft_Align,     true,  true); )
+DEF_BENCH( return new BigPathBench(kMiddle_Align,   true,  true); )
+DEF_BENCH( return new BigPathBench(kRight_Align,    true,  true); )
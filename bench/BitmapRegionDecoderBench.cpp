@@ -11,11 +11,12 @@
 #include "client_utils/android/BitmapRegionDecoder.h"
 #include "include/core/SkBitmap.h"
 #include "src/core/SkOSFile.h"
+#include "tools/Resources.h"
 
 BitmapRegionDecoderBench::BitmapRegionDecoderBench(const char* baseName, SkData* encoded,
         SkColorType colorType, uint32_t sampleSize, const SkIRect& subset)
     : fBRD(nullptr)
-    , fData(SkRef(encoded))
+    , fData(SkSafeRef(encoded))
     , fColorType(colorType)
     , fSampleSize(sampleSize)
     , fSubset(subset)
@@ -29,6 +30,14 @@ BitmapRegionDecoderBench::BitmapRegionDecoderBench(const char* baseName, SkData*
     }
 }
 
+BitmapRegionDecoderBench::BitmapRegionDecoderBench(const char* baseName, const char* resource,
+        SkColorType colorType, uint32_t sampleSize, const SkIRect& subset)
+    : BitmapRegionDecoderBench(baseName, static_cast<SkData*>(nullptr), colorType, sampleSize,
+                               subset)
+{
+    fResource = resource;
+}
+
 const char* BitmapRegionDecoderBench::onGetName() {
     return fName.c_str();
 }
@@ -38,6 +47,9 @@ bool BitmapRegionDecoderBench::isSuitableFor(Backend backend) {
 }
 
 void BitmapRegionDecoderBench::onDelayedSetup() {
+    if (fResource) {
+        fData = GetResourceAsData(fResource);
+    }
     fBRD = android::skia::BitmapRegionDecoder::Make(fData);
 }
 
@@ -49,4 +61,19 @@ void BitmapRegionDecoderBench::onDraw(int n, SkCanvas* canvas) {
         SkAssertResult(fBRD->decodeRegion(&bm, nullptr, fSubset, fSampleSize, ct, false, cs));
     }
 }
+
+// The same image with and without restart markers.  Decoding a region near the bottom can start
+// from the nearest restart marker instead of decoding (and throwing away) every row above it.
+DEF_BENCH(return new BitmapRegionDecoderBench("mandrill_512_q075_Bottom",
+                                              "images/mandrill_512_q075.jpg",
+                                              kN32_SkColorType, 1,
+                                              SkIRect::MakeXYWH(0, 384, 512, 128));)
+DEF_BENCH(return new BitmapRegionDecoderBench("mandrill_512_q075_restart_Bottom",
+                                              "images/mandrill_512_q075_restart.jpg",
+                                              kN32_SkColorType, 1,
+                                              SkIRect::MakeXYWH(0, 384, 512, 128));)
+DEF_BENCH(return new BitmapRegionDecoderBench("mandrill_512_q075_restart_Middle",
+                                              "images/mandrill_512_q075_restart.jpg",
+                                              kN32_SkColorType, 1,
+                                              SkIRect::MakeXYWH(128, 192, 256, 128));)
 #endif // SK_ENABLE_ANDROID_UTILS
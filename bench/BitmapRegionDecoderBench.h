@@ -33,6 +33,10 @@ public:
     BitmapRegionDecoderBench(const char* basename, SkData* encoded, SkColorType colorType,
             uint32_t sampleSize, const SkIRect& subset);
 
+    // Reads the encoded image from resources during setup.
+    BitmapRegionDecoderBench(const char* basename, const char* resource, SkColorType colorType,
+            uint32_t sampleSize, const SkIRect& subset);
+
 protected:
     const char* onGetName() override;
     bool isSuitableFor(Backend backend) override;
@@ -43,6 +47,7 @@ private:
     SkString                                            fName;
     std::unique_ptr<android::skia::BitmapRegionDecoder> fBRD;
     sk_sp<SkData>                                       fData;
+    const char*                                         fResource = nullptr;
     const SkColorType                                   fColorType;
     const uint32_t                                      fSampleSize;
     const SkIRect                                       fSubset;
@@ -8,8 +8,11 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkColorSpace.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkSurface.h"
 #include "include/gpu/ganesh/GrDirectContext.h"
 #include "include/gpu/ganesh/SkImageGanesh.h"
 #include "src/base/SkRandom.h"
@@ -19,11 +22,14 @@
 #include "src/gpu/ganesh/SkGr.h"
 #include "src/gpu/ganesh/SurfaceDrawContext.h"
 
+#include <algorithm>
+
 // Benchmarks that exercise the bulk image and solid color quad APIs, under a variety of patterns:
 enum class ImageMode {
     kShared, // 1. One shared image referenced by every rectangle
     kUnique, // 2. Unique image for every rectangle
-    kNone    // 3. No image, solid color shading per rectangle
+    kNone,   // 3. No image, solid color shading per rectangle
+    kRRect   // 4. No image, solid color shading per round rectangle
 };
 //   X
 enum class DrawMode {
@@ -37,35 +43,48 @@ enum class RectangleLayout {
     kGrid     // Small, non-overlapping rectangles in a grid covering the output surface
 };
 
-// Benchmark runner that can be configured by template arguments.
-template<int kRectCount, RectangleLayout kLayout, ImageMode kImageMode, DrawMode kDrawMode>
+// Benchmark runner that can be configured by template arguments.  With kF16, it draws into an
+// F16 raster surface of its own instead of the bench's canvas, since raster N32 configs without a
+// color space use the legacy blitters, which draw solid color batches one shape at a time.
+template<int kRectCount, RectangleLayout kLayout, ImageMode kImageMode, DrawMode kDrawMode,
+         bool kF16 = false>
 class BulkRectBench : public Benchmark {
 public:
     static_assert(kImageMode == ImageMode::kNone || kDrawMode != DrawMode::kQuad,
-                  "kQuad only supported for solid color draws");
+                  "kQuad only supported for solid color rect draws");
+
+    inline static constexpr bool kSolidColor = kImageMode == ImageMode::kNone ||
+                                               kImageMode == ImageMode::kRRect;
+    static_assert(kSolidColor || !kF16, "kF16 only supported for solid color draws");
 
     inline static constexpr int kWidth      = 1024;
     inline static constexpr int kHeight     = 1024;
 
     // There will either be 0 images, 1 image, or 1 image per rect
     inline static constexpr int kImageCount = kImageMode == ImageMode::kShared ?
-            1 : (kImageMode == ImageMode::kNone ? 0 : kRectCount);
+            1 : (kSolidColor ? 0 : kRectCount);
 
     bool isSuitableFor(Backend backend) override {
-        if (kDrawMode == DrawMode::kBatch && kImageMode == ImageMode::kNone) {
+        if (kF16) {
+            return backend == Backend::kRaster;
+        } else if (kDrawMode == DrawMode::kBatch && kImageMode == ImageMode::kNone) {
             // Currently the bulk color quad API is only available on
-            // skgpu::ganesh::SurfaceDrawContext
-            return backend == Backend::kGanesh;
+            // skgpu::ganesh::SurfaceDrawContext and raster devices
+            return backend == Backend::kGanesh || backend == Backend::kRaster;
+        } else if (kDrawMode == DrawMode::kBatch && kImageMode == ImageMode::kRRect) {
+            return backend == Backend::kRaster;
         } else {
             return this->INHERITED::isSuitableFor(backend);
         }
     }
 
 protected:
-    SkRect         fRects[kRectCount];
-    sk_sp<SkImage> fImages[kImageCount > 0 ? kImageCount : 1];
-    SkColor4f      fColors[kRectCount];
-    SkString       fName;
+    SkRect           fRects[kRectCount];
+    sk_sp<SkImage>   fImages[kImageCount > 0 ? kImageCount : 1];
+    SkRRect          fRRects[kImageMode == ImageMode::kRRect ? kRectCount : 1];
+    SkColor4f        fColors[kRectCount];
+    sk_sp<SkSurface> fSurface;  // Only with kF16.
+    SkString         fName;
 
     void computeName()  {
         fName = "bulkrect";
@@ -79,8 +98,13 @@ protected:
             fName.append("_sharedimage");
         } else if (kImageMode == ImageMode::kUnique) {
             fName.append("_uniqueimages");
-        } else {
+        } else if (kImageMode == ImageMode::kNone) {
             fName.append("_solidcolor");
+        } else {
+            fName.append("_solidcolor_rrect");
+        }
+        if (kF16) {
+            fName.append("_f16");
         }
         if (kDrawMode == DrawMode::kBatch) {
             fName.append("_batch");
@@ -131,10 +155,20 @@ protected:
     }
 
     void drawSolidColorsBatch(SkCanvas* canvas) const {
-        SkASSERT(kImageMode == ImageMode::kNone);
+        SkASSERT(kSolidColor);
         SkASSERT(kDrawMode == DrawMode::kBatch);
 
-        SkASSERT(canvas->recordingContext());
+        if (!canvas->recordingContext()) {
+            SkPaint paint;
+            paint.setAntiAlias(true);
+            if (kImageMode == ImageMode::kNone) {
+                SkCanvasPriv::DrawRectSet(canvas, fRects, fColors, kRectCount, paint);
+            } else {
+                SkCanvasPriv::DrawRRectSet(canvas, fRRects, fColors, kRectCount, paint);
+            }
+            return;
+        }
+        SkASSERT(kImageMode == ImageMode::kNone);
 
         GrQuadSetEntry batch[kRectCount];
         for (int i = 0; i < kRectCount; ++i) {
@@ -157,13 +191,16 @@ protected:
     }
 
     void drawSolidColorsRef(SkCanvas* canvas) const {
-        SkASSERT(kImageMode == ImageMode::kNone);
+        SkASSERT(kSolidColor);
         SkASSERT(kDrawMode == DrawMode::kRef || kDrawMode == DrawMode::kQuad);
 
         SkPaint paint;
         paint.setAntiAlias(true);
         for (int i = 0; i < kRectCount; ++i) {
-            if (kDrawMode == DrawMode::kRef) {
+            if (kImageMode == ImageMode::kRRect) {
+                paint.setColor4f(fColors[i]);
+                canvas->drawRRect(fRRects[i], paint);
+            } else if (kDrawMode == DrawMode::kRef) {
                 paint.setColor4f(fColors[i]);
                 canvas->drawRect(fRects[i], paint);
             } else {
@@ -212,10 +249,22 @@ protected:
             SkASSERT(SkRect::MakeWH(kWidth, kHeight).contains(fRects[i]));
 
             fColors[i] = {rand.nextF(), rand.nextF(), rand.nextF(), 1.f};
+
+            if (kImageMode == ImageMode::kRRect) {
+                SkScalar r = std::min(fRects[i].width(), fRects[i].height()) * 0.25f;
+                fRRects[i].setRectXY(fRects[i], r, r);
+            }
         }
     }
 
     void onPerCanvasPreDraw(SkCanvas* canvas) override {
+        if (kF16) {
+            fSurface = SkSurfaces::Raster(SkImageInfo::Make(kWidth, kHeight,
+                                                            kRGBA_F16_SkColorType,
+                                                            kPremul_SkAlphaType,
+                                                            SkColorSpace::MakeSRGB()));
+        }
+
         // Push the skimages to the GPU when using the GPU backend so that the texture creation is
         // not part of the bench measurements. Always remake the images since they are so simple,
         // and since they are context-specific, this works when the bench runs multiple GPU backends
@@ -235,6 +284,7 @@ protected:
     }
 
     void onPerCanvasPostDraw(SkCanvas* canvas) override {
+        fSurface.reset();
         for (int i = 0; i < kImageCount; ++i) {
             // For Vulkan we need to make sure the bench isn't holding onto any refs to the
             // GrContext when we go to delete the vulkan context (which happens before the bench is
@@ -244,8 +294,11 @@ protected:
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
+        if (kF16) {
+            canvas = fSurface->getCanvas();
+        }
         for (int i = 0; i < loops; i++) {
-            if (kImageMode == ImageMode::kNone) {
+            if (kSolidColor) {
                 if (kDrawMode == DrawMode::kBatch) {
                     this->drawSolidColorsBatch(canvas);
                 } else {
@@ -272,6 +325,9 @@ protected:
 #define ADD_BENCH(n, layout, imageMode, drawMode)                              \
     DEF_BENCH( return (new BulkRectBench<n, layout, imageMode, drawMode>()); )
 
+#define ADD_F16_BENCH(n, layout, imageMode, drawMode)                          \
+    DEF_BENCH( return (new BulkRectBench<n, layout, imageMode, drawMode, true>()); )
+
 #define ADD_BENCH_FAMILY(n, layout)                                            \
     ADD_BENCH(n, layout, ImageMode::kShared, DrawMode::kBatch)                 \
     ADD_BENCH(n, layout, ImageMode::kShared, DrawMode::kRef)                   \
@@ -279,10 +335,17 @@ protected:
     ADD_BENCH(n, layout, ImageMode::kUnique, DrawMode::kRef)                   \
     ADD_BENCH(n, layout, ImageMode::kNone,   DrawMode::kBatch)                 \
     ADD_BENCH(n, layout, ImageMode::kNone,   DrawMode::kRef)                   \
-    ADD_BENCH(n, layout, ImageMode::kNone,   DrawMode::kQuad)
+    ADD_BENCH(n, layout, ImageMode::kNone,   DrawMode::kQuad)                  \
+    ADD_BENCH(n, layout, ImageMode::kRRect,  DrawMode::kBatch)                 \
+    ADD_BENCH(n, layout, ImageMode::kRRect,  DrawMode::kRef)                   \
+    ADD_F16_BENCH(n, layout, ImageMode::kNone,  DrawMode::kBatch)              \
+    ADD_F16_BENCH(n, layout, ImageMode::kNone,  DrawMode::kRef)                \
+    ADD_F16_BENCH(n, layout, ImageMode::kRRect, DrawMode::kBatch)              \
+    ADD_F16_BENCH(n, layout, ImageMode::kRRect, DrawMode::kRef)
 
 ADD_BENCH_FAMILY(1000,  RectangleLayout::kRandom)
 ADD_BENCH_FAMILY(1000,  RectangleLayout::kGrid)
 
 #undef ADD_BENCH_FAMILY
+#undef ADD_F16_BENCH
 #undef ADD_BENCH
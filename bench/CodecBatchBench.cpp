@@ -0,0 +1,129 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/codec/SkCodec.h"
+#include "include/codec/SkCodecBatch.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkString.h"
+#include "include/encode/SkJpegEncoder.h"
+#include "include/encode/SkPngEncoder.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <memory>
+#include <vector>
+
+// Decodes a corpus of 10k 32x32 icons, half PNG and half JPEG, into a pixmap apiece.  Divide the
+// time by 10k for the time per icon.
+//
+//   CodecBatch_10k_icons_serial           one SkCodec after another on this thread
+//   CodecBatch_10k_icons_task_per_icon_N  one task per icon on an N thread executor
+//   CodecBatch_10k_icons_batch_N          SkCodecBatch on an N thread executor
+class CodecBatchBench : public Benchmark {
+public:
+    enum class Mode { kSerial, kTaskPerIcon, kBatch };
+
+    CodecBatchBench(Mode mode, int threads) : fMode(mode), fThreads(threads) {
+        switch (mode) {
+            case Mode::kSerial:
+                fName = "CodecBatch_10k_icons_serial";
+                break;
+            case Mode::kTaskPerIcon:
+                fName = SkStringPrintf("CodecBatch_10k_icons_task_per_icon_%d", threads);
+                break;
+            case Mode::kBatch:
+                fName = SkStringPrintf("CodecBatch_10k_icons_batch_%d", threads);
+                break;
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        constexpr int kIcons = 10000;
+        constexpr int kSize = 32;
+        SkRandom rand;
+        SkBitmap icon;
+        icon.allocN32Pixels(kSize, kSize);
+        for (int i = 0; i < kIcons; i++) {
+            // A gradient in a random color, with a little noise.
+            const SkColor color = rand.nextU() | 0xFF000000;
+            for (int y = 0; y < kSize; y++) {
+                for (int x = 0; x < kSize; x++) {
+                    const U8CPU shade = (x + y) * 255 / (2 * kSize) + (rand.nextU() & 7);
+                    *icon.getAddr32(x, y) = SkPreMultiplyARGB(
+                            0xFF, SkColorGetR(color) * shade / 0xFF,
+                            SkColorGetG(color) * shade / 0xFF, SkColorGetB(color) * shade / 0xFF);
+                }
+            }
+            SkDynamicMemoryWStream stream;
+            if (i % 2) {
+                SkAssertResult(SkJpegEncoder::Encode(&stream, icon.pixmap(), {}));
+            } else {
+                SkAssertResult(SkPngEncoder::Encode(&stream, icon.pixmap(), {}));
+            }
+            fIcons.push_back(stream.detachAsData());
+        }
+
+        fPixels.allocN32Pixels(kSize, kSize * kIcons);
+        for (int i = 0; i < kIcons; i++) {
+            SkPixmap slot;
+            SkAssertResult(fPixels.pixmap().extractSubset(
+                    &slot, SkIRect::MakeXYWH(0, kSize * i, kSize, kSize)));
+            fSlots.push_back(slot);
+        }
+
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeWorkStealingThreadPool(fThreads);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            switch (fMode) {
+                case Mode::kSerial:
+                    SkCodecBatch::Decode(fIcons, fSlots);
+                    break;
+                case Mode::kTaskPerIcon:
+                    SkTaskGroup(*fExecutor).batch((int)fIcons.size(), [this](int i) {
+                        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(fIcons[i]);
+                        codec->getPixels(fSlots[i]);
+                    });
+                    break;
+                case Mode::kBatch: {
+                    SkCodecBatch::Options options;
+                    options.fExecutor = fExecutor.get();
+                    SkCodecBatch::Decode(fIcons, fSlots, options);
+                    break;
+                }
+            }
+        }
+    }
+
+private:
+    const Mode fMode;
+    const int fThreads;
+    SkString fName;
+    std::vector<sk_sp<SkData>> fIcons;
+    SkBitmap fPixels;
+    std::vector<SkPixmap> fSlots;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH(return new CodecBatchBench(CodecBatchBench::Mode::kSerial, 0));
+DEF_BENCH(return new CodecBatchBench(CodecBatchBench::Mode::kTaskPerIcon, 4));
+DEF_BENCH(return new CodecBatchBench(CodecBatchBench::Mode::kBatch, 4));
+DEF_BENCH(return new CodecBatchBench(CodecBatchBench::Mode::kTaskPerIcon, 8));
+DEF_BENCH(return new CodecBatchBench(CodecBatchBench::Mode::kBatch, 8));
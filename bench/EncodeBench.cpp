@@ -7,13 +7,21 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPaint.h"
 #include "include/core/SkStream.h"
+#include "include/encode/SkEncoder.h"
 #include "include/encode/SkJpegEncoder.h"
 #include "include/encode/SkPngEncoder.h"
 #include "include/encode/SkWebpEncoder.h"
 #include "tools/DecodeUtils.h"
 
+#include <memory>
+#include <vector>
+
 // Like other Benchmark subclasses, Encoder benchmarks are run by:
 // nanobench --match ^Encode_
 //
@@ -134,3 +142,172 @@ DEF_BENCH(return new EncodeBench(srcs[0], PNG(kAll, 6), "PNG", kRGB_565_SkColorT
 DEF_BENCH(return new EncodeBench(srcs[1], PNG(kAll, 6), "PNG", kRGB_565_SkColorType));
 
 #undef PNG
+
+// Encodes a large image, the size of a 4K screenshot, with SkPngEncoder::Options::fExecutor set to
+// an executor with this many threads (or unset, for zero threads). The source is 33.2MB, so
+// throughput in MB/s is 33.2 divided by the reported time per loop in seconds.
+class ThreadedPngEncodeBench : public Benchmark {
+public:
+    explicit ThreadedPngEncodeBench(int threads)
+        : fThreads(threads)
+        , fName(SkStringPrintf("Encode_PNG_4k_%dthreads", threads)) {}
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkBitmap tile;
+        SkAssertResult(ToolUtils::GetResourceAsBitmapWithColortype(
+                "images/mandrill_512.png", &tile, kRGBA_8888_SkColorType));
+        fBitmap.allocPixels(tile.info().makeWH(3840, 2160));
+        for (int y = 0; y < fBitmap.height(); y += tile.height()) {
+            for (int x = 0; x < fBitmap.width(); x += tile.width()) {
+                fBitmap.writePixels(tile.pixmap(), x, y);
+            }
+        }
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeWorkStealingThreadPool(fThreads);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkPngEncoder::Options opts;
+        opts.fExecutor = fExecutor.get();
+        while (loops-- > 0) {
+            SkNullWStream dst;
+            SkAssertResult(SkPngEncoder::Encode(&dst, fBitmap.pixmap(), opts));
+        }
+    }
+
+private:
+    const int fThreads;
+    SkString fName;
+    SkBitmap fBitmap;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH(return new ThreadedPngEncodeBench(0));
+DEF_BENCH(return new ThreadedPngEncodeBench(1));
+DEF_BENCH(return new ThreadedPngEncodeBench(2));
+DEF_BENCH(return new ThreadedPngEncodeBench(4));
+DEF_BENCH(return new ThreadedPngEncodeBench(8));
+
+// Encodes the same 4K image with SkJpegEncoder::Options::fExecutor set to an executor with this
+// many threads (or unset, for zero threads), which encodes bands of MCU rows in parallel.
+class ThreadedJpegEncodeBench : public Benchmark {
+public:
+    explicit ThreadedJpegEncodeBench(int threads)
+        : fThreads(threads)
+        , fName(SkStringPrintf("Encode_JPEG_4k_%dthreads", threads)) {}
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkBitmap tile;
+        SkAssertResult(ToolUtils::GetResourceAsBitmapWithColortype(
+                "images/mandrill_512.png", &tile, kRGBA_8888_SkColorType));
+        fBitmap.allocPixels(tile.info().makeWH(3840, 2160).makeAlphaType(kOpaque_SkAlphaType));
+        for (int y = 0; y < fBitmap.height(); y += tile.height()) {
+            for (int x = 0; x < fBitmap.width(); x += tile.width()) {
+                fBitmap.writePixels(tile.pixmap(), x, y);
+            }
+        }
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeWorkStealingThreadPool(fThreads);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkJpegEncoder::Options opts;
+        opts.fQuality = 90;
+        opts.fExecutor = fExecutor.get();
+        while (loops-- > 0) {
+            SkNullWStream dst;
+            SkAssertResult(SkJpegEncoder::Encode(&dst, fBitmap.pixmap(), opts));
+        }
+    }
+
+private:
+    const int fThreads;
+    SkString fName;
+    SkBitmap fBitmap;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH(return new ThreadedJpegEncodeBench(0));
+DEF_BENCH(return new ThreadedJpegEncodeBench(1));
+DEF_BENCH(return new ThreadedJpegEncodeBench(2));
+DEF_BENCH(return new ThreadedJpegEncodeBench(4));
+DEF_BENCH(return new ThreadedJpegEncodeBench(8));
+
+// Encodes a 120 frame, 256x256 animation, like a few seconds of a Lottie animation exported to
+// animated WebP, with SkWebpEncoder::Options::fExecutor set to an executor with this many threads
+// (or unset, for zero threads).  Each frame moves a few shapes across a still background.
+class AnimatedWebpEncodeBench : public Benchmark {
+public:
+    AnimatedWebpEncodeBench(SkWebpEncoder::Compression compression, int threads)
+        : fCompression(compression)
+        , fThreads(threads)
+        , fName(SkStringPrintf("Encode_WEBP%s_anim120_%dthreads",
+                               compression == SkWebpEncoder::Compression::kLossless ? "_LL" : "",
+                               threads)) {}
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkBitmap background;
+        SkAssertResult(ToolUtils::GetResourceAsBitmapWithColortype(
+                "images/color_wheel.jpg", &background, kRGBA_8888_SkColorType));
+
+        constexpr int kFrames = 120;
+        fBitmaps.resize(kFrames);
+        fFrames.resize(kFrames);
+        for (int i = 0; i < kFrames; i++) {
+            fBitmaps[i].allocPixels(SkImageInfo::MakeN32Premul(256, 256));
+            SkCanvas canvas(fBitmaps[i]);
+            canvas.drawImageRect(background.asImage(), SkRect::MakeWH(256, 256),
+                                 SkSamplingOptions());
+            SkPaint paint;
+            paint.setAntiAlias(true);
+            paint.setColor(SK_ColorWHITE);
+            canvas.drawCircle(20 + 2 * i % 216, 128, 20, paint);
+            paint.setColor(SK_ColorBLACK);
+            canvas.drawRect(SkRect::MakeXYWH(128, 10 + i % 200, 40, 40), paint);
+            SkAssertResult(fBitmaps[i].peekPixels(&fFrames[i].pixmap));
+            fFrames[i].duration = 33;
+        }
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeWorkStealingThreadPool(fThreads);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkWebpEncoder::Options opts;
+        opts.fCompression = fCompression;
+        opts.fQuality = 90;
+        opts.fExecutor = fExecutor.get();
+        while (loops-- > 0) {
+            SkNullWStream dst;
+            SkAssertResult(SkWebpEncoder::EncodeAnimated(&dst, fFrames, opts));
+        }
+    }
+
+private:
+    const SkWebpEncoder::Compression fCompression;
+    const int fThreads;
+    SkString fName;
+    std::vector<SkBitmap> fBitmaps;
+    std::vector<SkEncoder::Frame> fFrames;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH(return new AnimatedWebpEncodeBench(SkWebpEncoder::Compression::kLossy, 0));
+DEF_BENCH(return new AnimatedWebpEncodeBench(SkWebpEncoder::Compression::kLossy, 4));
+DEF_BENCH(return new AnimatedWebpEncodeBench(SkWebpEncoder::Compression::kLossy, 8));
+DEF_BENCH(return new AnimatedWebpEncodeBench(SkWebpEncoder::Compression::kLossless, 0));
+DEF_BENCH(return new AnimatedWebpEncodeBench(SkWebpEncoder::Compression::kLossless, 8));
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkString.h"
+#include "include/private/base/SkAssert.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <atomic>
+#include <memory>
+
+// Measures the overhead of pushing many small tasks through each SkExecutor thread pool.
+// Every loop runs a batch of kTasks tiny tasks, half of which add a nested batch of their own,
+// roughly the shape of tiled rasterization or per-frame decoding work.
+class ExecutorBench : public Benchmark {
+public:
+    enum class Pool { kFIFO, kLIFO, kWorkStealing };
+
+    ExecutorBench(Pool pool, int threads) : fPool(pool), fThreads(threads) {
+        static const char* kNames[] = {"fifo", "lifo", "workstealing"};
+        fName.printf("executor_%s_%d", kNames[(int)pool], threads);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        switch (fPool) {
+            case Pool::kFIFO:
+                fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+                break;
+            case Pool::kLIFO:
+                fExecutor = SkExecutor::MakeLIFOThreadPool(fThreads);
+                break;
+            case Pool::kWorkStealing:
+                fExecutor = SkExecutor::MakeWorkStealingThreadPool(fThreads);
+                break;
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        static constexpr int kTasks = 1024;
+        static constexpr int kNested = 16;
+
+        // Even tasks add their index, odd tasks add 0 + 1 + ... + (kNested-1) in their batch.
+        constexpr int kExpected = (kTasks / 2) * (kTasks / 2 - 1) +
+                                  (kTasks / 2) * (kNested * (kNested - 1) / 2);
+
+        for (int i = 0; i < loops; i++) {
+            std::atomic<int> sum{0};
+            SkTaskGroup tg(*fExecutor);
+            tg.batch(kTasks, [&](int j) {
+                if (j & 1) {
+                    SkTaskGroup nested(*fExecutor);
+                    nested.batch(kNested, [&](int k) {
+                        sum.fetch_add(k, std::memory_order_relaxed);
+                    });
+                } else {
+                    sum.fetch_add(j, std::memory_order_relaxed);
+                }
+            });
+            tg.wait();
+            SkASSERT_RELEASE(sum.load(std::memory_order_relaxed) == kExpected);
+        }
+    }
+
+private:
+    Pool                        fPool;
+    int                         fThreads;
+    SkString                    fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+#define DEF_EXECUTOR_BENCHES(threads)                                                       \
+    DEF_BENCH(return new ExecutorBench(ExecutorBench::Pool::kFIFO, threads);)               \
+    DEF_BENCH(return new ExecutorBench(ExecutorBench::Pool::kLIFO, threads);)               \
+    DEF_BENCH(return new ExecutorBench(ExecutorBench::Pool::kWorkStealing, threads);)
+
+DEF_EXECUTOR_BENCHES(1)
+DEF_EXECUTOR_BENCHES(2)
+DEF_EXECUTOR_BENCHES(4)
+DEF_EXECUTOR_BENCHES(8)
+DEF_EXECUTOR_BENCHES(16)
+DEF_EXECUTOR_BENCHES(32)
+DEF_EXECUTOR_BENCHES(64)
+DEF_EXECUTOR_BENCHES(128)
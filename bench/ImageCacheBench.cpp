@@ -6,7 +6,12 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkString.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <memory>
 
 namespace {
 static void* gGlobalAddress;
@@ -14,8 +19,8 @@ class TestKey : public SkResourceCache::Key {
 public:
     intptr_t fValue;
 
-    TestKey(intptr_t value) : fValue(value) {
-        this->init(&gGlobalAddress, 0, sizeof(fValue));
+    TestKey(intptr_t value, uint64_t sharedID = 0) : fValue(value) {
+        this->init(&gGlobalAddress, sharedID, sizeof(fValue));
     }
 };
 struct TestRec : public SkResourceCache::Rec {
@@ -72,6 +77,64 @@ private:
     using INHERITED = Benchmark;
 };
 
+// Many threads finding and adding recs in the global cache at once, as when decoding images or
+// caching blur masks from several threads.
+class ImageCacheThreadedBench : public Benchmark {
+    static constexpr int kKeyCount = 4096;
+    // Keys for this bench's recs carry this sharedID so we can purge them all when we're done.
+    static constexpr uint64_t kSharedID = 0x1A6EC0DE;
+
+    const int fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;
+    SkString fName;
+
+public:
+    explicit ImageCacheThreadedBench(int threads) : fThreads(threads) {
+        fName.printf("imagecache_global_%dthreads", threads);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeWorkStealingThreadPool(fThreads);
+    }
+
+    void onPreDraw(SkCanvas*) override {
+        for (int i = 0; i < kKeyCount; ++i) {
+            SkResourceCache::Add(new TestRec(TestKey(i, kSharedID), i));
+        }
+    }
+
+    void onPostDraw(SkCanvas*) override {
+        SkResourceCache::PostPurgeSharedID(kSharedID);
+        SkResourceCache::CheckMessages();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkTaskGroup(*fExecutor).batch(fThreads, [&](int thread) {
+            // Mostly hits, with one add for every eight finds.
+            for (int i = 0; i < loops; ++i) {
+                const intptr_t value = (thread * 7919 + i * 31) % kKeyCount;
+                const TestKey key(value, kSharedID);
+                if (!SkResourceCache::Find(key, TestRec::Visitor, nullptr) || (i & 7) == 0) {
+                    SkResourceCache::Add(new TestRec(key, value));
+                }
+            }
+        });
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new ImageCacheBench(); )
+DEF_BENCH( return new ImageCacheThreadedBench(1); )
+DEF_BENCH( return new ImageCacheThreadedBench(4); )
+DEF_BENCH( return new ImageCacheThreadedBench(16); )
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "src/base/SkRandom.h"
+
+extern bool gSkUseRasterPipelineBlitterCache;
+
+// Draws thousands of tiny solid color shapes, each in its own color, the way charts draw their
+// markers and bars.  Blitting each one is cheap, so these mostly measure per-draw setup.  The
+// surface is in Display P3, so the draws use SkRasterPipelineBlitter rather than the legacy
+// blitters.
+class ManySmallDrawsBench : public Benchmark {
+public:
+    enum class Shape { kRect, kAARect, kCircle };
+
+    ManySmallDrawsBench(Shape shape, bool cache) : fShape(shape), fCache(cache) {
+        static const char* kShapeNames[] = {"rect", "aarect", "circle"};
+        fName.printf("many_small_draws_%s%s", kShapeNames[(int)shape], cache ? "" : "_nocache");
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fSurface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(
+                kSize, kSize, SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB,
+                                                    SkNamedGamut::kDisplayP3)));
+        SkRandom rand;
+        for (int i = 0; i < kDraws; i++) {
+            fPoints[i] = {rand.nextRangeF(0, kSize - 8), rand.nextRangeF(0, kSize - 8)};
+            fColors[i] = rand.nextU() | 0x40000000;  // Mostly translucent.
+        }
+        fCircle = SkPath::Circle(3, 3, 2.5f);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const bool useCache = gSkUseRasterPipelineBlitterCache;
+        gSkUseRasterPipelineBlitterCache = fCache;
+
+        SkCanvas* canvas = fSurface->getCanvas();
+        SkPaint paint;
+        paint.setAntiAlias(fShape != Shape::kRect);
+        for (int loop = 0; loop < loops; loop++) {
+            for (int i = 0; i < kDraws; i++) {
+                paint.setColor(fColors[i]);
+                const SkPoint p = fPoints[i];
+                switch (fShape) {
+                    case Shape::kRect:
+                    case Shape::kAARect:
+                        canvas->drawRect(SkRect::MakeXYWH(p.fX, p.fY, 4, 3), paint);
+                        break;
+                    case Shape::kCircle:
+                        canvas->save();
+                        canvas->translate(p.fX, p.fY);
+                        canvas->drawPath(fCircle, paint);
+                        canvas->restore();
+                        break;
+                }
+            }
+        }
+
+        gSkUseRasterPipelineBlitterCache = useCache;
+    }
+
+private:
+    static constexpr int kSize = 1024;
+    static constexpr int kDraws = 1000;
+
+    const Shape      fShape;
+    const bool       fCache;
+    SkString         fName;
+    sk_sp<SkSurface> fSurface;
+    SkPoint          fPoints[kDraws];
+    SkColor          fColors[kDraws];
+    SkPath           fCircle;
+};
+
+using Shape = ManySmallDrawsBench::Shape;
+DEF_BENCH(return new ManySmallDrawsBench(Shape::kRect,   true);)
+DEF_BENCH(return new ManySmallDrawsBench(Shape::kRect,   false);)
+DEF_BENCH(return new ManySmallDrawsBench(Shape::kAARect, true);)
+DEF_BENCH(return new ManySmallDrawsBench(Shape::kAARect, false);)
+DEF_BENCH(return new ManySmallDrawsBench(Shape::kCircle, true);)
+DEF_BENCH(return new ManySmallDrawsBench(Shape::kCircle, false);)
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/MappedCodecBench.h"
+
+#include "include/codec/SkCodec.h"
+#include "include/core/SkData.h"
+#include "include/core/SkStream.h"
+#include "src/core/SkOSFile.h"
+#include "src/utils/SkOSPath.h"
+
+MappedCodecBench::MappedCodecBench(SkString path, Input input)
+    : fPath(std::move(path))
+    , fInput(input) {
+    const char* inputName = "";
+    switch (fInput) {
+        case Input::kFile:             inputName = "file";    break;
+        case Input::kMapped:           inputName = "mmap";    break;
+        case Input::kMappedSequential: inputName = "mmapseq"; break;
+    }
+    fName.printf("MappedCodec_%s_%s", SkOSPath::Basename(fPath.c_str()).c_str(), inputName);
+}
+
+const char* MappedCodecBench::onGetName() {
+    return fName.c_str();
+}
+
+bool MappedCodecBench::isSuitableFor(Backend backend) {
+    return Backend::kNonRendering == backend;
+}
+
+std::unique_ptr<SkStream> MappedCodecBench::openInput() const {
+    switch (fInput) {
+        case Input::kFile:
+            return SkFILEStream::Make(fPath.c_str());
+        case Input::kMapped:
+            return SkStream::MakeFromFile(fPath.c_str());
+        case Input::kMappedSequential: {
+            sk_sp<SkData> data = SkData::MakeFromFileName(fPath.c_str());
+            if (!data) {
+                return nullptr;
+            }
+            sk_fmadvise(data->data(), data->size(), SkMmapAdvice::kSequential);
+            return SkMemoryStream::Make(std::move(data));
+        }
+    }
+    SkUNREACHABLE;
+}
+
+void MappedCodecBench::onDelayedSetup() {
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromStream(this->openInput());
+    SkASSERT(codec);
+
+    fInfo = codec->getInfo().makeColorType(kN32_SkColorType)
+                            .makeAlphaType(kPremul_SkAlphaType)
+                            .makeColorSpace(nullptr);
+
+    fPixelStorage.reset(fInfo.computeMinByteSize());
+}
+
+void MappedCodecBench::onDraw(int n, SkCanvas* canvas) {
+    for (int i = 0; i < n; i++) {
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromStream(this->openInput());
+#ifdef SK_DEBUG
+        const SkCodec::Result result =
+#endif
+        codec->getPixels(fInfo, fPixelStorage.get(), fInfo.minRowBytes());
+        SkASSERT(result == SkCodec::kSuccess
+                 || result == SkCodec::kIncompleteInput);
+    }
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef MappedCodecBench_DEFINED
+#define MappedCodecBench_DEFINED
+
+#include "bench/Benchmark.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkString.h"
+#include "src/base/SkAutoMalloc.h"
+
+#include <memory>
+
+class SkStream;
+
+/**
+ *  Time opening an image file and decoding it with SkCodec, reading the file through a FILE*, or
+ *  through a memory map that codecs read in place. nanobench reports the resident set size with
+ *  each result, so running these over a directory of large images (--images) also compares how
+ *  much memory each way of reading costs.
+ */
+class MappedCodecBench : public Benchmark {
+public:
+    enum class Input {
+        kFile,            // SkFILEStream, which codecs copy from with read().
+        kMapped,          // SkStream::MakeFromFile(), which maps the file.
+        kMappedSequential // The same, with the mapping advised to be read once, front to back.
+    };
+
+    MappedCodecBench(SkString path, Input);
+
+protected:
+    const char* onGetName() override;
+    bool isSuitableFor(Backend backend) override;
+    void onDraw(int n, SkCanvas* canvas) override;
+    void onDelayedSetup() override;
+
+private:
+    std::unique_ptr<SkStream> openInput() const;
+
+    const SkString          fPath;
+    const Input             fInput;
+    SkString                fName;
+    SkImageInfo             fInfo;          // Set in onDelayedSetup.
+    SkAutoMalloc            fPixelStorage;  // Set in onDelayedSetup.
+    using INHERITED = Benchmark;
+};
+#endif // MappedCodecBench_DEFINED
@@ -8,21 +8,31 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
 #include "src/core/SkMipmap.h"
 
+#include <memory>
+
 class MipmapBench: public Benchmark {
     SkBitmap fBitmap;
     SkString fName;
     const int fW, fH;
-    bool fHalfFoat;
+    const SkColorType fColorType;
+    const int fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;
 
 public:
-    MipmapBench(int w, int h, bool halfFloat = false)
-        : fW(w), fH(h), fHalfFoat(halfFloat)
+    MipmapBench(int w, int h, SkColorType ct = kN32_SkColorType, int threads = 0)
+        : fW(w), fH(h), fColorType(ct), fThreads(threads)
     {
         fName.printf("mipmap_build_%dx%d", w, h);
-        if (halfFloat) {
+        if (ct == kRGBA_F16_SkColorType) {
             fName.append("_f16");
+        } else if (ct == kAlpha_8_SkColorType) {
+            fName.append("_a8");
+        }
+        if (threads > 0) {
+            fName.appendf("_%dthreads", threads);
         }
     }
 
@@ -34,16 +44,18 @@ protected:
     const char* onGetName() override { return fName.c_str(); }
 
     void onDelayedSetup() override {
-        SkColorType ct = fHalfFoat ? kRGBA_F16_SkColorType : kN32_SkColorType;
-        SkImageInfo info = SkImageInfo::Make(fW, fH, ct, kPremul_SkAlphaType,
+        SkImageInfo info = SkImageInfo::Make(fW, fH, fColorType, kPremul_SkAlphaType,
                                              SkColorSpace::MakeSRGB());
         fBitmap.allocPixels(info);
         fBitmap.eraseColor(SK_ColorWHITE);  // so we don't read uninitialized memory
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeWorkStealingThreadPool(fThreads);
+        }
     }
 
     void onDraw(int loops, SkCanvas*) override {
         for (int i = 0; i < loops * 4; i++) {
-            SkMipmap::Build(fBitmap, nullptr)->unref();
+            SkMipmap::Build(fBitmap.pixmap(), nullptr, true, fExecutor.get())->unref();
         }
     }
 
@@ -59,10 +71,19 @@ DEF_BENCH( return new MipmapBench(512, 511); )
 DEF_BENCH( return new MipmapBench(511, 512); )
 DEF_BENCH( return new MipmapBench(512, 512); )
 
-DEF_BENCH( return new MipmapBench(512, 512, true); )
-DEF_BENCH( return new MipmapBench(511, 511, true); )
+DEF_BENCH( return new MipmapBench(512, 512, kRGBA_F16_SkColorType); )
+DEF_BENCH( return new MipmapBench(511, 511, kRGBA_F16_SkColorType); )
+
+DEF_BENCH( return new MipmapBench(512, 512, kAlpha_8_SkColorType); )
+DEF_BENCH( return new MipmapBench(511, 511, kAlpha_8_SkColorType); )
 
 DEF_BENCH( return new MipmapBench(2048, 2048); )
 DEF_BENCH( return new MipmapBench(2047, 2047); )
 DEF_BENCH( return new MipmapBench(2048, 2047); )
 DEF_BENCH( return new MipmapBench(2047, 2048); )
+
+// Large textures, where building levels in bands on several threads pays off.
+DEF_BENCH( return new MipmapBench(4096, 4096); )
+DEF_BENCH( return new MipmapBench(4096, 4096, kN32_SkColorType, 4); )
+DEF_BENCH( return new MipmapBench(4096, 4096, kRGBA_F16_SkColorType); )
+DEF_BENCH( return new MipmapBench(4096, 4096, kRGBA_F16_SkColorType, 4); )
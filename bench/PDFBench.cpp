@@ -14,6 +14,7 @@
 #include "include/core/SkPath.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkString.h"
 #include "include/docs/SkPDFJpegHelpers.h"
 #include "include/effects/SkGradientShader.h"
 #include "include/private/base/SkTo.h"
@@ -189,6 +190,54 @@ private:
     std::unique_ptr<SkStreamAsset> fAsset;
 };
 
+/** The same command stream repeated to 8MB, big enough that it's deflated in blocks when the
+    document has an executor. */
+class PDFBlockCompressionBench : public Benchmark {
+public:
+    PDFBlockCompressionBench(int threads) : fThreads(threads) {
+        fName.printf("PDFBlockCompression_%d", threads);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+    void onDelayedSetup() override {
+        sk_sp<SkData> commands = GetResourceAsData("pdf_command_stream.txt");
+        if (!commands) {
+            return;
+        }
+        SkDynamicMemoryWStream stream;
+        while (stream.bytesWritten() < 8 << 20) {
+            stream.write(commands->data(), commands->size());
+        }
+        fData = stream.detachAsData();
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        SkASSERT(fData);
+        if (!fData) { return; }
+        SkPDF::Metadata metadata;
+        metadata.fExecutor = fExecutor.get();
+        while (loops-- > 0) {
+            SkNullWStream wStream;
+            SkPDFDocument doc(&wStream, metadata);
+            doc.beginPage(256, 256);
+            (void)SkPDFStreamOut(nullptr, SkMemoryStream::Make(fData),
+                                 &doc, SkPDFSteamCompressionEnabled::Yes);
+        }
+    }
+
+private:
+    int fThreads;
+    SkString fName;
+    sk_sp<SkData> fData;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
 struct PDFColorComponentBench : public Benchmark {
     bool isSuitableFor(Backend b) override {
         return b == Backend::kNonRendering;
@@ -311,6 +360,8 @@ struct PDFClipPathBenchmark : public Benchmark {
 DEF_BENCH(return new PDFImageBench;)
 DEF_BENCH(return new PDFJpegImageBench;)
 DEF_BENCH(return new PDFCompressionBench;)
+DEF_BENCH(return new PDFBlockCompressionBench(0);)
+DEF_BENCH(return new PDFBlockCompressionBench(4);)
 DEF_BENCH(return new PDFColorComponentBench;)
 DEF_BENCH(return new PDFShaderBench;)
 DEF_BENCH(return new WritePDFTextBenchmark;)
@@ -8,8 +8,11 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
+#include "include/core/SkPathBuilder.h"
 #include "include/core/SkPathUtils.h"
 #include "include/core/SkRRect.h"
 #include "include/core/SkShader.h"
@@ -1283,3 +1286,91 @@ DEF_BENCH( return new CommonConvexBench(200, 16, false, false); )
 DEF_BENCH( return new CommonConvexBench(200, 16, true,  false); )
 DEF_BENCH( return new CommonConvexBench(200, 16, false, true); )
 DEF_BENCH( return new CommonConvexBench(200, 16, true,  true); )
+
+extern bool gSkUseSparseStrips;
+
+// Large antialiased fills with tens of thousands of edges, drawn by AAA or by sparse strips, or
+// split into bands drawn by sparse strips on several threads.
+class ComplexPathBench : public Benchmark {
+public:
+    enum class Type { kChart, kMap };
+
+    ComplexPathBench(Type type, bool sparseStrips, int threads = 0)
+            : fType(type), fSparseStrips(sparseStrips), fThreads(threads) {
+        fName.printf("complex_path_%s%s", type == Type::kChart ? "chart" : "map",
+                     sparseStrips ? "_sparse_strips" : "_aaa");
+        if (threads > 0) {
+            fName.appendf("_%dthreads", threads);
+        }
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    SkISize onGetSize() override { return {1024, 1024}; }
+
+    void onDelayedSetup() override {
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeWorkStealingThreadPool(fThreads);
+        }
+
+        SkRandom rand;
+        SkPathBuilder builder;
+        if (fType == Type::kChart) {
+            // An area chart of a random walk, 40 points to the pixel.
+            builder.moveTo(0, 1024);
+            float y = 512;
+            for (int i = 0; i <= 40 * 1024; i++) {
+                y = SkTPin(y + rand.nextRangeF(-8, 8), 0.0f, 1024.0f);
+                builder.lineTo(i / 40.0f, y);
+            }
+            builder.lineTo(1024, 1024);
+        } else {
+            // Thousands of small, overlapping regions with curved borders.
+            for (int i = 0; i < 3000; i++) {
+                const SkPoint c = {rand.nextRangeF(0, 1024), rand.nextRangeF(0, 1024)};
+                const float r = rand.nextRangeF(2, 24);
+                builder.moveTo(c.fX + r, c.fY);
+                for (int j = 1; j <= 6; j++) {
+                    const float a = j * SK_ScalarPI / 3,
+                                m = (j - 0.5f) * SK_ScalarPI / 3;
+                    const float s = rand.nextRangeF(0.8f, 1.5f);
+                    builder.quadTo(c.fX + s * r * SkScalarCos(m), c.fY + s * r * SkScalarSin(m),
+                                   c.fX + r * SkScalarCos(a), c.fY + r * SkScalarSin(a));
+                }
+                builder.close();
+            }
+        }
+        fPath = builder.detach();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        this->setupPaint(&paint);
+
+        const bool useSparseStrips = gSkUseSparseStrips;
+        gSkUseSparseStrips = useSparseStrips || fSparseStrips;
+        SkExecutor* executor = SkGraphics::SetPathRasterExecutor(fExecutor.get());
+        for (int i = 0; i < loops; i++) {
+            canvas->drawPath(fPath, paint);
+        }
+        SkGraphics::SetPathRasterExecutor(executor);
+        gSkUseSparseStrips = useSparseStrips;
+    }
+
+private:
+    const Type  fType;
+    const bool  fSparseStrips;
+    const int   fThreads;
+    SkString    fName;
+    SkPath      fPath;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH( return new ComplexPathBench(ComplexPathBench::Type::kChart, false); )
+DEF_BENCH( return new ComplexPathBench(ComplexPathBench::Type::kChart, true); )
+DEF_BENCH( return new ComplexPathBench(ComplexPathBench::Type::kMap,   false); )
+DEF_BENCH( return new ComplexPathBench(ComplexPathBench::Type::kMap,   true); )
+DEF_BENCH( return new ComplexPathBench(ComplexPathBench::Type::kChart, true, 4); )
+DEF_BENCH( return new ComplexPathBench(ComplexPathBench::Type::kMap,   true, 4); )
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "include/private/base/SkTPin.h"
+#include "src/base/SkRandom.h"
+
+// Fills the area under a polyline with many more points than pixels across, the way charts of
+// long time series are drawn.  With many points most of its lines are shorter than a row, so
+// these mostly measure building edges from the path's lines, rather than filling them.
+class PolylineFillBench : public Benchmark {
+public:
+    PolylineFillBench(int points, bool aa, bool clipped)
+            : fPoints(points), fAA(aa), fClipped(clipped) {
+        fName.printf("polyline_fill_%d_%s%s", points, aa ? "aa" : "bw", clipped ? "_clipped" : "");
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fSurface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(kWidth, kHeight));
+
+        // A random walk, like a stock price.
+        SkRandom rand;
+        float y = kHeight / 2;
+        fPath.moveTo(0, kHeight);
+        for (int i = 0; i < fPoints; i++) {
+            y = SkTPin(y + rand.nextRangeF(-2, 2), 0.0f, (float)kHeight);
+            fPath.lineTo(i * (float)kWidth / fPoints, y);
+        }
+        fPath.lineTo(kWidth, kHeight);
+        fPath.close();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkCanvas* canvas = fSurface->getCanvas();
+        canvas->save();
+        if (fClipped) {
+            // Zoomed in on part of the chart, so many lines are clipped out.
+            canvas->clipRect(SkRect::MakeLTRB(kWidth / 4, kHeight / 4,
+                                              kWidth * 3 / 4, kHeight * 3 / 4));
+        }
+        SkPaint paint;
+        paint.setAntiAlias(fAA);
+        paint.setColor(0x804080FF);
+        for (int loop = 0; loop < loops; loop++) {
+            canvas->drawPath(fPath, paint);
+        }
+        canvas->restore();
+    }
+
+private:
+    static constexpr int kWidth  = 1024;
+    static constexpr int kHeight = 512;
+
+    const int        fPoints;
+    const bool       fAA;
+    const bool       fClipped;
+    SkString         fName;
+    sk_sp<SkSurface> fSurface;
+    SkPath           fPath;
+};
+
+DEF_BENCH(return new PolylineFillBench(  1000, false, false);)
+DEF_BENCH(return new PolylineFillBench(  1000, true,  false);)
+DEF_BENCH(return new PolylineFillBench(100000, false, false);)
+DEF_BENCH(return new PolylineFillBench(100000, true,  false);)
+DEF_BENCH(return new PolylineFillBench(100000, false, true);)
+DEF_BENCH(return new PolylineFillBench(100000, true,  true);)
@@ -9,7 +9,9 @@
 
 #include "include/core/SkBBHFactory.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPictureRecorder.h"
+#include "include/utils/SkPictureTileSchedule.h"
 
 PictureCentricBench::PictureCentricBench(const char* name, const SkPicture* pic) : fName(name) {
     // Flatten the source picture in case it's trivially nested (useless for timing).
@@ -48,6 +50,36 @@ void RecordingBench::onDraw(int loops, SkCanvas*) {
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TiledPlaybackBench::TiledPlaybackBench(const char* name, const SkPicture* pic, int threads)
+    : INHERITED(name, pic)
+    , fThreads(threads)
+{
+    fName.appendf("_%dthreads", threads);
+}
+
+TiledPlaybackBench::~TiledPlaybackBench() = default;
+
+void TiledPlaybackBench::onDelayedSetup() {
+    fExecutor = SkExecutor::MakeWorkStealingThreadPool(fThreads);
+    fSchedule = SkPictureTileSchedule::Make(fSrc, SkMatrix::I(),
+                                            fSrc->cullRect().roundOut(), {256, 256});
+    fTiles.resize(fSchedule->tileCount());
+    fCanvases.resize(fSchedule->tileCount());
+    for (int t = 0; t < fSchedule->tileCount(); t++) {
+        fTiles[t].allocN32Pixels(fSchedule->tileBounds(t).width(),
+                                 fSchedule->tileBounds(t).height());
+        fCanvases[t] = std::make_unique<SkCanvas>(fTiles[t]);
+    }
+}
+
+void TiledPlaybackBench::onDraw(int loops, SkCanvas*) {
+    while (loops --> 0) {
+        fSchedule->playback(*fExecutor, [this](int tile) { return fCanvases[tile].get(); });
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 #include "include/core/SkSerialProcs.h"
 
@@ -9,7 +9,15 @@
 #define RecordingBench_DEFINED
 
 #include "bench/Benchmark.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkPicture.h"
+#include "include/private/base/SkTArray.h"
+
+#include <memory>
+
+class SkExecutor;
+class SkPictureTileSchedule;
 
 class PictureCentricBench : public Benchmark {
 public:
@@ -40,6 +48,27 @@ private:
     using INHERITED = PictureCentricBench;
 };
 
+// Plays the picture back through an SkPictureTileSchedule into a grid of raster tiles,
+// spread over a pool of the given number of threads.
+class TiledPlaybackBench : public PictureCentricBench {
+public:
+    TiledPlaybackBench(const char* name, const SkPicture*, int threads);
+    ~TiledPlaybackBench() override;
+
+protected:
+    void onDelayedSetup() override;
+    void onDraw(int loops, SkCanvas*) override;
+
+private:
+    int fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;
+    std::unique_ptr<SkPictureTileSchedule> fSchedule;
+    skia_private::TArray<SkBitmap> fTiles;
+    skia_private::TArray<std::unique_ptr<SkCanvas>> fCanvases;
+
+    using INHERITED = PictureCentricBench;
+};
+
 class DeserializePictureBench : public Benchmark {
 public:
     DeserializePictureBench(const char* name, sk_sp<SkData> encodedPicture);
@@ -8,8 +8,10 @@
 #include "src/core/SkStrike.h"
 
 #include "bench/Benchmark.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkGraphics.h"
 #include "include/core/SkTypeface.h"
@@ -22,6 +24,10 @@
 #include "tools/fonts/FontToolUtils.h"
 #include "tools/text/SkTextBlobTrace.h"
 
+#include <cstring>
+#include <memory>
+#include <vector>
+
 using namespace skia_private;
 
 static void do_font_stuff(SkFont* font) {
@@ -117,10 +123,62 @@ private:
     SkString fName;
 };
 
+// Draws the same text from many threads at once into their own canvases. Once the first draw has
+// filled the strike cache, every draw should find its strike and glyphs already there.
+class SkGlyphCacheThreadedDraw : public Benchmark {
+public:
+    explicit SkGlyphCacheThreadedDraw(int threads) : fThreads(threads) {}
+
+protected:
+    const char* onGetName() override {
+        fName.printf("SkGlyphCacheThreadedDraw_%dthreads", fThreads);
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeWorkStealingThreadPool(fThreads);
+        fBitmaps.resize(fThreads);
+        for (SkBitmap& bitmap : fBitmaps) {
+            bitmap.allocN32Pixels(256, 64);
+        }
+        fFont = ToolUtils::DefaultFont();
+        fFont.setEdging(SkFont::Edging::kAntiAlias);
+        fFont.setSubpixel(true);
+        fFont.setSize(14);
+        fFont.setTypeface(ToolUtils::CreatePortableTypeface("serif", SkFontStyle()));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        static constexpr char kText[] = "The quick brown fox jumps over the lazy dog.";
+        SkTaskGroup(*fExecutor).batch(fThreads, [&](int thread) {
+            SkCanvas canvas(fBitmaps[thread]);
+            SkPaint paint;
+            for (int i = 0; i < loops * 10; i++) {
+                canvas.drawSimpleText(kText, strlen(kText), SkTextEncoding::kUTF8,
+                                      0.25f * (i % 4), 20, fFont, paint);
+            }
+        });
+    }
+
+private:
+    const int fThreads;
+    SkString fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+    std::vector<SkBitmap> fBitmaps;
+    SkFont fFont;
+};
+
 DEF_BENCH( return new SkGlyphCacheBasic(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheBasic(32 * 1024 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(32 * 1024 * 1024); )
+DEF_BENCH( return new SkGlyphCacheThreadedDraw(1); )
+DEF_BENCH( return new SkGlyphCacheThreadedDraw(4); )
+DEF_BENCH( return new SkGlyphCacheThreadedDraw(16); )
 
 namespace {
 class DiscardableManager : public SkStrikeServer::DiscardableHandleManager,
@@ -14,21 +14,33 @@ public:
 
     SwizzleBench(const char* name, SkOpts::Swizzle_8888_u32 fn) : fName(name), fFn_u32(fn) {}
     SwizzleBench(const char* name, SkOpts::Swizzle_8888_u8  fn) : fName(name), fFn_u8 (fn) {}
+    SwizzleBench(const char* name, SkOpts::Swizzle_8888_index fn)
+        : fName(name), fFn_index(fn) {}
+    SwizzleBench(const char* name, SkOpts::Swizzle_8888_small_index fn, int bitsPerIndex)
+        : fName(name), fFn_small_index(fn), fBitsPerIndex(bitsPerIndex) {}
 
     bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
     const char* onGetName() override { return fName; }
     void onDraw(int loops, SkCanvas*) override {
         static const int K = 1023; // Arbitrary, but nice to be a non-power-of-two to trip up SIMD.
-        uint32_t dst[K], src[K];
+        uint32_t dst[K], src[2*K];  // 16-bit RGBA needs two uint32_t per pixel.
+        uint32_t table[256] = {};
         while (loops --> 0) {
             if (fFn_u32) { fFn_u32(dst,                 src, K); }
             if (fFn_u8)  { fFn_u8 (dst, (const uint8_t*)src, K); }
+            if (fFn_index) { fFn_index(dst, (const uint8_t*)src, K, table); }
+            if (fFn_small_index) {
+                fFn_small_index(dst, (const uint8_t*)src, K, fBitsPerIndex, table);
+            }
         }
     }
 private:
     const char* fName;
     SkOpts::Swizzle_8888_u32 fFn_u32 = nullptr;
     SkOpts::Swizzle_8888_u8  fFn_u8  = nullptr;
+    SkOpts::Swizzle_8888_index fFn_index = nullptr;
+    SkOpts::Swizzle_8888_small_index fFn_small_index = nullptr;
+    int fBitsPerIndex = 0;
 };
 
 
@@ -42,3 +54,11 @@ DEF_BENCH(return new SwizzleBench("SkOpts::grayA_to_RGBA", SkOpts::grayA_to_RGBA
 DEF_BENCH(return new SwizzleBench("SkOpts::grayA_to_rgbA", SkOpts::grayA_to_rgbA));
 DEF_BENCH(return new SwizzleBench("SkOpts::inverted_CMYK_to_RGB1", SkOpts::inverted_CMYK_to_RGB1));
 DEF_BENCH(return new SwizzleBench("SkOpts::inverted_CMYK_to_BGR1", SkOpts::inverted_CMYK_to_BGR1));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGB16_to_RGB1", SkOpts::RGB16_to_RGB1));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGB16_to_BGR1", SkOpts::RGB16_to_BGR1));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBA16_to_RGBA", SkOpts::RGBA16_to_RGBA));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBA16_to_BGRA", SkOpts::RGBA16_to_BGRA));
+DEF_BENCH(return new SwizzleBench("SkOpts::index_to_8888", SkOpts::index_to_8888));
+DEF_BENCH(return new SwizzleBench("SkOpts::small_index_to_8888_1", SkOpts::small_index_to_8888, 1));
+DEF_BENCH(return new SwizzleBench("SkOpts::small_index_to_8888_2", SkOpts::small_index_to_8888, 2));
+DEF_BENCH(return new SwizzleBench("SkOpts::small_index_to_8888_4", SkOpts::small_index_to_8888, 4));
@@ -15,6 +15,7 @@
 #include "bench/CodecBenchPriv.h"
 #include "bench/GMBench.h"
 #include "bench/MSKPBench.h"
+#include "bench/MappedCodecBench.h"
 #include "bench/RecordingBench.h"
 #include "bench/ResultsWriter.h"
 #include "bench/SKPAnimationBench.h"
@@ -26,10 +27,13 @@
 #include "include/codec/SkJpegDecoder.h"
 #include "include/codec/SkPngDecoder.h"
 #include "include/core/SkBBHFactory.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkGraphics.h"
 #include "include/core/SkPictureRecorder.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkString.h"
 #include "include/core/SkSurface.h"
 #include "include/encode/SkPngEncoder.h"
@@ -80,6 +84,7 @@
 #include "tools/graphite/GraphiteToolUtils.h"
 #endif
 
+#include <algorithm>
 #include <cinttypes>
 #include <memory>
 #include <optional>
@@ -88,6 +93,8 @@
 
 extern bool gSkForceRasterPipelineBlitter;
 extern bool gForceHighPrecisionRasterPipeline;
+extern bool gDisableRasterPipelineSuperstages;
+extern bool gSkUseSparseStrips;
 
 #ifndef SK_BUILD_FOR_WIN
 #include <unistd.h>
@@ -150,6 +157,8 @@ static DEFINE_string(zoom, "1.0,0",
                      "function that ping-pongs between 1.0 and zoomMax.");
 static DEFINE_bool(bbh, true, "Build a BBH for SKPs?");
 static DEFINE_bool(loopSKP, true, "Loop SKPs like we do for micro benches?");
+static DEFINE_string(tiledPlaybackThreads, "",
+                     "Space-separated thread counts to bench tiled, multithreaded SKP playback with.");
 static DEFINE_int(flushEvery, 10, "Flush --outResultsFile every Nth run.");
 static DEFINE_bool(gpuStats, false, "Print GPU stats after each gpu benchmark?");
 static DEFINE_bool(gpuStatsDump, false, "Dump GPU stats after each benchmark to json");
@@ -164,6 +173,8 @@ static DEFINE_string(benchType,  "",
 
 static DEFINE_bool(forceRasterPipeline, false, "sets gSkForceRasterPipelineBlitter");
 static DEFINE_bool(forceRasterPipelineHP, false, "sets gSkForceRasterPipelineBlitter and gForceHighPrecisionRasterPipeline");
+static DEFINE_bool(sparseStrips, false, "sets gSkUseSparseStrips");
+static DEFINE_bool(rasterPipelineSuperstages, true, "if false, sets gDisableRasterPipelineSuperstages");
 
 static DEFINE_bool2(pre_log, p, false,
                     "Log before running each test. May be incomprehensible when threading");
@@ -247,6 +258,29 @@ bool Target::capturePixels(SkBitmap* bmp) {
     return true;
 }
 
+// Draws through SkSurfaces::RasterThreaded(), flushing the recorded draws out to a thread pool
+// at the end of each frame so that the rasterization is included in the timing.
+struct ThreadedRasterTarget : public Target {
+    explicit ThreadedRasterTarget(const Config& c) : Target(c) {}
+    std::unique_ptr<SkExecutor> executor;
+
+    bool init(SkImageInfo info, Benchmark*) override {
+        this->executor = SkExecutor::MakeWorkStealingThreadPool();
+        this->surface = SkSurfaces::RasterThreaded(info, *this->executor);
+        return this->surface != nullptr;
+    }
+    void submitFrame() override {
+        // Peeking at the pixels forces the surface to rasterize everything recorded so far.
+        SkPixmap pm;
+        this->surface->peekPixels(&pm);
+    }
+    void submitWorkAndSyncCPU() override { this->submitFrame(); }
+    bool capturePixels(SkBitmap* bmp) override {
+        bmp->allocPixels(this->surface->imageInfo());
+        return this->surface->readPixels(*bmp, 0, 0);
+    }
+};
+
 struct GPUTarget : public Target {
     explicit GPUTarget(const Config& c) : Target(c) {}
     ContextInfo contextInfo;
@@ -449,8 +483,8 @@ static bool write_canvas_png(Target* target, const SkString& filename) {
     if (filename.isEmpty()) {
         return false;
     }
-    if (target->getCanvas() &&
-        kUnknown_SkColorType == target->getCanvas()->imageInfo().colorType()) {
+    if (target->surface &&
+        kUnknown_SkColorType == target->surface->imageInfo().colorType()) {
         return false;
     }
 
@@ -680,6 +714,7 @@ static std::optional<Config> create_config(const SkCommandLineConfig* config) {
     CPU_CONFIG("a8",    Backend::kRaster,    kAlpha_8_SkColorType, kPremul_SkAlphaType)
     CPU_CONFIG("565",   Backend::kRaster,    kRGB_565_SkColorType, kOpaque_SkAlphaType)
     CPU_CONFIG("8888",  Backend::kRaster,        kN32_SkColorType, kPremul_SkAlphaType)
+    CPU_CONFIG("8888_mt", Backend::kRaster,      kN32_SkColorType, kPremul_SkAlphaType)
     CPU_CONFIG("rgba",  Backend::kRaster,  kRGBA_8888_SkColorType, kPremul_SkAlphaType)
     CPU_CONFIG("bgra",  Backend::kRaster,  kBGRA_8888_SkColorType, kPremul_SkAlphaType)
     CPU_CONFIG("f16",   Backend::kRaster,   kRGBA_F16_SkColorType, kPremul_SkAlphaType)
@@ -737,7 +772,11 @@ static Target* is_enabled(Benchmark* bench, const Config& config) {
         break;
 #endif
     default:
-        target = new Target(config);
+        if (config.name.equals("8888_mt")) {
+            target = new ThreadedRasterTarget(config);
+        } else {
+            target = new Target(config);
+        }
         break;
     }
 
@@ -986,6 +1025,27 @@ public:
             return new DeserializePictureBench(name.c_str(), std::move(data));
         }
 
+        // Then once for each thread count as TiledPlaybackBenches.
+        while (fCurrentTiledThreads < FLAGS_tiledPlaybackThreads.size()) {
+            while (fCurrentTiledSKP < fSKPs.size()) {
+                const SkString& path = fSKPs[fCurrentTiledSKP++];
+                sk_sp<SkPicture> pic = ReadPicture(path.c_str());
+                if (!pic) {
+                    continue;
+                }
+                SkString name = SkOSPath::Basename(path.c_str());
+                fSourceType = "skp";
+                fBenchType  = "tiled_playback";
+                fSKPBytes = static_cast<double>(pic->approximateBytesUsed());
+                fSKPOps   = pic->approximateOpCount();
+                return new TiledPlaybackBench(
+                        name.c_str(), pic.get(),
+                        std::max(1, atoi(FLAGS_tiledPlaybackThreads[fCurrentTiledThreads])));
+            }
+            fCurrentTiledSKP = 0;
+            fCurrentTiledThreads++;
+        }
+
         // Then once each for each scale as SKPBenches (playback).
         while (fCurrentScale < fScales.size()) {
             while (fCurrentSKP < fSKPs.size()) {
@@ -1134,6 +1194,30 @@ public:
             fCurrentColorType = 0;
         }
 
+        // Run MappedCodecBenches, comparing ways of reading the same image files.
+        for (; fCurrentMappedCodec < fImages.size(); fCurrentMappedCodec++) {
+            fSourceType = "image";
+            fBenchType = "skcodec_input";
+
+            const SkString& path = fImages[fCurrentMappedCodec];
+            if (CommandLineFlags::ShouldSkip(FLAGS_match, path.c_str())) {
+                continue;
+            }
+            if (fCurrentMappedInput == 0 && !SkCodec::MakeFromData(
+                                                     SkData::MakeFromFileName(path.c_str()))) {
+                continue;
+            }
+            constexpr MappedCodecBench::Input kInputs[] = {
+                MappedCodecBench::Input::kFile,
+                MappedCodecBench::Input::kMapped,
+                MappedCodecBench::Input::kMappedSequential,
+            };
+            if (fCurrentMappedInput < (int)std::size(kInputs)) {
+                return new MappedCodecBench(path, kInputs[fCurrentMappedInput++]);
+            }
+            fCurrentMappedInput = 0;
+        }
+
         // Run AndroidCodecBenches
         const int sampleSizes[] = { 2, 4, 8 };
         for (; fCurrentAndroidCodec < fImages.size(); fCurrentAndroidCodec++) {
@@ -1308,12 +1392,16 @@ private:
     const char* fBenchType;   // How we bench it: micro, recording, playback, ...
     int fCurrentRecording = 0;
     int fCurrentDeserialPicture = 0;
+    int fCurrentTiledSKP = 0;
+    int fCurrentTiledThreads = 0;
     int fCurrentMSKP = 0;
     int fCurrentScale = 0;
     int fCurrentSKP = 0;
     int fCurrentSVG = 0;
     int fCurrentTextBlobTrace = 0;
     int fCurrentCodec = 0;
+    int fCurrentMappedCodec = 0;
+    int fCurrentMappedInput = 0;
     int fCurrentAndroidCodec = 0;
 #ifdef SK_ENABLE_ANDROID_UTILS
     int fCurrentBRDImage = 0;
@@ -1457,6 +1545,8 @@ int main(int argc, char** argv) {
 
     gSkForceRasterPipelineBlitter     = FLAGS_forceRasterPipelineHP || FLAGS_forceRasterPipeline;
     gForceHighPrecisionRasterPipeline = FLAGS_forceRasterPipelineHP;
+    gSkUseSparseStrips                = FLAGS_sparseStrips;
+    gDisableRasterPipelineSuperstages = !FLAGS_rasterPipelineSuperstages;
 
     // The SkSL memory benchmark must run before any GPU painting occurs. SkSL allocates memory for
     // its modules the first time they are accessed, and this test is trying to measure the size of
@@ -83,6 +83,7 @@ using namespace skia_private;
 
 extern bool gSkForceRasterPipelineBlitter;
 extern bool gForceHighPrecisionRasterPipeline;
+extern bool gSkUseSparseStrips;
 extern bool gCreateProtectedContext;
 
 static DEFINE_string(src, "tests gm skp mskp lottie rive svg image colorImage",
@@ -118,6 +119,7 @@ static DEFINE_int(shard,  0, "Which shard do I run?");
 static DEFINE_string(mskps, "", "Directory to read mskps from, or a single mskp file.");
 static DEFINE_bool(forceRasterPipeline, false, "sets gSkForceRasterPipelineBlitter");
 static DEFINE_bool(forceRasterPipelineHP, false, "sets gSkForceRasterPipelineBlitter and gForceHighPrecisionRasterPipeline");
+static DEFINE_bool(sparseStrips, false, "sets gSkUseSparseStrips");
 static DEFINE_bool(createProtected, false, "attempts to create a protected backend context");
 
 static DEFINE_string(bisect, "",
@@ -1029,6 +1031,7 @@ static Sink* create_sink(const GrContextOptions& grCtxOptions,
         SINK("565",         RasterSink, kRGB_565_SkColorType);
         SINK("4444",        RasterSink, kARGB_4444_SkColorType);
         SINK("8888",        RasterSink, kN32_SkColorType);
+        SINK("8888_mt",     ThreadedRasterSink, kN32_SkColorType);
         SINK("rgba",        RasterSink, kRGBA_8888_SkColorType);
         SINK("bgra",        RasterSink, kBGRA_8888_SkColorType);
         SINK("rgbx",        RasterSink, kRGB_888x_SkColorType);
@@ -1590,6 +1593,7 @@ int main(int argc, char** argv) {
 
     gSkForceRasterPipelineBlitter     = FLAGS_forceRasterPipelineHP || FLAGS_forceRasterPipeline;
     gForceHighPrecisionRasterPipeline = FLAGS_forceRasterPipelineHP;
+    gSkUseSparseStrips                = FLAGS_sparseStrips;
     gCreateProtectedContext           = FLAGS_createProtected;
 
     // The bots like having a verbose.log to upload, so always touch the file even if --verbose.
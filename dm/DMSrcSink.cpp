@@ -2149,7 +2149,41 @@ Result RasterSink::draw(const Src& src, SkBitmap* dst, SkWStream*, SkString*) co
     return src.draw(surface->getCanvas(), /*GraphiteTestContext=*/nullptr);
 }
 
-/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+ThreadedRasterSink::ThreadedRasterSink(SkColorType colorType)
+    : RasterSink(colorType)
+    , fExecutor(SkExecutor::MakeWorkStealingThreadPool()) {}
+
+Result ThreadedRasterSink::draw(const Src& src, SkBitmap* dst, SkWStream*, SkString*) const {
+    const SkISize size = src.size();
+    if (size.isEmpty()) {
+        return Result(Result::Status::Skip,
+                      SkStringPrintf("Skipping empty source: %s", src.name().c_str()));
+    }
+
+    const SkImageInfo info = SkImageInfo::Make(size, this->colorInfo());
+    SkSurfaceProps props(/*flags=*/0, kRGB_H_SkPixelGeometry);
+    // Small tiles, so that even small GMs are split across several threads.
+    auto surface = SkSurfaces::RasterThreaded(info, *fExecutor, {64, 64}, &props);
+    if (!surface) {
+        return Result::Fatal("Could not create a threaded raster surface.");
+    }
+    surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+
+    Result result = src.draw(surface->getCanvas(), /*GraphiteTestContext=*/nullptr);
+    if (!result.isOk()) {
+        return result;
+    }
+
+    dst->allocPixels(info);
+    if (!surface->readPixels(*dst, 0, 0)) {
+        return Result::Fatal("Could not read back threaded raster surface.");
+    }
+    return Result::Ok();
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 #if defined(SK_GRAPHITE)
 
@@ -542,6 +542,21 @@ private:
     sk_sp<SkColorSpace> fColorSpace;
 };
 
+// Draws like RasterSink, but through SkSurfaces::RasterThreaded(), checking that spreading the
+// rasterization across threads doesn't change any pixels.
+class ThreadedRasterSink : public RasterSink {
+public:
+    explicit ThreadedRasterSink(SkColorType);
+
+    Result draw(const Src&, SkBitmap*, SkWStream*, SkString*) const override;
+    SinkFlags flags() const override {
+        return SinkFlags{ SinkFlags::kRaster, SinkFlags::kIndirect };
+    }
+
+private:
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
 class SKPSink : public Sink {
 public:
     SKPSink();
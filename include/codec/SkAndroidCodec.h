@@ -214,6 +214,9 @@ public:
          *  method if it is more efficient.
          *
          *  The default is 1, representing no downscaling.
+         *
+         *  Ignored when SkCodec::Options::fResampling is set, in which case the dimensions
+         *  passed to getAndroidPixels() may be any size.
          */
         int fSampleSize;
     };
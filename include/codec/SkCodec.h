@@ -30,12 +30,14 @@
 #include <vector>
 
 class SkData;
+class SkExecutor;
 class SkFrameHolder;
 class SkImage;
 class SkPngChunkReader;
 class SkSampler;
 class SkStream;
 struct SkGainmapInfo;
+struct SkSamplingOptions;
 enum SkAlphaType : int;
 enum class SkEncodedImageFormat;
 
@@ -334,6 +336,9 @@ public:
             , fSubset(nullptr)
             , fFrameIndex(0)
             , fPriorFrame(kNoFrame)
+            , fExecutor(nullptr)
+            , fResampling(nullptr)
+            , fProgressivePreviews(false)
         {}
 
         ZeroInitialized            fZeroInitialized;
@@ -377,6 +382,40 @@ public:
          *  If set to kNoFrame, the codec will decode any necessary required frame(s) first.
          */
         int                        fPriorFrame;
+
+        /**
+         *  If not NULL, getPixels() may split the decode into parts that it decodes at the
+         *  same time on this executor.  It still returns once the whole decode is done.
+         *
+         *  Currently only used by JPEGs with restart markers.
+         */
+        SkExecutor*                fExecutor;
+
+        /**
+         *  If not NULL, getPixels() accepts any dimensions, not just those returned by
+         *  getScaledDimensions().  The codec decodes at the nearest size it supports that is
+         *  at least as large, and resamples to the requested size with these options as the
+         *  rows are decoded, without ever holding the whole image at that size.
+         *
+         *  Cubic resamplers use that cubic, kLinear a tent, and kNearest a box filter.  When
+         *  downscaling, each filter is widened so that every output pixel is an average of the
+         *  source pixels it covers.  Mipmap modes are ignored.
+         *
+         *  Not supported along with fSubset.
+         */
+        const SkSamplingOptions*   fResampling;
+
+        /**
+         *  If true, an incremental decode of a progressive image writes a preview of the whole
+         *  image to the dst each time incrementalDecode() finds that another scan has arrived,
+         *  each sharper than the last, rather than waiting for the final scan.  Once there is
+         *  a preview, incrementalDecode() reports every row as decoded.  Decoding to one of the
+         *  smaller sizes from getScaledDimensions() makes each preview that much quicker.
+         *
+         *  Currently only used by JPEG, which otherwise doesn't support incremental decodes.
+         *  Not supported along with fSubset.
+         */
+        bool                       fProgressivePreviews;
     };
 
     /**
@@ -1044,6 +1083,9 @@ private:
     Result handleFrameIndex(const SkImageInfo&, void* pixels, size_t rowBytes, const Options&,
                             GetPixelsCallback = nullptr);
 
+    // getPixels() to a size the codec can't decode to directly, using options.fResampling.
+    Result resampledDecode(const SkImageInfo&, void* pixels, size_t rowBytes, const Options&);
+
     // Methods for scanline decoding.
     virtual Result onStartScanlineDecode(const SkImageInfo& /*dstInfo*/,
             const Options& /*options*/) {
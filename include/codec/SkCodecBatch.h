@@ -0,0 +1,67 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkCodecBatch_DEFINED
+#define SkCodecBatch_DEFINED
+
+#include "include/codec/SkCodec.h"
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
+#include "include/core/SkTypes.h"
+
+#include <vector>
+
+class SkExecutor;
+class SkPixmap;
+struct SkSamplingOptions;
+
+/**
+ *  Decodes many encoded images, each into a pixmap the caller has already allocated.
+ *
+ *  This is meant for large numbers of small images, like icons and sprites, which each decode so
+ *  quickly that a task apiece would spend much of its time being scheduled.  Instead the images
+ *  are split into runs of consecutive images with about the same amount of encoded data, and
+ *  each task decodes a whole run.  Each thread decoding a batch keeps its row buffers, libpng's
+ *  allocations and libjpeg's decompress contexts from one image to the next.
+ */
+class SK_API SkCodecBatch {
+public:
+    struct Options {
+        /**
+         *  If not null, runs are decoded at the same time on this executor.  Otherwise they are
+         *  all decoded on the calling thread.
+         */
+        SkExecutor* fExecutor = nullptr;
+
+        /**
+         *  As SkCodec::Options::fResampling.  If not null, the pixmaps may be any size, and each
+         *  image is resampled to fit its pixmap.  Otherwise each pixmap must be a size its image
+         *  can be decoded to.
+         */
+        const SkSamplingOptions* fResampling = nullptr;
+    };
+
+    /**
+     *  Decodes encoded[i] into dst[i] for every i, as SkCodec::getPixels() would, and returns
+     *  their results.  encoded and dst must be the same size.  A null SkData is kInvalidInput.
+     *
+     *  Returns once every image has been decoded.
+     */
+    static std::vector<SkCodec::Result> Decode(SkSpan<const sk_sp<SkData>> encoded,
+                                               SkSpan<const SkPixmap> dst,
+                                               const Options& options);
+    static std::vector<SkCodec::Result> Decode(SkSpan<const sk_sp<SkData>> encoded,
+                                               SkSpan<const SkPixmap> dst) {
+        return Decode(encoded, dst, Options());
+    }
+
+private:
+    SkCodecBatch() = delete;
+};
+
+#endif  // SkCodecBatch_DEFINED
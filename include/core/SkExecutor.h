@@ -21,6 +21,10 @@ public:
                                                           bool allowBorrowing = true);
     static std::unique_ptr<SkExecutor> MakeLIFOThreadPool(int threads = 0,
                                                           bool allowBorrowing = true);
+    // Like the above, but each thread keeps its own work list and steals from the others when
+    // it runs out, which scales better when many threads are adding and running small tasks.
+    static std::unique_ptr<SkExecutor> MakeWorkStealingThreadPool(int threads = 0,
+                                                                  bool allowBorrowing = true);
 
     // There is always a default SkExecutor available by calling SkExecutor::GetDefault().
     static SkExecutor& GetDefault();
@@ -16,6 +16,7 @@
 #include <memory>
 
 class SkData;
+class SkExecutor;
 class SkImageGenerator;
 class SkOpenTypeSVGDecoder;
 class SkTraceMemoryDump;
@@ -126,6 +127,39 @@ public:
     static size_t GetResourceCacheSingleAllocationByteLimit();
     static size_t SetResourceCacheSingleAllocationByteLimit(size_t newLimit);
 
+    /**
+     *  Lazily decoded images (e.g. from SkImages::DeferredFromEncodedData) are decoded once into
+     *  the resource cache, even when several threads draw them at the same time: the first
+     *  decodes, and the others wait for it.  GetImageDecodeCount() returns how many times such an
+     *  image has been decoded for the cache, and GetSharedImageDecodeCount() how many times a
+     *  thread waited for another thread's decode and used it instead.
+     */
+    static size_t GetImageDecodeCount();
+    static size_t GetSharedImageDecodeCount();
+
+    /**
+     *  Raster drawing antialiases path fills with analytic coverage by default.  If set, it uses
+     *  sparse strips instead: each strip of pixels is covered from the path's lines alone, so a
+     *  fill can be split into horizontal bands that don't depend on each other.  Its pixels may
+     *  differ slightly from the default's.
+     *
+     *  Returns the previous setting.  Not thread safe: set it before drawing.
+     */
+    static bool SetUseSparseStripRasterizer(bool);
+    static bool GetUseSparseStripRasterizer();
+
+    /**
+     *  If set, raster drawing splits large antialiased path fills drawn with sparse strips (see
+     *  SetUseSparseStripRasterizer()) into horizontal bands and rasterizes them concurrently on
+     *  this executor.  The result is always the same as drawing without an executor.  Fills drawn
+     *  with the default rasterizer can't be split up, and are drawn on the calling thread.
+     *
+     *  The executor must outlive any drawing that uses it.  Returns the previous executor.  Not
+     *  thread safe: set it before drawing.
+     */
+    static SkExecutor* SetPathRasterExecutor(SkExecutor*);
+    static SkExecutor* GetPathRasterExecutor();
+
     /**
      *  Dumps memory usage of caches using the SkTraceMemoryDump interface. See SkTraceMemoryDump
      *  for usage of this method.
@@ -14,6 +14,7 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkScalar.h"
+#include "include/core/SkSize.h"
 #include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTypes.h"
 
@@ -30,6 +31,7 @@ class SkBitmap;
 class SkCanvas;
 class SkCapabilities;
 class SkColorSpace;
+class SkExecutor;
 class SkPaint;
 class SkSurface;
 struct SkIRect;
@@ -145,6 +147,29 @@ SK_API sk_sp<SkSurface> WrapPixels(const SkImageInfo& imageInfo,
                                    PixelsReleaseProc,
                                    void* context,
                                    const SkSurfaceProps* surfaceProps = nullptr);
+
+/** Allocates raster SkSurface whose drawing is spread across the threads of an SkExecutor.
+    SkCanvas returned by SkSurface records draws instead of rasterizing them immediately. When
+    the pixels are next needed (makeImageSnapshot(), readPixels(), peekPixels(), draw(), or
+    writePixels()) the recorded draws are split into tiles of tileSize, and each tile is
+    rasterized on executor into its own part of the allocated pixels. The result is the same as
+    drawing on a surface from Raster().
+
+    Because drawing is deferred, the SkCanvas cannot itself read or peek at the pixels; use the
+    SkSurface methods instead. executor must outlive the returned SkSurface.
+
+    @param imageInfo     width, height, SkColorType, SkAlphaType, SkColorSpace,
+                         of raster surface; width and height must be greater than zero
+    @param executor      runs the per-tile rasterization work
+    @param tileSize      width and height of each tile; must not be empty
+    @param surfaceProps  LCD striping orientation and setting for device independent fonts;
+                         may be nullptr
+    @return              SkSurface if parameters are valid and memory was allocated, else nullptr.
+*/
+SK_API sk_sp<SkSurface> RasterThreaded(const SkImageInfo& imageInfo,
+                                       SkExecutor& executor,
+                                       SkISize tileSize = {256, 256},
+                                       const SkSurfaceProps* surfaceProps = nullptr);
 }  // namespace SkSurfaces
 
 /** \class SkSurface
@@ -268,6 +268,38 @@ public:
     bool allowColorFilter()   const { return (fFlags & kAllowColorFilter_Flag);   }
     bool allowBlender()       const { return (fFlags & kAllowBlender_Flag);       }
 
+    /**
+     * A store for the programs that the CPU backend compiles runtime effects into, so that they
+     * can outlive the process. Keys and data are opaque blobs; the key is derived from the effect's
+     * SkSL source, kind and options. Data written by a different version of Skia is ignored and
+     * replaced, but the cache is otherwise trusted: it must return what was stored.
+     *
+     * load() and store() may be called from any thread, including several at once.
+     */
+    class SK_API RasterProgramCache {
+    public:
+        virtual ~RasterProgramCache() = default;
+
+        /** Returns the data for the key if it exists in the cache, otherwise returns null. */
+        virtual sk_sp<SkData> load(const SkData& key) = 0;
+
+        /** Stores data in the cache, indexed by key. */
+        virtual void store(const SkData& key, const SkData& data) = 0;
+
+    protected:
+        RasterProgramCache() = default;
+        RasterProgramCache(const RasterProgramCache&) = delete;
+        RasterProgramCache& operator=(const RasterProgramCache&) = delete;
+    };
+
+    /**
+     * Sets the process-wide cache consulted the first time each effect is drawn on the CPU
+     * backend, returning the previous one. A cache hit skips inlining and raster pipeline code
+     * generation for the effect. The cache is not owned by Skia and must stay alive until it has
+     * been replaced and any draws in flight have finished. Pass nullptr to stop caching.
+     */
+    static RasterProgramCache* SetRasterProgramCache(RasterProgramCache*);
+
     static void RegisterFlattenables();
     ~SkRuntimeEffect() override;
 
@@ -18,6 +18,7 @@
 class SkColorSpace;
 class SkData;
 class SkEncoder;
+class SkExecutor;
 class SkPixmap;
 class SkWStream;
 class SkImage;
@@ -90,6 +91,18 @@ struct Options {
     const char* fICCProfileDescription = nullptr;
 
     std::optional<SkEncodedOrigin> fOrigin;
+
+    /**
+     *  If non-null, Encode() splits large images into bands of whole MCU rows, encodes the bands
+     *  in parallel on this executor, and joins them into a single baseline jpeg with a restart
+     *  marker at the end of every MCU row.  The bands use libjpeg's standard Huffman tables
+     *  rather than tables optimized for the image, so the result decodes to exactly the same
+     *  pixels as a serial encode but is larger: a few percent at typical qualities, and more as
+     *  fQuality approaches 100.
+     *
+     *  Make() ignores this, since it encodes incrementally, a row at a time.
+     */
+    SkExecutor* fExecutor = nullptr;
 };
 
 /**
@@ -19,6 +19,7 @@
 
 class GrDirectContext;
 class SkData;
+class SkExecutor;
 class SkImage;
 class SkPixmap;
 class SkWStream;
@@ -94,6 +95,16 @@ struct Options {
      */
     const SkPixmap* fGainmap = nullptr;
     const SkGainmapInfo* fGainmapInfo = nullptr;
+
+    /**
+     *  If non-null, Encode() splits large images into horizontal strips, and filters and
+     *  compresses the strips in parallel on this executor.  The strips are joined into a single
+     *  zlib stream that any png decoder can read.  The result is usually slightly larger than
+     *  encoding serially, and is not byte for byte the same.
+     *
+     *  Make() ignores this, since it encodes incrementally, a row at a time.
+     */
+    SkExecutor* fExecutor = nullptr;
 };
 
 /**
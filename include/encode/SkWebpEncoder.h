@@ -16,6 +16,7 @@
 class SkPixmap;
 class SkWStream;
 class SkData;
+class SkExecutor;
 class GrDirectContext;
 class SkImage;
 struct skcms_ICCProfile;
@@ -52,6 +53,24 @@ struct SK_API Options {
      */
     const skcms_ICCProfile* fICCProfile = nullptr;
     const char* fICCProfileDescription = nullptr;
+
+    /**
+     *  If true, libwebp may use an extra thread of its own while encoding each image (see
+     *  WebPConfig::thread_level).  The output is the same either way.
+     */
+    bool fMultiThreaded = false;
+
+    /**
+     *  If non-null, EncodeAnimated() encodes the frames in parallel on this executor, rather
+     *  than one after another.  Each frame is encoded on its own, as the rectangle of pixels that
+     *  changed since the previous frame, and the frames are then put together in order.  Frames
+     *  that don't change are merged into the frame before them.  The result is usually somewhat
+     *  larger than encoding serially, which can also look for smaller rectangles and blend
+     *  frames together.
+     *
+     *  Encode() ignores this.
+     */
+    SkExecutor* fExecutor = nullptr;
 };
 
 /**
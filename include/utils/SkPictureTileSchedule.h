@@ -0,0 +1,78 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPictureTileSchedule_DEFINED
+#define SkPictureTileSchedule_DEFINED
+
+#include "include/core/SkMatrix.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSize.h"
+#include "include/core/SkTypes.h"
+
+#include <functional>
+#include <memory>
+
+class SkCanvas;
+class SkExecutor;
+class SkPicture;
+
+/**
+ *  Splits the drawing of a picture into a grid of tiles.
+ *
+ *  Making the schedule bins the picture's ops into the tiles in one pass, so each tile can then
+ *  be drawn by replaying only the ops that touch it, without a bounding box query per tile.
+ *  A schedule is immutable and may be shared by any number of threads, and reused as often as
+ *  the same picture needs drawing with the same matrix and tiles.
+ */
+class SK_API SkPictureTileSchedule {
+public:
+    /**
+     *  Lays a grid of tileSize tiles over grid, in device space once the picture is transformed
+     *  by matrix.  Returns nullptr if tileSize is empty.
+     */
+    static std::unique_ptr<SkPictureTileSchedule> Make(sk_sp<const SkPicture> picture,
+                                                       const SkMatrix& matrix,
+                                                       const SkIRect& grid,
+                                                       SkISize tileSize);
+
+    ~SkPictureTileSchedule();
+
+    /** Tiles are numbered row by row from the top-left of the grid. */
+    int tileCount() const;
+
+    /** The device space bounds of the tile, clipped to the grid. */
+    SkIRect tileBounds(int tile) const;
+
+    /** How many of the picture's ops are replayed to draw this tile. */
+    int opCount(int tile) const;
+
+    /**
+     *  Draws just the part of the picture inside the tile, translated so that the tile's
+     *  top-left corner is at the canvas's origin.  Leaves the canvas's state unchanged.
+     */
+    void playbackTile(int tile, SkCanvas*) const;
+
+    /**
+     *  Calls playbackTile() for every tile, spread over the executor's threads, and returns
+     *  when they are all done.  canvasForTile() is called on those threads, at most once per
+     *  tile, and may return nullptr to skip a tile.  Each tile's canvas must only be used by
+     *  that tile.
+     */
+    void playback(SkExecutor&, const std::function<SkCanvas*(int tile)>& canvasForTile) const;
+
+private:
+    struct Bins;
+
+    SkPictureTileSchedule(sk_sp<const SkPicture>, const SkMatrix&, std::unique_ptr<Bins>);
+
+    sk_sp<const SkPicture> fPicture;
+    SkMatrix               fMatrix;
+    std::unique_ptr<Bins>  fBins;
+};
+
+#endif
@@ -22,6 +22,7 @@
 
 class SkAnimCodecPlayer;
 class SkCodec;
+class SkExecutor;
 class SkImage;
 
 namespace skresources {
@@ -102,8 +103,11 @@ public:
     // Clients must call SkCodec::Register() to load the required decoding image codecs before
     // calling Make. For example:
     //     SkCodec::Register(SkPngDecoder::Decoder());
+    // If an executor is given, upcoming frames that don't depend on earlier frames are decoded
+    // on it ahead of playback.  It must outlive the asset.
     static sk_sp<MultiFrameImageAsset> Make(sk_sp<SkData>,
-                                            ImageDecodeStrategy = ImageDecodeStrategy::kLazyDecode);
+                                            ImageDecodeStrategy = ImageDecodeStrategy::kLazyDecode,
+                                            SkExecutor* = nullptr);
     // If the client has already decoded the data, they can use this constructor.
     static sk_sp<MultiFrameImageAsset> Make(std::unique_ptr<SkCodec>,
                                             ImageDecodeStrategy = ImageDecodeStrategy::kLazyDecode);
@@ -13,6 +13,7 @@
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -21,7 +22,9 @@
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkMutex.h"
 #include "src/codec/SkCodecImageGenerator.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <algorithm>
 #include <cstddef>
@@ -29,7 +32,78 @@
 #include <utility>
 #include <vector>
 
-SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(std::move(codec)) {
+// Decodes frame index with codec, on top of prior, which is the frame it requires (already
+// oriented), or nullptr if it doesn't require one.  Returns the frame oriented for display.
+static sk_sp<SkImage> decode_frame(SkCodec* codec, const SkCodec::FrameInfo& frameInfo, int index,
+                                   const SkImage* prior) {
+    const auto origin = codec->getOrigin();
+    SkImageInfo imageInfo = codec->getInfo();
+    const auto orientedDims = SkEncodedOriginSwapsWidthHeight(origin)
+                                      ? SkISize{imageInfo.height(), imageInfo.width()}
+                                      : imageInfo.dimensions();
+    const auto originMatrix = SkEncodedOriginToMatrix(origin, orientedDims.width(),
+                                                              orientedDims.height());
+
+    size_t rb = imageInfo.minRowBytes();
+    size_t size = imageInfo.computeByteSize(rb);
+    auto data = SkData::MakeUninitialized(size);
+
+    SkCodec::Options opts;
+    opts.fFrameIndex = index;
+
+    SkPaint paint;
+    paint.setBlendMode(SkBlendMode::kSrc);
+
+    if (frameInfo.fAlphaType != kOpaque_SkAlphaType && imageInfo.isOpaque()) {
+        imageInfo = imageInfo.makeAlphaType(kPremul_SkAlphaType);
+    }
+    if (prior) {
+        SkASSERT(frameInfo.fRequiredFrame != SkCodec::kNoFrame);
+        auto canvas = SkCanvas::MakeRasterDirect(imageInfo, data->writable_data(), rb);
+        if (origin != kDefault_SkEncodedOrigin) {
+            // The required frame is stored after applying the origin. Undo that,
+            // because the codec decodes prior to applying the origin.
+            // FIXME: Another approach would be to decode the frame's delta on top
+            // of transparent black, and then draw that through the origin matrix
+            // onto the required frame. To do that, SkCodec needs to expose the
+            // rectangle of the delta and the blend mode, so we can handle
+            // kRestoreBGColor frames and Blend::kSrc.
+            SkMatrix inverse;
+            SkAssertResult(originMatrix.invert(&inverse));
+            canvas->concat(inverse);
+        }
+        canvas->drawImage(prior, 0, 0, SkSamplingOptions(), &paint);
+        opts.fPriorFrame = frameInfo.fRequiredFrame;
+    }
+
+    if (SkCodec::kSuccess != codec->getPixels(imageInfo, data->writable_data(), rb, &opts)) {
+        return nullptr;
+    }
+
+    auto image = SkImages::RasterFromData(imageInfo, std::move(data), rb);
+    if (origin != kDefault_SkEncodedOrigin) {
+        imageInfo = imageInfo.makeDimensions(orientedDims);
+        rb = imageInfo.minRowBytes();
+        size = imageInfo.computeByteSize(rb);
+        data = SkData::MakeUninitialized(size);
+        auto canvas = SkCanvas::MakeRasterDirect(imageInfo, data->writable_data(), rb);
+        canvas->concat(originMatrix);
+        canvas->drawImage(image, 0, 0, SkSamplingOptions(), &paint);
+        image = SkImages::RasterFromData(imageInfo, std::move(data), rb);
+    }
+    return image;
+}
+
+static size_t frame_bytes(const SkImage* image) {
+    return image->imageInfo().computeMinByteSize();
+}
+
+SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec)
+        : SkAnimCodecPlayer(std::move(codec), nullptr, Options()) {}
+
+SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec, sk_sp<SkData> encodedData,
+                                     const Options& options)
+        : fCodec(std::move(codec)), fOptions(options) {
     fImageInfo = fCodec->getInfo();
     fFrameInfos = fCodec->getFrameInfo();
     fImages.resize(fFrameInfos.size());
@@ -48,10 +122,22 @@ SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(st
         fImages.clear();
         fImages.push_back(SkImages::DeferredFromGenerator(
                 SkCodecImageGenerator::MakeFromCodec(std::move(fCodec))));
+        return;
+    }
+
+    if (fOptions.fExecutor && fOptions.fPreDecodeFrames > 0 && encodedData) {
+        fEncodedData = std::move(encodedData);
+        fPreDecodeTasks = std::make_unique<SkTaskGroup>(*fOptions.fExecutor);
+        fPreDecoding.resize(fFrameInfos.size());
     }
 }
 
-SkAnimCodecPlayer::~SkAnimCodecPlayer() {}
+SkAnimCodecPlayer::~SkAnimCodecPlayer() {
+    // The tasks use the rest of our fields.
+    if (fPreDecodeTasks) {
+        fPreDecodeTasks->wait();
+    }
+}
 
 SkISize SkAnimCodecPlayer::dimensions() const {
     if (!fCodec) {
@@ -64,76 +150,155 @@ SkISize SkAnimCodecPlayer::dimensions() const {
     return { fImageInfo.width(), fImageInfo.height() };
 }
 
-sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
-    SkASSERT((unsigned)index < fFrameInfos.size());
+void SkAnimCodecPlayer::cacheFrame(int index, sk_sp<SkImage> image) {
+    SkASSERT(image && !fImages[index]);
+    fCachedBytes += frame_bytes(image.get());
+    fImages[index] = std::move(image);
 
-    if (fImages[index]) {
-        return fImages[index];
+    // Over budget, drop frames that depend on others first: the frames they need are kept, so
+    // they're a single decode away.  Otherwise drop the frames that looping playback would get
+    // to last.  Never drop the frame we just added, or the current frame, which the next one
+    // most likely needs.
+    const int frameCount = (int)fImages.size();
+    auto dependent = [this](int i) {
+        return fFrameInfos[i].fRequiredFrame != SkCodec::kNoFrame;
+    };
+    auto ahead = [this, frameCount](int i) {
+        return (i - fCurrIndex + frameCount) % frameCount;
+    };
+    while (fCachedBytes > fOptions.fFrameCacheBudget) {
+        int victim = -1;
+        for (int i = 0; i < frameCount; i++) {
+            if (i == index || i == fCurrIndex || !fImages[i]) {
+                continue;
+            }
+            if (victim < 0 ||
+                (dependent(i) != dependent(victim) ? dependent(i) : ahead(i) > ahead(victim))) {
+                victim = i;
+            }
+        }
+        if (victim < 0) {
+            break;
+        }
+        fCachedBytes -= frame_bytes(fImages[victim].get());
+        fImages[victim].reset();
     }
+}
 
-    size_t rb = fImageInfo.minRowBytes();
-    size_t size = fImageInfo.computeByteSize(rb);
-    auto data = SkData::MakeUninitialized(size);
+void SkAnimCodecPlayer::takePreDecodedFrames() {
+    if (!fPreDecodeTasks) {
+        return;
+    }
+    std::vector<std::pair<int, sk_sp<SkImage>>> preDecoded;
+    {
+        SkAutoMutexExclusive lock(fPreDecodeMutex);
+        preDecoded.swap(fPreDecoded);
+    }
+    for (auto& [index, image] : preDecoded) {
+        fPreDecoding[index] = false;
+        if (image && !fImages[index]) {
+            this->cacheFrame(index, std::move(image));
+        }
+    }
+}
 
-    SkCodec::Options opts;
-    opts.fFrameIndex = index;
+void SkAnimCodecPlayer::preDecodeFrom(int index) {
+    if (!fPreDecodeTasks) {
+        return;
+    }
+    this->takePreDecodedFrames();
 
-    const auto origin = fCodec->getOrigin();
-    const auto orientedDims = this->dimensions();
-    const auto originMatrix = SkEncodedOriginToMatrix(origin, orientedDims.width(),
-                                                              orientedDims.height());
+    // Only look as many frames ahead as we can keep along with the current frame, or pre-decoded
+    // frames would push each other out of the cache.
+    const size_t frameBytes = SkImageInfo::Make(this->dimensions(), fImageInfo.colorType(),
+                                                fImageInfo.alphaType()).computeMinByteSize();
+    size_t aheadBytes = frameBytes;
 
-    SkPaint paint;
-    paint.setBlendMode(SkBlendMode::kSrc);
+    const int frameCount = (int)fFrameInfos.size();
+    int ahead = 0;
+    for (int i = 1; i < frameCount && ahead < fOptions.fPreDecodeFrames; i++) {
+        // Playback loops, so the frames after the last are the first ones again.
+        const int next = (index + i) % frameCount;
+        if (fFrameInfos[next].fRequiredFrame != SkCodec::kNoFrame) {
+            // This needs the frame before it, so it can't be decoded on its own.
+            continue;
+        }
+        if (aheadBytes + frameBytes > fOptions.fFrameCacheBudget) {
+            break;
+        }
+        aheadBytes += frameBytes;
+        ahead++;
+        if (fImages[next] || fPreDecoding[next]) {
+            continue;
+        }
+        fPreDecoding[next] = true;
+        fPreDecodeTasks->add([this, next] {
+            std::unique_ptr<SkCodec> codec;
+            {
+                SkAutoMutexExclusive lock(fPreDecodeMutex);
+                if (!fSpareCodecs.empty()) {
+                    codec = std::move(fSpareCodecs.back());
+                    fSpareCodecs.pop_back();
+                }
+            }
+            if (!codec) {
+                codec = SkCodec::MakeFromData(fEncodedData);
+            }
+            sk_sp<SkImage> image =
+                    codec ? decode_frame(codec.get(), fFrameInfos[next], next, nullptr) : nullptr;
 
-    auto imageInfo = fImageInfo;
-    if (fFrameInfos[index].fAlphaType != kOpaque_SkAlphaType && imageInfo.isOpaque()) {
-        imageInfo = imageInfo.makeAlphaType(kPremul_SkAlphaType);
+            SkAutoMutexExclusive lock(fPreDecodeMutex);
+            fPreDecoded.emplace_back(next, std::move(image));
+            if (codec) {
+                fSpareCodecs.push_back(std::move(codec));
+            }
+        });
     }
-    const int requiredFrame = fFrameInfos[index].fRequiredFrame;
-    if (requiredFrame != SkCodec::kNoFrame && fImages[requiredFrame]) {
-        auto requiredImage = fImages[requiredFrame];
-        auto canvas = SkCanvas::MakeRasterDirect(imageInfo, data->writable_data(), rb);
-        if (origin != kDefault_SkEncodedOrigin) {
-            // The required frame is stored after applying the origin. Undo that,
-            // because the codec decodes prior to applying the origin.
-            // FIXME: Another approach would be to decode the frame's delta on top
-            // of transparent black, and then draw that through the origin matrix
-            // onto the required frame. To do that, SkCodec needs to expose the
-            // rectangle of the delta and the blend mode, so we can handle
-            // kRestoreBGColor frames and Blend::kSrc.
-            SkMatrix inverse;
-            SkAssertResult(originMatrix.invert(&inverse));
-            canvas->concat(inverse);
-        }
-        canvas->drawImage(requiredImage, 0, 0, SkSamplingOptions(), &paint);
-        opts.fPriorFrame = requiredFrame;
+}
+
+sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
+    SkASSERT((unsigned)index < fFrameInfos.size());
+
+    this->takePreDecodedFrames();
+    if (!fImages[index] && fPreDecodeTasks && fPreDecoding[index]) {
+        // It's on its way, which is sooner than decoding it again.
+        fPreDecodeTasks->wait();
+        this->takePreDecodedFrames();
     }
 
-    if (SkCodec::kSuccess != fCodec->getPixels(imageInfo, data->writable_data(), rb, &opts)) {
-        return nullptr;
+    if (fImages[index]) {
+        return fImages[index];
     }
 
-    auto image = SkImages::RasterFromData(imageInfo, std::move(data), rb);
-    if (origin != kDefault_SkEncodedOrigin) {
-        imageInfo = imageInfo.makeDimensions(orientedDims);
-        rb = imageInfo.minRowBytes();
-        size = imageInfo.computeByteSize(rb);
-        data = SkData::MakeUninitialized(size);
-        auto canvas = SkCanvas::MakeRasterDirect(imageInfo, data->writable_data(), rb);
-        canvas->concat(originMatrix);
-        canvas->drawImage(image, 0, 0, SkSamplingOptions(), &paint);
-        image = SkImages::RasterFromData(imageInfo, std::move(data), rb);
+    // Decode forward from the closest frame we have (or can decode on its own), keeping the
+    // frames along the way so that playing on from here doesn't decode them again.
+    std::vector<int> chain = {index};
+    for (int i = fFrameInfos[index].fRequiredFrame;
+         i != SkCodec::kNoFrame && !fImages[i];
+         i = fFrameInfos[i].fRequiredFrame) {
+        chain.push_back(i);
+    }
+    const int requiredFrame = fFrameInfos[chain.back()].fRequiredFrame;
+    sk_sp<SkImage> image = requiredFrame != SkCodec::kNoFrame ? fImages[requiredFrame] : nullptr;
+    for (auto i = chain.rbegin(); i != chain.rend(); ++i) {
+        image = decode_frame(fCodec.get(), fFrameInfos[*i], *i, image.get());
+        if (!image) {
+            return nullptr;
+        }
+        this->cacheFrame(*i, image);
     }
-    return fImages[index] = image;
+    return image;
 }
 
 sk_sp<SkImage> SkAnimCodecPlayer::getFrame() {
     SkASSERT(fTotalDuration > 0 || fImages.size() == 1);
 
-    return fTotalDuration > 0
-        ? this->getFrameAt(fCurrIndex)
-        : fImages.front();
+    if (!fTotalDuration) {
+        return fImages.front();
+    }
+    auto frame = this->getFrameAt(fCurrIndex);
+    this->preDecodeFrom(fCurrIndex);
+    return frame;
 }
 
 bool SkAnimCodecPlayer::seek(uint32_t msec) {
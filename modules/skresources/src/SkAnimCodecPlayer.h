@@ -12,16 +12,47 @@
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
+#include "include/private/base/SkMutex.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <utility>
 #include <vector>
 
+class SkData;
+class SkExecutor;
 class SkImage;
+class SkTaskGroup;
 
 class SkAnimCodecPlayer {
 public:
+    struct Options {
+        /**
+         *  Decoded frames are kept for reuse until they add up to more than this many bytes.
+         *  Then frames that depend on other frames are dropped before frames that don't, so
+         *  seeking only has to decode from the nearest kept frame, and otherwise the frames that
+         *  playback would get to last are dropped first.
+         */
+        size_t      fFrameCacheBudget = SIZE_MAX;
+
+        /**
+         *  If set, along with the encoded data, the next fPreDecodeFrames frames that don't
+         *  depend on other frames are decoded on this executor ahead of playback, each with
+         *  its own codec.  It must outlive the player.
+         */
+        SkExecutor* fExecutor = nullptr;
+        int         fPreDecodeFrames = 4;
+    };
+
     SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec);
+
+    /**
+     *  encodedData is what the codec decodes, and is only needed to pre-decode frames on
+     *  options.fExecutor.
+     */
+    SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec, sk_sp<SkData> encodedData,
+                      const Options& options);
     ~SkAnimCodecPlayer();
 
     /**
@@ -51,6 +82,10 @@ public:
      */
     bool seek(uint32_t msec);
 
+    /**
+     *  Returns the number of bytes of decoded frames being kept for reuse.
+     */
+    size_t cachedBytes() const { return fCachedBytes; }
 
 private:
     std::unique_ptr<SkCodec>        fCodec;
@@ -60,7 +95,23 @@ private:
     int                             fCurrIndex = 0;
     uint32_t                        fTotalDuration;
 
+    const Options                   fOptions;
+    size_t                          fCachedBytes = 0;
+
+    // Pre-decoding.  Tasks put the frames they decode (or nullptr, if they fail) in
+    // fPreDecoded, and take codecs from fSpareCodecs or make them from fEncodedData, so that
+    // they can decode at the same time.
+    sk_sp<SkData>                                    fEncodedData;
+    std::unique_ptr<SkTaskGroup>                     fPreDecodeTasks;
+    std::vector<bool>                                fPreDecoding;
+    SkMutex                                          fPreDecodeMutex;
+    std::vector<std::pair<int, sk_sp<SkImage>>>      fPreDecoded SK_GUARDED_BY(fPreDecodeMutex);
+    std::vector<std::unique_ptr<SkCodec>>            fSpareCodecs SK_GUARDED_BY(fPreDecodeMutex);
+
     sk_sp<SkImage> getFrameAt(int index);
+    void cacheFrame(int index, sk_sp<SkImage>);
+    void takePreDecodedFrames();
+    void preDecodeFrom(int index);
 };
 
 #endif
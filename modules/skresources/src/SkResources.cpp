@@ -107,10 +107,14 @@ ImageAsset::FrameData ImageAsset::getFrameData(float t) {
     };
 }
 
-sk_sp<MultiFrameImageAsset> MultiFrameImageAsset::Make(sk_sp<SkData> data, ImageDecodeStrategy strat) {
-    if (auto codec = SkCodec::MakeFromData(std::move(data))) {
+sk_sp<MultiFrameImageAsset> MultiFrameImageAsset::Make(sk_sp<SkData> data, ImageDecodeStrategy strat,
+                                                       SkExecutor* executor) {
+    if (auto codec = SkCodec::MakeFromData(data)) {
+        SkAnimCodecPlayer::Options options;
+        options.fExecutor = executor;
         return sk_sp<MultiFrameImageAsset>(new MultiFrameImageAsset(
-                std::make_unique<SkAnimCodecPlayer>(std::move(codec)), strat));
+                std::make_unique<SkAnimCodecPlayer>(std::move(codec), std::move(data), options),
+                strat));
     }
 
     return nullptr;
@@ -24,9 +24,13 @@
 #include "src/codec/SkCodecPriv.h"
 #include "src/codec/SkFrameHolder.h"
 #include "src/codec/SkPixmapUtilsPriv.h"
+#include "src/codec/SkResampler.h"
 #include "src/codec/SkSampler.h"
 #include "src/core/SkColorPriv.h"
+#include "src/core/SkConvertPixels.h"
+#include "src/core/SkImageInfoPriv.h"
 
+#include <algorithm>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -318,6 +322,8 @@ bool SkCodec::rewindIfNeeded() {
     const bool needsRewind = fNeedsRewind;
     fNeedsRewind = true;
     if (!needsRewind) {
+        // This is the first decode, so the input is about to be read in earnest.
+        SkCodecPriv::AdviseWillRead(fStream.get());
         return true;
     }
 
@@ -495,6 +501,10 @@ SkCodec::Result SkCodec::getPixels(const SkImageInfo& info, void* pixels, size_t
         }
     }
 
+    if (options->fResampling && !this->dimensionsSupported(info.dimensions())) {
+        return this->resampledDecode(info, pixels, rowBytes, *options);
+    }
+
     const Result frameIndexResult = this->handleFrameIndex(info, pixels, rowBytes,
                                                            *options);
     if (frameIndexResult != kSuccess) {
@@ -534,6 +544,91 @@ SkCodec::Result SkCodec::getPixels(const SkImageInfo& info, void* pixels, size_t
     return result;
 }
 
+SkCodec::Result SkCodec::resampledDecode(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                                         const Options& options) {
+    SkASSERT(options.fResampling);
+    if (options.fSubset) {
+        return kUnimplemented;
+    }
+
+    // Let the codec do as much of any downscale as it can natively.
+    const float scale = std::max((float)info.width()  / this->dimensions().width(),
+                                 (float)info.height() / this->dimensions().height());
+    SkISize srcSize = this->getScaledDimensions(scale);
+    if (srcSize.width() < info.width() || srcSize.height() < info.height()) {
+        srcSize = this->dimensions();
+    }
+
+    // Rows headed for 8-bit destinations can be decoded and filtered as 8-bit.  Deeper ones are
+    // decoded as half floats, so they're not clamped or quantized along the way.
+    const bool normalized = SkColorTypeIsNormalized(info.colorType()) &&
+                            SkColorTypeMaxBitsPerChannel(info.colorType()) <= 8;
+    const SkImageInfo srcInfo = info.makeDimensions(srcSize).makeColorType(
+            normalized ? kRGBA_8888_SkColorType : kRGBA_F16_SkColorType);
+    const SkImageInfo srcRowInfo = srcInfo.makeWH(srcSize.width(), 1);
+    const SkImageInfo srcFloatRowInfo = srcRowInfo.makeColorType(kRGBA_F32_SkColorType);
+    const SkImageInfo dstRowInfo = info.makeWH(info.width(), 1);
+    const SkImageInfo dstFloatRowInfo = dstRowInfo.makeColorType(kRGBA_F32_SkColorType);
+
+    auto resampler = SkResampler::Make(srcSize, info.dimensions(), *options.fResampling,
+                                       info.alphaType() == kPremul_SkAlphaType, normalized);
+    if (!resampler) {
+        return kInvalidScale;
+    }
+    skia_private::AutoTMalloc<float> srcFloatRow(4 * (size_t)srcSize.width());
+    skia_private::AutoTMalloc<float> dstFloatRow(4 * (size_t)info.width());
+    auto addRow = [&](const void* row) {
+        SkAssertResult(SkConvertPixels(srcFloatRowInfo, srcFloatRow.get(),
+                                       srcFloatRowInfo.minRowBytes(),
+                                       srcRowInfo, row, srcRowInfo.minRowBytes()));
+        resampler->addRow(srcFloatRow.get());
+        while (resampler->readRow(dstFloatRow.get())) {
+            void* dst = SkTAddOffset<void>(pixels, (resampler->rowsRead() - 1) * rowBytes);
+            SkAssertResult(SkConvertPixels(dstRowInfo, dst, rowBytes,
+                                           dstFloatRowInfo, dstFloatRow.get(),
+                                           dstFloatRowInfo.minRowBytes()));
+        }
+    };
+
+    Options srcOptions = options;
+    srcOptions.fResampling = nullptr;
+
+    // Stream the rows through the resampler if we can decode them from the top down.
+    if (0 == options.fFrameIndex &&
+        kSuccess == this->startScanlineDecode(srcInfo, &srcOptions) &&
+        kTopDown_SkScanlineOrder == this->getScanlineOrder()) {
+        skia_private::AutoTMalloc<uint8_t> row(srcRowInfo.minRowBytes());
+        Result result = kSuccess;
+        for (int y = 0; y < srcSize.height(); y++) {
+            // getScanlines() fills in any row it can't decode, so we carry on to the end.
+            if (1 != this->getScanlines(row.get(), 1, srcRowInfo.minRowBytes())) {
+                result = kIncompleteInput;
+            }
+            addRow(row.get());
+        }
+        SkASSERT(resampler->rowsRead() == info.height());
+        return result;
+    }
+
+    // Otherwise decode it all first.
+    skia_private::AutoTMalloc<uint8_t> decoded(srcInfo.computeMinByteSize());
+    const Result result = this->getPixels(srcInfo, decoded.get(), srcInfo.minRowBytes(),
+                                          &srcOptions);
+    switch (result) {
+        case kSuccess:
+        case kIncompleteInput:
+        case kErrorInInput:
+            break;
+        default:
+            return result;
+    }
+    for (int y = 0; y < srcSize.height(); y++) {
+        addRow(decoded.get() + y * srcInfo.minRowBytes());
+    }
+    SkASSERT(resampler->rowsRead() == info.height());
+    return result;
+}
+
 std::tuple<sk_sp<SkImage>, SkCodec::Result> SkCodec::getImage(const SkImageInfo& info,
                                                               const Options* options) {
     SkBitmap bm;
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/codec/SkCodecBatch.h"
+
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkStream.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkMutex.h"
+#include "src/codec/SkCodecScratch.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace {
+
+// A run should take long enough to decode that scheduling it is a small part of its time.  A few
+// hundred runs are plenty to keep any executor busy while the last ones finish.
+constexpr size_t kMinRunBytes = 64 * 1024;
+constexpr size_t kMaxRuns = 256;
+
+SkCodec::Result decode(const sk_sp<SkData>& data, const SkPixmap& dst,
+                       const SkCodec::Options& options) {
+    if (!data) {
+        return SkCodec::kInvalidInput;
+    }
+    SkCodec::Result result;
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromStream(SkMemoryStream::Make(data), &result);
+    if (!codec) {
+        return result;
+    }
+    return codec->getPixels(dst, &options);
+}
+
+// Scratches for the runs decoding at the same time, so each run reuses the row buffers and
+// decoder state of the runs decoded before it on its thread.
+class ScratchPool {
+public:
+    std::unique_ptr<SkCodecScratch> take() {
+        SkAutoMutexExclusive lock(fMutex);
+        if (fScratches.empty()) {
+            return std::make_unique<SkCodecScratch>();
+        }
+        std::unique_ptr<SkCodecScratch> scratch = std::move(fScratches.back());
+        fScratches.pop_back();
+        return scratch;
+    }
+
+    void give(std::unique_ptr<SkCodecScratch> scratch) {
+        SkAutoMutexExclusive lock(fMutex);
+        fScratches.push_back(std::move(scratch));
+    }
+
+private:
+    SkMutex fMutex;
+    std::vector<std::unique_ptr<SkCodecScratch>> fScratches;
+};
+
+}  // namespace
+
+std::vector<SkCodec::Result> SkCodecBatch::Decode(SkSpan<const sk_sp<SkData>> encoded,
+                                                  SkSpan<const SkPixmap> dst,
+                                                  const Options& options) {
+    SkASSERT(encoded.size() == dst.size());
+    const size_t count = std::min(encoded.size(), dst.size());
+    std::vector<SkCodec::Result> results(count, SkCodec::kInvalidInput);
+
+    SkCodec::Options codecOptions;
+    codecOptions.fResampling = options.fResampling;
+
+    if (!options.fExecutor || count < 2) {
+        SkCodecScratch scratch;
+        SkCodecScratch::AutoAttach attach(&scratch);
+        for (size_t i = 0; i < count; i++) {
+            results[i] = decode(encoded[i], dst[i], codecOptions);
+        }
+        return results;
+    }
+
+    // Cut the images into runs with about the same amount of encoded data.  Run r is images
+    // [runStarts[r], runStarts[r+1]).
+    size_t totalBytes = 0;
+    for (size_t i = 0; i < count; i++) {
+        totalBytes += encoded[i] ? encoded[i]->size() : 0;
+    }
+    const size_t runs = std::clamp<size_t>(totalBytes / kMinRunBytes, 1, std::min(count, kMaxRuns));
+    std::vector<size_t> runStarts = {0};
+    size_t bytes = 0;
+    for (size_t i = 0; i + 1 < count && runStarts.size() < runs; i++) {
+        bytes += encoded[i] ? encoded[i]->size() : 0;
+        if (bytes * runs >= totalBytes * runStarts.size()) {
+            runStarts.push_back(i + 1);
+        }
+    }
+    runStarts.push_back(count);
+
+    ScratchPool scratches;
+    SkTaskGroup(*options.fExecutor).batch(runStarts.size() - 1, [&](int r) {
+        std::unique_ptr<SkCodecScratch> scratch = scratches.take();
+        {
+            SkCodecScratch::AutoAttach attach(scratch.get());
+            for (size_t i = runStarts[r]; i < runStarts[r + 1]; i++) {
+                results[i] = decode(encoded[i], dst[i], codecOptions);
+            }
+        }
+        scratches.give(std::move(scratch));
+    });
+    return results;
+}
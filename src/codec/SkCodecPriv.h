@@ -11,10 +11,12 @@
 #include "include/codec/SkCodec.h"
 #include "include/codec/SkEncodedOrigin.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkStream.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkEncodedInfo.h"
 #include "src/codec/SkColorPalette.h"
 #include "src/core/SkColorData.h"
+#include "src/core/SkOSFile.h"
 
 #include <string_view>
 
@@ -30,6 +32,17 @@ bool HasDecoder(std::string_view id);
 
 class SkCodecPriv final {
 public:
+    // Codecs read streams that are backed by memory, like memory mapped files, in place. If the
+    // stream is big enough for it to matter, tell the OS we're about to read all of it, so it can
+    // page it in ahead of us rather than waiting for us to fault on each page.
+    static void AdviseWillRead(SkStream* stream) {
+        constexpr size_t kMinLength = 256 * 1024;
+        if (stream && stream->getMemoryBase() && stream->hasLength() &&
+            stream->getLength() >= kMinLength) {
+            sk_fmadvise(stream->getMemoryBase(), stream->getLength(), SkMmapAdvice::kWillNeed);
+        }
+    }
+
     static const SkEncodedInfo& GetEncodedInfo(const SkCodec* codec) {
         SkASSERT(codec);
         return codec->getEncodedInfo();
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/codec/SkCodecScratch.h"
+
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkMalloc.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkMathPriv.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+static thread_local SkCodecScratch* sScratch = nullptr;
+
+namespace {
+
+// Each block starts with its size class, padded to keep what follows aligned like malloc().
+constexpr int    kHeapClass  = -1;
+constexpr size_t kHeaderSize = alignof(std::max_align_t);
+
+int& block_class(void* block) {
+    return *static_cast<int*>(block);
+}
+
+}  // namespace
+
+SkCodecScratch::SkCodecScratch() = default;
+
+SkCodecScratch::~SkCodecScratch() {
+    SkASSERT(sScratch != this);
+    // Cached objects may give memory back to the scratch as they're destroyed.
+    for (auto& cached : fCached) {
+        cached.clear();
+    }
+    for (std::vector<void*>& blocks : fFree) {
+        for (void* block : blocks) {
+            sk_free(block);
+        }
+    }
+}
+
+SkCodecScratch* SkCodecScratch::Get() {
+    return sScratch;
+}
+
+SkCodecScratch::AutoAttach::AutoAttach(SkCodecScratch* scratch) : fPrev(sScratch) {
+    sScratch = scratch;
+}
+
+SkCodecScratch::AutoAttach::~AutoAttach() {
+    sScratch = fPrev;
+}
+
+void* SkCodecScratch::alloc(size_t size) {
+    void* block;
+    if (size > (size_t(1) << kMaxClass) - kHeaderSize) {
+        block = sk_malloc_canfail(size + kHeaderSize);
+        if (!block) {
+            return nullptr;
+        }
+        block_class(block) = kHeapClass;
+    } else {
+        const int sizeClass = std::max(kMinClass, SkNextLog2(SkToU32(size + kHeaderSize)));
+        std::vector<void*>& blocks = fFree[sizeClass];
+        if (!blocks.empty()) {
+            block = blocks.back();
+            blocks.pop_back();
+        } else {
+            block = sk_malloc_canfail(size_t(1) << sizeClass);
+            if (!block) {
+                return nullptr;
+            }
+            fBytesReserved += size_t(1) << sizeClass;
+        }
+        block_class(block) = sizeClass;
+    }
+    return static_cast<char*>(block) + kHeaderSize;
+}
+
+void SkCodecScratch::free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    void* block = static_cast<char*>(ptr) - kHeaderSize;
+    const int sizeClass = block_class(block);
+    if (sizeClass == kHeapClass) {
+        sk_free(block);
+        return;
+    }
+    SkASSERT(kMinClass <= sizeClass && sizeClass <= kMaxClass);
+    fFree[sizeClass].push_back(block);
+}
+
+std::unique_ptr<SkCodecScratch::Cached> SkCodecScratch::take(Kind kind) {
+    std::vector<std::unique_ptr<Cached>>& cached = fCached[(int)kind];
+    if (cached.empty()) {
+        return nullptr;
+    }
+    std::unique_ptr<Cached> object = std::move(cached.back());
+    cached.pop_back();
+    return object;
+}
+
+void SkCodecScratch::give(Kind kind, std::unique_ptr<Cached> object) {
+    fCached[(int)kind].push_back(std::move(object));
+}
+
+uint8_t* SkCodecScratchStorage::reset(size_t size) {
+    if (fScratch) {
+        fScratch->free(fPtr);
+    } else {
+        sk_free(fPtr);
+    }
+    fScratch = nullptr;
+    fPtr = nullptr;
+    if (size) {
+        fScratch = SkCodecScratch::Get();
+        fPtr = static_cast<uint8_t*>(fScratch ? fScratch->alloc(size) : sk_malloc_throw(size));
+        if (!fPtr) {
+            sk_out_of_memory();
+        }
+    }
+    return fPtr;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkCodecScratch_DEFINED
+#define SkCodecScratch_DEFINED
+
+#include "include/private/base/SkNoncopyable.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ *  Memory for decoding many images one after another on one thread, so that each decode reuses
+ *  what the ones before it allocated rather than going back to the heap.
+ *
+ *  While a scratch is attached to a thread, codecs made on that thread take their row buffers,
+ *  libpng's allocations (zlib's included), and libjpeg's decompress contexts from it, and give
+ *  them back when they're done.  Those codecs must not outlive the scratch.  SkCodecBatch keeps
+ *  one scratch per thread decoding a batch.
+ */
+class SkCodecScratch : SkNoncopyable {
+public:
+    SkCodecScratch();
+    ~SkCodecScratch();
+
+    // The scratch attached to this thread, if any.
+    static SkCodecScratch* Get();
+
+    class AutoAttach : SkNoncopyable {
+    public:
+        explicit AutoAttach(SkCodecScratch*);
+        ~AutoAttach();
+
+    private:
+        SkCodecScratch* fPrev;
+    };
+
+    // Returns at least size bytes, aligned like malloc(), or null if out of memory.  Freed blocks
+    // are kept, by power of two size, for the next alloc() of about the same size.
+    void* alloc(size_t size);
+    void free(void* ptr);
+
+    // How many bytes of blocks the scratch holds, in use or not.
+    size_t bytesReserved() const { return fBytesReserved; }
+
+    // Objects that are costly to set up, kept for the next codec to use.
+    class Cached {
+    public:
+        virtual ~Cached() = default;
+    };
+    enum class Kind {
+        kJpegDecompress,
+        kLast = kJpegDecompress,
+    };
+    // Null if none has been given back.
+    std::unique_ptr<Cached> take(Kind);
+    void give(Kind, std::unique_ptr<Cached>);
+
+private:
+    static constexpr int kMinClass = 6;   // 64 bytes
+    static constexpr int kMaxClass = 22;  // 4MB, above which blocks go back to the heap.
+
+    std::array<std::vector<void*>, kMaxClass + 1> fFree;
+    size_t fBytesReserved = 0;
+    std::array<std::vector<std::unique_ptr<Cached>>, (int)Kind::kLast + 1> fCached;
+};
+
+/**
+ *  A row buffer, like skia_private::AutoTMalloc<uint8_t>, that takes its memory from the scratch
+ *  attached to the thread when it is allocated, if there is one.
+ */
+class SkCodecScratchStorage : SkNoncopyable {
+public:
+    SkCodecScratchStorage() = default;
+    ~SkCodecScratchStorage() { this->reset(); }
+
+    // Frees the old buffer, and returns a new one of size bytes, or null if size is zero.
+    uint8_t* reset(size_t size = 0);
+
+    uint8_t* get() const { return fPtr; }
+
+private:
+    SkCodecScratch* fScratch = nullptr;  // Where fPtr came from, or null for the heap.
+    uint8_t*        fPtr = nullptr;
+};
+
+#endif  // SkCodecScratch_DEFINED
@@ -12,6 +12,7 @@
 #include "include/core/SkAlphaType.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
@@ -26,16 +27,22 @@
 #include "src/codec/SkJpegDecoderMgr.h"
 #include "src/codec/SkJpegMetadataDecoderImpl.h"
 #include "src/codec/SkJpegPriv.h"
+#include "src/codec/SkJpegRestartIndex.h"
+#include "src/codec/SkJpegSourceMgr.h"
 #include "src/codec/SkParseEncodedOrigin.h"
 #include "src/codec/SkSwizzler.h"
+#include "src/core/SkTaskGroup.h"
 
 #ifdef SK_CODEC_DECODES_JPEG_GAINMAPS
 #include "include/private/SkGainmapInfo.h"
 #endif  // SK_CODEC_DECODES_JPEG_GAINMAPS
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <csetjmp>
 #include <cstring>
+#include <memory>
 #include <utility>
 
 using namespace skia_private;
@@ -273,6 +280,9 @@ bool SkJpegCodec::onRewind() {
     }
     SkASSERT(nullptr != decoderMgr);
     fDecoderMgr.reset(decoderMgr);
+    fStripDecoderMgr = nullptr;
+    fStripStream = nullptr;
+    fStripFirstRow = 0;
 
     fSwizzler.reset(nullptr);
     fSwizzleSrcRow = nullptr;
@@ -397,45 +407,54 @@ bool SkJpegCodec::onDimensionsSupported(const SkISize& size) {
 
 SkCodec::Result SkJpegCodec::readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count,
                           const Options& opts, int* rowsDecoded) {
+    return this->readRows(this->scanlineDecoderMgr(), fSwizzleSrcRow, fColorXformSrcRow,
+                          dstInfo, dst, rowBytes, count, opts, rowsDecoded);
+}
+
+SkCodec::Result SkJpegCodec::readRows(JpegDecoderMgr* decoderMgr,
+                                      uint8_t* swizzleSrcRow,
+                                      uint32_t* colorXformSrcRow,
+                                      const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                                      int count, const Options& opts, int* rowsDecoded) const {
     // Set the jump location for libjpeg-turbo errors
-    skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr->errorMgr());
     if (setjmp(jmp)) {
         *rowsDecoded = 0;
         return kInvalidInput;
     }
 
-    // When fSwizzleSrcRow is non-null, it means that we need to swizzle.  In this case,
-    // we will always decode into fSwizzlerSrcRow before swizzling into the next buffer.
+    // When swizzleSrcRow is non-null, it means that we need to swizzle.  In this case,
+    // we will always decode into swizzleSrcRow before swizzling into the next buffer.
     // We can never swizzle "in place" because the swizzler may perform sampling and/or
     // subsetting.
-    // When fColorXformSrcRow is non-null, it means that we need to color xform and that
+    // When colorXformSrcRow is non-null, it means that we need to color xform and that
     // we cannot color xform "in place" (many times we can, but not when the src and dst
     // are different sizes).
-    // In this case, we will color xform from fColorXformSrcRow into the dst.
+    // In this case, we will color xform from colorXformSrcRow into the dst.
     JSAMPLE* decodeDst = (JSAMPLE*) dst;
     uint32_t* swizzleDst = (uint32_t*) dst;
     size_t decodeDstRowBytes = rowBytes;
     size_t swizzleDstRowBytes = rowBytes;
     int dstWidth = opts.fSubset ? opts.fSubset->width() : dstInfo.width();
-    if (fSwizzleSrcRow && fColorXformSrcRow) {
-        decodeDst = (JSAMPLE*) fSwizzleSrcRow;
-        swizzleDst = fColorXformSrcRow;
+    if (swizzleSrcRow && colorXformSrcRow) {
+        decodeDst = (JSAMPLE*) swizzleSrcRow;
+        swizzleDst = colorXformSrcRow;
         decodeDstRowBytes = 0;
         swizzleDstRowBytes = 0;
         dstWidth = fSwizzler->swizzleWidth();
-    } else if (fColorXformSrcRow) {
-        decodeDst = (JSAMPLE*) fColorXformSrcRow;
-        swizzleDst = fColorXformSrcRow;
+    } else if (colorXformSrcRow) {
+        decodeDst = (JSAMPLE*) colorXformSrcRow;
+        swizzleDst = colorXformSrcRow;
         decodeDstRowBytes = 0;
         swizzleDstRowBytes = 0;
-    } else if (fSwizzleSrcRow) {
-        decodeDst = (JSAMPLE*) fSwizzleSrcRow;
+    } else if (swizzleSrcRow) {
+        decodeDst = (JSAMPLE*) swizzleSrcRow;
         decodeDstRowBytes = 0;
         dstWidth = fSwizzler->swizzleWidth();
     }
 
     for (int y = 0; y < count; y++) {
-        uint32_t lines = jpeg_read_scanlines(fDecoderMgr->dinfo(), &decodeDst, 1);
+        uint32_t lines = jpeg_read_scanlines(decoderMgr->dinfo(), &decodeDst, 1);
         if (0 == lines) {
             *rowsDecoded = y;
             return kSuccess;
@@ -513,10 +532,15 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
         this->initializeSwizzler(dstInfo, options, true);
     }
 
-    if (!this->allocateStorage(dstInfo)) {
+    if (!this->allocateStorage(dstInfo, fDecoderMgr.get())) {
         return kInternalError;
     }
 
+    if (options.fExecutor && !isProgressive &&
+        kSuccess == this->decodeStrips(dstInfo, dst, dstRowBytes, options)) {
+        return kSuccess;
+    }
+
     if (isProgressive) {
       // Keep consuming input until we can't anymore, and only output/read scanlines
       // if there is at least one valid output.
@@ -564,21 +588,34 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
     return kSuccess;
 }
 
-bool SkJpegCodec::allocateStorage(const SkImageInfo& dstInfo) {
+/*
+ * How much memory readRows() needs for rows in between libjpeg-turbo and the dst.
+ */
+static void get_storage_bytes(const j_decompress_ptr dinfo,
+                              const SkSwizzler* swizzler,
+                              bool hasColorXform,
+                              const SkImageInfo& dstInfo,
+                              size_t* swizzleBytes,
+                              size_t* xformBytes) {
     int dstWidth = dstInfo.width();
 
-    size_t swizzleBytes = 0;
-    if (fSwizzler) {
-        swizzleBytes = get_row_bytes(fDecoderMgr->dinfo());
-        dstWidth = fSwizzler->swizzleWidth();
-        SkASSERT(!this->colorXform() || SkIsAlign4(swizzleBytes));
+    *swizzleBytes = 0;
+    if (swizzler) {
+        *swizzleBytes = get_row_bytes(dinfo);
+        dstWidth = swizzler->swizzleWidth();
+        SkASSERT(!hasColorXform || SkIsAlign4(*swizzleBytes));
     }
 
-    size_t xformBytes = 0;
-
-    if (this->colorXform() && sizeof(uint32_t) != dstInfo.bytesPerPixel()) {
-        xformBytes = dstWidth * sizeof(uint32_t);
+    *xformBytes = 0;
+    if (hasColorXform && sizeof(uint32_t) != dstInfo.bytesPerPixel()) {
+        *xformBytes = dstWidth * sizeof(uint32_t);
     }
+}
+
+bool SkJpegCodec::allocateStorage(const SkImageInfo& dstInfo, JpegDecoderMgr* decoderMgr) {
+    size_t swizzleBytes, xformBytes;
+    get_storage_bytes(decoderMgr->dinfo(), fSwizzler.get(), this->colorXform(), dstInfo,
+                      &swizzleBytes, &xformBytes);
 
     size_t totalBytes = swizzleBytes + xformBytes;
     if (totalBytes > 0) {
@@ -649,7 +686,7 @@ SkSampler* SkJpegCodec::getSampler(bool createIfNecessary) {
             fDecoderMgr->dinfo()->out_color_space, this->getEncodedInfo().profile(),
             this->colorXform());
     this->initializeSwizzler(this->dstInfo(), this->options(), needsCMYKToRGB);
-    if (!this->allocateStorage(this->dstInfo())) {
+    if (!this->allocateStorage(this->dstInfo(), fDecoderMgr.get())) {
         return nullptr;
     }
     return fSwizzler.get();
@@ -657,6 +694,10 @@ SkSampler* SkJpegCodec::getSampler(bool createIfNecessary) {
 
 SkCodec::Result SkJpegCodec::onStartScanlineDecode(const SkImageInfo& dstInfo,
         const Options& options) {
+    fStripDecoderMgr = nullptr;
+    fStripStream = nullptr;
+    fStripFirstRow = 0;
+
     // Set the jump location for libjpeg errors
     skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
     if (setjmp(jmp)) {
@@ -714,7 +755,7 @@ SkCodec::Result SkJpegCodec::onStartScanlineDecode(const SkImageInfo& dstInfo,
         this->initializeSwizzler(dstInfo, options, true);
     }
 
-    if (!this->allocateStorage(dstInfo)) {
+    if (!this->allocateStorage(dstInfo, fDecoderMgr.get())) {
         return kInternalError;
     }
 
@@ -726,20 +767,334 @@ int SkJpegCodec::onGetScanlines(void* dst, int count, size_t dstRowBytes) {
     this->readRows(this->dstInfo(), dst, dstRowBytes, count, this->options(), &rows);
     if (rows < count) {
         // This allows us to skip calling jpeg_finish_decompress().
-        fDecoderMgr->dinfo()->output_scanline = this->dstInfo().height();
+        this->scanlineDecoderMgr()->dinfo()->output_scanline = this->dstInfo().height();
     }
 
     return rows;
 }
 
 bool SkJpegCodec::onSkipScanlines(int count) {
+    // Entropy decoding every row we skip can take most of the time of a region decode.  When
+    // we're skipping a lot, start again from a restart marker near the end instead.
+    const int targetRow = fStripFirstRow + this->scanlineDecoderMgr()->dinfo()->output_scanline +
+                          count;
+    this->seekToRestartMarker(targetRow);
+    JpegDecoderMgr* decoderMgr = this->scanlineDecoderMgr();
+    count = targetRow - fStripFirstRow - decoderMgr->dinfo()->output_scanline;
+
     // Set the jump location for libjpeg errors
-    skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return decoderMgr->returnFalse("onSkipScanlines");
+    }
+
+    return (uint32_t) count == jpeg_skip_scanlines(decoderMgr->dinfo(), count);
+}
+
+JpegDecoderMgr* SkJpegCodec::scanlineDecoderMgr() const {
+    return fStripDecoderMgr ? fStripDecoderMgr.get() : fDecoderMgr.get();
+}
+
+const SkJpegRestartIndex* SkJpegCodec::restartIndex() {
+    if (!fRestartIndexBuilt) {
+        fRestartIndexBuilt = true;
+        // Strips are cut straight from the encoded data, which had better be in memory already.
+        SkStream* stream = this->stream();
+        sk_sp<SkData> data = stream->getData();
+        if (!data && stream->getMemoryBase() && stream->hasLength()) {
+            data = SkData::MakeWithoutCopy(stream->getMemoryBase(), stream->getLength());
+        }
+        fRestartIndex = SkJpegRestartIndex::Make(std::move(data));
+    }
+    return fRestartIndex.get();
+}
+
+/*
+ * How many rows of output each MCU row of the image decodes to.
+ */
+static int output_rows_per_mcu_row(const SkJpegRestartIndex& index,
+                                   const jpeg_decompress_struct* dinfo) {
+    // MCU rows are a multiple of 8 rows tall, and libjpeg-turbo scales by eighths.
+    return index.mcuRowHeight() * dinfo->scale_num / dinfo->scale_denom;
+}
+
+/*
+ * Gives a decoder that has read its header the same settings as the whole image's decoder, so
+ * that it produces the same pixels.
+ */
+static void copy_decompress_settings(jpeg_decompress_struct* dinfo,
+                                     const jpeg_decompress_struct* image) {
+    dinfo->out_color_space = image->out_color_space;
+    dinfo->scale_num = image->scale_num;
+    dinfo->scale_denom = image->scale_denom;
+    dinfo->dct_method = image->dct_method;
+    dinfo->dither_mode = image->dither_mode;
+    dinfo->do_fancy_upsampling = image->do_fancy_upsampling;
+}
+
+/*
+ * Starts decoding a strip of the image with the same settings as the whole image's decoder.
+ */
+static bool start_strip_decompress(JpegDecoderMgr* stripMgr, const jpeg_decompress_struct* image) {
+    stripMgr->init();
+    jpeg_decompress_struct* dinfo = stripMgr->dinfo();
+    if (JPEG_HEADER_OK != jpeg_read_header(dinfo, TRUE)) {
+        return false;
+    }
+    copy_decompress_settings(dinfo, image);
+    return jpeg_start_decompress(dinfo);
+}
+
+SkCodec::Result SkJpegCodec::decodeStrips(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                                          const Options& options) {
+    SkASSERT(options.fExecutor && !options.fSubset);
+    const SkJpegRestartIndex* index = this->restartIndex();
+    if (!index) {
+        return kUnimplemented;
+    }
+
+    // Each strip also decodes an MCU row above and below it, so keep them a good deal taller.
+    constexpr int kMinStripMcuRows = 16;
+    constexpr int kMaxStrips = 64;
+    const int interval = index->startRowInterval();
+    int stripMcuRows = std::max(kMinStripMcuRows,
+                                (index->mcuRowCount() + kMaxStrips - 1) / kMaxStrips);
+    stripMcuRows = (stripMcuRows + interval - 1) / interval * interval;
+    const int strips = (index->mcuRowCount() + stripMcuRows - 1) / stripMcuRows;
+    if (strips < 2) {
+        return kUnimplemented;
+    }
+
+    std::atomic<bool> failed{false};
+    SkTaskGroup(*options.fExecutor).batch(strips, [&](int i) {
+        const int start = i * stripMcuRows;
+        const int end = std::min(start + stripMcuRows, index->mcuRowCount());
+        if (!failed.load(std::memory_order_relaxed) &&
+            !this->decodeStrip(start, end, dstInfo, dst, rowBytes, options)) {
+            failed.store(true, std::memory_order_relaxed);
+        }
+    });
+    return failed.load() ? kUnimplemented : kSuccess;
+}
+
+bool SkJpegCodec::decodeStrip(int startMcuRow, int endMcuRow, const SkImageInfo& dstInfo,
+                              void* dst, size_t rowBytes, const Options& options) const {
+    const SkJpegRestartIndex& index = *fRestartIndex;
+    const jpeg_decompress_struct* image = fDecoderMgr->dinfo();
+    const int rowsPerMcuRow = output_rows_per_mcu_row(index, image);
+
+    // Decode an MCU row above and below the strip as well, so that the rows at its edges are
+    // upsampled just as they are when decoding the whole image.
+    const int decodeStart = startMcuRow > 0 ? index.startRowAtOrBefore(startMcuRow - 1) : 0;
+    const int decodeEnd = std::min(endMcuRow + 1, index.mcuRowCount());
+
+    SkMemoryStream stream(index.makeStrip(decodeStart, decodeEnd));
+    JpegDecoderMgr decoderMgr(&stream);
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr.errorMgr());
+    if (setjmp(jmp)) {
+        return decoderMgr.returnFalse("decodeStrip");
+    }
+    if (!start_strip_decompress(&decoderMgr, image)) {
+        return false;
+    }
+    jpeg_decompress_struct* dinfo = decoderMgr.dinfo();
+    if (dinfo->output_width != image->output_width ||
+        dinfo->out_color_components != image->out_color_components) {
+        return false;
+    }
+
+    size_t swizzleBytes, xformBytes;
+    get_storage_bytes(dinfo, fSwizzler.get(), this->colorXform(), dstInfo,
+                      &swizzleBytes, &xformBytes);
+    const size_t discardBytes = get_row_bytes(dinfo);
+    AutoTMalloc<uint8_t> storage(swizzleBytes + xformBytes + discardBytes);
+    uint8_t* swizzleSrcRow = swizzleBytes > 0 ? storage.get() : nullptr;
+    uint32_t* colorXformSrcRow =
+            xformBytes > 0 ? SkTAddOffset<uint32_t>(storage.get(), swizzleBytes) : nullptr;
+    JSAMPLE* discardRow = storage.get() + swizzleBytes + xformBytes;
+
+    for (int i = (startMcuRow - decodeStart) * rowsPerMcuRow; i > 0; i--) {
+        if (1 != jpeg_read_scanlines(dinfo, &discardRow, 1)) {
+            return false;
+        }
+    }
+
+    const int firstRow = startMcuRow * rowsPerMcuRow;
+    const int count = std::min(endMcuRow * rowsPerMcuRow, dstInfo.height()) - firstRow;
+    int rows = 0;
+    this->readRows(&decoderMgr, swizzleSrcRow, colorXformSrcRow, dstInfo,
+                   SkTAddOffset<void>(dst, firstRow * rowBytes), rowBytes, count, options, &rows);
+    return rows == count;
+}
+
+void SkJpegCodec::seekToRestartMarker(int row) {
+    const SkJpegRestartIndex* index = this->restartIndex();
+    if (!index) {
+        return;
+    }
+    const jpeg_decompress_struct* image = fDecoderMgr->dinfo();
+    const int rowsPerMcuRow = output_rows_per_mcu_row(*index, image);
+    const int mcuRow = row / rowsPerMcuRow;
+    if (mcuRow < 1) {
+        return;
+    }
+    // Start at least an MCU row early, so that row is upsampled just as it would be otherwise.
+    const int startMcuRow = index->startRowAtOrBefore(mcuRow - 1);
+    // Starting a new decoder costs about as much as skipping an MCU row or two.
+    const int currentRow = fStripFirstRow + this->scanlineDecoderMgr()->dinfo()->output_scanline;
+    if (startMcuRow * rowsPerMcuRow < currentRow + 2 * rowsPerMcuRow) {
+        return;
+    }
+
+    auto stream = std::make_unique<SkMemoryStream>(
+            index->makeStrip(startMcuRow, index->mcuRowCount()));
+    auto decoderMgr = std::make_unique<JpegDecoderMgr>(stream.get());
+    {
+        skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr->errorMgr());
+        if (setjmp(jmp)) {
+            decoderMgr->returnFalse("seekToRestartMarker");
+            return;
+        }
+        if (!start_strip_decompress(decoderMgr.get(), image)) {
+            return;
+        }
+        if (const SkIRect* subset = this->options().fSubset) {
+            // The same crop as onStartScanlineDecode().
+            uint32_t startX = subset->x();
+            uint32_t width = subset->width();
+            jpeg_crop_scanline(decoderMgr->dinfo(), &startX, &width);
+        }
+        if (decoderMgr->dinfo()->output_width != image->output_width) {
+            return;
+        }
+    }
+
+    fStripDecoderMgr = std::move(decoderMgr);
+    fStripStream = std::move(stream);
+    fStripFirstRow = startMcuRow * rowsPerMcuRow;
+}
+
+SkCodec::Result SkJpegCodec::onStartIncrementalDecode(const SkImageInfo& dstInfo, void* dst,
+                                                      size_t rowBytes, const Options& options) {
+    if (!options.fProgressivePreviews || options.fSubset) {
+        return kUnimplemented;
+    }
+
+    // Carry on from the header fDecoderMgr has read, which already has the settings for this
+    // decode, and suspend when the data runs out rather than failing.  The stream may still be
+    // receiving data, and so can't be rewound.
+    JpegDecoderMgr* decoderMgr = fDecoderMgr.get();
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr->errorMgr());
     if (setjmp(jmp)) {
-        return fDecoderMgr->returnFalse("onSkipScanlines");
+        return decoderMgr->returnFailure("onStartIncrementalDecode", kInvalidInput);
     }
+    decoderMgr->makeSuspending();
+    jpeg_decompress_struct* dinfo = decoderMgr->dinfo();
 
-    return (uint32_t) count == jpeg_skip_scanlines(fDecoderMgr->dinfo(), count);
+    // Images with several scans, progressive or not, are decoded in buffered image mode, which
+    // lets us output whichever scan we like, as often as we like.  In that mode this never needs
+    // more input.  Otherwise libjpeg would need every scan before it could output any rows.
+    dinfo->buffered_image = jpeg_has_multiple_scans(dinfo);
+    if (!jpeg_start_decompress(dinfo)) {
+        return decoderMgr->returnFailure("startDecompress", kIncompleteInput);
+    }
+    fFinalDctMethod = dinfo->dct_method;
+
+    if (needs_swizzler_to_convert_from_cmyk(dinfo->out_color_space,
+                                            this->getEncodedInfo().profile(), this->colorXform())) {
+        this->initializeSwizzler(dstInfo, options, true);
+    }
+    if (!this->allocateStorage(dstInfo, decoderMgr)) {
+        return kInternalError;
+    }
+
+    fIncrementalDst = dst;
+    fIncrementalRowBytes = rowBytes;
+    fIncrementalRowsDecoded = 0;
+    fLastCompletedScan = 0;
+    fPreviewScan = 0;
+    fFinishingOutput = false;
+    return kSuccess;
+}
+
+SkCodec::Result SkJpegCodec::onIncrementalDecode(int* rowsDecoded) {
+    JpegDecoderMgr* decoderMgr = fDecoderMgr.get();
+    jpeg_decompress_struct* dinfo = decoderMgr->dinfo();
+    const SkImageInfo& dstInfo = this->dstInfo();
+
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return decoderMgr->returnFailure("onIncrementalDecode", kInvalidInput);
+    }
+    decoderMgr->receiveData();
+
+    if (!dinfo->buffered_image) {
+        // A sequential image arrives from top to bottom, so decode the rows we have data for.
+        int rows = 0;
+        const Result result = this->readRows(
+                decoderMgr, fSwizzleSrcRow, fColorXformSrcRow, dstInfo,
+                SkTAddOffset<void>(fIncrementalDst, fIncrementalRowsDecoded * fIncrementalRowBytes),
+                fIncrementalRowBytes, dstInfo.height() - fIncrementalRowsDecoded, this->options(),
+                &rows);
+        if (result != kSuccess) {
+            return decoderMgr->returnFailure("readRows", result);
+        }
+        fIncrementalRowsDecoded += rows;
+        if (fIncrementalRowsDecoded == dstInfo.height()) {
+            return kSuccess;
+        }
+        if (rowsDecoded) {
+            *rowsDecoded = fIncrementalRowsDecoded;
+        }
+        return kIncompleteInput;
+    }
+
+    // Finishing the last preview reads ahead to the next scan, which may not have arrived then.
+    if (fFinishingOutput) {
+        fFinishingOutput = !jpeg_finish_output(dinfo);
+    }
+
+    if (!fFinishingOutput) {
+        while (!jpeg_input_complete(dinfo)) {
+            // Call the progress monitor hook if present, to prevent decoder from hanging.
+            if (dinfo->progress) {
+                dinfo->progress->progress_monitor((j_common_ptr)dinfo);
+            }
+            const int res = jpeg_consume_input(dinfo);
+            if (res == JPEG_SUSPENDED) {
+                break;
+            }
+            if (res == JPEG_SCAN_COMPLETED) {
+                fLastCompletedScan = dinfo->input_scan_number;
+            }
+        }
+
+        // Only the final pass has to match getPixels().  Previews use the faster IDCT.
+        const bool finalPass = jpeg_input_complete(dinfo);
+        const int scan = finalPass ? dinfo->input_scan_number : fLastCompletedScan;
+        if (finalPass || scan > fPreviewScan) {
+            dinfo->dct_method = finalPass ? (J_DCT_METHOD)fFinalDctMethod : JDCT_IFAST;
+            jpeg_start_output(dinfo, scan);
+            int rows = 0;
+            const Result result = this->readRows(decoderMgr, fSwizzleSrcRow, fColorXformSrcRow,
+                                                 dstInfo, fIncrementalDst, fIncrementalRowBytes,
+                                                 dstInfo.height(), this->options(), &rows);
+            if (result != kSuccess) {
+                return decoderMgr->returnFailure("readRows", result);
+            }
+            fIncrementalRowsDecoded = std::max(fIncrementalRowsDecoded, rows);
+            fPreviewScan = scan;
+            fFinishingOutput = !jpeg_finish_output(dinfo);
+            if (finalPass && rows == dstInfo.height()) {
+                return kSuccess;
+            }
+        }
+    }
+
+    if (rowsDecoded) {
+        *rowsDecoded = fIncrementalRowsDecoded;
+    }
+    return kIncompleteInput;
 }
 
 static bool is_yuv_supported(const jpeg_decompress_struct* dinfo,
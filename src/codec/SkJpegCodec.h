@@ -17,12 +17,14 @@
 #include "include/core/SkYUVAPixmaps.h"
 #include "include/private/SkEncodedInfo.h"
 #include "include/private/base/SkTemplates.h"
+#include "src/codec/SkCodecScratch.h"
 
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 
 class JpegDecoderMgr;
+class SkJpegRestartIndex;
 class SkSampler;
 class SkStream;
 class SkSwizzler;
@@ -129,9 +131,36 @@ private:
 
     void initializeSwizzler(const SkImageInfo& dstInfo, const Options& options,
                             bool needsCMYKToRGB);
-    [[nodiscard]] bool allocateStorage(const SkImageInfo& dstInfo);
+    [[nodiscard]] bool allocateStorage(const SkImageInfo& dstInfo, JpegDecoderMgr*);
     Result readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count,
                   const Options&, int* rowsDecoded);
+    Result readRows(JpegDecoderMgr*, uint8_t* swizzleSrcRow, uint32_t* colorXformSrcRow,
+                    const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count,
+                    const Options&, int* rowsDecoded) const;
+
+    /*
+     * Restart markers let us decode strips of the image independently.  This index of them is
+     * built the first time we could use it, and is null if the image has no useful restart
+     * markers or its encoded data isn't in memory.
+     */
+    const SkJpegRestartIndex* restartIndex();
+
+    /*
+     * Decodes the image as strips in parallel on options.fExecutor.  Returns kUnimplemented if
+     * that's not possible, in which case nothing has been read from fDecoderMgr.
+     */
+    Result decodeStrips(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, const Options&);
+    bool decodeStrip(int startMcuRow, int endMcuRow, const SkImageInfo& dstInfo, void* dst,
+                     size_t rowBytes, const Options&) const;
+
+    /*
+     * During a scanline decode, switches to decoding from the last restart marker that leaves
+     * an MCU row of context above row, if that skips enough to be worth starting a new decoder.
+     */
+    void seekToRestartMarker(int row);
+
+    // The decoder that scanline decodes are reading from.
+    JpegDecoderMgr* scanlineDecoderMgr() const;
 
     /*
      * Scanline decoding.
@@ -142,14 +171,42 @@ private:
     int onGetScanlines(void* dst, int count, size_t rowBytes) override;
     bool onSkipScanlines(int count) override;
 
+    /*
+     * Incremental decoding, only with Options::fProgressivePreviews.  Images with several scans
+     * are output whole every time another scan arrives.
+     */
+    Result onStartIncrementalDecode(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                                    const Options&) override;
+    Result onIncrementalDecode(int* rowsDecoded) override;
+
     std::unique_ptr<JpegDecoderMgr>    fDecoderMgr;
 
+    std::unique_ptr<SkJpegRestartIndex> fRestartIndex;
+    bool                                fRestartIndexBuilt = false;
+
+    // After seekToRestartMarker(), scanlines come from a decoder of a strip of the image that
+    // starts at fStripFirstRow.  fStripStream must outlive fStripDecoderMgr.
+    std::unique_ptr<SkStream>          fStripStream;
+    std::unique_ptr<JpegDecoderMgr>    fStripDecoderMgr;
+    int                                fStripFirstRow = 0;
+
+    // An incremental decode carries on from fDecoderMgr's header, with a source manager that
+    // suspends when it runs out of data.  Images with several scans are previewed from the last
+    // scan that has arrived in full, with the fast IDCT until the final pass.
+    void*                              fIncrementalDst = nullptr;
+    size_t                             fIncrementalRowBytes = 0;
+    int                                fIncrementalRowsDecoded = 0;
+    int                                fLastCompletedScan = 0;
+    int                                fPreviewScan = 0;
+    bool                               fFinishingOutput = false;
+    int                                fFinalDctMethod = 0;  // A J_DCT_METHOD.
+
     // We will save the state of the decompress struct after reading the header.
     // This allows us to safely call onGetScaledDimensions() at any time.
     const int                          fReadyState;
 
 
-    skia_private::AutoTMalloc<uint8_t>             fStorage;
+    SkCodecScratchStorage                          fStorage;
     uint8_t* fSwizzleSrcRow = nullptr;
     uint32_t* fColorXformSrcRow = nullptr;
 
@@ -8,6 +8,7 @@
 
 #include "include/core/SkTypes.h"
 #include "src/codec/SkCodecPriv.h"
+#include "src/codec/SkCodecScratch.h"
 #include "src/codec/SkJpegSourceMgr.h"
 #include "src/codec/SkJpegUtility.h"
 
@@ -54,17 +55,17 @@ static void progress_monitor(j_common_ptr info) {
 // JpegDecoderMgr
 
 bool JpegDecoderMgr::returnFalse(const char caller[]) {
-    print_message((j_common_ptr) &fDInfo, caller);
+    print_message((j_common_ptr) fDInfo, caller);
     return false;
 }
 
 SkCodec::Result JpegDecoderMgr::returnFailure(const char caller[], SkCodec::Result result) {
-    print_message((j_common_ptr) &fDInfo, caller);
+    print_message((j_common_ptr) fDInfo, caller);
     return result;
 }
 
 bool JpegDecoderMgr::getEncodedColor(SkEncodedInfo::Color* outColor) {
-    switch (fDInfo.jpeg_color_space) {
+    switch (fDInfo->jpeg_color_space) {
         case JCS_GRAYSCALE:
             *outColor = SkEncodedInfo::kGray_Color;
             return true;
@@ -92,25 +93,73 @@ SkJpegSourceMgr* JpegDecoderMgr::getSourceMgr() {
     return fSrcMgr.fSourceMgr.get();
 }
 
+void JpegDecoderMgr::makeSuspending() {
+    fSrcMgr.fSourceMgr = fSrcMgr.fSourceMgr->makeSuspending(fSrcMgr.next_input_byte,
+                                                            fSrcMgr.bytes_in_buffer);
+    fSrcMgr.next_input_byte = nullptr;
+    fSrcMgr.bytes_in_buffer = 0;
+    this->receiveData();
+}
+
+void JpegDecoderMgr::receiveData() {
+    fSrcMgr.fSourceMgr->receiveData(fSrcMgr.next_input_byte, fSrcMgr.bytes_in_buffer);
+}
+
 JpegDecoderMgr::JpegDecoderMgr(SkStream* stream)
-        : fSrcMgr(SkJpegSourceMgr::Make(stream)), fInit(false) {
+        : JpegDecoderMgr(SkJpegSourceMgr::Make(stream)) {}
+
+struct JpegDecoderMgr::Decompress : SkCodecScratch::Cached {
+    ~Decompress() override {
+        if (fCreated) {
+            // The error manager of the last decoder manager to use it is gone.
+            jpeg_error_mgr errorMgr;
+            fDInfo.err = jpeg_std_error(&errorMgr);
+            jpeg_destroy_decompress(&fDInfo);
+        }
+    }
+
+    jpeg_decompress_struct fDInfo;
+    bool                   fCreated = false;
+};
+
+JpegDecoderMgr::JpegDecoderMgr(std::unique_ptr<SkJpegSourceMgr> sourceMgr)
+        : fScratch(SkCodecScratch::Get()), fSrcMgr(std::move(sourceMgr)) {
+    if (fScratch) {
+        fDecompress.reset(static_cast<Decompress*>(
+                fScratch->take(SkCodecScratch::Kind::kJpegDecompress).release()));
+    }
+    if (!fDecompress) {
+        fDecompress = std::make_unique<Decompress>();
+    }
+    fDInfo = &fDecompress->fDInfo;
+
     // An error manager must be set before any calls to libjpeg, in order to handle failures.
-    fDInfo.err = jpeg_std_error(&fErrorMgr);
+    fDInfo->err = jpeg_std_error(&fErrorMgr);
     fErrorMgr.error_exit = skjpeg_err_exit;
 }
 
 void JpegDecoderMgr::init() {
-    jpeg_create_decompress(&fDInfo);
-    fInit = true;
-    fDInfo.src = &fSrcMgr;
-    fDInfo.err->output_message = &output_message;
-    fDInfo.progress = &fProgressMgr;
+    if (!fDecompress->fCreated) {
+        jpeg_create_decompress(fDInfo);
+        fDecompress->fCreated = true;
+    } else {
+        // A struct another manager has given back is where jpeg_abort_decompress() left it, which
+        // is as jpeg_create_decompress() would, except for which markers it saves.
+        for (int marker = JPEG_APP0; marker < JPEG_APP0 + 16; marker++) {
+            jpeg_save_markers(fDInfo, marker, 0);
+        }
+        jpeg_save_markers(fDInfo, JPEG_COM, 0);
+    }
+    fDInfo->src = &fSrcMgr;
+    fDInfo->err->output_message = &output_message;
+    fDInfo->progress = &fProgressMgr;
     fProgressMgr.progress_monitor = &progress_monitor;
 }
 
 JpegDecoderMgr::~JpegDecoderMgr() {
-    if (fInit) {
-        jpeg_destroy_decompress(&fDInfo);
+    if (fScratch && fDecompress->fCreated) {
+        jpeg_abort_decompress(fDInfo);
+        fScratch->give(SkCodecScratch::Kind::kJpegDecompress, std::move(fDecompress));
     }
 }
 
@@ -20,6 +20,7 @@ extern "C" {
 
 #include <memory>
 
+class SkCodecScratch;
 class SkStream;
 
 class JpegDecoderMgr : SkNoncopyable {
@@ -41,6 +42,11 @@ public:
      */
     JpegDecoderMgr(SkStream* stream);
 
+    /*
+     * Create the decode manager with a particular source manager
+     */
+    JpegDecoderMgr(std::unique_ptr<SkJpegSourceMgr> sourceMgr);
+
     /*
      * Initialize decompress struct
      * Initialize the source manager
@@ -66,11 +72,18 @@ public:
     /*
      * Get function for the decompress info struct
      */
-    jpeg_decompress_struct* dinfo() { return &fDInfo; }
+    jpeg_decompress_struct* dinfo() { return fDInfo; }
 
     // Get the source manager.
     SkJpegSourceMgr* getSourceMgr();
 
+    // Carry on from what libjpeg has read so far with a source manager that suspends libjpeg
+    // when it runs out of data, rather than failing, so the rest can be decoded as it arrives.
+    void makeSuspending();
+
+    // Let a suspended decode see the data the stream has received since it suspended.
+    void receiveData();
+
 private:
     // Wrapper that calls into the full SkJpegSourceMgr interface.
     struct SourceMgr : jpeg_source_mgr {
@@ -83,11 +96,16 @@ private:
         std::unique_ptr<SkJpegSourceMgr> fSourceMgr;
     };
 
-    jpeg_decompress_struct fDInfo;
-    SourceMgr              fSrcMgr;
-    skjpeg_error_mgr       fErrorMgr;
-    jpeg_progress_mgr      fProgressMgr;
-    bool                   fInit;
+    // The decompress struct is kept apart from the manager so that, if the manager was made with
+    // an SkCodecScratch attached, it can be given back to the scratch for the next one to reuse.
+    struct Decompress;
+
+    SkCodecScratch*             fScratch;
+    std::unique_ptr<Decompress> fDecompress;
+    jpeg_decompress_struct*     fDInfo;  // Owned by fDecompress.
+    SourceMgr                   fSrcMgr;
+    skjpeg_error_mgr            fErrorMgr;
+    jpeg_progress_mgr           fProgressMgr;
 };
 
 #endif
@@ -0,0 +1,205 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/codec/SkJpegRestartIndex.h"
+
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTo.h"
+#include "src/codec/SkCodecPriv.h"
+#include "src/codec/SkJpegConstants.h"
+#include "src/codec/SkJpegSegmentScan.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+constexpr uint8_t kMarkerSOF0 = 0xC0;  // Baseline
+constexpr uint8_t kMarkerSOF1 = 0xC1;  // Extended sequential, Huffman coded
+constexpr uint8_t kMarkerDHT = 0xC4;
+constexpr uint8_t kMarkerRST0 = 0xD0;
+constexpr uint8_t kMarkerDQT = 0xDB;
+constexpr uint8_t kMarkerDRI = 0xDD;
+constexpr uint8_t kMarkerAPP14 = 0xEE;
+constexpr uint8_t kMarkerCOM = 0xFE;
+
+uint16_t read_u16(const uint8_t* p) { return (p[0] << 8) | p[1]; }
+
+}  // namespace
+
+std::unique_ptr<SkJpegRestartIndex> SkJpegRestartIndex::Make(sk_sp<SkData> data) {
+    if (!data) {
+        return nullptr;
+    }
+    SkJpegSegmentScanner scanner;
+    scanner.onBytes(data->data(), data->size());
+    if (!scanner.isDone()) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SkJpegRestartIndex> index(new SkJpegRestartIndex);
+    index->fHeader = {0xFF, kJpegMarkerStartOfImage};
+
+    int width = 0;
+    int components = 0;
+    int maxH = 0, maxV = 0;
+    bool sawScan = false;
+    int expectedRestart = 0;
+    for (const SkJpegSegment& segment : scanner.getSegments()) {
+        const uint8_t marker = segment.marker;
+        if (sawScan) {
+            // Everything after the scan starts must be restart markers, in order, and then the
+            // end of the image.  Anything else (more scans, a DNL marker) we leave to libjpeg.
+            if (marker == kJpegMarkerEndOfImage) {
+                index->fIntervalEnds.push_back(segment.offset);
+                break;
+            }
+            if (marker != kMarkerRST0 + expectedRestart) {
+                return nullptr;
+            }
+            index->fIntervalEnds.push_back(segment.offset);
+            expectedRestart = (expectedRestart + 1) % 8;
+            continue;
+        }
+        if (marker == kJpegMarkerStartOfImage) {
+            continue;
+        }
+
+        sk_sp<SkData> params = SkJpegSegmentScanner::GetParameters(data.get(), segment);
+        const uint8_t* p = params->bytes();
+        const size_t size = params->size();
+        switch (marker) {
+            case kMarkerSOF0:
+            case kMarkerSOF1: {
+                if (size < 6 || p[0] != 8) {
+                    return nullptr;
+                }
+                index->fImageHeight = read_u16(p + 1);
+                width = read_u16(p + 3);
+                components = p[5];
+                if (index->fImageHeight == 0 || width == 0 || components < 1 || components > 4 ||
+                    size < 6 + 3 * SkToSizeT(components)) {
+                    return nullptr;
+                }
+                for (int i = 0; i < components; i++) {
+                    const int h = p[6 + 3 * i + 1] >> 4,
+                              v = p[6 + 3 * i + 1] & 0xF;
+                    if (h < 1 || h > 4 || v < 1 || v > 4) {
+                        return nullptr;
+                    }
+                    maxH = std::max(maxH, h);
+                    maxV = std::max(maxV, v);
+                }
+                // The height is the first parameter after the sample precision.
+                index->fHeightOffset = index->fHeader.size() + kJpegMarkerCodeSize +
+                                       kJpegSegmentParameterLengthSize + 1;
+                break;
+            }
+            case kMarkerDRI:
+                if (size < 2) {
+                    return nullptr;
+                }
+                index->fRestartInterval = read_u16(p);
+                break;
+            case kJpegMarkerStartOfScan:
+                if (size < 1 || p[0] != components) {
+                    return nullptr;
+                }
+                index->fScanStart =
+                        segment.offset + kJpegMarkerCodeSize + segment.parameterLength;
+                sawScan = true;
+                break;
+            case kMarkerDHT:
+            case kMarkerDQT:
+            case kJpegMarkerAPP0:
+            case kMarkerAPP14:
+                // JFIF and Adobe markers decide how libjpeg converts colors.
+                break;
+            default:
+                if ((marker > kJpegMarkerAPP0 && marker <= 0xEF) || marker == kMarkerCOM) {
+                    // Metadata the strips don't need.
+                    continue;
+                }
+                // Progressive, lossless, arithmetic coding, hierarchical...
+                return nullptr;
+        }
+        const uint8_t* bytes = data->bytes() + segment.offset;
+        index->fHeader.insert(index->fHeader.end(), bytes,
+                              bytes + kJpegMarkerCodeSize + segment.parameterLength);
+    }
+    if (!sawScan || index->fRestartInterval == 0 || index->fHeightOffset == 0 ||
+        index->fIntervalEnds.empty() ||
+        data->bytes()[index->fIntervalEnds.back() + 1] != kJpegMarkerEndOfImage) {
+        return nullptr;
+    }
+
+    // A single component scan isn't interleaved, so its MCUs are single blocks.
+    if (components == 1) {
+        maxH = maxV = 1;
+    }
+    const int mcuWidth = 8 * maxH;
+    index->fMcuRowHeight = 8 * maxV;
+    index->fMcusPerRow = (width + mcuWidth - 1) / mcuWidth;
+    index->fMcuRowCount = (index->fImageHeight + index->fMcuRowHeight - 1) / index->fMcuRowHeight;
+
+    const int64_t mcus = (int64_t)index->fMcusPerRow * index->fMcuRowCount;
+    const int64_t intervals = (mcus + index->fRestartInterval - 1) / index->fRestartInterval;
+    if (intervals != SkToS64(index->fIntervalEnds.size())) {
+        SkCodecPrintf("Expected %lld restart intervals, found %zu.\n",
+                      (long long)intervals, index->fIntervalEnds.size());
+        return nullptr;
+    }
+
+    // Rows that start at the beginning of a restart interval.
+    index->fStartRowInterval = index->fRestartInterval /
+                               std::gcd(index->fRestartInterval, index->fMcusPerRow);
+    if (index->fStartRowInterval >= index->fMcuRowCount) {
+        return nullptr;
+    }
+
+    index->fData = std::move(data);
+    return index;
+}
+
+sk_sp<SkData> SkJpegRestartIndex::makeStrip(int startRow, int endRow) const {
+    SkASSERT(startRow % fStartRowInterval == 0);
+    SkASSERT(0 <= startRow && startRow < endRow && endRow <= fMcuRowCount);
+
+    const int64_t firstInterval = (int64_t)startRow * fMcusPerRow / fRestartInterval;
+    const int64_t endInterval = std::min<int64_t>(
+            fIntervalEnds.size(),
+            ((int64_t)endRow * fMcusPerRow + fRestartInterval - 1) / fRestartInterval);
+    auto intervalStart = [this](int64_t i) {
+        return i == 0 ? fScanStart : fIntervalEnds[i - 1] + kJpegMarkerCodeSize;
+    };
+
+    const size_t dataSize = fIntervalEnds[endInterval - 1] - intervalStart(firstInterval);
+    sk_sp<SkData> strip = SkData::MakeUninitialized(fHeader.size() + dataSize +
+                                                    kJpegMarkerCodeSize);
+    uint8_t* dst = static_cast<uint8_t*>(strip->writable_data());
+
+    memcpy(dst, fHeader.data(), fHeader.size());
+    const int height = std::min(endRow * fMcuRowHeight, fImageHeight) - startRow * fMcuRowHeight;
+    dst[fHeightOffset + 0] = height >> 8;
+    dst[fHeightOffset + 1] = height & 0xFF;
+    dst += fHeader.size();
+
+    for (int64_t i = firstInterval; i < endInterval; i++) {
+        const size_t start = intervalStart(i);
+        memcpy(dst, fData->bytes() + start, fIntervalEnds[i] - start);
+        dst += fIntervalEnds[i] - start;
+        // libjpeg expects the restart markers to count up from zero.
+        dst[0] = 0xFF;
+        dst[1] = i + 1 < endInterval ? kMarkerRST0 + (i - firstInterval) % 8
+                                     : kJpegMarkerEndOfImage;
+        dst += kJpegMarkerCodeSize;
+    }
+    SkASSERT(dst == strip->bytes() + strip->size());
+    return strip;
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkJpegRestartIndex_codec_DEFINED
+#define SkJpegRestartIndex_codec_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*
+ * An index of where each restart interval starts in the entropy-coded data of a baseline JPEG.
+ *
+ * Restart markers reset the entropy decoder, so any interval that starts at the beginning of an
+ * MCU row can be decoded without decoding anything before it.  The index can cut the image into
+ * strips of MCU rows that are complete JPEGs on their own, which lets us seek straight to a
+ * region of interest, or decode several strips at the same time.
+ */
+class SkJpegRestartIndex {
+public:
+    /*
+     * Returns nullptr unless data is a complete, 8-bit, Huffman coded JPEG with a single scan
+     * whose restart intervals line up with MCU rows often enough to be useful.
+     */
+    static std::unique_ptr<SkJpegRestartIndex> Make(sk_sp<SkData> data);
+
+    // The height of an MCU row, in pixels of the full size image.
+    int mcuRowHeight() const { return fMcuRowHeight; }
+    int mcuRowCount() const { return fMcuRowCount; }
+
+    // How many MCU rows there are from one row a strip may start at to the next.
+    int startRowInterval() const { return fStartRowInterval; }
+
+    // Returns the last MCU row at or above mcuRow that a strip may start at.
+    int startRowAtOrBefore(int mcuRow) const {
+        return mcuRow - mcuRow % fStartRowInterval;
+    }
+
+    /*
+     * Returns a JPEG of MCU rows [startRow, endRow) of the image.  startRow must be a row that a
+     * strip may start at.  The strip has the same tables and sampling as the image, so decoding
+     * it with the same settings produces the same pixels, apart from the first and last rows
+     * which miss the chroma rows above and below them when upsampling.
+     */
+    sk_sp<SkData> makeStrip(int startRow, int endRow) const;
+
+private:
+    SkJpegRestartIndex() = default;
+
+    sk_sp<SkData> fData;
+
+    // Every segment of the image we need up to and including the start of scan, with the image
+    // height at fHeightOffset.
+    std::vector<uint8_t> fHeader;
+    size_t fHeightOffset = 0;
+
+    // The offset of each restart marker in fData, followed by the offset of the end of image.
+    std::vector<size_t> fIntervalEnds;
+    size_t fScanStart = 0;
+
+    int fImageHeight = 0;
+    int fMcuRowHeight = 0;
+    int fMcuRowCount = 0;
+    int fMcusPerRow = 0;
+    int fRestartInterval = 0;
+    int fStartRowInterval = 0;
+};
+
+#endif
@@ -13,6 +13,8 @@
 #include "include/core/SkTypes.h"
 #include "src/codec/SkCodecPriv.h"
 
+#include <vector>
+
 #ifdef SK_CODEC_DECODES_JPEG_GAINMAPS
 #include "src/codec/SkJpegConstants.h"
 #include "src/codec/SkJpegSegmentScan.h"
@@ -74,6 +76,12 @@ public:
         bytesInBuffer -= bytesToSkip;
         return true;
     }
+    std::unique_ptr<SkJpegSourceMgr> makeSuspending(const uint8_t* unread, size_t size) override {
+        // libjpeg was given the whole stream without it being read, so all that's left is what
+        // libjpeg hasn't read.
+        fStream->seek(fStream->getLength());
+        return this->SkJpegSourceMgr::makeSuspending(unread, size);
+    }
 #ifdef SK_CODEC_DECODES_JPEG_GAINMAPS
     const std::vector<SkJpegSegment>& getAllSegments() override {
         if (fScanner) {
@@ -418,6 +426,99 @@ private:
 };
 #endif  // SK_CODEC_DECODES_JPEG_GAINMAPS
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SkJpegSuspendingSourceMgr
+
+/*
+ * This class implements SkJpegSourceMgr for a stream that is still receiving data. libjpeg only
+ * commits to what it has read at the end of each marker or MCU. When it runs out of data part
+ * way through one, it suspends and later starts that one again from where it last committed, so
+ * we keep everything from there on until it has been committed.
+ */
+class SkJpegSuspendingSourceMgr : public SkJpegSourceMgr {
+public:
+    SkJpegSuspendingSourceMgr(SkStream* stream, const uint8_t* unread, size_t size)
+            : SkJpegSourceMgr(stream), fBuffer(unread, unread + size) {}
+    ~SkJpegSuspendingSourceMgr() override {}
+
+    void initSource(const uint8_t*& nextInputByte, size_t& bytesInBuffer) override {
+        nextInputByte = nullptr;
+        bytesInBuffer = 0;
+        this->receiveData(nextInputByte, bytesInBuffer);
+    }
+    bool fillInputBuffer(const uint8_t*& nextInputByte, size_t& bytesInBuffer) override {
+        // libjpeg has read everything it was given, and will resume from where it last
+        // committed. After the first time it suspends, JpegDecoderMgr will have cleared these.
+        if (nextInputByte) {
+            fUnreadOffset = nextInputByte - fBuffer.data();
+        }
+        return false;
+    }
+    bool skipInputBytes(size_t bytesToSkip,
+                        const uint8_t*& nextInputByte,
+                        size_t& bytesInBuffer) override {
+        // libjpeg commits before skipping, so nothing skipped will need to be read again.
+        if (bytesToSkip <= bytesInBuffer) {
+            nextInputByte += bytesToSkip;
+            bytesInBuffer -= bytesToSkip;
+            return true;
+        }
+        fBytesToSkip += bytesToSkip - bytesInBuffer;
+        nextInputByte += bytesInBuffer;
+        bytesInBuffer = 0;
+        return true;
+    }
+    void receiveData(const uint8_t*& nextInputByte, size_t& bytesInBuffer) override {
+        if (nextInputByte) {
+            fUnreadOffset = nextInputByte - fBuffer.data();
+        }
+        fBuffer.erase(fBuffer.begin(), fBuffer.begin() + fUnreadOffset);
+        fUnreadOffset = 0;
+
+        while (fBytesToSkip > 0) {
+            const size_t skipped = fStream->skip(fBytesToSkip);
+            if (skipped == 0) {
+                break;
+            }
+            fBytesToSkip -= skipped;
+        }
+        if (fBytesToSkip == 0) {
+            constexpr size_t kReadSize = 4096;
+            size_t bytesRead;
+            do {
+                const size_t size = fBuffer.size();
+                fBuffer.resize(size + kReadSize);
+                bytesRead = fStream->read(fBuffer.data() + size, kReadSize);
+                fBuffer.resize(size + bytesRead);
+            } while (bytesRead > 0);
+        }
+
+        nextInputByte = fBuffer.data();
+        bytesInBuffer = fBuffer.size();
+    }
+#ifdef SK_CODEC_DECODES_JPEG_GAINMAPS
+    // Gainmaps are found by the decoder that reads the header, never by this one.
+    const std::vector<SkJpegSegment>& getAllSegments() override {
+        static const std::vector<SkJpegSegment> kNoSegments;
+        return kNoSegments;
+    }
+    sk_sp<SkData> getSubsetData(size_t offset, size_t size, bool* wasCopied) override {
+        return nullptr;
+    }
+    sk_sp<SkData> getSegmentParameters(const SkJpegSegment& segment) override { return nullptr; }
+#endif  // SK_CODEC_DECODES_JPEG_GAINMAPS
+
+private:
+    // Everything from where libjpeg last committed to the end of what the stream has received.
+    std::vector<uint8_t> fBuffer;
+
+    // Where libjpeg will resume in fBuffer, if it has suspended since receiveData().
+    size_t fUnreadOffset = 0;
+
+    // How much libjpeg has skipped past the end of fBuffer.
+    size_t fBytesToSkip = 0;
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // SkJpegSourceMgr
 
@@ -434,6 +535,11 @@ std::unique_ptr<SkJpegSourceMgr> SkJpegSourceMgr::Make(SkStream* stream, size_t
     return std::make_unique<SkJpegBufferedSourceMgr>(stream, bufferSize);
 }
 
+std::unique_ptr<SkJpegSourceMgr> SkJpegSourceMgr::makeSuspending(const uint8_t* unread,
+                                                                 size_t size) {
+    return std::make_unique<SkJpegSuspendingSourceMgr>(fStream, unread, size);
+}
+
 SkJpegSourceMgr::SkJpegSourceMgr(SkStream* stream) : fStream(stream) {}
 
 SkJpegSourceMgr::~SkJpegSourceMgr() = default;
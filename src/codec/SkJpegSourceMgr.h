@@ -39,8 +39,17 @@ public:
     // Create a source manager. If the source manager will buffer data, |bufferSize| specifies
     // the size of that buffer.
     static std::unique_ptr<SkJpegSourceMgr> Make(SkStream* stream, size_t bufferSize = 1024);
+
     virtual ~SkJpegSourceMgr();
 
+    // Create a source manager to carry on from where this one has got to, for decoding the rest
+    // of the image as its data arrives. It first hands libjpeg the |size| bytes at |unread|,
+    // which this one has given libjpeg but libjpeg hasn't read yet, then the rest of the stream.
+    // When libjpeg has read everything it was given, it suspends libjpeg rather than failing, and
+    // keeps every byte libjpeg may need to read again when it resumes. Call receiveData() before
+    // resuming.
+    virtual std::unique_ptr<SkJpegSourceMgr> makeSuspending(const uint8_t* unread, size_t size);
+
     // Interface called by libjpeg via its jpeg_source_mgr interface.
     virtual void initSource(const uint8_t*& nextInputByte, size_t& bytesInBuffer) = 0;
     virtual bool fillInputBuffer(const uint8_t*& nextInputByte, size_t& bytesInBuffer) = 0;
@@ -48,6 +57,10 @@ public:
                                 const uint8_t*& nextInputByte,
                                 size_t& bytesInBuffer) = 0;
 
+    // Hand libjpeg everything the stream has received since it last suspended. Only suspending
+    // source managers do anything here; the others read the stream as libjpeg needs it.
+    virtual void receiveData(const uint8_t*& nextInputByte, size_t& bytesInBuffer) {}
+
 #ifdef SK_CODEC_DECODES_JPEG_GAINMAPS
     // Parse this stream all the way through its EndOfImage marker and return the list of segments.
     // Return false if there is an error or if no EndOfImage marker is found.
@@ -24,6 +24,7 @@
 #include "include/private/base/SkTemplates.h"
 #include "modules/skcms/skcms.h"
 #include "src/codec/SkCodecPriv.h"
+#include "src/codec/SkCodecScratch.h"
 #include "src/codec/SkPngCompositeChunkReader.h"
 #include "src/codec/SkPngPriv.h"
 #include "src/codec/SkSwizzler.h"
@@ -70,6 +71,17 @@ void sk_warning_fn(png_structp, png_const_charp msg) {
     SkCodecPrintf("----- png warning %s\n", msg);
 }
 
+#ifdef PNG_USER_MEM_SUPPORTED
+// libpng's memory, zlib's included, from the SkCodecScratch attached when the png_ptr was made.
+static png_voidp sk_malloc_fn(png_structp png_ptr, png_alloc_size_t size) {
+    return static_cast<SkCodecScratch*>(png_get_mem_ptr(png_ptr))->alloc(size);
+}
+
+static void sk_free_fn(png_structp png_ptr, png_voidp ptr) {
+    static_cast<SkCodecScratch*>(png_get_mem_ptr(png_ptr))->free(ptr);
+}
+#endif
+
 #ifdef PNG_READ_UNKNOWN_CHUNKS_SUPPORTED
 static int sk_read_user_chunk(png_structp png_ptr, png_unknown_chunkp chunk) {
     SkPngChunkReader* chunkReader = (SkPngChunkReader*)png_get_user_chunk_ptr(png_ptr);
@@ -148,6 +160,19 @@ static inline bool is_chunk(const png_byte* chunk, const char* tag) {
 
 static inline bool process_data(png_structp png_ptr, png_infop info_ptr,
         SkStream* stream, void* buffer, size_t bufferSize, size_t length) {
+    if (const void* base = stream->getMemoryBase();
+            base && stream->hasPosition() && stream->hasLength()) {
+        // Hand libpng the stream's own memory rather than copying it through buffer. Move past
+        // the bytes first, like read() does, in case libpng longjmps out partway through them.
+        const size_t position = stream->getPosition();
+        const size_t bytesToProcess = std::min(length, stream->getLength() - position);
+        SkAssertResult(stream->skip(bytesToProcess) == bytesToProcess);
+        // libpng doesn't write to the data, despite taking it non-const.
+        png_process_data(png_ptr, info_ptr,
+                         const_cast<png_bytep>(static_cast<const png_byte*>(base) + position),
+                         bytesToProcess);
+        return bytesToProcess == length;
+    }
     while (length > 0) {
         const size_t bytesToProcess = std::min(bufferSize, length);
         const size_t bytesRead = stream->read(buffer, bytesToProcess);
@@ -720,8 +745,17 @@ static SkCodec::Result read_header(SkStream* stream, const sk_sp<SkPngCompositeC
                                    SkCodec** outCodec,
                                    png_structp* png_ptrp, png_infop* info_ptrp) {
     // The image is known to be a PNG. Decode enough to know the SkImageInfo.
-    png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr,
-                                                 sk_error_fn, sk_warning_fn);
+    png_structp png_ptr = nullptr;
+#ifdef PNG_USER_MEM_SUPPORTED
+    if (SkCodecScratch* scratch = SkCodecScratch::Get()) {
+        png_ptr = png_create_read_struct_2(PNG_LIBPNG_VER_STRING, nullptr, sk_error_fn,
+                                           sk_warning_fn, scratch, sk_malloc_fn, sk_free_fn);
+    } else
+#endif
+    {
+        png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, sk_error_fn,
+                                         sk_warning_fn);
+    }
     if (!png_ptr) {
         return SkCodec::kInternalError;
     }
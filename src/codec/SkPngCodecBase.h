@@ -19,6 +19,7 @@
 #include "include/private/SkEncodedInfo.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkTemplates.h"
+#include "src/codec/SkCodecScratch.h"
 
 class SkColorPalette;
 class SkSampler;
@@ -97,7 +98,7 @@ private:
     XformMode fXformMode;
 
     std::unique_ptr<SkSwizzler> fSwizzler;
-    skia_private::AutoTMalloc<uint8_t> fStorage;
+    SkCodecScratchStorage              fStorage;
     int fXformWidth = -1;
     sk_sp<SkColorPalette> fColorTable;
 
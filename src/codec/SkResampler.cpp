@@ -0,0 +1,193 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/codec/SkResampler.h"
+
+#include "include/core/SkSamplingOptions.h"
+#include "include/private/base/SkAssert.h"
+#include "src/base/SkVx.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+// Filters are functions of the distance from the center of an output pixel, in source pixels
+// (before widening for downscales), and are zero at and beyond their support.
+struct Kernel {
+    enum class Type { kBox, kTent, kCubic } fType;
+    SkCubicResampler fCubic;
+
+    float support() const {
+        switch (fType) {
+            case Type::kBox:   return 0.5f;
+            case Type::kTent:  return 1.0f;
+            case Type::kCubic: return 2.0f;
+        }
+        SkUNREACHABLE;
+    }
+
+    float operator()(float x) const {
+        switch (fType) {
+            case Type::kBox:
+                return -0.5f <= x && x < 0.5f ? 1.0f : 0.0f;
+            case Type::kTent:
+                return std::max(0.0f, 1.0f - std::abs(x));
+            case Type::kCubic: {
+                // Mitchell & Netravali, "Reconstruction Filters in Computer Graphics", 1988.
+                const float B = fCubic.B, C = fCubic.C;
+                x = std::abs(x);
+                if (x < 1) {
+                    return ((12 - 9*B - 6*C) * x*x*x + (-18 + 12*B + 6*C) * x*x + (6 - 2*B)) / 6;
+                }
+                if (x < 2) {
+                    return ((-B - 6*C) * x*x*x + (6*B + 30*C) * x*x + (-12*B - 48*C) * x +
+                            (8*B + 24*C)) / 6;
+                }
+                return 0;
+            }
+        }
+        SkUNREACHABLE;
+    }
+};
+
+Kernel choose_kernel(const SkSamplingOptions& sampling) {
+    if (sampling.useCubic) {
+        return {Kernel::Type::kCubic, sampling.cubic};
+    }
+    if (sampling.filter == SkFilterMode::kLinear || sampling.isAniso()) {
+        return {Kernel::Type::kTent, {}};
+    }
+    return {Kernel::Type::kBox, {}};
+}
+
+}  // namespace
+
+SkResampler::Axis SkResampler::MakeAxis(int srcSize, int dstSize,
+                                        const SkSamplingOptions& sampling) {
+    const Kernel kernel = choose_kernel(sampling);
+    const float scale = (float)srcSize / dstSize;
+    const float filterScale = std::max(1.0f, scale);
+    const float radius = kernel.support() * filterScale;
+
+    Axis axis;
+    axis.fOffsets.push_back(0);
+    std::vector<float> taps;
+    for (int i = 0; i < dstSize; i++) {
+        const float center = (i + 0.5f) * scale;
+        const int lo = (int)std::floor(center - radius - 0.5f),
+                  hi = (int)std::ceil(center + radius - 0.5f);
+
+        // Pixels past the edges are clamped to the edges, so their weight goes to the edges.
+        const int first = std::clamp(lo, 0, srcSize - 1),
+                  last  = std::clamp(hi, 0, srcSize - 1);
+        taps.assign(last - first + 1, 0.0f);
+        for (int j = lo; j <= hi; j++) {
+            taps[std::clamp(j, 0, srcSize - 1) - first] += kernel((j + 0.5f - center) / filterScale);
+        }
+
+        // Trim the taps that don't contribute at all.
+        int start = 0, end = (int)taps.size();
+        while (start < end && taps[start] == 0) { start++; }
+        while (end > start && taps[end - 1] == 0) { end--; }
+
+        float sum = 0;
+        for (int t = start; t < end; t++) {
+            sum += taps[t];
+        }
+        if (sum == 0) {
+            // This shouldn't happen with the kernels above, but make sure we never divide by zero.
+            axis.fFirst.push_back(std::clamp((int)center, 0, srcSize - 1));
+            axis.fWeights.push_back(1.0f);
+        } else {
+            axis.fFirst.push_back(first + start);
+            for (int t = start; t < end; t++) {
+                axis.fWeights.push_back(taps[t] / sum);
+            }
+        }
+        axis.fOffsets.push_back((int)axis.fWeights.size());
+        axis.fMaxTaps = std::max(axis.fMaxTaps, axis.taps(i));
+    }
+    return axis;
+}
+
+std::unique_ptr<SkResampler> SkResampler::Make(SkISize src, SkISize dst,
+                                               const SkSamplingOptions& sampling,
+                                               bool premul, bool clampToUnit) {
+    if (src.isEmpty() || dst.isEmpty()) {
+        return nullptr;
+    }
+    Axis x = MakeAxis(src.width(), dst.width(), sampling),
+         y = MakeAxis(src.height(), dst.height(), sampling);
+    return std::unique_ptr<SkResampler>(
+            new SkResampler(src, dst, std::move(x), std::move(y), premul, clampToUnit));
+}
+
+SkResampler::SkResampler(SkISize src, SkISize dst, Axis&& x, Axis&& y,
+                         bool premul, bool clampToUnit)
+        : fSrcSize(src)
+        , fDstSize(dst)
+        , fX(std::move(x))
+        , fY(std::move(y))
+        , fPremul(premul)
+        , fClampToUnit(clampToUnit)
+        , fRing((size_t)fY.fMaxTaps * dst.width() * 4) {}
+
+void SkResampler::addRow(const float* src) {
+    SkASSERT(fRowsAdded < fSrcSize.height());
+    // The slot we're about to reuse had better not be needed by a row we haven't read yet.
+    SkASSERT(fRowsRead == fDstSize.height() ||
+             fY.fFirst[fRowsRead] > fRowsAdded - fY.fMaxTaps);
+
+    float* dst = fRing.data() + (size_t)(fRowsAdded % fY.fMaxTaps) * fDstSize.width() * 4;
+    for (int i = 0; i < fDstSize.width(); i++) {
+        const float* s = src + 4 * fX.fFirst[i];
+        const float* w = fX.weights(i);
+        skvx::float4 sum = 0;
+        for (int t = 0; t < fX.taps(i); t++) {
+            sum += skvx::float4::Load(s + 4 * t) * w[t];
+        }
+        sum.store(dst + 4 * i);
+    }
+    fRowsAdded++;
+}
+
+bool SkResampler::readRow(float* dst) {
+    if (fRowsRead == fDstSize.height()) {
+        return false;
+    }
+    const int first = fY.fFirst[fRowsRead];
+    const int taps = fY.taps(fRowsRead);
+    if (first + taps > fRowsAdded) {
+        return false;
+    }
+
+    const int width = fDstSize.width();
+    const float* w = fY.weights(fRowsRead);
+    memset(dst, 0, (size_t)width * 4 * sizeof(float));
+    for (int t = 0; t < taps; t++) {
+        const float* row = fRing.data() + (size_t)((first + t) % fY.fMaxTaps) * width * 4;
+        for (int i = 0; i < width * 4; i++) {
+            dst[i] += row[i] * w[t];
+        }
+    }
+
+    if (fClampToUnit) {
+        for (int i = 0; i < width; i++) {
+            skvx::float4 px = skvx::pin(skvx::float4::Load(dst + 4 * i),
+                                        skvx::float4(0), skvx::float4(1));
+            if (fPremul) {
+                px = skvx::min(px, px[3]);
+            }
+            px.store(dst + 4 * i);
+        }
+    }
+    fRowsRead++;
+    return true;
+}
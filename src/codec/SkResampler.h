@@ -0,0 +1,85 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkResampler_DEFINED
+#define SkResampler_DEFINED
+
+#include "include/core/SkSize.h"
+
+#include <memory>
+#include <vector>
+
+struct SkSamplingOptions;
+
+/*
+ * Resizes an image one row at a time with a separable filter.
+ *
+ * Rows of the source go in from top to bottom.  Each is filtered horizontally as it arrives and
+ * kept in a ring buffer only as tall as the vertical filter, so no more than a few rows of the
+ * image are ever held at once.  Rows come out as soon as all the source rows they need are in.
+ *
+ * Pixels are RGBA floats.  The filter is chosen from SkSamplingOptions:
+ *     cubic    - the Mitchell-Netravali family of cubics with the given B and C
+ *     linear   - a tent
+ *     nearest  - a box, which is nearest neighbor when upscaling
+ * When downscaling, the filter is widened to cover every source pixel under each output pixel,
+ * so every choice averages rather than aliasing.  Mipmap modes are ignored.
+ */
+class SkResampler {
+public:
+    /*
+     * If clampToUnit, outputs are clamped to [0,1], and premul outputs are also clamped to their
+     * alpha.  That's useful when the source is normalized, and cubics would otherwise overshoot.
+     */
+    static std::unique_ptr<SkResampler> Make(SkISize src, SkISize dst, const SkSamplingOptions&,
+                                             bool premul, bool clampToUnit);
+
+    /*
+     * Adds the next row of the source, src.width() RGBA pixels.  Call readRow() until it returns
+     * false before adding another row.
+     */
+    void addRow(const float* src);
+
+    /*
+     * Writes the next output row, dst.width() RGBA pixels, if every source row it needs has been
+     * added.  Otherwise returns false.
+     */
+    bool readRow(float* dst);
+
+    int rowsAdded() const { return fRowsAdded; }
+    int rowsRead() const { return fRowsRead; }
+
+private:
+    // Describes one axis of the filter: which source pixels each output pixel is made of.
+    struct Axis {
+        std::vector<int>   fFirst;    // The first source pixel of each output pixel.
+        std::vector<int>   fOffsets;  // Output i's weights are [fOffsets[i], fOffsets[i+1]).
+        std::vector<float> fWeights;  // Weights of consecutive source pixels, summing to 1.
+        int                fMaxTaps = 0;
+
+        int taps(int i) const { return fOffsets[i + 1] - fOffsets[i]; }
+        const float* weights(int i) const { return fWeights.data() + fOffsets[i]; }
+    };
+
+    static Axis MakeAxis(int srcSize, int dstSize, const SkSamplingOptions&);
+
+    SkResampler(SkISize src, SkISize dst, Axis&& x, Axis&& y, bool premul, bool clampToUnit);
+
+    const SkISize      fSrcSize;
+    const SkISize      fDstSize;
+    const Axis         fX;
+    const Axis         fY;
+    const bool         fPremul;
+    const bool         fClampToUnit;
+
+    // Horizontally filtered source rows.  Source row y is in slot y % fY.fMaxTaps.
+    std::vector<float> fRing;
+    int                fRowsAdded = 0;
+    int                fRowsRead = 0;
+};
+
+#endif  // SkResampler_DEFINED
@@ -80,7 +80,7 @@ SkCodec::Result SkSampledCodec::onGetAndroidPixels(const SkImageInfo& info, void
         size_t rowBytes, const AndroidOptions& options) {
     const SkIRect* subset = options.fSubset;
     if (!subset || subset->size() == this->codec()->dimensions()) {
-        if (this->codec()->dimensionsSupported(info.dimensions())) {
+        if (this->codec()->dimensionsSupported(info.dimensions()) || options.fResampling) {
             return this->codec()->getPixels(info, pixels, rowBytes, &options);
         }
 
@@ -81,7 +81,42 @@
 #define SK_WUFFS_INITIALIZE_FLAGS WUFFS_INITIALIZE__DEFAULT_OPTIONS
 #endif
 
+// If the whole stream is in memory, returns an io_buffer that reads it in place, rather than
+// copying it into a buffer of our own. Otherwise returns an empty io_buffer.
+static wuffs_base__io_buffer wrap_stream_memory(SkStream* s) {
+    // io_buffer positions are offsets from where we started reading, which only match the
+    // stream's own offsets (used for seeking) if we start at the beginning.
+    if (!s->getMemoryBase() || !s->hasLength() || !s->hasPosition() || s->getPosition() != 0) {
+        return wuffs_base__empty_io_buffer();
+    }
+    // Wuffs only writes to an io_buffer it's reading from if we ask it to compact(), which
+    // fill_buffer() never does to a buffer like this one.
+    uint8_t* base = static_cast<uint8_t*>(const_cast<void*>(s->getMemoryBase()));
+    const size_t length = s->getLength();
+    wuffs_base__io_buffer b = wuffs_base__make_io_buffer(wuffs_base__make_slice_u8(base, length),
+                                                         wuffs_base__empty_io_buffer_meta());
+    b.meta.wi = length;
+    return b;
+}
+
+static bool is_stream_memory(const wuffs_base__io_buffer& b, SkStream* s) {
+    return b.data.ptr && b.data.ptr == s->getMemoryBase();
+}
+
+// Resets b to read s from the beginning. s must already be rewound.
+static void reset_buffer(wuffs_base__io_buffer* b, SkStream* s) {
+    b->meta = wuffs_base__empty_io_buffer_meta();
+    if (is_stream_memory(*b, s)) {
+        b->meta.wi = b->data.len;
+    }
+}
+
 static bool fill_buffer(wuffs_base__io_buffer* b, SkStream* s) {
+    if (is_stream_memory(*b, s)) {
+        // All of it is in the buffer already. There's nothing more to read, and closed stays false
+        // for the same reasons as below.
+        return false;
+    }
     b->compact();
     size_t num_read = s->read(b->data.ptr + b->meta.wi, b->data.len - b->meta.wi);
     b->meta.wi += num_read;
@@ -117,6 +152,10 @@ static bool seek_buffer(wuffs_base__io_buffer* b, SkStream* s, uint64_t pos) {
         b->meta.ri = pos - b->meta.pos;
         return true;
     }
+    if (is_stream_memory(*b, s)) {
+        // The buffer already holds the whole stream.
+        return false;
+    }
     // Seek in the backing SkStream.
     if ((pos > SIZE_MAX) || (!s->seek(pos))) {
         return false;
@@ -333,6 +372,9 @@ private:
     // calling other fDecoder methods.
     bool fDecoderIsSuspended;
 
+    bool fAdvisedWillRead;
+
+    // Holds the input unless fIOBuffer reads the stream's memory in place.
     uint8_t fBuffer[SK_WUFFS_CODEC_BUFFER_SIZE];
 
     const bool fCanSeek;
@@ -415,9 +457,16 @@ SkWuffsCodec::SkWuffsCodec(SkEncodedInfo&& encodedInfo,
         , fNumFullyReceivedFrames(0)
         , fFramesComplete(false)
         , fDecoderIsSuspended(false)
+        , fAdvisedWillRead(false)
         , fCanSeek(canSeek) {
     fFrameHolder.init(this, imgcfg.pixcfg.width(), imgcfg.pixcfg.height());
 
+    if (is_stream_memory(iobuf, fPrivStream.get())) {
+        // iobuf reads the stream's memory in place, which lives as long as we do.
+        fIOBuffer = iobuf;
+        return;
+    }
+
     // Initialize fIOBuffer's fields, copying any outstanding data from iobuf to
     // fIOBuffer, as iobuf's backing array may not be valid for the lifetime of
     // this SkWuffsCodec object, but fIOBuffer's backing array (fBuffer) is.
@@ -464,6 +513,11 @@ SkCodec::Result SkWuffsCodec::onStartIncrementalDecode(const SkImageInfo&      d
     if (options.fSubset) {
         return SkCodec::kUnimplemented;
     }
+    if (!fAdvisedWillRead) {
+        // We don't use SkCodec's stream, so it can't do this for us.
+        SkCodecPriv::AdviseWillRead(fPrivStream.get());
+        fAdvisedWillRead = true;
+    }
     SkCodec::Result result = this->seekFrame(options.fFrameIndex);
     if (result != SkCodec::kSuccess) {
         return result;
@@ -926,7 +980,7 @@ SkCodec::Result SkWuffsCodec::resetDecoder() {
     if (!fPrivStream->rewind()) {
         return SkCodec::kInternalError;
     }
-    fIOBuffer.meta = wuffs_base__empty_io_buffer_meta();
+    reset_buffer(&fIOBuffer, fPrivStream.get());
 
     SkCodec::Result result =
         reset_and_decode_image_config(fDecoder.get(), nullptr, &fIOBuffer, fPrivStream.get());
@@ -1019,9 +1073,12 @@ std::unique_ptr<SkCodec> MakeFromStream(std::unique_ptr<SkStream> stream,
     }
 
     uint8_t               buffer[SK_WUFFS_CODEC_BUFFER_SIZE];
-    wuffs_base__io_buffer iobuf =
-        wuffs_base__make_io_buffer(wuffs_base__make_slice_u8(buffer, SK_WUFFS_CODEC_BUFFER_SIZE),
-                                   wuffs_base__empty_io_buffer_meta());
+    wuffs_base__io_buffer iobuf = wrap_stream_memory(stream.get());
+    if (!iobuf.data.ptr) {
+        iobuf = wuffs_base__make_io_buffer(
+                wuffs_base__make_slice_u8(buffer, SK_WUFFS_CODEC_BUFFER_SIZE),
+                wuffs_base__empty_io_buffer_meta());
+    }
     wuffs_base__image_config imgcfg = wuffs_base__null_image_config();
 
     // Wuffs is primarily a C library, not a C++ one. Furthermore, outside of
@@ -169,7 +169,10 @@ bool SkAnalyticEdge::setLine(const SkPoint& p0, const SkPoint& p1) {
     SkFixed x1 = SkFDot6ToFixed(SkScalarToFDot6(p1.fX * multiplier)) >> accuracy;
     SkFixed y1 = SnapY(SkFDot6ToFixed(SkScalarToFDot6(p1.fY * multiplier)) >> accuracy);
 #endif
+    return this->setFixedLine(x0, y0, x1, y1);
+}
 
+bool SkAnalyticEdge::setFixedLine(SkFixed x0, SkFixed y0, SkFixed x1, SkFixed y1) {
     Winding winding = Winding::kCW;
 
     if (y0 > y1) {
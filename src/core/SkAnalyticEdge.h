@@ -76,6 +76,8 @@ struct SkAnalyticEdge {
     }
 
     bool setLine(const SkPoint& p0, const SkPoint& p1);
+    // Like setLine(), but with the endpoints already converted to fixed point, y snapped.
+    bool setFixedLine(SkFixed x0, SkFixed y0, SkFixed x1, SkFixed y1);
     bool updateLine(SkFixed ax, SkFixed ay, SkFixed bx, SkFixed by, SkFixed slope);
 
     // return true if we're NOT done with this edge
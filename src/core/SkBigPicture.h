@@ -58,6 +58,8 @@ public:
     const SkRecord*     record() const { return fRecord.get(); }
 
 private:
+    friend class SkPictureTileSchedule;  // Replays ops of fRecord itself, with fDrawablePicts.
+
     int drawableCount() const;
     SkPicture const* const* drawablePicts() const;
 
@@ -9,6 +9,7 @@
 
 #include "include/core/SkBitmap.h"
 #include "include/core/SkFourByteTag.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixelRef.h"
@@ -19,11 +20,14 @@
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkMutex.h"
 #include "include/private/chromium/SkDiscardableMemory.h"
+#include "src/base/SkNoDestructor.h"
 #include "src/core/SkMipmap.h"
 #include "src/core/SkNextID.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkTHash.h"
 #include "src/image/SkImage_Base.h"
 
+#include <atomic>
 #include <cstddef>
 #include <utility>
 
@@ -222,6 +226,74 @@ bool SkBitmapCache::Find(const SkBitmapCacheDesc& desc, SkBitmap* result) {
     return SkResourceCache::Find(BitmapKey(desc), SkBitmapCache::Rec::Finder, result);
 }
 
+struct SkBitmapCache::DecodeLock::InFlight {
+    SkMutex fMutex;
+    int     fThreads = 0;  // Holding or waiting for fMutex.  Guarded by in_flight_mutex().
+};
+
+static SkMutex& in_flight_mutex() {
+    static SkNoDestructor<SkMutex> mutex;
+    return *mutex;
+}
+
+// Every desc a DecodeLock is held or waited for.  Guarded by in_flight_mutex().
+static auto& in_flight() {
+    using Map = skia_private::THashMap<SkBitmapCacheDesc, SkBitmapCache::DecodeLock::InFlight*>;
+    static SkNoDestructor<Map> map;
+    return *map;
+}
+
+static std::atomic<size_t> gDecodeCount{0};
+static std::atomic<size_t> gSharedDecodeCount{0};
+
+SkBitmapCache::DecodeLock::DecodeLock(const SkBitmapCacheDesc& desc) : fDesc(desc) {
+    desc.validate();
+    {
+        SkAutoMutexExclusive lock(in_flight_mutex());
+        InFlight** inFlight = in_flight().find(desc);
+        if (!inFlight) {
+            inFlight = in_flight().set(desc, new InFlight);
+        }
+        fInFlight = *inFlight;
+        fWaited = fInFlight->fThreads++ > 0;
+    }
+    fInFlight->fMutex.acquire();
+}
+
+SkBitmapCache::DecodeLock::~DecodeLock() {
+    fInFlight->fMutex.release();
+    SkAutoMutexExclusive lock(in_flight_mutex());
+    if (--fInFlight->fThreads == 0) {
+        in_flight().remove(fDesc);
+        delete fInFlight;
+    }
+}
+
+bool SkBitmapCache::DecodeLock::findAfterWaiting(SkBitmap* result) {
+    if (fWaited && Find(fDesc, result)) {
+        gSharedDecodeCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    gDecodeCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+size_t SkBitmapCache::GetDecodeCount() {
+    return gDecodeCount.load(std::memory_order_relaxed);
+}
+
+size_t SkBitmapCache::GetSharedDecodeCount() {
+    return gSharedDecodeCount.load(std::memory_order_relaxed);
+}
+
+size_t SkGraphics::GetImageDecodeCount() {
+    return SkBitmapCache::GetDecodeCount();
+}
+
+size_t SkGraphics::GetSharedImageDecodeCount() {
+    return SkBitmapCache::GetSharedDecodeCount();
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////
 
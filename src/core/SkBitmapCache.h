@@ -38,6 +38,10 @@ struct SkBitmapCacheDesc {
 
     static SkBitmapCacheDesc Make(const SkImage*);
     static SkBitmapCacheDesc Make(uint32_t genID, const SkIRect& subset);
+
+    bool operator==(const SkBitmapCacheDesc& that) const {
+        return fImageID == that.fImageID && fSubset == that.fSubset;
+    }
 };
 
 class SkBitmapCache {
@@ -55,6 +59,39 @@ public:
     static RecPtr Alloc(const SkBitmapCacheDesc&, const SkImageInfo&, SkPixmap*);
     static void Add(RecPtr, SkBitmap*);
 
+    /**
+     *  Held while making the pixels to Add() for a desc, so that threads that want the same
+     *  pixels at the same time take turns rather than all making them at once.  Whoever waited
+     *  for another thread should look in the cache with findAfterWaiting() before making the
+     *  pixels themselves; if the other thread failed, the next one in line tries instead.
+     */
+    class DecodeLock {
+    public:
+        explicit DecodeLock(const SkBitmapCacheDesc&);
+        ~DecodeLock();
+
+        DecodeLock(const DecodeLock&) = delete;
+        DecodeLock& operator=(const DecodeLock&) = delete;
+
+        /**
+         *  Returns true if another thread made and added these pixels while we waited, setting
+         *  result as Find() would.  Otherwise, we're expected to make them.
+         */
+        bool findAfterWaiting(SkBitmap* result);
+
+        struct InFlight;  // Defined in SkBitmapCache.cpp.
+
+    private:
+        const SkBitmapCacheDesc fDesc;
+        InFlight*               fInFlight;
+        bool                    fWaited;
+    };
+
+    // How many times a DecodeLock's holder made the pixels, and how many times it found another
+    // thread's instead.  See SkGraphics::GetImageDecodeCount().
+    static size_t GetDecodeCount();
+    static size_t GetSharedDecodeCount();
+
 private:
     static void PrivateDeleteRec(Rec*);
 };
@@ -70,6 +70,7 @@ class SkDrawTiler {
     // fTileMatrix... are only used if fNeedTiling
     SkTLazy<SkMatrix> fTileMatrix;
     SkRasterClip      fTileRC;
+    SkIRect           fTileBlitterClip;
     SkIPoint          fOrigin;
 
     bool            fDone, fNeedsTiling;
@@ -121,6 +122,7 @@ public:
         if (fNeedsTiling) {
             // fDraw.fDst and fCTM are reset each time in setupTileDraw()
             fDraw.fRC = &fTileRC;
+            fDraw.fBlitterClip = dev->fBlitterClip ? &fTileBlitterClip : nullptr;
             // we'll step/increase it before using it
             fOrigin.set(fSrcBounds.fLeft - kMaxDim, fSrcBounds.fTop);
         } else {
@@ -128,6 +130,7 @@ public:
             fDraw.fDst = fRootPixmap;
             fDraw.fCTM = &dev->localToDevice();
             fDraw.fRC = &dev->fRCStack.rc();
+            fDraw.fBlitterClip = dev->fBlitterClip ? &*dev->fBlitterClip : nullptr;
             fOrigin.set(0, 0);
         }
 
@@ -183,6 +186,13 @@ private:
         fDraw.fCTM = fTileMatrix.get();
         fDevice->fRCStack.rc().translate(-fOrigin.x(), -fOrigin.y(), &fTileRC);
         fTileRC.op(SkIRect::MakeSize(fDraw.fDst.dimensions()), SkClipOp::kIntersect);
+
+        if (fDevice->fBlitterClip) {
+            fTileBlitterClip = fDevice->fBlitterClip->makeOffset(-fOrigin.x(), -fOrigin.y());
+            if (!fTileBlitterClip.intersect(SkIRect::MakeSize(fDraw.fDst.dimensions()))) {
+                fTileRC.setEmpty();  // nothing we're allowed to touch in this tile
+            }
+        }
     }
 };
 
@@ -207,6 +217,7 @@ public:
         }
         fCTM = &dev->localToDevice();
         fRC = &dev->fRCStack.rc();
+        fBlitterClip = dev->fBlitterClip ? &*dev->fBlitterClip : nullptr;
     }
 };
 
@@ -541,6 +552,16 @@ void SkBitmapDevice::drawMesh(const SkMesh&, sk_sp<SkBlender>, const SkPaint&) {
     // TODO: Implement, maybe with a subclass of BitmapDevice that has SkSL support.
 }
 
+void SkBitmapDevice::drawRectSet(const SkRect rects[], const SkColor4f colors[], int count,
+                                 const SkPaint& paint) {
+    LOOP_TILER( drawRectSet(rects, colors, count, paint), nullptr)
+}
+
+void SkBitmapDevice::drawRRectSet(const SkRRect rrects[], const SkColor4f colors[], int count,
+                                  const SkPaint& paint) {
+    LOOP_TILER( drawRRectSet(rrects, colors, count, paint), nullptr)
+}
+
 void SkBitmapDevice::drawAtlas(const SkRSXform xform[],
                                const SkRect tex[],
                                const SkColor colors[],
@@ -575,6 +596,7 @@ void SkBitmapDevice::drawSpecial(SkSpecialImage* src,
         }
         draw.fCTM = &localToDevice;
         draw.fRC = &fRCStack.rc();
+        draw.fBlitterClip = fBlitterClip ? &*fBlitterClip : nullptr;
         draw.drawBitmap(resultBM, SkMatrix::I(), nullptr, sampling, paint);
     }
 }
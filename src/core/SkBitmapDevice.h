@@ -19,6 +19,7 @@
 #include "src/core/SkRasterClipStack.h"
 
 #include <cstddef>
+#include <optional>
 
 class SkBlender;
 class SkImage;
@@ -82,6 +83,9 @@ public:
     void drawAtlas(const SkRSXform[], const SkRect[], const SkColor[], int count, sk_sp<SkBlender>,
                    const SkPaint&) override;
 
+    void drawRectSet(const SkRect[], const SkColor4f[], int count, const SkPaint&) override;
+    void drawRRectSet(const SkRRect[], const SkColor4f[], int count, const SkPaint&) override;
+
     ///////////////////////////////////////////////////////////////////////////
 
     void pushClipStack() override;
@@ -113,6 +117,15 @@ public:
 
     void* getRasterHandle() const override { return fRasterHandle; }
 
+    /**
+     *  Only touch pixels inside this device-space rectangle.  Unlike a clip, this does not
+     *  change how anything is rasterized, so several devices sharing one set of pixels can each
+     *  draw the same content into their own disjoint rectangle, concurrently, and together
+     *  produce exactly what a single device would have.  Layers created by this device are
+     *  not restricted.
+     */
+    void setBlitterClip(const SkIRect& r) { fBlitterClip = r; }
+
 private:
     friend class SkDraw;
     friend class SkDrawBase;
@@ -141,6 +154,7 @@ private:
     void*       fRasterHandle = nullptr;
     SkRasterClipStack  fRCStack;
     SkGlyphRunListPainterCPU fGlyphPainter;
+    std::optional<SkIRect> fBlitterClip;
 };
 
 #endif // SkBitmapDevice_DEFINED
@@ -35,6 +35,7 @@
 #include "src/core/SkRegionPriv.h"
 #include "src/shaders/SkShaderBase.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <functional>
 #include <optional>
@@ -460,6 +461,119 @@ void SkRectClipBlitter::blitMask(const SkMask& mask, const SkIRect& clip) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void SkExactRectClipBlitter::blitH(int left, int y, int width) {
+    SkASSERT(width > 0);
+
+    if (!y_in_rect(y, fClipRect)) {
+        return;
+    }
+    int right = std::min(left + width, fClipRect.fRight);
+    left = std::max(left, fClipRect.fLeft);
+    if (left < right) {
+        fBlitter->blitH(left, y, right - left);
+    }
+}
+
+void SkExactRectClipBlitter::blitAntiH(int left, int y, const SkAlpha aa[],
+                                       const int16_t runs[]) {
+    if (!y_in_rect(y, fClipRect) || left >= fClipRect.fRight) {
+        return;
+    }
+    const int right = left + compute_anti_width(runs);
+    if (right <= fClipRect.fLeft) {
+        return;
+    }
+    if (left >= fClipRect.fLeft && right <= fClipRect.fRight) {
+        fBlitter->blitAntiH(left, y, aa, runs);
+        return;
+    }
+
+    // Copy out just the runs inside the clip; callers may reuse theirs for the next row.
+    const int x0 = std::max(left, fClipRect.fLeft),
+              x1 = std::min(right, fClipRect.fRight);
+    AutoSTMalloc<64, int16_t> clippedRuns(x1 - x0 + 1);
+    AutoSTMalloc<64, SkAlpha> clippedAA(x1 - x0);
+    for (int x = left; x < x1;) {
+        const int count = runs[0];
+        const int l = std::max(x, x0),
+                  r = std::min(x + count, x1);
+        if (l < r) {
+            clippedRuns[l - x0] = SkToS16(r - l);
+            clippedAA[l - x0] = aa[0];
+        }
+        x += count;
+        runs += count;
+        aa += count;
+    }
+    clippedRuns[x1 - x0] = 0;
+    fBlitter->blitAntiH(x0, y, clippedAA.get(), clippedRuns.get());
+}
+
+void SkExactRectClipBlitter::blitV(int x, int y, int height, SkAlpha alpha) {
+    SkASSERT(height > 0);
+
+    if (!x_in_rect(x, fClipRect)) {
+        return;
+    }
+    int y1 = std::min(y + height, fClipRect.fBottom);
+    y = std::max(y, fClipRect.fTop);
+    if (y < y1) {
+        fBlitter->blitV(x, y, y1 - y, alpha);
+    }
+}
+
+void SkExactRectClipBlitter::blitRect(int left, int y, int width, int height) {
+    SkIRect r = SkIRect::MakeXYWH(left, y, width, height);
+    if (r.intersect(fClipRect)) {
+        fBlitter->blitRect(r.fLeft, r.fTop, r.width(), r.height());
+    }
+}
+
+void SkExactRectClipBlitter::blitAntiRect(int left, int y, int width, int height,
+                                          SkAlpha leftAlpha, SkAlpha rightAlpha) {
+    // The *true* width of the rectangle blitted is width+2:
+    const SkIRect r = SkIRect::MakeLTRB(left, y, left + width + 2, y + height);
+    if (fClipRect.contains(r)) {
+        fBlitter->blitAntiRect(left, y, width, height, leftAlpha, rightAlpha);
+    } else if (SkIRect::Intersects(r, fClipRect)) {
+        // Split it into columns the same way the default SkBlitter::blitAntiRect() does.
+        this->SkBlitter::blitAntiRect(left, y, width, height, leftAlpha, rightAlpha);
+    }
+}
+
+void SkExactRectClipBlitter::blitMask(const SkMask& mask, const SkIRect& clip) {
+    SkASSERT(mask.fBounds.contains(clip));
+
+    SkIRect r = clip;
+    if (r.intersect(fClipRect)) {
+        fBlitter->blitMask(mask, r);
+    }
+}
+
+void SkExactRectClipBlitter::blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) {
+    if (!y_in_rect(y, fClipRect)) {
+        return;
+    }
+    const bool in0 = x_in_rect(x, fClipRect),
+               in1 = x_in_rect(x + 1, fClipRect);
+    if (in0 || in1) {
+        fBlitter->blitAntiH2(x, y, in0 ? a0 : 0, in1 ? a1 : 0);
+    }
+}
+
+void SkExactRectClipBlitter::blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) {
+    if (!x_in_rect(x, fClipRect)) {
+        return;
+    }
+    const bool in0 = y_in_rect(y, fClipRect),
+               in1 = y_in_rect(y + 1, fClipRect);
+    if (in0 || in1) {
+        fBlitter->blitAntiV2(x, y, in0 ? a0 : 0, in1 ? a1 : 0);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void SkRgnClipBlitter::blitH(int x, int y, int width) {
     SkRegion::Spanerator span(*fRgn, y, x, x + width);
     int left, right;
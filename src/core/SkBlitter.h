@@ -84,6 +84,7 @@ public:
     virtual void blitMask(const SkMask&, const SkIRect& clip);
 
     // (x, y), (x + 1, y)
+    // As with blitAntiH(), a pixel given zero coverage must be left untouched.
     virtual void blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) {
         int16_t runs[3];
         uint8_t aa[2];
@@ -206,6 +207,44 @@ private:
     SkIRect     fClipRect;
 };
 
+/** Like SkRectClipBlitter, but everything inside the clip is passed on to the real blitter
+    exactly as it would have been without the clip: the same entry point, and with the caller's
+    runs left untouched.  Blitters' entry points can round slightly differently from each other,
+    so this is what makes drawing through disjoint clipped blitters bit-identical to drawing
+    through the real blitter alone.  This relies on blitters leaving any pixel they're given
+    zero coverage for untouched.
+*/
+class SkExactRectClipBlitter final : public SkBlitter {
+public:
+    void init(SkBlitter* blitter, const SkIRect& clipRect) {
+        SkASSERT(!clipRect.isEmpty());
+        fBlitter = blitter;
+        fClipRect = clipRect;
+    }
+
+    void blitH(int x, int y, int width) override;
+    void blitAntiH(int x, int y, const SkAlpha[], const int16_t runs[]) override;
+    void blitV(int x, int y, int height, SkAlpha alpha) override;
+    void blitRect(int x, int y, int width, int height) override;
+    void blitAntiRect(int x, int y, int width, int height,
+                      SkAlpha leftAlpha, SkAlpha rightAlpha) override;
+    void blitMask(const SkMask&, const SkIRect& clip) override;
+    void blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) override;
+    void blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) override;
+
+    int requestRowsPreserved() const override {
+        return fBlitter->requestRowsPreserved();
+    }
+
+    void* allocBlitMemory(size_t sz) override {
+        return fBlitter->allocBlitMemory(sz);
+    }
+
+private:
+    SkBlitter*  fBlitter;
+    SkIRect     fClipRect;
+};
+
 /** Wraps another (real) blitter, and ensures that the real blitter is only
     called with coordinates that have been clipped by the specified clipRgn.
     This means the caller need not perform the clipping ahead of time.
@@ -13,6 +13,7 @@
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkMaskFilter.h"
 #include "include/core/SkMatrix.h"
+#include "include/core/SkRRect.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkShader.h"
@@ -20,6 +21,7 @@
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkAutoMalloc.h"
+#include "src/core/SkDevice.h"
 #include "src/core/SkMaskFilterBase.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkWriteBuffer.h"
@@ -159,6 +161,60 @@ bool SkCanvasPriv::ImageToColorFilter(SkPaint* paint) {
     return true;
 }
 
+// Sets of shapes go straight to the top device only when it has pixels, so canvases that record
+// or forward their draws see each shape, and when no layer is needed to filter them.
+static bool can_draw_shape_set(SkCanvas* canvas, const SkPaint& paint) {
+    return !SkCanvasPriv::TopDevice(canvas)->isNoPixelsDevice() &&
+           !paint.getImageFilter() && !paint.getMaskFilter() && !paint.getPathEffect() &&
+           paint.getStyle() == SkPaint::kFill_Style;
+}
+
+void SkCanvasPriv::DrawRectSet(SkCanvas* canvas, const SkRect rects[], const SkColor4f colors[],
+                               int count, const SkPaint& paint) {
+    if (!can_draw_shape_set(canvas, paint)) {
+        SkPaint p(paint);
+        for (int i = 0; i < count; ++i) {
+            p.setColor4f(colors[i]);
+            canvas->drawRect(rects[i], p);
+        }
+        return;
+    }
+
+    SkRect bounds = SkRect::MakeEmpty();
+    for (int i = 0; i < count; ++i) {
+        bounds.join(rects[i].makeSorted());
+    }
+    if (canvas->internalQuickReject(bounds, paint)) {
+        return;
+    }
+    if (auto layer = canvas->aboutToDraw(paint, &bounds)) {
+        canvas->topDevice()->drawRectSet(rects, colors, count, layer->paint());
+    }
+}
+
+void SkCanvasPriv::DrawRRectSet(SkCanvas* canvas, const SkRRect rrects[], const SkColor4f colors[],
+                                int count, const SkPaint& paint) {
+    if (!can_draw_shape_set(canvas, paint)) {
+        SkPaint p(paint);
+        for (int i = 0; i < count; ++i) {
+            p.setColor4f(colors[i]);
+            canvas->drawRRect(rrects[i], p);
+        }
+        return;
+    }
+
+    SkRect bounds = SkRect::MakeEmpty();
+    for (int i = 0; i < count; ++i) {
+        bounds.join(rrects[i].getBounds());
+    }
+    if (canvas->internalQuickReject(bounds, paint)) {
+        return;
+    }
+    if (auto layer = canvas->aboutToDraw(paint, &bounds)) {
+        canvas->topDevice()->drawRRectSet(rrects, colors, count, layer->paint());
+    }
+}
+
 AutoLayerForImageFilter::AutoLayerForImageFilter(SkCanvas* canvas,
                                                  const SkPaint& paint,
                                                  const SkRect* rawBounds,
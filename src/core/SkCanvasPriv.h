@@ -22,6 +22,7 @@ class SkDevice;
 class SkImageFilter;
 class SkMatrix;
 class SkReadBuffer;
+class SkRRect;
 struct SkRect;
 class SkWriteBuffer;
 
@@ -103,6 +104,15 @@ public:
     // Returns true if the paint has been modified.
     // Requires the paint to have an image filter and the copy-on-write be initialized.
     static bool ImageToColorFilter(SkPaint*);
+
+    // Draws each rect (or rrect) as if by drawRect() (or drawRRect()), with the paint's color
+    // replaced by the entry's color.  Raster devices draw solid color sets that need the raster
+    // pipeline in one pass with a shared blitter, pixel for pixel as the separate draws would.
+    // Canvases without pixels (e.g. recorders) get one draw call per entry.
+    static void DrawRectSet(SkCanvas*, const SkRect[], const SkColor4f[], int count,
+                            const SkPaint&);
+    static void DrawRRectSet(SkCanvas*, const SkRRect[], const SkColor4f[], int count,
+                             const SkPaint&);
 };
 
 /**
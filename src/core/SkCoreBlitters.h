@@ -23,6 +23,7 @@
 class SkArenaAlloc;
 class SkMatrix;
 class SkRasterPipeline;
+class SkRasterPipelineBlitter;
 class SkShader;
 class SkSurfaceProps;
 struct SkIRect;
@@ -126,4 +127,25 @@ SkBlitter* SkCreateRasterPipelineBlitter(const SkPixmap&, const SkPaint&,
                                          bool shader_is_opaque,
                                          SkArenaAlloc*, sk_sp<SkShader> clipShader);
 
+// Raster pipeline blitters for drawing many solid colors with one paint.  Rather than building a
+// blitter per color, each blitter is recolored between blits, yet blits exactly what the blitter
+// SkCreateRasterPipelineBlitter() makes for the paint with that color would.  The paint must
+// have no shader or color filter, and its blender must be a blend mode.
+class SkRasterPipelineColorBlitters {
+public:
+    SkRasterPipelineColorBlitters(const SkPixmap& dst, const SkPaint&, SkArenaAlloc*,
+                                  sk_sp<SkShader> clipShader);
+
+    // Returns a blitter set to draw this unpremul color, already in the dst's color space, until
+    // the next call.  Colors that need different pipelines get different blitters.
+    SkBlitter* blitterFor(const SkColor4f& dstColor);
+
+private:
+    const SkPixmap           fDst;
+    const SkPaint            fPaint;
+    SkArenaAlloc*            fAlloc;
+    const sk_sp<SkShader>    fClipShader;
+    SkRasterPipelineBlitter* fBlitters[8] = {};  // Indexed by color op and opacity.
+};
+
 #endif
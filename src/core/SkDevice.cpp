@@ -233,6 +233,24 @@ void SkDevice::drawAtlas(const SkRSXform xform[],
     this->drawVertices(builder.detach().get(), std::move(blender), paint);
 }
 
+void SkDevice::drawRectSet(const SkRect rects[], const SkColor4f colors[], int count,
+                           const SkPaint& paint) {
+    SkPaint p(paint);
+    for (int i = 0; i < count; ++i) {
+        p.setColor4f(colors[i]);
+        this->drawRect(rects[i], p);
+    }
+}
+
+void SkDevice::drawRRectSet(const SkRRect rrects[], const SkColor4f colors[], int count,
+                            const SkPaint& paint) {
+    SkPaint p(paint);
+    for (int i = 0; i < count; ++i) {
+        p.setColor4f(colors[i]);
+        this->drawRRect(rrects[i], p);
+    }
+}
+
 void SkDevice::drawEdgeAAQuad(const SkRect& r, const SkPoint clip[4], SkCanvas::QuadAAFlags aa,
                               const SkColor4f& color, SkBlendMode mode) {
     SkPaint paint;
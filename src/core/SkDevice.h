@@ -395,6 +395,11 @@ public:
     virtual void drawAtlas(const SkRSXform[], const SkRect[], const SkColor[], int count,
                            sk_sp<SkBlender>, const SkPaint&);
 
+    // Default impl calls drawRect() (or drawRRect()) for each entry, with the paint's color
+    // replaced by the entry's color.
+    virtual void drawRectSet(const SkRect[], const SkColor4f[], int count, const SkPaint&);
+    virtual void drawRRectSet(const SkRRect[], const SkColor4f[], int count, const SkPaint&);
+
     virtual void drawAnnotation(const SkRect&, const char[], SkData*) {}
 
     // Default impl always calls drawRect() with a solid-color paint, setting it to anti-aliased
@@ -26,6 +26,7 @@ class SkGlyph;
 class SkGlyphRunListPainterCPU;
 class SkMatrix;
 class SkPaint;
+class SkRRect;
 class SkVertices;
 namespace sktext { class GlyphRunList; }
 struct SkPoint3;
@@ -60,12 +61,20 @@ public:
     void drawAtlas(const SkRSXform[], const SkRect[], const SkColor[], int count,
                    sk_sp<SkBlender>, const SkPaint&);
 
+    /* Draws each rect (or rrect) filled with its own color, as if by drawRect() (or drawRRect())
+       with the paint's color replaced.  Solid color fills are drawn in one sweep down the rows
+       they cover, recoloring shared blitters; anything else is drawn one shape at a time. */
+    void drawRectSet(const SkRect[], const SkColor4f[], int count, const SkPaint&) const;
+    void drawRRectSet(const SkRRect[], const SkColor4f[], int count, const SkPaint&) const;
+
 #if defined(SK_SUPPORT_LEGACY_ALPHA_BITMAP_AS_COVERAGE)
     void drawDevMask(const SkMask& mask, const SkPaint&) const;
     void drawBitmapAsMask(const SkBitmap&, const SkSamplingOptions&, const SkPaint&) const;
 #endif
 
 private:
+    void drawShapeSet(const SkRect[], const SkRRect[], const SkColor4f[], int count,
+                      const SkPaint&) const;
     void drawFixedVertices(const SkVertices* vertices,
                            sk_sp<SkBlender> blender,
                            const SkPaint& paint,
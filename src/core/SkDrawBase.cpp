@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkGraphics.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
@@ -22,10 +23,12 @@
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkTemplates.h"
+#include "src/base/SkArenaAlloc.h"
 #include "src/base/SkTLazy.h"
 #include "src/base/SkZip.h"
 #include "src/core/SkAutoBlitterChoose.h"
 #include "src/core/SkBlendModePriv.h"
+#include "src/core/SkBlitter.h"
 #include "src/core/SkBlitter_A8.h"
 #include "src/core/SkDevice.h"
 #include "src/core/SkDrawBase.h"
@@ -37,6 +40,7 @@
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkRectPriv.h"
 #include "src/core/SkScan.h"
+#include "src/core/SkSurfacePriv.h"
 
 #include <algorithm>
 #include <cstddef>
@@ -53,6 +57,15 @@ using namespace skia_private;
 
 SkDrawBase::SkDrawBase() {}
 
+SkBlitter* SkDrawBase::clipBlitter(SkBlitter* blitter, SkArenaAlloc* alloc) const {
+    if (!blitter || !fBlitterClip) {
+        return blitter;
+    }
+    auto clipped = alloc->make<SkExactRectClipBlitter>();
+    clipped->init(blitter, *fBlitterClip);
+    return clipped;
+}
+
 bool SkDrawBase::computeConservativeLocalClipBounds(SkRect* localBounds) const {
     if (fRC->isEmpty()) {
         return false;
@@ -331,6 +344,21 @@ void SkDrawBase::drawDevPath(const SkPath& devPath,
     if (SkPathPriv::TooBigForMath(devPath)) {
         return;
     }
+
+    // Large antialiased fills may be split into bands drawn concurrently, each with its own blitter.
+    SkExecutor* executor = SkGraphics::GetPathRasterExecutor();
+    if (executor && doFill && paint.isAntiAlias() && !customBlitter && !paint.getMaskFilter()) {
+        auto makeBlitter = [&](SkArenaAlloc* alloc) {
+            SkBlitter* blitter = fBlitterChooser(fDst, *fCTM, paint, alloc, drawCoverage,
+                                                 fRC->clipShader(),
+                                                 SkSurfacePropsCopyOrDefault(fProps));
+            return this->clipBlitter(blitter, alloc);
+        };
+        if (SkScan::AntiFillPathInBands(devPath, *fRC, *executor, makeBlitter)) {
+            return;
+        }
+    }
+
     SkBlitter* blitter = nullptr;
     SkAutoBlitterChoose blitterStorage;
     if (nullptr == customBlitter) {
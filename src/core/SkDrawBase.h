@@ -120,6 +120,12 @@ public:
                                       sk_sp<SkShader> clipShader,
                                       const SkSurfaceProps&);
 
+    /**
+     *  If fBlitterClip is set, wrap blitter so that it only writes inside that rectangle.
+     *  The wrapper is allocated from alloc.  Otherwise, returns blitter unchanged.
+     */
+    SkBlitter* clipBlitter(SkBlitter* blitter, SkArenaAlloc* alloc) const;
+
 private:
     // not supported
     void paintMasks(SkZip<const SkGlyph*, SkPoint> accepted, const SkPaint& paint) const override;
@@ -156,6 +162,10 @@ public:
     const SkMatrix*         fCTM{nullptr};             // required
     const SkRasterClip*     fRC{nullptr};              // required
     const SkSurfaceProps*   fProps{nullptr};           // optional
+    // Unlike fRC, this doesn't affect how geometry is scan converted; it only limits which
+    // pixels the blitters may touch, so disjoint rectangles of one draw can be rasterized
+    // independently with exactly the same results as rasterizing it all at once.
+    const SkIRect*          fBlitterClip{nullptr};     // optional
 
 #ifdef SK_DEBUG
     void validate() const;
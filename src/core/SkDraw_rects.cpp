@@ -0,0 +1,672 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkAlphaType.h"
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkRect.h"
+#include "include/private/base/SkFixed.h"
+#include "include/private/base/SkTPin.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkColorPriv.h"
+#include "src/core/SkColorSpacePriv.h"
+#include "src/core/SkColorSpaceXformSteps.h"
+#include "src/core/SkCoreBlitters.h"
+#include "src/core/SkDraw.h"
+#include "src/core/SkEdge.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkRasterClip.h"
+#include "src/core/SkScan.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/*
+ *  A batch of solid color rects or rrects is drawn in one sweep down the device, sharing the
+ *  blitters and clip, with each instance's color written into its blitter's pipeline before its
+ *  pixels are blitted.
+ *
+ *  The shapes are sorted by their top row, and the sweep steps through bands of rows short enough
+ *  that a band of the device stays in cache while every shape that crosses it is blitted.  Shapes
+ *  are blitted in batch order within each band, so each pixel is blended in the same order as if
+ *  the shapes had been drawn one at a time.
+ *
+ *  Antialiased rects are covered exactly as SkScan::AntiFillRect() covers them.  Rrects are
+ *  filled by the path filler, as drawRRect() fills them.  Where an rrect crosses more than one
+ *  band, it's filled once into a recording whose calls are replayed band by band, clipped to the
+ *  band's rows.  Only the rows between the corners of non-antialiased rrects are blitted directly,
+ *  rounded as the path filler rounds the straight sides.
+ */
+
+namespace {
+
+using FDot8 = int;  // 24.8 integer fixed point, as in SkScan_Antihair.cpp.
+
+FDot8 to_fdot8(float x) {
+    return (SkScalarToFixed(x) + 0x80) >> 8;
+}
+
+constexpr size_t kBandBytes = 128 * 1024;  // About how much of the device to sweep at once.
+constexpr int    kMaxRuns   = 100;  // Longest run we hand blitAntiH(), as in SkScan_Antihair.cpp.
+
+void blit_hline(SkBlitter* blitter, int x, int y, int count, U8CPU alpha) {
+    int16_t runs[kMaxRuns + 1];
+    uint8_t aa[kMaxRuns];
+    while (count > 0) {
+        // Some clipping blitters modify runs and aa in place, so we set them up every time.
+        const int n = std::min(count, kMaxRuns);
+        aa[0] = SkToU8(alpha);
+        runs[0] = SkToS16(n);
+        runs[n] = 0;
+        blitter->blitAntiH(x, y, aa, runs);
+        x += n;
+        count -= n;
+    }
+}
+
+// One row of an antialiased rect, covered by alpha (in 1/256ths) vertically.
+void blit_aa_row(SkBlitter* blitter, FDot8 L, int y, FDot8 R, U8CPU alpha) {
+    if ((L >> 8) == ((R - 1) >> 8)) {
+        blitter->blitV(L >> 8, y, 1, SkAlphaMul(alpha, R - L));
+        return;
+    }
+    int left = L >> 8;
+    if (L & 0xFF) {
+        blitter->blitV(left, y, 1, SkAlphaMul(alpha, 256 - (L & 0xFF)));
+        left += 1;
+    }
+    const int rite = R >> 8;
+    if (rite > left) {
+        blit_hline(blitter, left, y, rite - left, alpha);
+    }
+    if (R & 0xFF) {
+        blitter->blitV(rite, y, 1, SkAlphaMul(alpha, R & 0xFF));
+    }
+}
+
+// Rows fully covered vertically, with antialiased left and right edges.
+void blit_aa_rows(SkBlitter* blitter, FDot8 L, int y, FDot8 R, int height) {
+    int left = L >> 8;
+    if (left == ((R - 1) >> 8)) {
+        blitter->blitV(left, y, height, R - L - 1);
+        return;
+    }
+    if (L & 0xFF) {
+        blitter->blitV(left, y, height, 256 - (L & 0xFF));
+        left += 1;
+    }
+    const int rite = R >> 8;
+    if (rite > left) {
+        blitter->blitRect(left, y, rite - left, height);
+    }
+    if (R & 0xFF) {
+        blitter->blitV(rite, y, height, R & 0xFF);
+    }
+}
+
+// Records what the path filler blits, so that a path crossing several bands is filled once and
+// each band replays the calls that touch its rows, in the order the filler made them.
+class FillRecorder final : public SkBlitter {
+public:
+    explicit FillRecorder(SkBlitter* blitter) : fBlitter(blitter) {}
+
+    void blitH(int x, int y, int width) override { this->push(Op::kH, x, y, width, 1); }
+
+    void blitAntiH(int x, int y, const SkAlpha aa[], const int16_t runs[]) override {
+        Op& op = this->push(Op::kAntiH, x, y, 0, 1);
+        op.fData = fRuns.size();
+        for (int n; (n = runs[0]) > 0; runs += n, aa += n) {
+            fRuns.push_back({SkToS16(n), aa[0]});
+            op.fWidth += n;
+        }
+    }
+
+    void blitV(int x, int y, int height, SkAlpha alpha) override {
+        this->push(Op::kV, x, y, 1, height).fA0 = alpha;
+    }
+
+    void blitRect(int x, int y, int width, int height) override {
+        this->push(Op::kRect, x, y, width, height);
+    }
+
+    void blitAntiRect(int x, int y, int width, int height,
+                      SkAlpha leftAlpha, SkAlpha rightAlpha) override {
+        Op& op = this->push(Op::kAntiRect, x, y, width, height);
+        op.fA0 = leftAlpha;
+        op.fA1 = rightAlpha;
+    }
+
+    void blitMask(const SkMask& mask, const SkIRect& clip) override {
+        SkASSERT(mask.fFormat != SkMask::k3D_Format && mask.fBounds.contains(clip));
+        Op& op = this->push(Op::kMask, clip.fLeft, clip.fTop, clip.width(), clip.height());
+        op.fMaskLeft  = mask.fBounds.fLeft;
+        op.fMaskRight = mask.fBounds.fRight;
+        op.fRowBytes  = mask.fRowBytes;
+        op.fFormat    = mask.fFormat;
+        // Just the clipped rows, which the replayed mask's bounds start at.
+        op.fData = fBytes.size();
+        const uint8_t* rows = mask.fImage +
+                              (size_t)(clip.fTop - mask.fBounds.fTop) * mask.fRowBytes;
+        fBytes.insert(fBytes.end(), rows, rows + (size_t)clip.height() * mask.fRowBytes);
+    }
+
+    void blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) override {
+        Op& op = this->push(Op::kAntiH2, x, y, 2, 1);
+        op.fA0 = SkToU8(a0);
+        op.fA1 = SkToU8(a1);
+    }
+
+    void blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) override {
+        Op& op = this->push(Op::kAntiV2, x, y, 1, 2);
+        op.fA0 = SkToU8(a0);
+        op.fA1 = SkToU8(a1);
+    }
+
+    // The filler buffers as many rows as the blitter it would have blitted to asks it to.
+    int requestRowsPreserved() const override { return fBlitter->requestRowsPreserved(); }
+
+    // Blits the recorded calls to blitter, clipped to rows [top, bottom).  Rows above top may
+    // not be replayed after this.
+    void replay(SkBlitter* blitter, int left, int top, int right, int bottom) {
+        SkExactRectClipBlitter rows;
+        rows.init(blitter, {left, top, right, bottom});
+        while (fNext < fOps.size() && fOps[fNext].fY + fOps[fNext].fHeight <= top) {
+            fNext++;
+        }
+        for (size_t i = fNext; i < fOps.size(); i++) {
+            const Op& op = fOps[i];
+            if (op.fY >= bottom) {
+                if (fSorted) {
+                    break;
+                }
+                continue;
+            }
+            if (op.fY + op.fHeight <= top) {
+                continue;
+            }
+            switch (op.fKind) {
+                case Op::kH:
+                    rows.blitH(op.fX, op.fY, op.fWidth);
+                    break;
+                case Op::kAntiH: {
+                    // The clipping blitter may modify runs and aa in place, so they're rebuilt.
+                    fScratchRuns.resize(op.fWidth + 1);
+                    fScratchAA.resize(op.fWidth + 1);
+                    size_t r = op.fData;
+                    for (int x = 0; x < op.fWidth; r++) {
+                        fScratchRuns[x] = fRuns[r].fCount;
+                        fScratchAA[x] = fRuns[r].fAlpha;
+                        x += fRuns[r].fCount;
+                    }
+                    fScratchRuns[op.fWidth] = 0;
+                    rows.blitAntiH(op.fX, op.fY, fScratchAA.data(), fScratchRuns.data());
+                    break;
+                }
+                case Op::kV:
+                    rows.blitV(op.fX, op.fY, op.fHeight, op.fA0);
+                    break;
+                case Op::kRect:
+                    rows.blitRect(op.fX, op.fY, op.fWidth, op.fHeight);
+                    break;
+                case Op::kAntiRect:
+                    rows.blitAntiRect(op.fX, op.fY, op.fWidth, op.fHeight, op.fA0, op.fA1);
+                    break;
+                case Op::kMask: {
+                    const SkIRect clip = SkIRect::MakeXYWH(op.fX, op.fY, op.fWidth, op.fHeight);
+                    const SkMask mask(fBytes.data() + op.fData,
+                                      {op.fMaskLeft, clip.fTop, op.fMaskRight, clip.fBottom},
+                                      op.fRowBytes, op.fFormat);
+                    rows.blitMask(mask, clip);
+                    break;
+                }
+                case Op::kAntiH2:
+                    rows.blitAntiH2(op.fX, op.fY, op.fA0, op.fA1);
+                    break;
+                case Op::kAntiV2:
+                    rows.blitAntiV2(op.fX, op.fY, op.fA0, op.fA1);
+                    break;
+            }
+        }
+    }
+
+private:
+    struct Op {
+        enum Kind : uint8_t { kH, kAntiH, kV, kRect, kAntiRect, kMask, kAntiH2, kAntiV2 };
+
+        Kind           fKind;
+        uint8_t        fA0, fA1;
+        SkMask::Format fFormat;                // For kMask.
+        int            fX, fY, fWidth, fHeight;  // The pixels blitted, or the clip of a mask.
+        int            fMaskLeft, fMaskRight;    // For kMask.
+        uint32_t       fRowBytes;              // For kMask.
+        size_t         fData;                  // Index of kAntiH's runs, or kMask's image.
+    };
+    struct Run {
+        int16_t fCount;
+        SkAlpha fAlpha;
+    };
+
+    Op& push(Op::Kind kind, int x, int y, int width, int height) {
+        fSorted = fSorted && (fOps.empty() || fOps.back().fY <= y);
+        Op& op = fOps.emplace_back();
+        op.fKind = kind;
+        op.fX = x;
+        op.fY = y;
+        op.fWidth = width;
+        op.fHeight = height;
+        return op;
+    }
+
+    SkBlitter* const     fBlitter;
+    std::vector<Op>      fOps;
+    std::vector<Run>     fRuns;
+    std::vector<uint8_t> fBytes;
+    bool                 fSorted = true;  // Whether fOps are in order of their top rows.
+    size_t               fNext = 0;       // The first op that may touch rows yet to be replayed.
+    std::vector<int16_t> fScratchRuns;
+    std::vector<SkAlpha> fScratchAA;
+};
+
+// A rect or rrect of the batch, in device space and inside the clip bounds.  The rows it touches
+// are [fTop, fBottom).  Rows [fInnerTop, fInnerBottom) are covered the same way, with vertical
+// left and right edges at fL and fR.  Rows outside them are each covered differently, and those
+// of rrects are filled by the path filler.
+struct Shape {
+    FDot8 fL, fR;           // Pixels, not FDot8, if not antialiased.
+    FDot8 fT, fB;           // Only used by antialiased rects.
+    int   fTop, fBottom;
+    int   fInnerTop, fInnerBottom;
+    int   fIndex;           // Into the batch, and the order shapes are blended in.
+};
+
+class RectSetSweep {
+public:
+    RectSetSweep(const SkRasterClip& clip, const SkIRect& bounds, bool antiAlias, int bandRows)
+            : fClip(clip)
+            , fBounds(bounds)
+            , fAntiAlias(antiAlias)
+            , fBandRows(bandRows)
+            , fStartsAt((bounds.height() + bandRows - 1) / bandRows + 1, 0) {}
+
+    void addRect(const SkRect& devRect, int index);
+    // The rrect's path, mapped to the device as drawRRect() maps it.
+    void addRRect(const SkRRect& devRRect, SkPath devPath, int index);
+
+    // Blits each shape with the blitters returned by setColor(index), for the shape at that index
+    // of the batch: the first for the path filler, which clips it itself, and the second that
+    // blitter clipped to the clip.  Shapes for which it returns nulls are skipped.
+    template <typename SetColor>
+    void draw(SetColor&& setColor);
+
+private:
+    void addShape(const Shape& shape, SkPath* devPath);
+    void blitShapeRows(SkBlitter* pathBlitter, SkBlitter*, int shape, int top, int bottom);
+    void blitEdgeRow(SkBlitter*, const Shape&, int y);
+    void fillPath(SkBlitter*, const SkPath& devPath);
+    void fillPathRows(SkBlitter*, int shape, int top, int bottom);
+
+    const SkRasterClip&   fClip;
+    const SkIRect         fBounds;
+    const bool            fAntiAlias;
+    const int             fBandRows;
+    std::vector<Shape>    fShapes;
+    std::vector<SkPath>   fPaths;     // Parallel to fShapes, if this is a batch of rrects.
+    // Parallel to fPaths, the path's fill while it's being blitted over more than one call.
+    std::vector<std::unique_ptr<FillRecorder>> fFills;
+    std::vector<int>      fStartsAt;  // How many shapes start in each band, then prefix sums.
+};
+
+void RectSetSweep::addShape(const Shape& shape, SkPath* devPath) {
+    SkASSERT(fBounds.fTop <= shape.fTop && shape.fTop < shape.fBottom &&
+             shape.fBottom <= fBounds.fBottom);
+    SkASSERT(shape.fTop <= shape.fInnerTop && shape.fInnerBottom <= shape.fBottom);
+    fShapes.push_back(shape);
+    if (devPath) {
+        fPaths.push_back(std::move(*devPath));
+        fFills.emplace_back();
+    }
+    fStartsAt[(shape.fTop - fBounds.fTop) / fBandRows]++;
+}
+
+void RectSetSweep::addRect(const SkRect& devRect, int index) {
+    SkRect r;
+    if (!r.intersect(devRect, SkRect::Make(fBounds))) {
+        return;
+    }
+    Shape shape;
+    shape.fIndex = index;
+    if (fAntiAlias) {
+        shape.fL = to_fdot8(r.fLeft);
+        shape.fT = to_fdot8(r.fTop);
+        shape.fR = to_fdot8(r.fRight);
+        shape.fB = to_fdot8(r.fBottom);
+        if (shape.fL >= shape.fR || shape.fT >= shape.fB) {
+            return;
+        }
+        shape.fTop    = shape.fT >> 8;
+        shape.fBottom = (shape.fB + 0xFF) >> 8;
+        if (shape.fTop == ((shape.fB - 1) >> 8)) {
+            // Just one row, covered by the rect's height.
+            shape.fInnerTop = shape.fInnerBottom = shape.fTop;
+        } else {
+            shape.fInnerTop    = (shape.fT + 0xFF) >> 8;
+            shape.fInnerBottom = shape.fB >> 8;
+        }
+    } else {
+        const SkIRect ir = r.round();
+        if (ir.isEmpty()) {
+            return;
+        }
+        shape.fL = ir.fLeft;
+        shape.fR = ir.fRight;
+        shape.fT = shape.fB = 0;
+        shape.fTop    = shape.fInnerTop    = ir.fTop;
+        shape.fBottom = shape.fInnerBottom = ir.fBottom;
+    }
+    this->addShape(shape, nullptr);
+}
+
+void RectSetSweep::addRRect(const SkRRect& devRRect, SkPath devPath, int index) {
+    // The path's points bound it, so its sides are where the path filler sees them.
+    const SkRect r = devPath.getBounds();
+    const float left  = std::max(r.fLeft,  (float)fBounds.fLeft),
+                right = std::min(r.fRight, (float)fBounds.fRight);
+    if (left >= right) {
+        return;
+    }
+    Shape shape;
+    shape.fIndex = index;
+    shape.fL = shape.fR = shape.fT = shape.fB = 0;
+    shape.fTop    = (int)SkTPin(std::floor(r.fTop),   (float)fBounds.fTop, (float)fBounds.fBottom);
+    shape.fBottom = (int)SkTPin(std::ceil(r.fBottom), (float)fBounds.fTop, (float)fBounds.fBottom);
+    if (shape.fTop >= shape.fBottom) {
+        return;
+    }
+    shape.fInnerTop = shape.fInnerBottom = shape.fTop;
+
+    // Without antialiasing, rows wholly between the corners are covered by the sides alone,
+    // rounded to pixels as SkEdge rounds them.  Antialiased sides are covered differently
+    // depending on how the path filler goes about it, so it fills every row of those.
+    SkEdge leftEdge, rightEdge;
+    const float cornersTop = r.fTop + std::max(devRRect.radii(SkRRect::kUpperLeft_Corner).fY,
+                                               devRRect.radii(SkRRect::kUpperRight_Corner).fY),
+                cornersBottom = r.fBottom - std::max(
+                        devRRect.radii(SkRRect::kLowerLeft_Corner).fY,
+                        devRRect.radii(SkRRect::kLowerRight_Corner).fY);
+    const int innerTop    = (int)SkTPin(std::ceil(cornersTop),
+                                        (float)shape.fTop, (float)shape.fBottom),
+              innerBottom = (int)SkTPin(std::floor(cornersBottom),
+                                        (float)shape.fTop, (float)shape.fBottom);
+    if (!fAntiAlias && innerTop < innerBottom &&
+        leftEdge.setLine({left, r.fTop}, {left, r.fBottom}, nullptr, 0) &&
+        rightEdge.setLine({right, r.fTop}, {right, r.fBottom}, nullptr, 0)) {
+        shape.fL = SkFixedRoundToInt(leftEdge.fX);
+        shape.fR = SkFixedRoundToInt(rightEdge.fX);
+        if (shape.fL < shape.fR) {
+            shape.fInnerTop    = innerTop;
+            shape.fInnerBottom = innerBottom;
+        }
+    }
+    this->addShape(shape, &devPath);
+}
+
+void RectSetSweep::fillPath(SkBlitter* blitter, const SkPath& devPath) {
+    if (fAntiAlias) {
+        SkScan::AntiFillPath(devPath, fClip, blitter);
+    } else {
+        SkScan::FillPath(devPath, fClip, blitter);
+    }
+}
+
+void RectSetSweep::fillPathRows(SkBlitter* blitter, int i, int top, int bottom) {
+    if (top >= bottom) {
+        return;
+    }
+    const Shape& shape = fShapes[i];
+    const bool oneCall = shape.fInnerTop == shape.fInnerBottom &&
+                         (shape.fTop - fBounds.fTop) / fBandRows ==
+                         (shape.fBottom - 1 - fBounds.fTop) / fBandRows;
+    if (oneCall) {
+        SkExactRectClipBlitter rows;
+        rows.init(blitter, {fBounds.fLeft, top, fBounds.fRight, bottom});
+        this->fillPath(&rows, fPaths[i]);
+        return;
+    }
+    // The path is filled once, the first time we get to it, and its rows are replayed from there.
+    if (!fFills[i]) {
+        fFills[i] = std::make_unique<FillRecorder>(blitter);
+        this->fillPath(fFills[i].get(), fPaths[i]);
+    }
+    fFills[i]->replay(blitter, fBounds.fLeft, top, fBounds.fRight, bottom);
+}
+
+void RectSetSweep::blitEdgeRow(SkBlitter* blitter, const Shape& shape, int y) {
+    // A partially covered row at the top or bottom of an antialiased rect.
+    SkASSERT(fAntiAlias);
+    U8CPU alpha;
+    if (shape.fInnerTop == shape.fInnerBottom && shape.fTop + 1 == shape.fBottom) {
+        alpha = shape.fB - shape.fT - 1;
+    } else if (y < shape.fInnerTop) {
+        alpha = 256 - (shape.fT & 0xFF);
+    } else {
+        alpha = shape.fB & 0xFF;
+    }
+    blit_aa_row(blitter, shape.fL, y, shape.fR, alpha);
+}
+
+// Blits the rows of the shape in [top, bottom).
+void RectSetSweep::blitShapeRows(SkBlitter* pathBlitter, SkBlitter* blitter, int i,
+                                 int top, int bottom) {
+    const Shape& shape = fShapes[i];
+    int y = std::max(top, shape.fTop);
+    const int end = std::min(bottom, shape.fBottom);
+    const int innerEnd = std::min(end, shape.fInnerBottom);
+    if (!fPaths.empty()) {
+        // The rows above and below those between the corners are left to the path filler.
+        const int innerTop = std::min(end, shape.fInnerTop);
+        this->fillPathRows(pathBlitter, i, y, innerTop);
+        this->fillPathRows(pathBlitter, i, std::max(y, std::max(innerTop, innerEnd)), end);
+        y = std::max(y, innerTop);
+        if (y < innerEnd) {
+            SkASSERT(!fAntiAlias);
+            blitter->blitRect(shape.fL, y, shape.fR - shape.fL, innerEnd - y);
+        }
+        if (end == shape.fBottom) {
+            fFills[i].reset();
+        }
+        return;
+    }
+
+    for (; y < end && y < shape.fInnerTop; y++) {
+        this->blitEdgeRow(blitter, shape, y);
+    }
+    if (y < innerEnd) {
+        if (fAntiAlias) {
+            blit_aa_rows(blitter, shape.fL, y, shape.fR, innerEnd - y);
+        } else {
+            blitter->blitRect(shape.fL, y, shape.fR - shape.fL, innerEnd - y);
+        }
+        y = innerEnd;
+    }
+    for (; y < end; y++) {
+        this->blitEdgeRow(blitter, shape, y);
+    }
+}
+
+template <typename SetColor>
+void RectSetSweep::draw(SetColor&& setColor) {
+    // Sort the shapes by the band they start in.  Shapes that start in the same band stay in
+    // batch order.
+    int total = 0;
+    for (int& count : fStartsAt) {
+        const int n = count;
+        count = total;
+        total += n;
+    }
+    std::vector<int> byTop(fShapes.size());
+    for (int i = 0; i < (int)fShapes.size(); i++) {
+        byTop[fStartsAt[(fShapes[i].fTop - fBounds.fTop) / fBandRows]++] = i;
+    }
+
+    std::vector<int> active, merged;
+    auto byIndex = [&](int a, int b) { return fShapes[a].fIndex < fShapes[b].fIndex; };
+    size_t next = 0;
+    int lastIndex = -1;
+    std::pair<SkBlitter*, SkBlitter*> blitters = {nullptr, nullptr};
+    for (int top = fBounds.fTop; top < fBounds.fBottom; top += fBandRows) {
+        const int bottom = std::min(top + fBandRows, fBounds.fBottom);
+
+        // Drop the shapes that have ended, and merge in the ones that start in this band.
+        active.erase(std::remove_if(active.begin(), active.end(),
+                                    [&](int i) { return fShapes[i].fBottom <= top; }),
+                     active.end());
+        const size_t first = next;
+        while (next < byTop.size() && fShapes[byTop[next]].fTop < bottom) {
+            next++;
+        }
+        merged.clear();
+        std::merge(active.begin(), active.end(), byTop.begin() + first, byTop.begin() + next,
+                   std::back_inserter(merged), byIndex);
+        std::swap(active, merged);
+
+        for (int i : active) {
+            const Shape& shape = fShapes[i];
+            if (shape.fIndex != lastIndex) {
+                blitters = setColor(shape.fIndex);
+                lastIndex = shape.fIndex;
+            }
+            if (blitters.first) {
+                this->blitShapeRows(blitters.first, blitters.second, i, top, bottom);
+            }
+        }
+    }
+}
+
+}  // namespace
+
+void SkDraw::drawRectSet(const SkRect rects[], const SkColor4f colors[], int count,
+                         const SkPaint& paint) const {
+    this->drawShapeSet(rects, nullptr, colors, count, paint);
+}
+
+void SkDraw::drawRRectSet(const SkRRect rrects[], const SkColor4f colors[], int count,
+                          const SkPaint& paint) const {
+    this->drawShapeSet(nullptr, rrects, colors, count, paint);
+}
+
+void SkDraw::drawShapeSet(const SkRect rects[], const SkRRect rrects[], const SkColor4f colors[],
+                          int count, const SkPaint& paint) const {
+    SkASSERT(SkToBool(rects) != SkToBool(rrects));
+    SkDEBUGCODE(this->validate();)
+
+    const bool canSweep = fDst.colorType() != kUnknown_SkColorType &&
+                          fCTM->rectStaysRect() &&
+                          paint.getStyle() == SkPaint::kFill_Style &&
+                          !paint.getShader() && !paint.getColorFilter() &&
+                          !paint.getMaskFilter() && !paint.getPathEffect() &&
+                          !paint.getImageFilter() && paint.asBlendMode().has_value();
+    // The legacy blitters fill shapes faster on their own than the raster pipeline does in a
+    // sweep, and they round colors a little differently.
+    if (!canSweep || SkBlitter::UseLegacyBlitter(fDst, paint, *fCTM)) {
+        SkPaint p(paint);
+        for (int i = 0; i < count; i++) {
+            p.setColor4f(colors[i]);
+            if (rects) {
+                this->drawRect(rects[i], p);
+            } else {
+                this->drawRRect(rrects[i], p);
+            }
+        }
+        return;
+    }
+
+    if (fRC->isEmpty() || count <= 0) {
+        return;
+    }
+    SkIRect bounds = fRC->getBounds();
+    if (fBlitterClip && !bounds.intersect(*fBlitterClip)) {
+        return;
+    }
+
+    const size_t bandRowBytes = (size_t)bounds.width() * fDst.info().bytesPerPixel();
+    const int bandRows = (int)std::max<size_t>(1, kBandBytes / std::max<size_t>(1, bandRowBytes));
+    RectSetSweep sweep(*fRC, bounds, paint.isAntiAlias(), bandRows);
+    for (int i = 0; i < count; i++) {
+        if (rects) {
+            const SkRect devRect = fCTM->mapRect(rects[i]);
+            if (devRect.isFinite()) {
+                sweep.addRect(devRect, i);
+            }
+        } else {
+            SkRRect devRRect;
+            if (rrects[i].transform(*fCTM, &devRRect) && devRRect.getBounds().isFinite()) {
+                SkPath devPath;
+                devPath.addRRect(rrects[i]);
+                devPath.transform(*fCTM);
+                if (!SkPathPriv::TooBigForMath(devPath)) {
+                    sweep.addRRect(devRRect, std::move(devPath), i);
+                }
+            }
+        }
+    }
+
+    // Each color's blitter is recolored rather than rebuilt, and wrapped in the clip once.
+    SkColorSpaceXformSteps steps(sk_srgb_singleton(), kUnpremul_SkAlphaType,
+                                 fDst.colorSpace(),   kUnpremul_SkAlphaType);
+    std::vector<SkColor4f> dstColors(colors, colors + count);
+    for (SkColor4f& c : dstColors) {
+        c.fA = SkTPin(c.fA, 0.0f, 1.0f);
+        steps.apply(c.vec());
+    }
+
+    SkSTArenaAlloc<4096> alloc;
+    SkRasterPipelineColorBlitters blitters(fDst, paint, &alloc, fRC->clipShader());
+    // Each of the blitters, wrapped for the path filler and clipped for the sweep.
+    struct Clipped {
+        SkBlitter* fBlitter;
+        std::pair<SkBlitter*, SkBlitter*> fWrapped;
+    } clipped[8];
+    int clippedCount = 0;
+    auto clip = [&](SkBlitter* blitter) -> std::pair<SkBlitter*, SkBlitter*> {
+        for (int i = 0; i < clippedCount; i++) {
+            if (clipped[i].fBlitter == blitter) {
+                return clipped[i].fWrapped;
+            }
+        }
+        SkBlitter* forPath = this->clipBlitter(blitter, &alloc);
+        SkBlitter* wrapped = forPath;
+        // Every shape is inside the clip bounds, so only complex clips need to clip the blitter.
+        const SkRegion* clipRgn;
+        if (fRC->isBW()) {
+            clipRgn = &fRC->bwRgn();
+        } else {
+            auto aaClip = alloc.make<SkAAClipBlitterWrapper>(*fRC, wrapped);
+            clipRgn = &aaClip->getRgn();
+            wrapped = aaClip->getBlitter();
+        }
+        wrapped = alloc.make<SkBlitterClipper>()->apply(wrapped, clipRgn, &bounds);
+        SkASSERT(clippedCount < (int)std::size(clipped));
+        clipped[clippedCount++] = {blitter, {forPath, wrapped}};
+        return {forPath, wrapped};
+    };
+
+    sweep.draw([&](int index) -> std::pair<SkBlitter*, SkBlitter*> {
+        SkBlitter* blitter = blitters.blitterFor(dstColors[index]);
+        return blitter ? clip(blitter) : std::pair<SkBlitter*, SkBlitter*>{nullptr, nullptr};
+    });
+}
@@ -59,6 +59,7 @@ void SkDraw::paintMasks(SkZip<const SkGlyph*, SkPoint> accepted, const SkPaint&
                                            SkDrawCoverage::kNo,
                                            fRC->clipShader(),
                                            SkSurfacePropsCopyOrDefault(fProps));
+    blitter = this->clipBlitter(blitter, &alloc);
 
     SkAAClipBlitterWrapper wrapper{*fRC, blitter};
     blitter = wrapper.getBlitter();
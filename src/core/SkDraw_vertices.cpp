@@ -289,6 +289,7 @@ void SkDraw::drawFixedVertices(const SkVertices* vertices,
                                                  outerAlloc,
                                                  fRC->clipShader(),
                                                  props);
+    blitter = this->clipBlitter(blitter, outerAlloc);
     if (!blitter) {
         return;
     }
@@ -49,6 +49,8 @@ struct SkEdge {
     int setLine(const SkPoint& p0, const SkPoint& p1, const SkIRect* clip, int shiftUp);
     // call this version if you know you don't have a clip
     inline int setLine(const SkPoint& p0, const SkPoint& p1, int shiftUp);
+    // call this version if the endpoints are already in FDot6, shifted up
+    inline int setFDot6Line(SkFDot6 x0, SkFDot6 y0, SkFDot6 x1, SkFDot6 y1);
     inline int updateLine(SkFixed ax, SkFixed ay, SkFixed bx, SkFixed by);
     void chopLineWithClip(const SkIRect& clip);
 
@@ -110,7 +112,10 @@ int SkEdge::setLine(const SkPoint& p0, const SkPoint& p1, int shift) {
         y1 = int(p1.fY * scale);
 #endif
     }
+    return this->setFDot6Line(x0, y0, x1, y1);
+}
 
+int SkEdge::setFDot6Line(SkFDot6 x0, SkFDot6 y0, SkFDot6 x1, SkFDot6 y1) {
     Winding winding = Winding::kCW;
 
     if (y0 > y1) {
@@ -17,13 +17,18 @@
 #include "include/private/base/SkSafe32.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkSafeMath.h"
+#include "src/base/SkVx.h"
 #include "src/core/SkAnalyticEdge.h"
 #include "src/core/SkEdge.h"
 #include "src/core/SkEdgeClipper.h"
+#include "src/core/SkFDot6.h"
 #include "src/core/SkGeometry.h"
 #include "src/core/SkLineClipper.h"
 #include "src/core/SkPathPriv.h"
 
+#include <cstdint>
+#include <cstring>
+
 SkEdgeBuilder::Combine SkBasicEdgeBuilder::combineVertical(const SkEdge* edge, SkEdge* last) {
     // We only consider edges that were originally lines to be vertical to avoid numerical issues
     // (crbug.com/1154864).
@@ -187,24 +192,92 @@ void SkAnalyticEdgeBuilder::addCubic(const SkPoint pts[]) {
 
 // TODO: merge addLine() and addPolyLine()?
 
-SkEdgeBuilder::Combine SkBasicEdgeBuilder::addPolyLine(const SkPoint pts[],
+void SkBasicEdgeBuilder::convertPolyLines(LineBatch* lines, int n) const {
+    SkASSERT(n <= kLineBatch);
+#ifdef SK_RASTERIZE_EVEN_ROUNDING
+    for (int i = 0; i < n; i++) {
+        const float* pts = lines->fPts[i];
+        lines->fX0[i] = SkScalarRoundToFDot6(pts[0], fClipShift);
+        lines->fY0[i] = SkScalarRoundToFDot6(pts[1], fClipShift);
+        lines->fX1[i] = SkScalarRoundToFDot6(pts[2], fClipShift);
+        lines->fY1[i] = SkScalarRoundToFDot6(pts[3], fClipShift);
+        lines->fHasHeight[i] = SkFDot6Round(lines->fY0[i]) != SkFDot6Round(lines->fY1[i]) ? ~0 : 0;
+    }
+#else
+    // The same conversion as SkEdge::setLine(), for the whole batch at once.
+    skvx::float8 x0, y0, x1, y1;
+    skvx::strided_load4(&lines->fPts[0][0], x0, y0, x1, y1);
+    const float scale = float(1 << (fClipShift + 6));
+    const skvx::int8 fy0 = skvx::cast<int>(y0 * scale),
+                     fy1 = skvx::cast<int>(y1 * scale);
+    skvx::cast<int>(x0 * scale).store(lines->fX0);
+    skvx::cast<int>(x1 * scale).store(lines->fX1);
+    fy0.store(lines->fY0);
+    fy1.store(lines->fY1);
+
+    // Lines whose ends round to the same row are zero-height, and make no edge.
+    ((fy0 + SK_FDot6Half) >> 6 != (fy1 + SK_FDot6Half) >> 6).store(lines->fHasHeight);
+#endif
+}
+void SkAnalyticEdgeBuilder::convertPolyLines(LineBatch* lines, int n) const {
+    SkASSERT(n <= kLineBatch);
+#ifdef SK_RASTERIZE_EVEN_ROUNDING
+    for (int i = 0; i < n; i++) {
+        constexpr int accuracy = SkAnalyticEdge::kDefaultAccuracy;
+        const float* pts = lines->fPts[i];
+        lines->fX0[i] = SkFDot6ToFixed(SkScalarRoundToFDot6(pts[0], accuracy)) >> accuracy;
+        lines->fY0[i] = SkAnalyticEdge::SnapY(
+                SkFDot6ToFixed(SkScalarRoundToFDot6(pts[1], accuracy)) >> accuracy);
+        lines->fX1[i] = SkFDot6ToFixed(SkScalarRoundToFDot6(pts[2], accuracy)) >> accuracy;
+        lines->fY1[i] = SkAnalyticEdge::SnapY(
+                SkFDot6ToFixed(SkScalarRoundToFDot6(pts[3], accuracy)) >> accuracy);
+        lines->fHasHeight[i] = lines->fY0[i] != lines->fY1[i] ? ~0 : 0;
+    }
+#else
+    // The same conversion as SkAnalyticEdge::setLine(), for the whole batch at once:
+    // SkFDot6ToFixed(SkScalarToFDot6(v * multiplier)) >> accuracy, with y then snapped.
+    constexpr int accuracy = SkAnalyticEdge::kDefaultAccuracy;
+    auto to_fixed = [](skvx::float8 v) {
+        const skvx::int8 fdot6 = skvx::cast<int>(v * float(1 << accuracy) * float(SK_FDot6One));
+        return skvx::cast<int>(skvx::cast<uint32_t>(fdot6) << 10) >> accuracy;
+    };
+    auto snap_y = [](skvx::int8 y) {
+        const skvx::uint8 u = skvx::cast<uint32_t>(y) + (SK_Fixed1 >> (accuracy + 1));
+        return skvx::cast<int>(u >> (16 - accuracy) << (16 - accuracy));
+    };
+
+    skvx::float8 x0, y0, x1, y1;
+    skvx::strided_load4(&lines->fPts[0][0], x0, y0, x1, y1);
+    const skvx::int8 fy0 = snap_y(to_fixed(y0)),
+                     fy1 = snap_y(to_fixed(y1));
+    to_fixed(x0).store(lines->fX0);
+    to_fixed(x1).store(lines->fX1);
+    fy0.store(lines->fY0);
+    fy1.store(lines->fY1);
+
+    // Lines whose ends snap to the same y are zero-height, and make no edge.
+    (fy0 != fy1).store(lines->fHasHeight);
+#endif
+}
+
+SkEdgeBuilder::Combine SkBasicEdgeBuilder::addPolyLine(const LineBatch& lines, int i,
                                                        char* arg_edge, char** arg_edgePtr) {
     auto edge    = (SkEdge*) arg_edge;
     auto edgePtr = (SkEdge**)arg_edgePtr;
 
-    if (edge->setLine(pts[0], pts[1], fClipShift)) {
+    if (edge->setFDot6Line(lines.fX0[i], lines.fY0[i], lines.fX1[i], lines.fY1[i])) {
         return is_vertical(edge) && edgePtr > (SkEdge**)fEdgeList
             ? this->combineVertical(edge, edgePtr[-1])
             : kNo_Combine;
     }
     return SkEdgeBuilder::kPartial_Combine;  // A convenient lie.  Same do-nothing behavior.
 }
-SkEdgeBuilder::Combine SkAnalyticEdgeBuilder::addPolyLine(const SkPoint pts[],
+SkEdgeBuilder::Combine SkAnalyticEdgeBuilder::addPolyLine(const LineBatch& lines, int i,
                                                           char* arg_edge, char** arg_edgePtr) {
     auto edge    = (SkAnalyticEdge*) arg_edge;
     auto edgePtr = (SkAnalyticEdge**)arg_edgePtr;
 
-    if (edge->setLine(pts[0], pts[1])) {
+    if (edge->setFixedLine(lines.fX0[i], lines.fY0[i], lines.fX1[i], lines.fY1[i])) {
         return is_vertical(edge) && edgePtr > (SkAnalyticEdge**)fEdgeList
             ? this->combineVertical(edge, edgePtr[-1])
             : kNo_Combine;
@@ -252,23 +325,77 @@ int SkEdgeBuilder::buildPoly(const SkPath& path, const SkIRect* iclip, bool canC
     char** edgePtr = fAlloc.makeArrayDefault<char*>(maxEdgeCount);
     fEdgeList = (void**)edgePtr;
 
+    // Lines are gathered into batches and set up kLineBatch at a time.  The lanes past n hold
+    // lines from earlier batches (or zeros), so converting them is harmless.
+    LineBatch batch = {};
+    int n = 0;
+    auto flush_lines = [&] {
+        this->convertPolyLines(&batch, n);
+        for (int i = 0; i < n; i++) {
+            if (!batch.fHasHeight[i]) {
+                continue;
+            }
+            switch( this->addPolyLine(batch, i, edge, edgePtr) ) {
+                case kTotal_Combine:   edgePtr--; break;
+                case kPartial_Combine:            break;
+                case kNo_Combine: *edgePtr++ = edge;
+                                   edge += edgeSize;
+            }
+        }
+        n = 0;
+    };
+    auto add_line = [&](const SkPoint pts[2]) {
+        memcpy(batch.fPts[n], pts, sizeof(batch.fPts[n]));
+        if (++n == kLineBatch) {
+            flush_lines();
+        }
+    };
+
     SkPathEdgeIter iter(path);
     if (iclip) {
-        SkRect clip = this->recoverClip(*iclip);
+        const SkRect clip = this->recoverClip(*iclip);
+
+        // Most lines of a big path are either wholly inside the clip, or wholly above or below
+        // it, and for those SkLineClipper::ClipLine() would return the line itself or nothing.
+        // Sort lines into those cases a batch at a time, and only clip the ones that are left.
+        SkPoint unclipped[kLineBatch][2] = {};
+        int m = 0;
+        auto clip_lines = [&] {
+            skvx::float8 x0, y0, x1, y1;
+            skvx::strided_load4(&unclipped[0][0].fX, x0, y0, x1, y1);
+            const skvx::float8 l = min(x0, x1), t = min(y0, y1),
+                               r = max(x0, x1), b = max(y0, y1);
+            int32_t outside[kLineBatch], inside[kLineBatch];
+            ((b <= clip.fTop) | (t >= clip.fBottom)).store(outside);
+            ((l >= clip.fLeft) & (r < clip.fRight) &
+             (t >= clip.fTop)  & (b <= clip.fBottom)).store(inside);
+
+            for (int i = 0; i < m; i++) {
+                if (outside[i]) {
+                    continue;
+                }
+                if (inside[i]) {
+                    add_line(unclipped[i]);
+                    continue;
+                }
+                SkPoint lines[SkLineClipper::kMaxPoints];
+                int lineCount = SkLineClipper::ClipLine(unclipped[i], clip, lines,
+                                                        canCullToTheRight);
+                SkASSERT(lineCount <= SkLineClipper::kMaxClippedLineSegments);
+                for (int j = 0; j < lineCount; j++) {
+                    add_line(lines + j);
+                }
+            }
+            m = 0;
+        };
 
         while (auto e = iter.next()) {
             switch (e.fEdge) {
                 case SkPathEdgeIter::Edge::kLine: {
-                    SkPoint lines[SkLineClipper::kMaxPoints];
-                    int lineCount = SkLineClipper::ClipLine(e.fPts, clip, lines, canCullToTheRight);
-                    SkASSERT(lineCount <= SkLineClipper::kMaxClippedLineSegments);
-                    for (int i = 0; i < lineCount; i++) {
-                        switch( this->addPolyLine(lines + i, edge, edgePtr) ) {
-                            case kTotal_Combine:   edgePtr--; break;
-                            case kPartial_Combine:            break;
-                            case kNo_Combine: *edgePtr++ = edge;
-                                               edge += edgeSize;
-                        }
+                    unclipped[m][0] = e.fPts[0];
+                    unclipped[m][1] = e.fPts[1];
+                    if (++m == kLineBatch) {
+                        clip_lines();
                     }
                     break;
                 }
@@ -277,16 +404,12 @@ int SkEdgeBuilder::buildPoly(const SkPath& path, const SkIRect* iclip, bool canC
                     break;
             }
         }
+        clip_lines();
     } else {
         while (auto e = iter.next()) {
             switch (e.fEdge) {
                 case SkPathEdgeIter::Edge::kLine: {
-                    switch( this->addPolyLine(e.fPts, edge, edgePtr) ) {
-                        case kTotal_Combine:   edgePtr--; break;
-                        case kPartial_Combine:            break;
-                        case kNo_Combine: *edgePtr++ = edge;
-                                           edge += edgeSize;
-                    }
+                    add_line(e.fPts);
                     break;
                 }
                 default:
@@ -295,6 +418,7 @@ int SkEdgeBuilder::buildPoly(const SkPath& path, const SkIRect* iclip, bool canC
             }
         }
     }
+    flush_lines();
     SkASSERT((size_t)(edge - edgeStart) <= maxEdgeCount * edgeSize);
     SkASSERT((size_t)(edgePtr - (char**)fEdgeList) <= maxEdgeCount);
     return SkToInt(edgePtr - (char**)fEdgeList);
@@ -39,6 +39,15 @@ protected:
         kTotal_Combine
     };
 
+    // In polygon mode lines are set up in batches, converting their endpoints to fixed point and
+    // finding those that cover no rows kLineBatch at a time with SIMD.
+    static constexpr int kLineBatch = 8;
+    struct LineBatch {
+        float   fPts[kLineBatch][4];     // x0, y0, x1, y1 of each line.
+        int32_t fX0[kLineBatch], fY0[kLineBatch], fX1[kLineBatch], fY1[kLineBatch];
+        int32_t fHasHeight[kLineBatch];  // 0 if the line is known to make no edge, else ~0.
+    };
+
 private:
     int build    (const SkPath& path, const SkIRect* clip, bool clipToTheRight);
     int buildPoly(const SkPath& path, const SkIRect* clip, bool clipToTheRight);
@@ -49,7 +58,9 @@ private:
     virtual void addLine (const SkPoint pts[]) = 0;
     virtual void addQuad (const SkPoint pts[]) = 0;
     virtual void addCubic(const SkPoint pts[]) = 0;
-    virtual Combine addPolyLine(const SkPoint pts[], char* edge, char** edgePtr) = 0;
+    // Fills in the fixed point endpoints and fHasHeight of the first n lines of the batch.
+    virtual void convertPolyLines(LineBatch*, int n) const = 0;
+    virtual Combine addPolyLine(const LineBatch&, int i, char* edge, char** edgePtr) = 0;
 };
 
 class SkBasicEdgeBuilder final : public SkEdgeBuilder {
@@ -67,7 +78,8 @@ private:
     void addLine (const SkPoint pts[]) override;
     void addQuad (const SkPoint pts[]) override;
     void addCubic(const SkPoint pts[]) override;
-    Combine addPolyLine(const SkPoint pts[], char* edge, char** edgePtr) override;
+    void convertPolyLines(LineBatch*, int n) const override;
+    Combine addPolyLine(const LineBatch&, int i, char* edge, char** edgePtr) override;
 
     const int fClipShift;
 };
@@ -87,6 +99,7 @@ private:
     void addLine (const SkPoint pts[]) override;
     void addQuad (const SkPoint pts[]) override;
     void addCubic(const SkPoint pts[]) override;
-    Combine addPolyLine(const SkPoint pts[], char* edge, char** edgePtr) override;
+    void convertPolyLines(LineBatch*, int n) const override;
+    Combine addPolyLine(const LineBatch&, int i, char* edge, char** edgePtr) override;
 };
 #endif
@@ -10,8 +10,12 @@
 #include "include/private/base/SkSemaphore.h"
 #include "include/private/base/SkTArray.h"
 #include "src/base/SkNoDestructor.h"
+#include "src/base/SkSpinlock.h"
 
+#include <atomic>
+#include <cstdint>
 #include <deque>
+#include <memory>
 #include <thread>
 #include <utility>
 
@@ -143,6 +147,184 @@ private:
     bool                  fAllowBorrowing;
 };
 
+// A double-ended list of work kept in a ring that only ever grows.  Once it has held as much work
+// as it will need to, adding and taking work moves std::functions in and out of its slots without
+// allocating, which std::deque can't promise as it frees and reallocates its blocks.
+class SkWorkRing {
+public:
+    bool empty() const { return fHead == fTail; }
+
+    void push_back(std::function<void(void)> work) {
+        if (fTail - fHead == fCapacity) {
+            this->grow();
+        }
+        fSlots[fTail++ & (fCapacity - 1)] = std::move(work);
+    }
+
+    std::function<void(void)> pop_back() {
+        SkASSERT(!this->empty());
+        return take(&fSlots[--fTail & (fCapacity - 1)]);
+    }
+
+    std::function<void(void)> pop_front() {
+        SkASSERT(!this->empty());
+        return take(&fSlots[fHead++ & (fCapacity - 1)]);
+    }
+
+private:
+    static std::function<void(void)> take(std::function<void(void)>* slot) {
+        std::function<void(void)> work = std::move(*slot);
+        *slot = nullptr;  // Don't hold on to anything the work captured.
+        return work;
+    }
+
+    void grow() {
+        const uint32_t capacity = fCapacity ? fCapacity * 2 : 64;
+        auto slots = std::make_unique<std::function<void(void)>[]>(capacity);
+        for (uint32_t i = fHead; i != fTail; i++) {
+            slots[i & (capacity - 1)] = std::move(fSlots[i & (fCapacity - 1)]);
+        }
+        fSlots = std::move(slots);
+        fCapacity = capacity;
+    }
+
+    std::unique_ptr<std::function<void(void)>[]> fSlots;
+    uint32_t fCapacity = 0;  // Always a power of two.
+    uint32_t fHead = 0,      // fHead and fTail count up forever, and wrap into fSlots.
+             fTail = 0;
+};
+
+// An SkWorkStealingThreadPool gives each OS thread its own work list, so that threads adding and
+// running work rarely contend on the same lock.  Work added from a pool thread goes onto that
+// thread's own list, other work is spread round-robin across the lists.  Each thread runs its
+// own newest work first (LIFO, cache-warm), and when it runs dry steals the oldest work from
+// the other threads, starting at a random victim.
+class SkWorkStealingThreadPool final : public SkExecutor {
+public:
+    explicit SkWorkStealingThreadPool(int threads, bool allowBorrowing)
+            : fWorkers(new Worker[threads])
+            , fWorkerCount(threads)
+            , fAllowBorrowing(allowBorrowing) {
+        for (int i = 0; i < threads; i++) {
+            fThreads.emplace_back(&Loop, this, i);
+        }
+    }
+
+    ~SkWorkStealingThreadPool() override {
+        // Signal each thread that it's time to shut down.
+        for (int i = 0; i < fThreads.size(); i++) {
+            this->add(nullptr);
+        }
+        // Wait for each thread to shut down.
+        for (int i = 0; i < fThreads.size(); i++) {
+            fThreads[i].join();
+        }
+    }
+
+    void add(std::function<void(void)> work) override {
+        // Prefer our own list when called from one of our threads, e.g. by nested SkTaskGroups.
+        int index = (tPool == this)
+                ? tWorkerIndex
+                : (int)(fNextWorker.fetch_add(1, std::memory_order_relaxed) % fWorkerCount);
+        {
+            Worker& worker = fWorkers[index];
+            SkAutoSpinlock lock(worker.fLock);
+            worker.fWork.push_back(std::move(work));
+        }
+        fWorkAvailable.signal(1);
+    }
+
+    void borrow() override {
+        // If there is work waiting and we're allowed to borrow work, do it.
+        if (fAllowBorrowing && fWorkAvailable.try_wait()) {
+            uint32_t seed = fNextWorker.fetch_add(1, std::memory_order_relaxed);
+            SkAssertResult(this->do_work(/*self=*/-1, &seed));
+        }
+    }
+
+private:
+    // Each Worker sits on its own cache line so threads don't false-share their list locks.
+    struct alignas(64) Worker {
+        SkSpinlock  fLock;
+        SkWorkRing  fWork;
+    };
+
+    static uint32_t NextRandom(uint32_t* seed) {
+        // xorshift32: cheap, and plenty good enough to spread out steal attempts.
+        uint32_t x = *seed;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return *seed = x;
+    }
+
+    bool pop_own(int self, std::function<void(void)>* work) {
+        Worker& worker = fWorkers[self];
+        SkAutoSpinlock lock(worker.fLock);
+        if (worker.fWork.empty()) {
+            return false;
+        }
+        *work = worker.fWork.pop_back();
+        return true;
+    }
+
+    bool steal(int victim, std::function<void(void)>* work) {
+        Worker& worker = fWorkers[victim];
+        SkAutoSpinlock lock(worker.fLock);
+        if (worker.fWork.empty()) {
+            return false;
+        }
+        *work = worker.fWork.pop_front();
+        return true;
+    }
+
+    // This method should be called only when fWorkAvailable indicates there's work to do.
+    // Every successful wait() on fWorkAvailable is matched by exactly one queued piece of work,
+    // so the search below always terminates, though it may have to look more than once while
+    // another thread's add() is racing with us.
+    bool do_work(int self, uint32_t* seed) {
+        std::function<void(void)> work;
+        const int n = fWorkerCount;
+        bool found = self >= 0 && this->pop_own(self, &work);
+        while (!found) {
+            int victim = (int)((NextRandom(seed) >> 8) % n);
+            for (int i = 0; i < n && !found; i++) {
+                found = this->steal((victim + i) % n, &work);
+            }
+        }
+
+        if (!work) {
+            return false;  // This is Loop()'s signal to shut down.
+        }
+
+        work();
+        return true;
+    }
+
+    static void Loop(SkWorkStealingThreadPool* pool, int self) {
+        tPool        = pool;
+        tWorkerIndex = self;
+        uint32_t seed = 2654435761u * (uint32_t)(self + 1);
+        do {
+            pool->fWorkAvailable.wait();
+        } while (pool->do_work(self, &seed));
+        tPool = nullptr;
+    }
+
+    static thread_local SkWorkStealingThreadPool* tPool;
+    static thread_local int                       tWorkerIndex;
+
+    std::unique_ptr<Worker[]> fWorkers;
+    int                       fWorkerCount;
+    TArray<std::thread>       fThreads;
+    std::atomic<uint32_t>     fNextWorker{0};
+    SkSemaphore               fWorkAvailable;
+    bool                      fAllowBorrowing;
+};
+
+thread_local SkWorkStealingThreadPool* SkWorkStealingThreadPool::tPool = nullptr;
+thread_local int SkWorkStealingThreadPool::tWorkerIndex = 0;
+
 std::unique_ptr<SkExecutor> SkExecutor::MakeFIFOThreadPool(int threads, bool allowBorrowing) {
     using WorkList = std::deque<std::function<void(void)>>;
     return std::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores(),
@@ -153,3 +335,8 @@ std::unique_ptr<SkExecutor> SkExecutor::MakeLIFOThreadPool(int threads, bool all
     return std::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores(),
                                                     allowBorrowing);
 }
+std::unique_ptr<SkExecutor> SkExecutor::MakeWorkStealingThreadPool(int threads,
+                                                                 bool allowBorrowing) {
+    return std::make_unique<SkWorkStealingThreadPool>(threads > 0 ? threads : num_cores(),
+                                                      allowBorrowing);
+}
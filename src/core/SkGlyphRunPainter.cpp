@@ -25,6 +25,7 @@
 #include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkSpan_impl.h"
 #include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTo.h"
 #include "src/core/SkGlyph.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkScalerContext.h"
@@ -52,37 +53,70 @@ SkScalerContextFlags compute_scaler_context_flags(const SkColorSpace* cs) {
     }
 }
 
-// TODO: collect this up into a single class when all the details are worked out.
-// This is duplicate code. The original is in SubRunContainer.cpp.
+// Sort the glyphs in source into those the strike accepts for actionType and those it rejects.
+// mapGlyph(glyphID, pos) gives the ID to look the glyph up with, and where to draw it if it is
+// accepted. All the glyphs are looked up with a single call into the strike, which only needs to
+// lock the strike shared once it has seen these glyphs before.
+template <typename MapGlyph>
 std::tuple<SkZip<const SkGlyph*, SkPoint>, SkZip<SkGlyphID, SkPoint>>
-prepare_for_path_drawing(SkStrike* strike,
-                         SkZip<const SkGlyphID, const SkPoint> source,
-                         SkZip<const SkGlyph*, SkPoint> acceptedBuffer,
-                         SkZip<SkGlyphID, SkPoint> rejectedBuffer) {
-    int acceptedSize = 0;
-    int rejectedSize = 0;
-    strike->lock();
-    for (auto [glyphID, pos] : source) {
+prepare_for_drawing(SkStrike* strike,
+                    ActionType actionType,
+                    SkZip<const SkGlyphID, const SkPoint> source,
+                    SkZip<const SkGlyph*, SkPoint> acceptedBuffer,
+                    SkZip<SkGlyphID, SkPoint> rejectedBuffer,
+                    MapGlyph&& mapGlyph) {
+    STArray<64, SkPackedGlyphID> packedIDs;
+    STArray<64, SkPoint> acceptedPositions;
+    STArray<64, int> sourceIndices;
+    for (size_t i = 0; i < source.size(); i++) {
+        auto [glyphID, pos] = source[i];
         if (!SkIsFinite(pos.x(), pos.y())) {
             continue;
         }
-        const SkPackedGlyphID packedID{glyphID};
-        switch (SkGlyphDigest digest = strike->digestFor(kPath, packedID);
-                digest.actionFor(kPath)) {
+        auto [packedID, acceptedPos] = mapGlyph(glyphID, pos);
+        packedIDs.push_back(packedID);
+        acceptedPositions.push_back(acceptedPos);
+        sourceIndices.push_back(SkToInt(i));
+    }
+
+    STArray<64, SkGlyphDigest> digests;
+    STArray<64, const SkGlyph*> glyphs;
+    digests.resize(packedIDs.size());
+    glyphs.resize(packedIDs.size());
+    strike->glyphsFor(actionType, packedIDs, digests.data(), glyphs.data());
+
+    int acceptedSize = 0;
+    int rejectedSize = 0;
+    for (int i = 0; i < packedIDs.size(); i++) {
+        switch (digests[i].actionFor(actionType)) {
             case GlyphAction::kAccept:
-                acceptedBuffer[acceptedSize++] = std::make_tuple(strike->glyph(digest), pos);
+                acceptedBuffer[acceptedSize++] = std::make_tuple(glyphs[i], acceptedPositions[i]);
                 break;
-            case GlyphAction::kReject:
+            case GlyphAction::kReject: {
+                auto [glyphID, pos] = source[sourceIndices[i]];
                 rejectedBuffer[rejectedSize++] = std::make_tuple(glyphID, pos);
                 break;
+            }
             default:
                 break;
         }
     }
-    strike->unlock();
     return {acceptedBuffer.first(acceptedSize), rejectedBuffer.first(rejectedSize)};
 }
 
+// TODO: collect this up into a single class when all the details are worked out.
+// This is duplicate code. The original is in SubRunContainer.cpp.
+std::tuple<SkZip<const SkGlyph*, SkPoint>, SkZip<SkGlyphID, SkPoint>>
+prepare_for_path_drawing(SkStrike* strike,
+                         SkZip<const SkGlyphID, const SkPoint> source,
+                         SkZip<const SkGlyph*, SkPoint> acceptedBuffer,
+                         SkZip<SkGlyphID, SkPoint> rejectedBuffer) {
+    return prepare_for_drawing(strike, kPath, source, acceptedBuffer, rejectedBuffer,
+                               [](SkGlyphID glyphID, SkPoint pos) {
+                                   return std::make_tuple(SkPackedGlyphID{glyphID}, pos);
+                               });
+}
+
 // TODO: collect this up into a single class when all the details are worked out.
 // This is duplicate code. The original is in SubRunContainer.cpp.
 std::tuple<SkZip<const SkGlyph*, SkPoint>, SkZip<SkGlyphID, SkPoint>>
@@ -90,28 +124,10 @@ prepare_for_drawable_drawing(SkStrike* strike,
                              SkZip<const SkGlyphID, const SkPoint> source,
                              SkZip<const SkGlyph*, SkPoint> acceptedBuffer,
                              SkZip<SkGlyphID, SkPoint> rejectedBuffer) {
-    int acceptedSize = 0;
-    int rejectedSize = 0;
-    strike->lock();
-    for (auto [glyphID, pos] : source) {
-        if (!SkIsFinite(pos.x(), pos.y())) {
-            continue;
-        }
-        const SkPackedGlyphID packedID{glyphID};
-        switch (SkGlyphDigest digest = strike->digestFor(kDrawable, packedID);
-                digest.actionFor(kDrawable)) {
-            case GlyphAction::kAccept:
-                acceptedBuffer[acceptedSize++] = std::make_tuple(strike->glyph(digest), pos);
-                break;
-            case GlyphAction::kReject:
-                rejectedBuffer[rejectedSize++] = std::make_tuple(glyphID, pos);
-                break;
-            default:
-                break;
-        }
-    }
-    strike->unlock();
-    return {acceptedBuffer.first(acceptedSize), rejectedBuffer.first(rejectedSize)};
+    return prepare_for_drawing(strike, kDrawable, source, acceptedBuffer, rejectedBuffer,
+                               [](SkGlyphID glyphID, SkPoint pos) {
+                                   return std::make_tuple(SkPackedGlyphID{glyphID}, pos);
+                               });
 }
 
 std::tuple<SkZip<const SkGlyph*, SkPoint>, SkZip<SkGlyphID, SkPoint>>
@@ -128,35 +144,15 @@ prepare_for_direct_mask_drawing(SkStrike* strike,
     SkMatrix positionMatrixWithRounding = creationMatrix;
     positionMatrixWithRounding.postTranslate(halfSampleFreq.x(), halfSampleFreq.y());
 
-    int acceptedSize = 0;
-    int rejectedSize = 0;
-    strike->lock();
-    for (auto [glyphID, pos] : source) {
-        if (!SkIsFinite(pos.x(), pos.y())) {
-            continue;
-        }
-
-        const SkPoint mappedPos = positionMatrixWithRounding.mapPoint(pos);
-        const SkPackedGlyphID packedGlyphID = SkPackedGlyphID{glyphID, mappedPos, mask};
-        switch (SkGlyphDigest digest = strike->digestFor(kDirectMaskCPU, packedGlyphID);
-                digest.actionFor(kDirectMaskCPU)) {
-            case GlyphAction::kAccept: {
-                const SkPoint roundedPos{SkScalarFloorToScalar(mappedPos.x()),
-                                         SkScalarFloorToScalar(mappedPos.y())};
-                acceptedBuffer[acceptedSize++] =
-                        std::make_tuple(strike->glyph(digest), roundedPos);
-                break;
-            }
-            case GlyphAction::kReject:
-                rejectedBuffer[rejectedSize++] = std::make_tuple(glyphID, pos);
-                break;
-            default:
-                break;
-        }
-    }
-    strike->unlock();
-
-    return {acceptedBuffer.first(acceptedSize), rejectedBuffer.first(rejectedSize)};
+    return prepare_for_drawing(strike, kDirectMaskCPU, source, acceptedBuffer, rejectedBuffer,
+                               [&](SkGlyphID glyphID, SkPoint pos) {
+                                   const SkPoint mappedPos =
+                                           positionMatrixWithRounding.mapPoint(pos);
+                                   const SkPoint roundedPos{SkScalarFloorToScalar(mappedPos.x()),
+                                                            SkScalarFloorToScalar(mappedPos.y())};
+                                   return std::make_tuple(
+                                           SkPackedGlyphID{glyphID, mappedPos, mask}, roundedPos);
+                               });
 }
 
 // Same as prepare_for_direct_mask_drawing but accepted points are unmapped source points.
@@ -174,33 +170,13 @@ prepare_for_direct_bitmap_drawing(SkStrike* strike,
     SkMatrix positionMatrixWithRounding = creationMatrix;
     positionMatrixWithRounding.postTranslate(halfSampleFreq.x(), halfSampleFreq.y());
 
-    int acceptedSize = 0;
-    int rejectedSize = 0;
-    strike->lock();
-    for (auto [glyphID, pos] : source) {
-        if (!SkIsFinite(pos.x(), pos.y())) {
-            continue;
-        }
-
-        const SkPoint mappedPos = positionMatrixWithRounding.mapPoint(pos);
-        const SkPackedGlyphID packedGlyphID = SkPackedGlyphID{glyphID, mappedPos, mask};
-        switch (SkGlyphDigest digest = strike->digestFor(kDirectMaskCPU, packedGlyphID);
-                digest.actionFor(kDirectMaskCPU)) {
-            case GlyphAction::kAccept: {
-                acceptedBuffer[acceptedSize++] =
-                        std::make_tuple(strike->glyph(digest), pos);
-                break;
-            }
-            case GlyphAction::kReject:
-                rejectedBuffer[rejectedSize++] = std::make_tuple(glyphID, pos);
-                break;
-            default:
-                break;
-        }
-    }
-    strike->unlock();
-
-    return {acceptedBuffer.first(acceptedSize), rejectedBuffer.first(rejectedSize)};
+    return prepare_for_drawing(strike, kDirectMaskCPU, source, acceptedBuffer, rejectedBuffer,
+                               [&](SkGlyphID glyphID, SkPoint pos) {
+                                   const SkPoint mappedPos =
+                                           positionMatrixWithRounding.mapPoint(pos);
+                                   return std::make_tuple(
+                                           SkPackedGlyphID{glyphID, mappedPos, mask}, pos);
+                               });
 }
 }  // namespace
 
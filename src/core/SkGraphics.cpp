@@ -90,6 +90,30 @@ int SkGraphics::SetTypefaceCacheCountLimit(int count) {
     return prev;
 }
 
+extern bool gSkUseSparseStrips;
+
+bool SkGraphics::SetUseSparseStripRasterizer(bool useSparseStrips) {
+    bool old = gSkUseSparseStrips;
+    gSkUseSparseStrips = useSparseStrips;
+    return old;
+}
+
+bool SkGraphics::GetUseSparseStripRasterizer() {
+    return gSkUseSparseStrips;
+}
+
+static SkExecutor* gPathRasterExecutor = nullptr;
+
+SkExecutor* SkGraphics::SetPathRasterExecutor(SkExecutor* executor) {
+    SkExecutor* old = gPathRasterExecutor;
+    gPathRasterExecutor = executor;
+    return old;
+}
+
+SkExecutor* SkGraphics::GetPathRasterExecutor() {
+    return gPathRasterExecutor;
+}
+
 static SkGraphics::OpenTypeSVGDecoderFactory gSVGDecoderFactory = nullptr;
 
 SkGraphics::OpenTypeSVGDecoderFactory
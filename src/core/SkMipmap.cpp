@@ -14,8 +14,11 @@
 #include "src/base/SkMathPriv.h"
 #include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkMipmapBuilder.h"
+#include "src/core/SkTaskGroup.h"
 
+#include <algorithm>
 #include <new>
+#include <utility>
 
 //
 // ColorTypeFilter is the "Type" we pass to some downsample template functions.
@@ -26,6 +29,99 @@
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+// With an executor, levels are split into bands of at least this many pixels.
+constexpr int64_t kMinBandPixels = 1 << 16;
+
+// When building the first two levels together, we build this many rows of the second level at a
+// time, after the rows of the first level they need.
+constexpr int kFusedRows = 4;
+
+int band_count(SkExecutor* executor, int64_t pixels, int maxBands) {
+    if (!executor) {
+        return 1;
+    }
+    return (int)std::clamp<int64_t>(pixels / kMinBandPixels, 1, maxBands);
+}
+
+// The first row of band b of bandCount, where band_top(bandCount, bandCount, height) is height.
+int band_top(int band, int bandCount, int height) {
+    return (int)((int64_t)height * band / bandCount);
+}
+
+// The rows of src that rows [top, bottom) of the level below it are filtered from.
+std::pair<int, int> src_rows(int top, int bottom, int srcHeight) {
+    if (srcHeight == 1) {
+        return {0, 1};
+    }
+    // Odd heights take three rows at a time, overlapping by one.
+    return {2 * top, 2 * bottom + (srcHeight & 1)};
+}
+
+void build_level(SkMipmapDownSampler* downsampler, const SkPixmap& dst, const SkPixmap& src,
+                 SkExecutor* executor) {
+    const int bands = band_count(executor, (int64_t)dst.width() * dst.height(), dst.height());
+    if (bands == 1) {
+        downsampler->buildLevel(dst, src);
+        return;
+    }
+    SkTaskGroup(*executor).batch(bands, [&](int b) {
+        downsampler->buildRows(dst, src, band_top(b,     bands, dst.height()),
+                                         band_top(b + 1, bands, dst.height()));
+    });
+}
+
+// Builds level1 from src and level2 from level1 a few rows at a time, so the rows of level1 are
+// still in cache when we filter level2 from them.
+void build_two_levels(SkMipmapDownSampler* downsampler, const SkPixmap& level2,
+                      const SkPixmap& level1, const SkPixmap& src, SkExecutor* executor) {
+    const int height1 = level1.height(),
+              height2 = level2.height();
+    const int bands = band_count(executor, (int64_t)level1.width() * height1, height2);
+
+    // Each band builds the rows of level1 from the first one its rows of level2 need up to the
+    // first one the next band needs.  When the level2 rows take three level1 rows each, the last
+    // row of each band but the last needs the next band's first level1 row, so it waits.
+    auto buildBand = [&](int b) {
+        const int top = band_top(b, bands, height2),
+                  bottom = band_top(b + 1, bands, height2);
+        const int end1 = b + 1 == bands ? height1 : src_rows(bottom, bottom, height1).first;
+
+        int rows1 = src_rows(top, top, height1).first;
+        for (int y = top; y < bottom; y += kFusedRows) {
+            const int chunkBottom = std::min(y + kFusedRows, bottom);
+            const int needed1 = std::min(src_rows(y, chunkBottom, height1).second, end1);
+            if (rows1 < needed1) {
+                downsampler->buildRows(level1, src, rows1, needed1);
+                rows1 = needed1;
+            }
+
+            int ready = chunkBottom;
+            if (src_rows(chunkBottom - 1, chunkBottom, height1).second > end1) {
+                ready--;
+            }
+            if (y < ready) {
+                downsampler->buildRows(level2, level1, y, ready);
+            }
+        }
+    };
+
+    if (bands == 1) {
+        buildBand(0);
+        return;
+    }
+    SkTaskGroup(*executor).batch(bands, buildBand);
+    for (int b = 0; b + 1 < bands; b++) {
+        const int bottom = band_top(b + 1, bands, height2);
+        if (src_rows(bottom - 1, bottom, height1).second > src_rows(bottom, bottom, height1).first) {
+            downsampler->buildRows(level2, level1, bottom - 1, bottom);
+        }
+    }
+}
+
+}  // namespace
+
 SkMipmap::SkMipmap(void* malloc, size_t size) : SkCachedData(malloc, size) {}
 SkMipmap::SkMipmap(size_t size, SkDiscardableMemory* dm) : SkCachedData(size, dm) {}
 
@@ -43,7 +139,7 @@ size_t SkMipmap::AllocLevelsSize(int levelCount, size_t pixelSize) {
 }
 
 SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
-                          bool computeContents) {
+                          bool computeContents, SkExecutor* executor) {
     if (src.width() <= 1 && src.height() <= 1) {
         return nullptr;
     }
@@ -92,7 +188,6 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
     int         width = src.width();
     int         height = src.height();
     uint32_t    rowBytes;
-    SkPixmap    srcPM(src);
 
     // Depending on architecture and other factors, the pixel data alignment may need to be as
     // large as 8 (for F16 pixels). See the comment on SkMipmap::Level.
@@ -117,16 +212,23 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
         new (&levels[i].fPixmap) SkPixmap(SkImageInfo::Make(width, height, ct, at), addr, rowBytes);
         levels[i].fScale  = SkSize::Make(SkIntToScalar(width)  / src.width(),
                                          SkIntToScalar(height) / src.height());
-
-        const SkPixmap& dstPM = levels[i].fPixmap;
-        if (downsampler) {
-            downsampler->buildLevel(dstPM, srcPM);
-        }
-        srcPM = dstPM;
         addr += height * rowBytes;
     }
     SkASSERT(addr == baseAddr + size);
 
+    if (downsampler) {
+        int i = 0;
+        if (countLevels >= 2) {
+            build_two_levels(downsampler.get(), levels[1].fPixmap, levels[0].fPixmap, src,
+                             executor);
+            i = 2;
+        }
+        for (; i < countLevels; ++i) {
+            build_level(downsampler.get(), levels[i].fPixmap,
+                        i == 0 ? src : levels[i - 1].fPixmap, executor);
+        }
+    }
+
     SkASSERT(mipmap->fLevels);
     return mipmap;
 }
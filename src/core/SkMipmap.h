@@ -19,6 +19,7 @@
 class SkBitmap;
 class SkData;
 class SkDiscardableMemory;
+class SkExecutor;
 class SkMipmapBuilder;
 
 typedef SkDiscardableMemory* (*SkDiscardableFactoryProc)(size_t bytes);
@@ -26,7 +27,13 @@ typedef SkDiscardableMemory* (*SkDiscardableFactoryProc)(size_t bytes);
 struct SkMipmapDownSampler {
     virtual ~SkMipmapDownSampler() {}
 
-    virtual void buildLevel(const SkPixmap& dst, const SkPixmap& src) = 0;
+    // Fills rows [top, bottom) of dst, the level below src.  Different rows of the same dst may be
+    // built on different threads at the same time.
+    virtual void buildRows(const SkPixmap& dst, const SkPixmap& src, int top, int bottom) = 0;
+
+    void buildLevel(const SkPixmap& dst, const SkPixmap& src) {
+        this->buildRows(dst, src, 0, dst.height());
+    }
 };
 
 /*
@@ -41,8 +48,9 @@ public:
     ~SkMipmap() override;
     // Allocate and fill-in a mipmap. If computeContents is false, we just allocated
     // and compute the sizes/rowbytes, but leave the pixel-data uninitialized.
+    // If an executor is passed, large levels are built in bands of rows on its threads.
     static SkMipmap* Build(const SkPixmap& src, SkDiscardableFactoryProc,
-                           bool computeContents = true);
+                           bool computeContents = true, SkExecutor* = nullptr);
 
     static SkMipmap* Build(const SkBitmap& src, SkDiscardableFactoryProc);
 
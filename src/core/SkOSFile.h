@@ -50,6 +50,19 @@ void*   sk_fdmmap(int fd, size_t* length);
  */
 void    sk_fmunmap(const void* addr, size_t length);
 
+enum class SkMmapAdvice {
+    kWillNeed,    // The range will be read soon, so start paging it in now.
+    kSequential,  // The range will be read once, front to back. Read far ahead, and drop the
+                  // pages behind sooner.
+};
+
+/** Advises the OS how a range of memory will be read. The range need not be page aligned.
+ *  kWillNeed is a one-off hint, harmless on any memory. kSequential stays with the mapping,
+ *  so only use it on a whole mapping from sk_fmmap or sk_fdmmap that will be read just once.
+ *  Does nothing where unsupported.
+ */
+void    sk_fmadvise(const void* addr, size_t length, SkMmapAdvice);
+
 /** Returns true if the two point at the exact same filesystem object. */
 bool    sk_fidentical(FILE* a, FILE* b);
 
@@ -36,6 +36,7 @@ namespace SkOpts {
 
 #define M(st) (StageFn)SK_OPTS_NS::lowp::st,
     StageFn ops_lowp[] = { SK_RASTER_PIPELINE_OPS_LOWP(M) };
+    StageFn superstages_lowp[] = { SK_RASTER_PIPELINE_SUPERSTAGES_LOWP(M) };
     StageFn just_return_lowp = (StageFn)SK_OPTS_NS::lowp::just_return;
     void (*start_pipeline_lowp)(size_t, size_t, size_t, size_t, SkRasterPipelineStage*,
                                 SkSpan<SkRasterPipelineContexts::MemoryCtxPatch>,
@@ -75,6 +75,7 @@ namespace SkOpts {
     using StageFn = void(*)(void);
     extern StageFn ops_highp[kNumRasterPipelineHighpOps], just_return_highp;
     extern StageFn ops_lowp [kNumRasterPipelineLowpOps ], just_return_lowp;
+    extern StageFn superstages_lowp[kNumRasterPipelineSuperstages];
 
     extern void (*start_pipeline_highp)(size_t,size_t,size_t,size_t, SkRasterPipelineStage*,
                                         SkSpan<SkRasterPipelineContexts::MemoryCtxPatch>,
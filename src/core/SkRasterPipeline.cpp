@@ -21,12 +21,51 @@
 
 #include <algorithm>
 #include <cstring>
+#include <iterator>
 #include <vector>
 
 using namespace skia_private;
 using Op = SkRasterPipelineOp;
 
 bool gForceHighPrecisionRasterPipeline;
+bool gDisableRasterPipelineSuperstages;
+
+namespace {
+// The chain of ops that each lowp superstage replaces. When chains overlap, we prefer the one that
+// comes first here, so longer chains go before the shorter chains they contain.
+struct SuperstageChain {
+    SkRasterPipelineSuperstage superstage;
+    int length;
+    Op ops[4];
+};
+
+constexpr SuperstageChain kSuperstageChains[] = {
+    {SkRasterPipelineSuperstage::linear_gradient_2_stop_scale_translate, 4,
+     {Op::seed_shader, Op::matrix_scale_translate, Op::clamp_x_1,
+      Op::evenly_spaced_2_stop_gradient}},
+    {SkRasterPipelineSuperstage::linear_gradient_2_stop_2x3, 4,
+     {Op::seed_shader, Op::matrix_2x3, Op::clamp_x_1, Op::evenly_spaced_2_stop_gradient}},
+    {SkRasterPipelineSuperstage::scale_1_float_srcover_8888_dst, 4,
+     {Op::scale_1_float, Op::load_8888_dst, Op::srcover, Op::store_8888}},
+    {SkRasterPipelineSuperstage::scale_u8_srcover_8888_dst, 4,
+     {Op::scale_u8, Op::load_8888_dst, Op::srcover, Op::store_8888}},
+    {SkRasterPipelineSuperstage::srcover_8888_dst, 3,
+     {Op::load_8888_dst, Op::srcover, Op::store_8888}},
+    {SkRasterPipelineSuperstage::lerp_1_float_8888_dst, 3,
+     {Op::load_8888_dst, Op::lerp_1_float, Op::store_8888}},
+    {SkRasterPipelineSuperstage::lerp_u8_8888_dst, 3,
+     {Op::load_8888_dst, Op::lerp_u8, Op::store_8888}},
+    {SkRasterPipelineSuperstage::seed_shader_matrix_translate, 2,
+     {Op::seed_shader, Op::matrix_translate}},
+    {SkRasterPipelineSuperstage::seed_shader_matrix_scale_translate, 2,
+     {Op::seed_shader, Op::matrix_scale_translate}},
+    {SkRasterPipelineSuperstage::seed_shader_matrix_2x3, 2,
+     {Op::seed_shader, Op::matrix_2x3}},
+    {SkRasterPipelineSuperstage::clamp_01_store_8888, 2,
+     {Op::clamp_01, Op::store_8888}},
+};
+static_assert(std::size(kSuperstageChains) == kNumRasterPipelineSuperstages);
+}  // namespace
 
 SkRasterPipeline::SkRasterPipeline(SkArenaAlloc* alloc) : fAlloc(alloc) {
     this->reset();
@@ -271,34 +310,49 @@ void SkRasterPipeline::appendSetRGB(SkArenaAlloc* alloc, const float rgb[3]) {
     this->uncheckedAppend(op, arg);
 }
 
+SkRasterPipelineOp SkRasterPipeline::ConstantColorOp(const float rgba[4]) {
+    if (rgba[0] == 0 && rgba[1] == 0 && rgba[2] == 0 && rgba[3] == 1) {
+        return Op::black_color;
+    }
+    if (rgba[0] == 1 && rgba[1] == 1 && rgba[2] == 1 && rgba[3] == 1) {
+        return Op::white_color;
+    }
+    // uniform_color requires colors in range and can go lowp,
+    // while unbounded_uniform_color supports out-of-range colors too but not lowp.
+    if (0 <= rgba[0] && rgba[0] <= rgba[3] &&
+        0 <= rgba[1] && rgba[1] <= rgba[3] &&
+        0 <= rgba[2] && rgba[2] <= rgba[3]) {
+        return Op::uniform_color;
+    }
+    return Op::unbounded_uniform_color;
+}
+
+void SkRasterPipeline::SetConstantColor(SkRasterPipelineContexts::UniformColorCtx* ctx,
+                                        const float rgba[4]) {
+    skvx::float4 color = skvx::float4::Load(rgba);
+    color.store(&ctx->r);
+
+    if (ConstantColorOp(rgba) == Op::uniform_color) {
+        // To make loads more direct, we store 8-bit values in 16-bit slots.
+        color = color * 255.0f + 0.5f;
+        ctx->rgba[0] = (uint16_t)color[0];
+        ctx->rgba[1] = (uint16_t)color[1];
+        ctx->rgba[2] = (uint16_t)color[2];
+        ctx->rgba[3] = (uint16_t)color[3];
+    }
+}
+
 void SkRasterPipeline::appendConstantColor(SkArenaAlloc* alloc, const float rgba[4]) {
     // r,g,b might be outside [0,1], but alpha should probably always be in [0,1].
     SkASSERT(0 <= rgba[3] && rgba[3] <= 1);
 
-    if (rgba[0] == 0 && rgba[1] == 0 && rgba[2] == 0 && rgba[3] == 1) {
-        this->append(Op::black_color);
-    } else if (rgba[0] == 1 && rgba[1] == 1 && rgba[2] == 1 && rgba[3] == 1) {
-        this->append(Op::white_color);
+    const Op op = ConstantColorOp(rgba);
+    if (op == Op::black_color || op == Op::white_color) {
+        this->append(op);
     } else {
         auto ctx = alloc->make<SkRasterPipelineContexts::UniformColorCtx>();
-        skvx::float4 color = skvx::float4::Load(rgba);
-        color.store(&ctx->r);
-
-        // uniform_color requires colors in range and can go lowp,
-        // while unbounded_uniform_color supports out-of-range colors too but not lowp.
-        if (0 <= rgba[0] && rgba[0] <= rgba[3] &&
-            0 <= rgba[1] && rgba[1] <= rgba[3] &&
-            0 <= rgba[2] && rgba[2] <= rgba[3]) {
-            // To make loads more direct, we store 8-bit values in 16-bit slots.
-            color = color * 255.0f + 0.5f;
-            ctx->rgba[0] = (uint16_t)color[0];
-            ctx->rgba[1] = (uint16_t)color[1];
-            ctx->rgba[2] = (uint16_t)color[2];
-            ctx->rgba[3] = (uint16_t)color[3];
-            this->uncheckedAppend(Op::uniform_color, ctx);
-        } else {
-            this->uncheckedAppend(Op::unbounded_uniform_color, ctx);
-        }
+        SetConstantColor(ctx, rgba);
+        this->uncheckedAppend(op, ctx);
     }
 }
 
@@ -581,6 +635,25 @@ bool SkRasterPipeline::buildLowpPipeline(SkRasterPipelineStage* ip) const {
     if (gForceHighPrecisionRasterPipeline || fRewindCtx) {
         return false;
     }
+    // Returns the superstage chain ending with `st`, if there is one.
+    auto findSuperstageChain = [](const StageList* st) -> const SuperstageChain* {
+        if (gDisableRasterPipelineSuperstages) {
+            return nullptr;
+        }
+        for (const SuperstageChain& chain : kSuperstageChains) {
+            const StageList* link = st;
+            int i = chain.length;
+            while (i > 0 && link && link->stage == chain.ops[i - 1]) {
+                link = link->prev;
+                --i;
+            }
+            if (i == 0 && SkOpts::superstages_lowp[(int)chain.superstage]) {
+                return &chain;
+            }
+        }
+        return nullptr;
+    };
+
     // Stages are stored backwards in fStages; to compensate, we assemble the pipeline in reverse
     // here, back to front.
     prepend_to_pipeline(ip, SkOpts::just_return_lowp, /*ctx=*/nullptr);
@@ -590,6 +663,16 @@ bool SkRasterPipeline::buildLowpPipeline(SkRasterPipelineStage* ip) const {
             // This program contains a stage that doesn't exist in lowp.
             return false;
         }
+        if (const SuperstageChain* chain = findSuperstageChain(st)) {
+            // The rest of the chain stays in the program to hold each stage's context, and the
+            // superstage takes the place of the chain's first stage. It skips over the others.
+            for (int i = 1; i < chain->length; ++i) {
+                prepend_to_pipeline(ip, SkOpts::ops_lowp[(int)st->stage], st->ctx);
+                st = st->prev;
+            }
+            prepend_to_pipeline(ip, SkOpts::superstages_lowp[(int)chain->superstage], st->ctx);
+            continue;
+        }
         prepend_to_pipeline(ip, SkOpts::ops_lowp[opIndex], st->ctx);
     }
     return true;
@@ -119,6 +119,14 @@ public:
         this->appendConstantColor(alloc, color.vec());
     }
 
+    // The op appendConstantColor() appends for this color: black_color, white_color,
+    // uniform_color, or unbounded_uniform_color.  Only the last two have a context.
+    static SkRasterPipelineOp ConstantColorOp(const float rgba[4]);
+
+    // Fills the context of a uniform_color or unbounded_uniform_color stage with this color.
+    // The color must have the same ConstantColorOp() as the stage.
+    static void SetConstantColor(SkRasterPipelineContexts::UniformColorCtx*, const float rgba[4]);
+
     // Like appendConstantColor() but only affecting r,g,b, ignoring the alpha channel.
     void appendSetRGB(SkArenaAlloc*, const float rgb[3]);
 
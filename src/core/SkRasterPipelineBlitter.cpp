@@ -10,6 +10,7 @@
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkBlender.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -30,6 +31,7 @@
 #include "src/core/SkColorSpaceXformSteps.h"
 #include "src/core/SkCoreBlitters.h"
 #include "src/core/SkEffectPriv.h"
+#include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkMemset.h"
 #include "src/core/SkRasterPipeline.h"
@@ -43,13 +45,18 @@
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <utility>
 #include <vector>
 
-class SkColorSpace;
 class SkShader;
 
+// When false, solid color blitters are built from scratch for every draw.
+bool gSkUseRasterPipelineBlitterCache{true};
+// How many solid color blitters this thread's cache has had to build, for tests.
+thread_local int gSkRasterPipelineBlitterCacheMisses{0};
+
 class SkRasterPipelineBlitter final : public SkBlitter {
 public:
     // This is our common entrypoint for creating the blitter once we've sorted out shaders.
@@ -62,6 +69,12 @@ public:
                              bool is_constant,
                              const SkShader* clipShader);
 
+    // Reuses a solid color blitter from this thread's cache, or builds and caches a new one.
+    // Returns null if the paint isn't a plain color with a blend mode.
+    static SkBlitter* CreateSolidColor(const SkPixmap& dst,
+                                       const SkPaint& paint,
+                                       SkArenaAlloc* alloc);
+
     SkRasterPipelineBlitter(SkPixmap dst,
                             SkArenaAlloc* alloc)
         : fDst(std::move(dst))
@@ -78,7 +91,13 @@ public:
     void blitRect  (int x, int y, int width, int height)            override;
     void blitV     (int x, int y, int height, SkAlpha alpha)        override;
 
+    // Changes the color of a blitter Create()d for a constant color to another color with the
+    // same solid_color_op() and opacity.
+    void setSolidColor(const SkPMColor4f&);
+
 private:
+    class SolidColorCache;
+
     void appendLoadDst      (SkRasterPipeline*) const;
     void appendStore        (SkRasterPipeline*) const;
 
@@ -86,6 +105,9 @@ private:
     void appendClipScale    (SkRasterPipeline*) const;
     void appendClipLerp     (SkRasterPipeline*) const;
 
+    // Runs the (constant) color pipeline to find fMemsetColor.
+    void storeMemsetColor();
+
     SkPixmap               fDst;
     SkArenaAlloc*          fAlloc;
     SkRasterPipeline       fColorPipeline;
@@ -109,7 +131,8 @@ private:
                                                         fBlitAntiH,
                                                         fBlitMaskA8,
                                                         fBlitMaskLCD16,
-                                                        fBlitMask3D;
+                                                        fBlitMask3D,
+                                                        fStoreMemsetColor;
 
     // These values are pointed to by the blit pipelines above,
     // which allows us to adjust them from call to call.
@@ -169,6 +192,12 @@ SkBlitter* SkCreateRasterPipelineBlitter(const SkPixmap& dst,
                                          SkArenaAlloc* alloc,
                                          sk_sp<SkShader> clipShader,
                                          const SkSurfaceProps& props) {
+    if (!clipShader && gSkUseRasterPipelineBlitterCache) {
+        if (SkBlitter* blitter = SkRasterPipelineBlitter::CreateSolidColor(dst, paint, alloc)) {
+            return blitter;
+        }
+    }
+
     SkRasterPipeline_<256> shaderPipeline;
     SkColor4f dstPaintColor;
     bool is_opaque, is_constant;
@@ -404,11 +433,7 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
         dst.info().bytesPerPixel() <= static_cast<int>(sizeof(blitter->fMemsetColor))) {
         // Run our color pipeline all the way through to produce what we'd memset when we can.
         // Not all blits can memset, so we need to keep colorPipeline too.
-        SkRasterPipeline_<256> p;
-        p.extend(*colorPipeline);
-        blitter->fDstPtr = SkRasterPipelineContexts::MemoryCtx{&blitter->fMemsetColor, 0};
-        blitter->appendStore(&p);
-        p.run(0,0,1,1);
+        blitter->storeMemsetColor();
 
         switch (blitter->fDst.shiftPerPixel()) {
             case 0: blitter->fMemset2D = [](SkPixmap* dst, int x,int y, int w,int h, uint64_t c) {
@@ -453,6 +478,232 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
     return blitter;
 }
 
+// The color Create() folds a constant color pipeline into, given an unpremul color in dst's space.
+static SkPMColor4f solid_color(const SkColor4f& dstColor, const SkPixmap& dst) {
+    SkPMColor4f color = dstColor.premul();
+    if (SkColorTypeIsNormalized(dst.colorType())) {
+        for (int i = 0; i < 4; i++) {
+            color[i] = std::min(std::max(color[i], 0.0f), 1.0f);
+        }
+    }
+    return color;
+}
+
+// Blitters for solid colors can be recolored with any color sharing their color op and opacity.
+static int solid_color_kind(const SkPMColor4f& color) {
+    int op;
+    switch (SkRasterPipeline::ConstantColorOp(color.vec())) {
+        case SkRasterPipelineOp::black_color:   op = 0; break;
+        case SkRasterPipelineOp::white_color:   op = 1; break;
+        case SkRasterPipelineOp::uniform_color: op = 2; break;
+        default:                                op = 3; break;
+    }
+    return op * 2 + (color.fA == 1.0f ? 1 : 0);
+}
+
+void SkRasterPipelineBlitter::setSolidColor(const SkPMColor4f& color) {
+    const SkRasterPipeline::StageList* stage = fColorPipeline.getStageList();
+    SkASSERT(stage && !stage->prev &&
+             stage->stage == SkRasterPipeline::ConstantColorOp(color.vec()));
+    if (stage->ctx) {
+        SkRasterPipeline::SetConstantColor(
+                static_cast<SkRasterPipelineContexts::UniformColorCtx*>(stage->ctx), color.vec());
+    }
+    if (fMemset2D) {
+        this->storeMemsetColor();
+    }
+}
+
+// Solid color draws differ from one to the next only in their color and destination, yet building
+// and compiling their pipelines can cost more than blitting a small shape.  So each thread keeps
+// the solid color blitters it used most recently, keyed by everything that shapes their pipelines,
+// and hands them out again with the new color and destination written into the contexts their
+// compiled pipelines already point to.
+class SkRasterPipelineBlitter::SolidColorCache {
+public:
+    SkBlitter* find(const SkPixmap& dst, const SkPaint& paint, SkBlendMode mode,
+                    SkArenaAlloc* alloc);
+
+private:
+    struct Entry {
+        // The key.
+        SkColorType         fColorType;
+        SkAlphaType         fAlphaType;
+        sk_sp<SkColorSpace> fColorSpace;
+        SkBlendMode         fBlendMode;
+        SkRasterPipelineOp  fColorOp;
+        bool                fIsOpaque;
+
+        SkArenaAlloc             fAlloc{1024};  // Holds fBlitter and all of its pipelines.
+        SkRasterPipelineBlitter* fBlitter = nullptr;
+        uint32_t                 fLastUse = 0;
+        bool                     fInUse = false;
+    };
+
+    // Lives in the caller's arena, and returns the entry to the cache when the arena goes away.
+    class Lease {
+    public:
+        explicit Lease(Entry* entry) : fEntry(entry) { fEntry->fInUse = true; }
+        ~Lease() { fEntry->fInUse = false; }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+    private:
+        Entry* fEntry;
+    };
+
+    static constexpr int kMaxEntries = 16;
+
+    std::unique_ptr<Entry>  fEntries[kMaxEntries];
+    uint32_t                fUseCount = 0;
+
+    // Converts paint colors to the destination's color space.
+    sk_sp<SkColorSpace>     fStepsColorSpace;
+    SkColorSpaceXformSteps  fSteps;
+    bool                    fHasSteps = false;
+};
+
+SkBlitter* SkRasterPipelineBlitter::SolidColorCache::find(const SkPixmap& dst,
+                                                          const SkPaint& paint,
+                                                          SkBlendMode mode,
+                                                          SkArenaAlloc* alloc) {
+    if (!fHasSteps || !SkColorSpace::Equals(fStepsColorSpace.get(), dst.colorSpace())) {
+        fStepsColorSpace = dst.refColorSpace();
+        fSteps = SkColorSpaceXformSteps(sk_srgb_singleton(), kUnpremul_SkAlphaType,
+                                        dst.colorSpace(),    kUnpremul_SkAlphaType);
+        fHasSteps = true;
+    }
+    SkColor4f dstPaintColor = paint.getColor4f();
+    fSteps.apply(dstPaintColor.vec());
+
+    const SkPMColor4f color = solid_color(dstPaintColor, dst);
+    const SkRasterPipelineOp colorOp = SkRasterPipeline::ConstantColorOp(color.vec());
+    const bool isOpaque = color.fA == 1.0f;
+
+    Entry* entry = nullptr;
+    std::unique_ptr<Entry>* victim = nullptr;
+    for (std::unique_ptr<Entry>& e : fEntries) {
+        if (!e) {
+            // An empty slot beats evicting anything.
+            if (!victim || *victim) {
+                victim = &e;
+            }
+            continue;
+        }
+        if (e->fInUse) {
+            continue;
+        }
+        if (e->fColorType == dst.colorType() &&
+            e->fAlphaType == dst.alphaType() &&
+            e->fBlendMode == mode &&
+            e->fColorOp   == colorOp &&
+            e->fIsOpaque  == isOpaque &&
+            SkColorSpace::Equals(e->fColorSpace.get(), dst.colorSpace())) {
+            entry = e.get();
+            break;
+        }
+        if (!victim || (*victim && (*victim)->fLastUse > e->fLastUse)) {
+            victim = &e;
+        }
+    }
+
+    if (entry) {
+        SkRasterPipelineBlitter* blitter = entry->fBlitter;
+        blitter->fDst = dst;
+        blitter->fDstPtr = SkRasterPipelineContexts::MemoryCtx{
+            blitter->fDst.writable_addr(),
+            blitter->fDst.rowBytesAsPixels(),
+        };
+        blitter->setSolidColor(color);
+    } else {
+        if (!victim) {
+            return nullptr;  // Every entry is being drawn with.
+        }
+        // Build a fresh blitter just as SkCreateRasterPipelineBlitter() would, but in its own arena.
+        auto fresh = std::make_unique<Entry>();
+        SkRasterPipeline_<256> shaderPipeline;
+        shaderPipeline.appendConstantColor(&fresh->fAlloc, color.vec());
+        auto blitter = static_cast<SkRasterPipelineBlitter*>(
+                SkRasterPipelineBlitter::Create(dst, paint, dstPaintColor, &fresh->fAlloc,
+                                                shaderPipeline, isOpaque, /*is_constant=*/true,
+                                                /*clipShader=*/nullptr));
+        if (!blitter) {
+            return nullptr;
+        }
+        const SkRasterPipeline::StageList* stage = blitter->fColorPipeline.getStageList();
+        SkASSERT(stage && !stage->prev && stage->stage == colorOp);
+
+        fresh->fColorType  = dst.colorType();
+        fresh->fAlphaType  = dst.alphaType();
+        fresh->fColorSpace = dst.refColorSpace();
+        fresh->fBlendMode  = mode;
+        fresh->fColorOp    = colorOp;
+        fresh->fIsOpaque   = isOpaque;
+        fresh->fBlitter    = blitter;
+        *victim = std::move(fresh);
+        entry = victim->get();
+        gSkRasterPipelineBlitterCacheMisses++;
+    }
+
+    entry->fLastUse = ++fUseCount;
+    alloc->make<Lease>(entry);
+    return entry->fBlitter;
+}
+
+SkBlitter* SkRasterPipelineBlitter::CreateSolidColor(const SkPixmap& dst,
+                                                     const SkPaint& paint,
+                                                     SkArenaAlloc* alloc) {
+    std::optional<SkBlendMode> mode = paint.asBlendMode();
+    if (paint.getShader() || paint.getColorFilter() || !mode) {
+        return nullptr;
+    }
+    static thread_local SolidColorCache cache;
+    return cache.find(dst, paint, *mode, alloc);
+}
+
+SkRasterPipelineColorBlitters::SkRasterPipelineColorBlitters(const SkPixmap& dst,
+                                                             const SkPaint& paint,
+                                                             SkArenaAlloc* alloc,
+                                                             sk_sp<SkShader> clipShader)
+        : fDst(dst)
+        , fPaint(paint)
+        , fAlloc(alloc)
+        , fClipShader(std::move(clipShader)) {
+    SkASSERT(!paint.getShader() && !paint.getColorFilter() && paint.asBlendMode());
+}
+
+SkBlitter* SkRasterPipelineColorBlitters::blitterFor(const SkColor4f& dstColor) {
+    const SkPMColor4f color = solid_color(dstColor, fDst);
+    SkRasterPipelineBlitter*& blitter = fBlitters[solid_color_kind(color)];
+    if (!blitter) {
+        // Built just as SkCreateRasterPipelineBlitter() would for a paint of this color.
+        SkRasterPipeline_<256> shaderPipeline;
+        shaderPipeline.appendConstantColor(fAlloc, color.vec());
+        blitter = static_cast<SkRasterPipelineBlitter*>(
+                SkRasterPipelineBlitter::Create(fDst, fPaint, dstColor, fAlloc, shaderPipeline,
+                                                color.fA == 1.0f, /*is_constant=*/true,
+                                                fClipShader.get()));
+        return blitter;
+    }
+    blitter->setSolidColor(color);
+    return blitter;
+}
+
+void SkRasterPipelineBlitter::storeMemsetColor() {
+    if (!fStoreMemsetColor) {
+        SkRasterPipeline p(fAlloc);
+        p.extend(fColorPipeline);
+        this->appendStore(&p);
+        fStoreMemsetColor = p.compile();
+    }
+    // The store goes wherever fDstPtr points, so point it at fMemsetColor for a moment.
+    const SkRasterPipelineContexts::MemoryCtx dstPtr = fDstPtr;
+    fDstPtr = SkRasterPipelineContexts::MemoryCtx{&fMemsetColor, 0};
+    fStoreMemsetColor(0,0,1,1);
+    fDstPtr = dstPtr;
+}
+
 void SkRasterPipelineBlitter::appendLoadDst(SkRasterPipeline* p) const {
     p->appendLoadDst(fDst.info().colorType(), &fDstPtr);
     if (fDst.info().alphaType() == kUnpremul_SkAlphaType) {
@@ -561,14 +812,23 @@ void SkRasterPipelineBlitter::blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) {
     SkIRect clip = {x,y, x+2,y+1};
     uint8_t coverage[] = { (uint8_t)a0, (uint8_t)a1 };
     SkMask mask(coverage, clip, 2, SkMask::kA8_Format);
-    this->blitMask(mask, clip);
+    // Don't touch a pixel with no coverage (see SkExactRectClipBlitter).
+    if (a0 == 0) { clip.fLeft++;  }
+    if (a1 == 0) { clip.fRight--; }
+    if (!clip.isEmpty()) {
+        this->blitMask(mask, clip);
+    }
 }
 
 void SkRasterPipelineBlitter::blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) {
     SkIRect clip = {x,y, x+1,y+2};
     uint8_t coverage[] = { (uint8_t)a0, (uint8_t)a1 };
     SkMask mask(coverage, clip, 1, SkMask::kA8_Format);
-    this->blitMask(mask, clip);
+    if (a0 == 0) { clip.fTop++;    }
+    if (a1 == 0) { clip.fBottom--; }
+    if (!clip.isEmpty()) {
+        this->blitMask(mask, clip);
+    }
 }
 
 void SkRasterPipelineBlitter::blitV(int x, int y, int height, SkAlpha alpha) {
@@ -26,10 +26,15 @@ namespace SkRasterPipelineContexts {
 inline static constexpr int kMaxStride = 16;
 inline static constexpr int kMaxStride_highp = 16;
 
+// The SKX lowp pipeline alone handles 32 pixels at a time. Lowp stages keep 16-bit values in the
+// buffers they share with the rest of Skia, so buffers of kMaxStride 32-bit values still hold them.
+inline static constexpr int kMaxStride_lowp_skx = 32;
+static_assert(kMaxStride_lowp_skx * sizeof(uint16_t) <= kMaxStride * sizeof(float));
+
 // How much space to allocate for each MemoryCtx scratch buffer, as part of tail-pixel handling.
 inline static constexpr size_t kMaxScratchPerPatch =
-        std::max(kMaxStride_highp * 16,  // 16 == largest highp bpp (RGBA_F32)
-                 kMaxStride * 4);        // 4 == largest lowp bpp (RGBA_8888)
+        std::max(kMaxStride_highp * 16,     // 16 == largest highp bpp (RGBA_F32)
+                 kMaxStride_lowp_skx * 4);  // 4 == largest lowp bpp (RGBA_8888)
 
 // These structs hold the context data for many of the Raster Pipeline ops.
 struct MemoryCtx {
@@ -218,6 +218,18 @@
     SK_RASTER_PIPELINE_OPS_LOWP(M)       \
     SK_RASTER_PIPELINE_OPS_HIGHP_ONLY(M)
 
+// `SK_RASTER_PIPELINE_SUPERSTAGES_LOWP` defines lowp stages that each run a common chain of lowp
+// ops as a single stage. They aren't ops and can't be appended to a pipeline; SkRasterPipeline
+// substitutes them for their chains when it builds a lowp pipeline. The chain each one replaces is
+// listed in SkRasterPipeline.cpp.
+#define SK_RASTER_PIPELINE_SUPERSTAGES_LOWP(M)                                        \
+    M(seed_shader_matrix_translate) M(seed_shader_matrix_scale_translate)             \
+    M(seed_shader_matrix_2x3)                                                         \
+    M(linear_gradient_2_stop_scale_translate) M(linear_gradient_2_stop_2x3)           \
+    M(clamp_01_store_8888)                                                            \
+    M(srcover_8888_dst) M(scale_1_float_srcover_8888_dst) M(scale_u8_srcover_8888_dst) \
+    M(lerp_1_float_8888_dst) M(lerp_u8_8888_dst)
+
 // An enumeration of every RasterPipeline op:
 enum class SkRasterPipelineOp {
 #define M(op) op,
@@ -225,10 +237,18 @@ enum class SkRasterPipelineOp {
 #undef M
 };
 
+// An enumeration of every lowp superstage:
+enum class SkRasterPipelineSuperstage {
+#define M(stage) stage,
+    SK_RASTER_PIPELINE_SUPERSTAGES_LOWP(M)
+#undef M
+};
+
 // A count of raster pipeline ops:
 #define M(st) +1
     static constexpr int kNumRasterPipelineLowpOps  = SK_RASTER_PIPELINE_OPS_LOWP(M);
     static constexpr int kNumRasterPipelineHighpOps = SK_RASTER_PIPELINE_OPS_ALL(M);
+    static constexpr int kNumRasterPipelineSuperstages = SK_RASTER_PIPELINE_SUPERSTAGES_LOWP(M);
 #undef M
 
 #endif  // SkRasterPipelineOpList_DEFINED
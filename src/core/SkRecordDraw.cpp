@@ -592,3 +592,67 @@ void SkRecordFillBounds(const SkRect& cullRect, const SkRecord& record,
         }
     }
 }
+
+SkIRect SkRecordTileBins::tileBounds(int t) const {
+    SkASSERT(0 <= t && t < this->tileCount());
+    SkIRect r = SkIRect::MakeXYWH(grid.fLeft + (t % tilesX) * tileSize.width(),
+                                  grid.fTop  + (t / tilesX) * tileSize.height(),
+                                  tileSize.width(),
+                                  tileSize.height());
+    SkAssertResult(r.intersect(grid));
+    return r;
+}
+
+SkRecordTileBins SkRecordBinOps(const SkRect bounds[], int count, const SkMatrix& matrix,
+                                const SkIRect& grid, SkISize tileSize) {
+    SkASSERT(!tileSize.isEmpty());
+
+    SkRecordTileBins bins;
+    bins.grid     = grid;
+    bins.tileSize = tileSize;
+    if (grid.isEmpty()) {
+        bins.starts.push_back(0);
+        return bins;
+    }
+    bins.tilesX = (grid.width()  + tileSize.width()  - 1) / tileSize.width();
+    bins.tilesY = (grid.height() + tileSize.height() - 1) / tileSize.height();
+    bins.starts.assign(bins.tileCount() + 1, 0);
+
+    // First find the range of tiles each op touches, counting how many ops land in each tile...
+    std::vector<SkIRect> tiles(count, SkIRect::MakeEmpty());
+    for (int i = 0; i < count; i++) {
+        if (bounds[i].isEmpty()) {
+            continue;
+        }
+        // Outset by a pixel for antialiasing, as SkCanvas::getLocalClipBounds() does.
+        SkIRect devBounds = matrix.mapRect(bounds[i]).makeOutset(1, 1).roundOut();
+        if (!devBounds.intersect(grid)) {
+            continue;
+        }
+        devBounds.offset(-grid.fLeft, -grid.fTop);
+        tiles[i].setLTRB( devBounds.fLeft       / tileSize.width(),
+                          devBounds.fTop        / tileSize.height(),
+                         (devBounds.fRight - 1) / tileSize.width()  + 1,
+                         (devBounds.fBottom - 1) / tileSize.height() + 1);
+        for (int y = tiles[i].fTop; y < tiles[i].fBottom; y++) {
+            for (int x = tiles[i].fLeft; x < tiles[i].fRight; x++) {
+                bins.starts[y * bins.tilesX + x + 1]++;
+            }
+        }
+    }
+    for (int t = 0; t < bins.tileCount(); t++) {
+        bins.starts[t + 1] += bins.starts[t];
+    }
+
+    // ...then fill them in.  Visiting ops in order keeps each tile's list sorted.
+    bins.ops.resize(bins.starts.back());
+    std::vector<int> next(bins.starts.begin(), bins.starts.end() - 1);
+    for (int i = 0; i < count; i++) {
+        for (int y = tiles[i].fTop; y < tiles[i].fBottom; y++) {
+            for (int x = tiles[i].fLeft; x < tiles[i].fRight; x++) {
+                bins.ops[next[y * bins.tilesX + x]++] = i;
+            }
+        }
+    }
+    return bins;
+}
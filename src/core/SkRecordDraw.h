@@ -12,16 +12,42 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkM44.h"
 #include "include/core/SkPicture.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkSize.h"
 #include "include/private/base/SkNoncopyable.h"
 
+#include <vector>
+
 class SkDrawable;
+class SkMatrix;
 class SkRecord;
-struct SkRect;
 
 // Calculate conservative identity space bounds for each op in the record.
 void SkRecordFillBounds(const SkRect& cullRect, const SkRecord&,
                         SkRect bounds[], SkBBoxHierarchy::Metadata[]);
 
+// Which ops may draw into each tile of a grid, in increasing order: for tile t (numbered row by
+// row), ops[starts[t]] through ops[starts[t+1] - 1].
+struct SkRecordTileBins {
+    SkIRect          grid;      // Device space area covered by the tiles.
+    SkISize          tileSize;
+    int              tilesX = 0,
+                     tilesY = 0;
+    std::vector<int> starts;    // tilesX*tilesY + 1 entries.
+    std::vector<int> ops;
+
+    int tileCount() const { return tilesX * tilesY; }
+
+    // The device space bounds of tile t, clipped to grid.
+    SkIRect tileBounds(int t) const;
+};
+
+// Bin ops into tiles in one pass over their identity space bounds (from SkRecordFillBounds()),
+// which are mapped into device space by matrix.  Like SkRecordDraw()'s BBH query, this is
+// conservative: an op lands in every tile within a pixel of its bounds.
+SkRecordTileBins SkRecordBinOps(const SkRect bounds[], int count, const SkMatrix& matrix,
+                                const SkIRect& grid, SkISize tileSize);
+
 // Draw an SkRecord into an SkCanvas.  A convenience wrapper around SkRecords::Draw.
 void SkRecordDraw(const SkRecord&, SkCanvas*, SkPicture const* const drawablePicts[],
                   SkDrawable* const drawables[], int drawableCount,
@@ -112,6 +112,11 @@ void SkRecorder::reset(SkRecord* record, const SkRect& bounds) {
     SkASSERT(this->imageInfo().width() >= 0 && this->imageInfo().height() >= 0);
 }
 
+void SkRecorder::setRecord(SkRecord* record) {
+    this->forgetRecord();
+    fRecord = record;
+}
+
 void SkRecorder::forgetRecord() {
     fDrawableList.reset(nullptr);
     fApproxBytesUsedBySubPictures = 0;
@@ -90,6 +90,10 @@ public:
     // Make SkRecorder forget entirely about its SkRecord*; all calls to SkRecorder will fail.
     void forgetRecord();
 
+    // Record into another SkRecord from now on, keeping this canvas's save stack, matrix and clip
+    // as they are.  Forgets the drawables recorded so far, so the new SkRecord mustn't draw them.
+    void setRecord(SkRecord*);
+
     void willSave() override;
     SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec&) override;
     bool onDoSaveBehind(const SkRect*) override;
@@ -18,6 +18,7 @@
 #include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTo.h"
+#include "src/base/SkMathPriv.h"
 #include "src/core/SkCachedData.h"
 #include "src/core/SkChecksum.h"
 #include "src/core/SkImageFilter_Base.h"
@@ -29,6 +30,7 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 
 using namespace skia_private;
 
@@ -52,6 +54,10 @@ static inline bool SkShouldPostMessageToBus(
     #define SK_DEFAULT_IMAGE_CACHE_LIMIT     (32 * 1024 * 1024)
 #endif
 
+#ifndef SK_RESOURCE_CACHE_SHARD_COUNT
+    #define SK_RESOURCE_CACHE_SHARD_COUNT    16
+#endif
+
 void SkResourceCache::Key::init(void* nameSpace, uint64_t sharedID, size_t dataSize) {
     SkASSERT(SkAlign4(dataSize) == dataSize);
 
@@ -198,6 +204,9 @@ void SkResourceCache::remove(Rec* rec) {
 
     fTotalBytesUsed -= used;
     fCount -= 1;
+    if (fSharedBytesUsed) {
+        fSharedBytesUsed->fetch_sub(used, std::memory_order_relaxed);
+    }
 
     //SkDebugf("-RC count [%3d] bytes %d\n", fCount, fTotalBytesUsed);
 
@@ -217,7 +226,7 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
     int    countLimit;
 
     if (fDiscardableFactory) {
-        countLimit = SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT;
+        countLimit = std::max(SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT / fShardCount, 1);
         byteLimit = UINT32_MAX;  // no limit based on bytes
     } else {
         countLimit = SK_MaxS32; // no limit based on count
@@ -226,7 +235,8 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
 
     Rec* rec = fTail;
     while (rec) {
-        if (!forcePurge && fTotalBytesUsed < byteLimit && fCount < countLimit) {
+        if (!forcePurge && fTotalBytesUsed < byteLimit && fCount < countLimit &&
+            !(rec != fHead && this->overSharedBudget())) {
             break;
         }
 
@@ -238,6 +248,14 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
     }
 }
 
+bool SkResourceCache::overSharedBudget() const {
+    // A shard of the global cache only purges for the whole cache's sake down to its share of the
+    // budget, so that adding to one shard never empties it to make room for the others' recs.
+    return fSharedBytesUsed && !fDiscardableFactory &&
+           fSharedBytesUsed->load(std::memory_order_relaxed) >= fTotalByteLimit &&
+           fTotalBytesUsed > fTotalByteLimit / fShardCount;
+}
+
 //#define SK_TRACK_PURGE_SHAREDID_HITRATE
 
 #ifdef SK_TRACK_PURGE_SHAREDID_HITRATE
@@ -303,17 +321,20 @@ size_t SkResourceCache::setTotalByteLimit(size_t newLimit) {
     return prevLimit;
 }
 
-SkCachedData* SkResourceCache::newCachedData(size_t bytes) {
-    this->checkMessages();
-
-    if (fDiscardableFactory) {
-        SkDiscardableMemory* dm = fDiscardableFactory(bytes);
+static SkCachedData* new_cached_data(SkResourceCache::DiscardableFactory factory, size_t bytes) {
+    if (factory) {
+        SkDiscardableMemory* dm = factory(bytes);
         return dm ? new SkCachedData(bytes, dm) : nullptr;
     } else {
         return new SkCachedData(sk_malloc_throw(bytes), bytes);
     }
 }
 
+SkCachedData* SkResourceCache::newCachedData(size_t bytes) {
+    this->checkMessages();
+    return new_cached_data(fDiscardableFactory, bytes);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void SkResourceCache::release(Rec* rec) {
@@ -369,6 +390,9 @@ void SkResourceCache::addToHead(Rec* rec) {
     }
     fTotalBytesUsed += rec->bytesUsed();
     fCount += 1;
+    if (fSharedBytesUsed) {
+        fSharedBytesUsed->fetch_add(rec->bytesUsed(), std::memory_order_relaxed);
+    }
 
     this->validate();
 }
@@ -437,22 +461,29 @@ size_t SkResourceCache::getSingleAllocationByteLimit() const {
     return fSingleAllocationByteLimit;
 }
 
-size_t SkResourceCache::getEffectiveSingleAllocationByteLimit() const {
-    // fSingleAllocationByteLimit == 0 means the caller is asking for our default
-    size_t limit = fSingleAllocationByteLimit;
+static size_t effective_single_allocation_limit(size_t singleLimit,
+                                                size_t totalLimit,
+                                                bool discardable) {
+    // singleLimit == 0 means the caller is asking for our default
+    size_t limit = singleLimit;
 
     // if we're not discardable (i.e. we are fixed-budget) then cap the single-limit
     // to our budget.
-    if (nullptr == fDiscardableFactory) {
+    if (!discardable) {
         if (0 == limit) {
-            limit = fTotalByteLimit;
+            limit = totalLimit;
         } else {
-            limit = std::min(limit, fTotalByteLimit);
+            limit = std::min(limit, totalLimit);
         }
     }
     return limit;
 }
 
+size_t SkResourceCache::getEffectiveSingleAllocationByteLimit() const {
+    return effective_single_allocation_limit(fSingleAllocationByteLimit, fTotalByteLimit,
+                                             fDiscardableFactory != nullptr);
+}
+
 void SkResourceCache::checkMessages() {
     TArray<PurgeSharedIDMessage> msgs;
     fPurgeSharedIDInbox.poll(&msgs);
@@ -463,94 +494,153 @@ void SkResourceCache::checkMessages() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static SkMutex& resource_cache_mutex() {
-    static SkMutex& mutex = *(new SkMutex);
-    return mutex;
-}
+struct SkResourceCache::Shard {
+    SkMutex          fMutex;
+    SkResourceCache* fCache;  // Only use while holding fMutex.
+};
+
+static constexpr int kShardCount = SK_RESOURCE_CACHE_SHARD_COUNT;
+static_assert(SkIsPow2(kShardCount), "SK_RESOURCE_CACHE_SHARD_COUNT must be a power of two");
 
-/** Must hold resource_cache_mutex() when calling. */
-static SkResourceCache* get_cache() {
-    // resource_cache_mutex() is always held when this is called, so we don't need to be fancy in here.
-    resource_cache_mutex().assertHeld();
-    static SkResourceCache* gResourceCache = nullptr;
-    if (nullptr == gResourceCache) {
+static std::atomic<size_t> gGlobalBytesUsed{0};
+
+// Every shard has the same limits. They're kept here too, so reading them takes no shard's lock.
 #if defined(SK_USE_DISCARDABLE_SCALEDIMAGECACHE)
-        gResourceCache = new SkResourceCache(SkDiscardableMemory::Create);
+static const SkResourceCache::DiscardableFactory gGlobalDiscardableFactory =
+        SkDiscardableMemory::Create;
+static std::atomic<size_t> gGlobalByteLimit{0};
 #else
-        gResourceCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
+static const SkResourceCache::DiscardableFactory gGlobalDiscardableFactory = nullptr;
+static std::atomic<size_t> gGlobalByteLimit{SK_DEFAULT_IMAGE_CACHE_LIMIT};
 #endif
+static std::atomic<size_t> gGlobalSingleAllocationByteLimit{0};
+
+SkResourceCache::Shard* SkResourceCache::Shards() {
+    static Shard* gShards = [] {
+        Shard* shards = new Shard[kShardCount];
+        for (int i = 0; i < kShardCount; ++i) {
+            SkAutoMutexExclusive am(shards[i].fMutex);
+            if (gGlobalDiscardableFactory) {
+                shards[i].fCache = new SkResourceCache(gGlobalDiscardableFactory);
+            } else {
+                shards[i].fCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
+            }
+            shards[i].fCache->fSharedBytesUsed = &gGlobalBytesUsed;
+            shards[i].fCache->fShardCount = kShardCount;
+        }
+        return shards;
+    }();
+    return gShards;
+}
+
+SkResourceCache::Shard& SkResourceCache::ShardFor(const Key& key) {
+    // Each shard's hash table indexes by the low bits of the hash, so pick shards with the high.
+    static constexpr int kShardBits = SkNextLog2_portable(kShardCount);
+    return Shards()[kShardBits ? key.hash() >> (32 - kShardBits) : 0];
+}
+
+// Calls fn(cache) for each shard of the global cache in turn, holding that shard's lock.
+template <typename Shard, typename Fn>
+static void for_each_shard(Shard* shards, Fn&& fn) {
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexExclusive am(shards[i].fMutex);
+        fn(shards[i].fCache);
     }
-    return gResourceCache;
 }
 
 size_t SkResourceCache::GetTotalBytesUsed() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getTotalBytesUsed();
+    return gGlobalBytesUsed.load(std::memory_order_relaxed);
 }
 
 size_t SkResourceCache::GetTotalByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getTotalByteLimit();
+    return gGlobalByteLimit.load(std::memory_order_relaxed);
 }
 
 size_t SkResourceCache::SetTotalByteLimit(size_t newLimit) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->setTotalByteLimit(newLimit);
+    const size_t prevLimit = gGlobalByteLimit.exchange(newLimit, std::memory_order_relaxed);
+    for_each_shard(Shards(), [&](SkResourceCache* cache) { cache->setTotalByteLimit(newLimit); });
+    return prevLimit;
 }
 
 SkResourceCache::DiscardableFactory SkResourceCache::GetDiscardableFactory() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->discardableFactory();
+    return gGlobalDiscardableFactory;
 }
 
 SkCachedData* SkResourceCache::NewCachedData(size_t bytes) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->newCachedData(bytes);
+    // This doesn't touch any recs, so needs no shard. Each shard reads its purge messages
+    // itself when it's next used.
+    return new_cached_data(gGlobalDiscardableFactory, bytes);
 }
 
 void SkResourceCache::Dump() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->dump();
+    int count = 0;
+    size_t bytesUsed = 0;
+    for_each_shard(Shards(), [&](SkResourceCache* cache) {
+        cache->validate();
+        count += cache->fCount;
+        bytesUsed += cache->fTotalBytesUsed;
+    });
+    SkDebugf("SkResourceCache: count=%d bytes=%zu %s\n",
+             count, bytesUsed, gGlobalDiscardableFactory ? "discardable" : "malloc");
 }
 
 size_t SkResourceCache::SetSingleAllocationByteLimit(size_t size) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->setSingleAllocationByteLimit(size);
+    const size_t prevLimit = gGlobalSingleAllocationByteLimit.exchange(size,
+                                                                       std::memory_order_relaxed);
+    for_each_shard(Shards(), [&](SkResourceCache* cache) {
+        cache->setSingleAllocationByteLimit(size);
+    });
+    return prevLimit;
 }
 
 size_t SkResourceCache::GetSingleAllocationByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getSingleAllocationByteLimit();
+    return gGlobalSingleAllocationByteLimit.load(std::memory_order_relaxed);
 }
 
 size_t SkResourceCache::GetEffectiveSingleAllocationByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getEffectiveSingleAllocationByteLimit();
+    return effective_single_allocation_limit(
+            gGlobalSingleAllocationByteLimit.load(std::memory_order_relaxed),
+            gGlobalByteLimit.load(std::memory_order_relaxed),
+            gGlobalDiscardableFactory != nullptr);
 }
 
 void SkResourceCache::PurgeAll() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->purgeAll();
+    for_each_shard(Shards(), [](SkResourceCache* cache) { cache->purgeAll(); });
 }
 
 void SkResourceCache::CheckMessages() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->checkMessages();
+    for_each_shard(Shards(), [](SkResourceCache* cache) { cache->checkMessages(); });
 }
 
 bool SkResourceCache::Find(const Key& key, FindVisitor visitor, void* context) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->find(key, visitor, context);
+    Shard& shard = ShardFor(key);
+    SkAutoMutexExclusive am(shard.fMutex);
+    return shard.fCache->find(key, visitor, context);
 }
 
 void SkResourceCache::Add(Rec* rec, void* payload) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->add(rec, payload);
+    {
+        Shard& shard = ShardFor(rec->getKey());
+        SkAutoMutexExclusive am(shard.fMutex);
+        shard.fCache->add(rec, payload);
+    }
+    if (gGlobalDiscardableFactory) {
+        return;  // Each shard has its own count limit.
+    }
+    // If the cache is still over budget, that shard is down to its share of it, so others must
+    // have more than theirs. Take turns purging them, one lock at a time, until it's back under.
+    static std::atomic<int> gNextShard{0};
+    Shard* shards = Shards();
+    for (int i = 0; i < kShardCount && GetTotalBytesUsed() >= GetTotalByteLimit(); ++i) {
+        Shard& shard = shards[gNextShard.fetch_add(1, std::memory_order_relaxed) &
+                              (kShardCount - 1)];
+        SkAutoMutexExclusive am(shard.fMutex);
+        shard.fCache->purgeAsNeeded();
+    }
 }
 
 void SkResourceCache::VisitAll(Visitor visitor, void* context) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->visitAll(visitor, context);
+    for_each_shard(Shards(), [&](SkResourceCache* cache) { cache->visitAll(visitor, context); });
 }
 
 void SkResourceCache::PostPurgeSharedID(uint64_t sharedID) {
@@ -11,6 +11,7 @@
 #include "include/private/base/SkDebug.h"
 #include "src/core/SkMessageBus.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 
@@ -27,6 +28,10 @@ class SkTraceMemoryDump;
  *
  *  As a convenience, a global instance is also defined, which can be safely
  *  access across threads via the static methods (e.g. FindAndLock, etc.).
+ *  The global cache is split into shards, each with its own lock and LRU, so
+ *  that threads working with different keys rarely contend. The shards share
+ *  one byte budget: while the cache is over it, shards holding more than their
+ *  share purge their least recently used recs, but never the one added last.
  */
 class SkResourceCache {
 public:
@@ -275,6 +280,19 @@ private:
 
     SkMessageBus<PurgeSharedIDMessage, uint32_t>::Inbox fPurgeSharedIDInbox;
 
+    // When this is one shard of the global cache, fTotalByteLimit is the whole cache's budget and
+    // the bytes used by all the shards are tallied in *fSharedBytesUsed.
+    std::atomic<size_t>* fSharedBytesUsed = nullptr;
+    int fShardCount = 1;
+
+    // True if this is a shard of the global cache, the whole cache is over budget, and this shard
+    // has more than its share of it.
+    bool overSharedBudget() const;
+
+    struct Shard;
+    static Shard* Shards();
+    static Shard& ShardFor(const Key&);
+
     void checkMessages();
     void purgeAsNeeded(bool forcePurge = false);
 
@@ -62,6 +62,7 @@
 #include "src/sksl/transform/SkSLTransform.h"
 
 #include <algorithm>
+#include <atomic>
 
 using namespace skia_private;
 
@@ -215,11 +216,43 @@ sk_sp<const SkData> SkRuntimeEffectPriv::TransformUniforms(
     return data ? data : originalData;
 }
 
+static std::atomic<SkRuntimeEffect::RasterProgramCache*> gRasterProgramCache{nullptr};
+
+SkRuntimeEffect::RasterProgramCache* SkRuntimeEffect::SetRasterProgramCache(
+        RasterProgramCache* cache) {
+    return gRasterProgramCache.exchange(cache);
+}
+
+static sk_sp<SkData> raster_program_cache_key(const SkSL::Program& program, uint32_t flags) {
+    // The source, kind and flags determine the compiled program. (Options which only decide
+    // whether the source is accepted don't need to be part of the key.)
+    SkBinaryWriteBuffer buffer({});
+    buffer.writeUInt((uint32_t)program.fConfig->fKind);
+    buffer.writeUInt(flags);
+    buffer.writeString(*program.fSource);
+    return buffer.snapshotAsData();
+}
+
 const SkSL::RP::Program* SkRuntimeEffect::getRPProgram(SkSL::DebugTracePriv* debugTrace) const {
     // Lazily compile the program the first time `getRPProgram` is called.
     // By using an SkOnce, we avoid thread hazards and behave in a conceptually const way, but we
     // can avoid the cost of invoking the RP code generator until it's actually needed.
     fCompileRPProgramOnce([&] {
+        // Traced programs are one-offs, so they don't go through the program cache.
+        RasterProgramCache* cache =
+                (debugTrace || kRPEnableLiveTrace) ? nullptr : gRasterProgramCache.load();
+        sk_sp<SkData> cacheKey;
+        if (cache) {
+            cacheKey = raster_program_cache_key(*fBaseProgram, fFlags);
+            if (sk_sp<SkData> data = cache->load(*cacheKey)) {
+                const_cast<SkRuntimeEffect*>(this)->fRPProgram =
+                        SkSL::RP::Program::Deserialize(data->data(), data->size());
+                if (fRPProgram) {
+                    return;
+                }
+            }
+        }
+
         // We generally do not run the inliner when an SkRuntimeEffect program is initially created,
         // because the final compile to native shader code will do this. However, in SkRP, there's
         // no additional compilation occurring, so we need to manually inline here if we want the
@@ -258,6 +291,10 @@ const SkSL::RP::Program* SkRuntimeEffect::getRPProgram(SkSL::DebugTracePriv* deb
                 SkDebugf("----- RP unsupported -----\n\n");
             }
         }
+
+        if (cache && fRPProgram) {
+            cache->store(*cacheKey, *fRPProgram->serialize());
+        }
     });
 
     return fRPProgram.get();
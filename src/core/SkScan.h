@@ -13,7 +13,11 @@
 #include "include/core/SkRect.h"
 #include "include/private/base/SkFixed.h"
 
+#include <functional>
+
+class SkArenaAlloc;
 class SkBlitter;
+class SkExecutor;
 class SkPath;
 class SkRasterClip;
 class SkRegion;
@@ -50,6 +54,18 @@ public:
     static void AntiFillXRect(const SkXRect&, const SkRasterClip&, SkBlitter*);
     static void FillPath(const SkPath&, const SkRasterClip&, SkBlitter*);
     static void AntiFillPath(const SkPath&, const SkRasterClip&, SkBlitter*);
+
+    // Makes a blitter for one band of a banded draw, allocated from the arena.  It may be called
+    // from several threads at once, and each blitter is only used on the thread that made it.
+    using BandBlitterProc = std::function<SkBlitter*(SkArenaAlloc*)>;
+
+    // Like AntiFillPath(), but splits the path into horizontal bands and rasterizes them
+    // concurrently on executor.  Only done when gSkUseSparseStrips is set: its strips are
+    // independent of each other, so the pixels are the same as AntiFillPath() on one thread.
+    // Returns false without drawing anything if the path can't be split up (e.g. AAA is in use,
+    // it's an inverse fill, or it's too small to be worth it), in which case call AntiFillPath().
+    static bool AntiFillPathInBands(const SkPath&, const SkRasterClip&, SkExecutor&,
+                                    const BandBlitterProc&);
     static void FrameRect(const SkRect&, const SkPoint& strokeSize,
                           const SkRasterClip&, SkBlitter*);
     static void AntiFrameRect(const SkRect&, const SkPoint& strokeSize,
@@ -87,6 +103,11 @@ private:
     static void AntiHairLineRgn(const SkPoint[], int count, const SkRegion*, SkBlitter*);
     static void AAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR,
                             const SkIRect& clipBounds, bool forceRLE);
+    static void SparseStripFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR,
+                                    const SkIRect& clipBounds, bool forceRLE);
+    static void SparseStripFillPathInBands(const SkPath& path, const SkIRect& pathIR,
+                                           const SkIRect& clipBounds, bool forceRLE,
+                                           SkExecutor&, int bandCount, const BandBlitterProc&);
 };
 
 /** Assign an SkXRect from a SkIRect, by promoting the src rect's coordinates
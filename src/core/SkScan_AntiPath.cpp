@@ -11,14 +11,28 @@
 #include "include/core/SkRegion.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkMath.h"
+#include "src/base/SkArenaAlloc.h"
 #include "src/core/SkAAClip.h"
 #include "src/core/SkBlitter.h"
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkScan.h"
 #include "src/core/SkScanPriv.h"
 
+#include <algorithm>
 #include <cstdint>
 
+// Rasterize antialiased paths with SkScan::SparseStripFillPath() instead of AAA.
+extern bool gSkUseSparseStrips;
+
+// Our antialiasing can't handle a clip larger than 32767 (the runs[] uses int16_t for its index).
+static constexpr int32_t kMaxClipCoord = 32767;
+
+// AntiFillPathInBands() only splits up paths covering at least this many pixels, into bands at
+// least this tall.
+static constexpr int64_t kMinBandedPixels = 1 << 18;
+static constexpr int kMinBandHeight = 64;
+static constexpr int kMaxBands = 256;
+
 static SkIRect safeRoundOut(const SkRect& src) {
     // roundOut will pin huge floats to max/min int
     SkIRect dst = src.roundOut();
@@ -89,7 +103,7 @@ void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
     }
 
     // Our antialiasing can't handle a clip larger than 32767, so we restrict
-    // the clip to that limit here. (the runs[] uses int16_t for its index).
+    // the clip to that limit here.
     //
     // A more general solution (one that could also eliminate the need to
     // disable aa based on ir bounds (see overflows_short_shift) would be
@@ -97,7 +111,6 @@ void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
     SkRegion tmpClipStorage;
     const SkRegion* clipRgn = &origClip;
     {
-        static const int32_t kMaxClipCoord = 32767;
         const SkIRect& bounds = origClip.getBounds();
         if (bounds.fRight > kMaxClipCoord || bounds.fBottom > kMaxClipCoord) {
             SkIRect limit = { 0, 0, kMaxClipCoord, kMaxClipCoord };
@@ -126,13 +139,66 @@ void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
         sk_blit_above(blitter, ir, *clipRgn);
     }
 
-    SkScan::AAAFillPath(path, blitter, ir, clipRgn->getBounds(), forceRLE);
+    if (gSkUseSparseStrips) {
+        SkScan::SparseStripFillPath(path, blitter, ir, clipRgn->getBounds(), forceRLE);
+    } else {
+        SkScan::AAAFillPath(path, blitter, ir, clipRgn->getBounds(), forceRLE);
+    }
 
     if (isInverse) {
         sk_blit_below(blitter, ir, *clipRgn);
     }
 }
 
+bool SkScan::AntiFillPathInBands(const SkPath& path, const SkRasterClip& clip,
+                                 SkExecutor& executor, const BandBlitterProc& makeBlitter) {
+    if (clip.isEmpty() || !path.isFinite()) {
+        return true;
+    }
+    // Only sparse strips can be split into bands that don't depend on each other; AAA fills
+    // aren't, so that drawing with an executor gives the same pixels as drawing without one.
+    // Leave inverse fills, and the paths AntiFillPath() draws without antialiasing, to it too.
+    if (!gSkUseSparseStrips || path.isInverseFillType()) {
+        return false;
+    }
+    const SkIRect ir = safeRoundOut(path.getBounds());
+    const SkIRect& clipBounds = clip.getBounds();
+    SkIRect clippedIR;
+    if (ir.isEmpty() || !clippedIR.intersect(ir, clipBounds)) {
+        return true;
+    }
+    if (rect_overflows_short_shift(clippedIR, SK_SUPERSAMPLE_SHIFT) ||
+        clipBounds.fRight > kMaxClipCoord || clipBounds.fBottom > kMaxClipCoord) {
+        return false;
+    }
+
+    const int bandCount = std::min(clippedIR.height() / kMinBandHeight, kMaxBands);
+    if (bandCount < 2 || (int64_t)clippedIR.width() * clippedIR.height() < kMinBandedPixels) {
+        return false;
+    }
+
+    // Each band wraps its blitter in the same clipping AntiFillPath() would use.
+    SkScan::SparseStripFillPathInBands(
+            path, ir, clipBounds, /*forceRLE=*/!clip.isBW(), executor, bandCount,
+            [&](SkArenaAlloc* alloc) -> SkBlitter* {
+                SkBlitter* blitter = makeBlitter(alloc);
+                if (!blitter) {
+                    return nullptr;
+                }
+                const SkRegion* clipRgn;
+                if (clip.isBW()) {
+                    clipRgn = &clip.bwRgn();
+                } else {
+                    clipRgn = alloc->make<SkRegion>(clipBounds);
+                    SkAAClipBlitter* aaBlitter = alloc->make<SkAAClipBlitter>();
+                    aaBlitter->init(blitter, &clip.aaRgn());
+                    blitter = aaBlitter;
+                }
+                return alloc->make<SkScanClipper>(blitter, clipRgn, ir)->getBlitter();
+            });
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void SkScan::FillPath(const SkPath& path, const SkRasterClip& clip, SkBlitter* blitter) {
@@ -0,0 +1,502 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkPath.h"
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkTPin.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/base/SkVx.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkGeometry.h"
+#include "src/core/SkScan.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/*
+ * A sparse strip rasterizer, in the style of Vello's CPU renderer and Blend2D.
+ *
+ * We flatten the path to lines, clip them, and bin each line into every 4x4 tile of pixels it
+ * crosses.  Sorting the bins puts the tiles of each strip (a row of tiles) in order from left to
+ * right.  Walking a strip, each tile adds up the exact signed area to the right of each of its
+ * lines in every pixel, a row of four pixels at a time, on top of the winding carried over from
+ * the tiles to its left.  Between tiles that winding is constant along each row, so the gaps are
+ * solid spans.
+ *
+ * That's work in proportion to the number of tiles the edges touch, rather than sorting the edges
+ * and inserting runs on every scanline as AAA does, which pays off for large paths with thousands
+ * of edges.
+ *
+ * Like other rasterizers that add up area, pixels where edges cross aren't exact: the fill rule
+ * is applied to the sum of the edges' areas, not to each part of the pixel.  AAA has similar
+ * error there.
+ */
+
+bool gSkUseSparseStrips{false};
+
+namespace {
+
+constexpr int kTileWidth = 4;
+constexpr int kTileHeight = 4;
+
+// How far the lines we flatten curves into may stray from them, in pixels.
+constexpr float kTolerance = 0.25f;
+constexpr int kMaxCurveLines = 1 << 10;
+
+// Bins are (strip, tile, line) packed so that sorting them sorts the tiles of each strip.
+constexpr int kStripShift = 48;
+constexpr int kTileShift = 32;
+
+uint64_t make_bin(int strip, int tile, uint32_t line) {
+    return (uint64_t)strip << kStripShift | (uint64_t)tile << kTileShift | line;
+}
+int bin_strip(uint64_t bin) { return (int)(bin >> kStripShift); }
+int bin_tile(uint64_t bin) { return (int)(bin >> kTileShift & 0xFFFF); }
+uint32_t bin_line(uint64_t bin) { return (uint32_t)bin; }
+
+int curve_lines(float n) {
+    if (!(n < kMaxCurveLines)) {  // Also catches NaN.
+        return kMaxCurveLines;
+    }
+    return std::max(1, (int)std::ceil(n));
+}
+
+// The average over x from xa to xb of how much of each pixel is right of x, where dxa and dxb are
+// xa and xb relative to the left of each pixel.
+skvx::float4 coverage_right_of(const skvx::float4& dxa, const skvx::float4& dxb) {
+    const float dx = dxb[0] - dxa[0];
+    if (std::abs(dx) < 1.0f / 256) {
+        // Coverage is linear in x within a pixel, so its average is its value at the midpoint.
+        return skvx::pin(1 - (dxa + dxb) * 0.5f, skvx::float4(0), skvx::float4(1));
+    }
+    // F is the integral of the coverage right of x, so the average is (F(xb) - F(xa)) / (xb - xa).
+    auto F = [](const skvx::float4& d) {
+        const skvx::float4 u = skvx::pin(d, skvx::float4(0), skvx::float4(1));
+        return skvx::min(d, 0) + u - u * u * 0.5f;
+    };
+    return (F(dxb) - F(dxa)) * (1 / dx);
+}
+
+class SparseStripRasterizer {
+public:
+    SparseStripRasterizer(const SkIRect& bounds, SkPathFillType fillType)
+            : fLeft(bounds.fLeft)
+            , fTop(bounds.fTop)
+            , fRight(bounds.fRight)
+            , fBottom(bounds.fBottom)
+            , fTileCount((bounds.width() + kTileWidth - 1) / kTileWidth)
+            , fEvenOdd(SkPathFillType_IsEvenOdd(fillType))
+            , fInverse(SkPathFillType_IsInverse(fillType)) {}
+
+    int stripCount() const { return (fBottom - fTop + kTileHeight - 1) / kTileHeight; }
+
+    // Flattens and bins the path, ready to render.
+    void setPath(const SkPath& path) {
+        SkPath::Iter iter(path, /*forceClose=*/true);
+        SkAutoConicToQuads quadder;
+        SkPoint pts[4];
+        for (SkPath::Verb verb; (verb = iter.next(pts)) != SkPath::kDone_Verb;) {
+            switch (verb) {
+                case SkPath::kMove_Verb:
+                case SkPath::kClose_Verb:
+                    break;
+                case SkPath::kLine_Verb:
+                    this->addLine(pts[0], pts[1]);
+                    break;
+                case SkPath::kQuad_Verb:
+                    this->addQuad(pts);
+                    break;
+                case SkPath::kConic_Verb: {
+                    const SkPoint* quads = quadder.computeQuads(pts, iter.conicWeight(),
+                                                                kTolerance);
+                    for (int i = 0; i < quadder.countQuads(); i++) {
+                        this->addQuad(quads + 2 * i);
+                    }
+                    break;
+                }
+                case SkPath::kCubic_Verb:
+                    this->addCubic(pts);
+                    break;
+                case SkPath::kDone_Verb:
+                    SkUNREACHABLE;
+            }
+        }
+        std::sort(fBins.begin(), fBins.end());
+    }
+
+    // Renders strips [firstStrip, endStrip).  Each strip only depends on the path, so disjoint
+    // ranges of strips can be rendered at the same time, to different blitters.
+    void render(SkBlitter* blitter, bool keepRowOrder, int firstStrip, int endStrip) const {
+        const int width = fRight - fLeft;
+        Row rows[kTileHeight];
+        for (Row& row : rows) {
+            row.fRuns.reset(new int16_t[width + 1]);
+            row.fAlphas.reset(new SkAlpha[width + 1]);
+        }
+
+        const uint64_t* bin = std::lower_bound(fBins.data(), fBins.data() + fBins.size(),
+                                               make_bin(firstStrip, 0, 0));
+        const uint64_t* end = fBins.data() + fBins.size();
+        for (int strip = firstStrip; strip < endStrip; strip++) {
+            const uint64_t* stripEnd = bin;
+            while (stripEnd < end && bin_strip(*stripEnd) == strip) {
+                stripEnd++;
+            }
+            // Without any lines, a strip is entirely outside the path.
+            if (bin < stripEnd || fInverse) {
+                this->renderStrip(strip, bin, stripEnd, blitter, keepRowOrder, rows);
+            }
+            bin = stripEnd;
+        }
+    }
+
+private:
+    struct Line {
+        float x0, y0, x1, y1;  // y0 < y1
+        float winding;         // +1 if the path goes down the line, -1 if it goes up.
+    };
+
+    // The coverage of one row of pixels in a strip, in the format SkBlitter::blitAntiH() takes.
+    struct Row {
+        std::unique_ptr<int16_t[]> fRuns;
+        std::unique_ptr<SkAlpha[]> fAlphas;
+        int fNext = 0;         // The first pixel we have no run for yet.
+        int fLastRun = -1;
+        int fFirstCovered = -1;
+        int fCoveredEnd = 0;
+
+        void reset() {
+            fNext = 0;
+            fLastRun = -1;
+            fFirstCovered = -1;
+            fCoveredEnd = 0;
+        }
+
+        void add(int count, SkAlpha alpha) {
+            if (fLastRun >= 0 && fAlphas[fLastRun] == alpha) {
+                fRuns[fLastRun] += count;
+            } else {
+                fRuns[fNext] = count;
+                fAlphas[fNext] = alpha;
+                fLastRun = fNext;
+            }
+            if (alpha) {
+                if (fFirstCovered < 0) {
+                    fFirstCovered = fLastRun;
+                }
+                fCoveredEnd = fNext + count;
+            }
+            fNext += count;
+        }
+
+        void blit(SkBlitter* blitter, int left, int y) {
+            if (fFirstCovered < 0) {
+                return;
+            }
+            // Trim the uncovered runs from both ends.
+            fRuns[fCoveredEnd] = 0;
+            blitter->blitAntiH(left + fFirstCovered, y, fAlphas.get() + fFirstCovered,
+                               fRuns.get() + fFirstCovered);
+        }
+    };
+
+    void addLine(SkPoint a, SkPoint b) {
+        float winding = 1;
+        if (a.fY > b.fY) {
+            std::swap(a, b);
+            winding = -1;
+        }
+        if (!(a.fY < b.fY) || b.fY <= fTop || a.fY >= fBottom) {
+            return;
+        }
+
+        // Clip to the top and bottom.
+        const float dxdy = (b.fX - a.fX) / (b.fY - a.fY);
+        auto xAt = [&](float y) { return a.fX + (y - a.fY) * dxdy; };
+        float ys[4] = {std::max(a.fY, (float)fTop), 0, 0, 0};
+        const float bottom = std::min(b.fY, (float)fBottom);
+
+        // Split where the line crosses the left and right edges.  The parts left of the bounds
+        // still wind everything to their right, so they become vertical lines along the left
+        // edge.  The parts right of the bounds don't cover anything.
+        int count = 1;
+        if (dxdy != 0) {
+            for (float edge : {(float)fLeft, (float)fRight}) {
+                const float y = a.fY + (edge - a.fX) / dxdy;
+                if (ys[0] < y && y < bottom) {
+                    ys[count++] = y;
+                }
+            }
+            if (count == 3 && ys[1] > ys[2]) {
+                std::swap(ys[1], ys[2]);
+            }
+        }
+        ys[count] = bottom;
+
+        for (int i = 0; i < count; i++) {
+            const float y0 = ys[i],
+                        y1 = ys[i + 1];
+            if (!(y0 < y1)) {
+                continue;
+            }
+            const float mid = xAt((y0 + y1) * 0.5f);
+            if (mid >= fRight) {
+                continue;
+            }
+            if (mid <= fLeft) {
+                this->addClippedLine({(float)fLeft, y0, (float)fLeft, y1, winding});
+            } else {
+                this->addClippedLine({SkTPin(xAt(y0), (float)fLeft, (float)fRight), y0,
+                                      SkTPin(xAt(y1), (float)fLeft, (float)fRight), y1,
+                                      winding});
+            }
+        }
+    }
+
+    void addQuad(const SkPoint pts[3]) {
+        const SkQuadCoeff quad(pts);
+        // The curve strays at most |A|/(4n^2) from n equal steps of t.
+        const float a = SkPoint::Length(quad.fA[0], quad.fA[1]);
+        const int n = curve_lines(std::sqrt(a / (4 * kTolerance)));
+        this->addCurve(n, pts[0], pts[2], [&](float t) { return quad.eval(skvx::float2(t)); });
+    }
+
+    void addCubic(const SkPoint pts[4]) {
+        const SkCubicCoeff cubic(pts);
+        // The second derivative, 6At + 2B, is largest at one end or the other, and the curve strays
+        // at most an eighth of that over n^2 from n equal steps of t.
+        const skvx::float2 d0 = cubic.fB * 2,
+                           d1 = cubic.fA * 6 + cubic.fB * 2;
+        const float m = std::max(SkPoint::Length(d0[0], d0[1]), SkPoint::Length(d1[0], d1[1]));
+        const int n = curve_lines(std::sqrt(m / (8 * kTolerance)));
+        this->addCurve(n, pts[0], pts[3], [&](float t) { return cubic.eval(skvx::float2(t)); });
+    }
+
+    template <typename Eval>
+    void addCurve(int n, SkPoint start, SkPoint end, Eval&& eval) {
+        SkPoint prev = start;
+        for (int i = 1; i < n; i++) {
+            const skvx::float2 p = eval((float)i / n);
+            const SkPoint next = {p[0], p[1]};
+            this->addLine(prev, next);
+            prev = next;
+        }
+        this->addLine(prev, end);
+    }
+
+    int tileAt(float x) const {
+        return SkTPin((int)((x - fLeft) * (1.0f / kTileWidth)), 0, fTileCount - 1);
+    }
+
+    // Bins a line that's inside the bounds into every tile it crosses.
+    void addClippedLine(const Line& line) {
+        const uint32_t index = SkToU32(fLines.size());
+        fLines.push_back(line);
+
+        const float dxdy = (line.x1 - line.x0) / (line.y1 - line.y0);
+        const int first = (int)((line.y0 - fTop) * (1.0f / kTileHeight)),
+                  last = (int)std::ceil((line.y1 - fTop) * (1.0f / kTileHeight)) - 1;
+        for (int strip = first; strip <= last; strip++) {
+            const float ya = std::max(line.y0, (float)(fTop + strip * kTileHeight)),
+                        yb = std::min(line.y1, (float)(fTop + strip * kTileHeight + kTileHeight));
+            const float xa = line.x0 + (ya - line.y0) * dxdy,
+                        xb = line.x0 + (yb - line.y0) * dxdy;
+            const int right = this->tileAt(std::max(xa, xb));
+            for (int tile = this->tileAt(std::min(xa, xb)); tile <= right; tile++) {
+                fBins.push_back(make_bin(strip, tile, index));
+            }
+        }
+    }
+
+    // Adds the coverage of the part of the line in the tile at (left, top) to each pixel right of
+    // it, and the winding of that part to delta.
+    void accumulate(const Line& line, float left, float top,
+                    skvx::float4 area[kTileHeight], float delta[kTileHeight]) const {
+        float ya = std::max(line.y0, top),
+              yb = std::min(line.y1, top + kTileHeight);
+        const float dxdy = (line.x1 - line.x0) / (line.y1 - line.y0);
+        if (line.x0 != line.x1) {
+            // The parts of the line left and right of the tile belong to other tiles.
+            const float dydx = 1 / dxdy;
+            float y0 = line.y0 + (left - line.x0) * dydx,
+                  y1 = line.y0 + (left + kTileWidth - line.x0) * dydx;
+            if (y0 > y1) {
+                std::swap(y0, y1);
+            }
+            ya = std::max(ya, y0);
+            yb = std::min(yb, y1);
+        }
+        if (!(ya < yb)) {
+            return;
+        }
+
+        auto xAt = [&](float y) {
+            return SkTPin(line.x0 + (y - line.y0) * dxdy, left, left + kTileWidth);
+        };
+        const skvx::float4 pixelLeft = left + skvx::float4{0, 1, 2, 3};
+        for (int r = std::max(0, (int)(ya - top)); r < kTileHeight; r++) {
+            const float y0 = std::max(ya, top + r),
+                        y1 = std::min(yb, top + r + 1);
+            if (!(y0 < y1)) {
+                break;
+            }
+            const float dy = (y1 - y0) * line.winding;
+            area[r] += dy * coverage_right_of(xAt(y0) - pixelLeft, xAt(y1) - pixelLeft);
+            delta[r] += dy;
+        }
+    }
+
+    template <int N>
+    skvx::Vec<N, uint8_t> toAlpha(const skvx::Vec<N, float>& winding) const {
+        skvx::Vec<N, float> a = skvx::abs(winding);
+        if (fEvenOdd) {
+            a = skvx::abs(a - 2 * skvx::floor(a * 0.5f + 0.5f));
+        } else {
+            a = skvx::min(a, 1);
+        }
+        if (fInverse) {
+            a = 1 - a;
+        }
+        return skvx::cast<uint8_t>(skvx::cast<int32_t>(a * 255 + 0.5f));
+    }
+
+    // Fills pixels [from, to) of each row of a strip, where the winding doesn't change.
+    void fillGap(int from, int to, int y, int rows, const float backdrop[kTileHeight],
+                 SkBlitter* blitter, bool keepRowOrder, Row rowRuns[kTileHeight]) const {
+        if (from >= to) {
+            return;
+        }
+        const skvx::byte4 alphas = this->toAlpha(skvx::float4::Load(backdrop));
+        if (!keepRowOrder && to - from >= kTileWidth && rows == kTileHeight &&
+            skvx::all(alphas == 0xFF)) {
+            blitter->blitRect(fLeft + from, y, to - from, rows);
+            for (int r = 0; r < rows; r++) {
+                rowRuns[r].add(to - from, 0);
+            }
+            return;
+        }
+        for (int r = 0; r < rows; r++) {
+            rowRuns[r].add(to - from, alphas[r]);
+        }
+    }
+
+    void renderStrip(int strip, const uint64_t* bin, const uint64_t* end,
+                     SkBlitter* blitter, bool keepRowOrder, Row rowRuns[kTileHeight]) const {
+        const int y = fTop + strip * kTileHeight;
+        const int rows = std::min(kTileHeight, fBottom - y);
+        const int width = fRight - fLeft;
+        for (int r = 0; r < kTileHeight; r++) {
+            rowRuns[r].reset();
+        }
+
+        float backdrop[kTileHeight] = {0, 0, 0, 0};
+        int x = 0;
+        while (bin < end) {
+            const int tile = bin_tile(*bin);
+            const int tileLeft = tile * kTileWidth;
+            this->fillGap(x, tileLeft, y, rows, backdrop, blitter, keepRowOrder, rowRuns);
+
+            skvx::float4 area[kTileHeight];
+            float delta[kTileHeight] = {0, 0, 0, 0};
+            for (int r = 0; r < kTileHeight; r++) {
+                area[r] = backdrop[r];
+            }
+            for (; bin < end && bin_tile(*bin) == tile; bin++) {
+                this->accumulate(fLines[bin_line(*bin)], fLeft + tileLeft, y, area, delta);
+            }
+            for (int r = 0; r < kTileHeight; r++) {
+                backdrop[r] += delta[r];
+            }
+
+            const int tileWidth = std::min(kTileWidth, width - tileLeft);
+            for (int r = 0; r < rows; r++) {
+                const skvx::byte4 alphas = this->toAlpha(area[r]);
+                for (int i = 0; i < tileWidth; i++) {
+                    rowRuns[r].add(1, alphas[i]);
+                }
+            }
+            x = tileLeft + tileWidth;
+        }
+        this->fillGap(x, width, y, rows, backdrop, blitter, keepRowOrder, rowRuns);
+
+        for (int r = 0; r < rows; r++) {
+            rowRuns[r].blit(blitter, fLeft, y + r);
+        }
+    }
+
+    const int fLeft, fTop, fRight, fBottom;
+    const int fTileCount;
+    const bool fEvenOdd;
+    const bool fInverse;
+
+    std::vector<Line> fLines;
+    std::vector<uint64_t> fBins;
+};
+
+}  // namespace
+
+void SkScan::SparseStripFillPath(const SkPath& path,
+                                 SkBlitter* blitter,
+                                 const SkIRect& ir,
+                                 const SkIRect& clipBounds,
+                                 bool forceRLE) {
+    // Like AAA, an inverse fill covers the whole width of the clip, but only the rows of ir; the
+    // caller fills the rows above and below.
+    SkIRect bounds = clipBounds;
+    if (path.isInverseFillType()) {
+        bounds.fTop = std::max(bounds.fTop, ir.fTop);
+        bounds.fBottom = std::min(bounds.fBottom, ir.fBottom);
+    } else if (!bounds.intersect(ir)) {
+        return;
+    }
+    if (bounds.isEmpty()) {
+        return;
+    }
+
+    // An SkAAClip builder needs every row before the next, so forceRLE keeps us from blitting
+    // solid rects across the rows of a strip.
+    SparseStripRasterizer rasterizer(bounds, path.getFillType());
+    rasterizer.setPath(path);
+    rasterizer.render(blitter, forceRLE, 0, rasterizer.stripCount());
+}
+
+void SkScan::SparseStripFillPathInBands(const SkPath& path,
+                                        const SkIRect& ir,
+                                        const SkIRect& clipBounds,
+                                        bool forceRLE,
+                                        SkExecutor& executor,
+                                        int bandCount,
+                                        const BandBlitterProc& makeBlitter) {
+    SkASSERT(!path.isInverseFillType());
+    SkIRect bounds;
+    if (!bounds.intersect(ir, clipBounds)) {
+        return;
+    }
+
+    // The lines are built once and shared; each band renders its own strips to its own blitter.
+    SparseStripRasterizer rasterizer(bounds, path.getFillType());
+    rasterizer.setPath(path);
+
+    const int strips = rasterizer.stripCount();
+    bandCount = std::min(bandCount, strips);
+    SkTaskGroup(executor).batch(bandCount, [&](int band) {
+        SkSTArenaAlloc<4096> alloc;
+        if (SkBlitter* blitter = makeBlitter(&alloc)) {
+            rasterizer.render(blitter, forceRLE,
+                              strips * band / bandCount, strips * (band + 1) / bandCount);
+        }
+    });
+}
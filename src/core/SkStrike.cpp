@@ -211,24 +211,98 @@ const SkDrawable* SkStrike::mergeDrawable(SkGlyph* glyph, sk_sp<SkDrawable> draw
 
 void SkStrike::findIntercepts(const SkScalar bounds[2], SkScalar scale, SkScalar xPos,
                               SkGlyph* glyph, SkScalar* array, int* count) {
-    SkAutoMutexExclusive lock{fStrikeLock};
+    SkAutoSharedMutexExclusive lock{fStrikeLock};
     glyph->ensureIntercepts(bounds, scale, xPos, array, count, &fAlloc);
 }
 
+template <typename ID, typename IsReady>
+bool SkStrike::findReadyGlyphs(SkSpan<const ID> glyphIDs,
+                               const SkGlyph* results[],
+                               IsReady&& isReady) const {
+    for (auto glyphID : glyphIDs) {
+        const SkGlyphDigest* digest = fDigestForPackedGlyphID.find(SkPackedGlyphID{glyphID});
+        if (digest == nullptr) {
+            return false;
+        }
+        const SkGlyph* glyph = fGlyphForIndex[digest->index()];
+        if (!isReady(*digest, *glyph)) {
+            return false;
+        }
+        *results++ = glyph;
+    }
+    return true;
+}
+
+void SkStrike::glyphsFor(ActionType actionType,
+                         SkSpan<const SkPackedGlyphID> packedIDs,
+                         SkGlyphDigest digests[],
+                         const SkGlyph* glyphs[]) {
+    {
+        SkAutoSharedMutexShared lock{fStrikeLock};
+        size_t i = 0;
+        for (; i < packedIDs.size(); i++) {
+            const SkGlyphDigest* digest = fDigestForPackedGlyphID.find(packedIDs[i]);
+            if (digest == nullptr || digest->actionFor(actionType) == GlyphAction::kUnset) {
+                break;
+            }
+            digests[i] = *digest;
+            glyphs[i] = fGlyphForIndex[digest->index()];
+        }
+        if (i == packedIDs.size()) {
+            return;
+        }
+    }
+
+    Monitor m{this};
+    for (size_t i = 0; i < packedIDs.size(); i++) {
+        digests[i] = this->digestFor(actionType, packedIDs[i]);
+        glyphs[i] = this->glyph(digests[i]);
+    }
+}
+
 SkSpan<const SkGlyph*> SkStrike::metrics(
         SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) {
+    {
+        SkAutoSharedMutexShared lock{fStrikeLock};
+        // A glyph has all its metrics as soon as it has a digest.
+        if (this->findReadyGlyphs(glyphIDs, results,
+                                  [](const SkGlyphDigest&, const SkGlyph&) { return true; })) {
+            return {results, glyphIDs.size()};
+        }
+    }
+
     Monitor m{this};
     return this->internalPrepare(glyphIDs, kMetricsOnly, results);
 }
 
 SkSpan<const SkGlyph*> SkStrike::preparePaths(
         SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) {
+    {
+        SkAutoSharedMutexShared lock{fStrikeLock};
+        if (this->findReadyGlyphs(glyphIDs, results,
+                                  [](const SkGlyphDigest&, const SkGlyph& glyph) {
+                                      return glyph.setPathHasBeenCalled();
+                                  })) {
+            return {results, glyphIDs.size()};
+        }
+    }
+
     Monitor m{this};
     return this->internalPrepare(glyphIDs, kMetricsAndPath, results);
 }
 
 SkSpan<const SkGlyph*> SkStrike::prepareImages(
         SkSpan<const SkPackedGlyphID> glyphIDs, const SkGlyph* results[]) {
+    {
+        SkAutoSharedMutexShared lock{fStrikeLock};
+        if (this->findReadyGlyphs(glyphIDs, results,
+                                  [](const SkGlyphDigest&, const SkGlyph& glyph) {
+                                      return glyph.setImageHasBeenCalled();
+                                  })) {
+            return {results, glyphIDs.size()};
+        }
+    }
+
     const SkGlyph** cursor = results;
     Monitor m{this};
     for (auto glyphID : glyphIDs) {
@@ -242,6 +316,16 @@ SkSpan<const SkGlyph*> SkStrike::prepareImages(
 
 SkSpan<const SkGlyph*> SkStrike::prepareDrawables(
         SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) {
+    {
+        SkAutoSharedMutexShared lock{fStrikeLock};
+        if (this->findReadyGlyphs(glyphIDs, results,
+                                  [](const SkGlyphDigest&, const SkGlyph& glyph) {
+                                      return glyph.setDrawableHasBeenCalled();
+                                  })) {
+            return {results, glyphIDs.size()};
+        }
+    }
+
     const SkGlyph** cursor = results;
     {
         Monitor m{this};
@@ -275,7 +359,7 @@ void SkStrike::glyphIDsToDrawables(SkSpan<sktext::IDOrDrawable> idsOrDrawables)
 }
 
 void SkStrike::dump() const {
-    SkAutoMutexExclusive lock{fStrikeLock};
+    SkAutoSharedMutexShared lock{fStrikeLock};
     const SkTypeface* face = fScalerContext->getTypeface();
     const SkScalerContextRec& rec = fScalerContext->getRec();
     SkMatrix matrix;
@@ -293,7 +377,7 @@ void SkStrike::dump() const {
 }
 
 void SkStrike::dumpMemoryStatistics(SkTraceMemoryDump* dump) const {
-    SkAutoMutexExclusive lock{fStrikeLock};
+    SkAutoSharedMutexShared lock{fStrikeLock};
     const SkTypeface* face = fScalerContext->getTypeface();
     const SkScalerContextRec& rec = fScalerContext->getRec();
 
@@ -447,7 +531,7 @@ void SkStrike::updateMemoryUsage(size_t increase) {
     if (increase > 0) {
         // fRemoved and the cache's total memory are managed under the cache's lock. This allows
         // them to be accessed under LRU operation.
-        SkAutoMutexExclusive lock{fStrikeCache->fLock};
+        SkAutoSharedMutexExclusive lock{fStrikeCache->fLock};
         fMemoryUsed += increase;
         if (!fRemoved) {
             fStrikeCache->fTotalMemoryUsed += increase;
@@ -11,16 +11,17 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkTypes.h"
-#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkSpan_impl.h"
 #include "include/private/base/SkThreadAnnotations.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/base/SkSharedMutex.h"
 #include "src/core/SkGlyph.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkStrikeSpec.h"
 #include "src/core/SkTHash.h"
 #include "src/text/StrikeForGPU.h"
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
 #include <vector>
@@ -56,6 +57,14 @@ public:
     bool prepareForPath(SkGlyph*) override SK_REQUIRES(fStrikeLock);
     bool prepareForDrawable(SkGlyph*) override SK_REQUIRES(fStrikeLock);
 
+    // Fill digests and glyphs with the digest, with the action for actionType decided, and the
+    // glyph for each of packedIDs. When all the glyphs have been seen before with this action,
+    // the strike is only locked shared, so threads drawing the same text don't block each other.
+    void glyphsFor(skglyph::ActionType actionType,
+                   SkSpan<const SkPackedGlyphID> packedIDs,
+                   SkGlyphDigest digests[],
+                   const SkGlyph* glyphs[]) SK_EXCLUDES(fStrikeLock);
+
     bool mergeFromBuffer(SkReadBuffer& buffer) SK_EXCLUDES(fStrikeLock);
     static void FlattenGlyphsByType(SkWriteBuffer& buffer,
                                     SkSpan<SkGlyph> images,
@@ -131,7 +140,7 @@ public:
     void dump() const SK_EXCLUDES(fStrikeLock);
     void dumpMemoryStatistics(SkTraceMemoryDump* dump) const SK_EXCLUDES(fStrikeLock);
 
-    SkGlyph* glyph(SkGlyphDigest) SK_REQUIRES(fStrikeLock);
+    SkGlyph* glyph(SkGlyphDigest) SK_REQUIRES_SHARED(fStrikeLock);
 
 private:
     friend class SkStrikeCache;
@@ -150,6 +159,14 @@ private:
     bool mergeGlyphAndPathFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
     bool mergeGlyphAndDrawableFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
 
+    // Look up the glyph for each ID holding only a shared lock. Returns false as soon as a glyph
+    // is missing, or isReady(digest, glyph) says it still needs work done under the exclusive
+    // lock.
+    template <typename ID, typename IsReady>
+    bool findReadyGlyphs(SkSpan<const ID> glyphIDs,
+                         const SkGlyph* results[],
+                         IsReady&& isReady) const SK_REQUIRES_SHARED(fStrikeLock);
+
     // Maintain memory use statistics.
     void updateMemoryUsage(size_t increase) SK_EXCLUDES(fStrikeLock);
 
@@ -170,8 +187,9 @@ private:
     const SkStrikeSpec                fStrikeSpec;
     SkStrikeCache* const              fStrikeCache;
 
-    // This mutex provides protection for this specific SkStrike.
-    mutable SkMutex fStrikeLock;
+    // This mutex provides protection for this specific SkStrike. It is held shared when only
+    // finding glyphs that are already complete, and exclusively when adding to the strike.
+    mutable SkSharedMutex fStrikeLock;
 
     // Maps from a combined GlyphID and sub-pixel position to a SkGlyphDigest. The actual glyph is
     // stored in the fAlloc. The pointer to the glyph is stored fGlyphForIndex. The
@@ -203,6 +221,9 @@ private:
     std::unique_ptr<SkStrikePinner> fPinner;
     size_t                          fMemoryUsed{sizeof(SkStrike)};
     bool                            fRemoved{false};
+
+    // Set by lookups holding the SkStrikeCache's mutex shared, which can't reorder the LRU list.
+    std::atomic<bool>               fRecentlyUsed{false};
 };
 
 #endif  // SkStrike_DEFINED
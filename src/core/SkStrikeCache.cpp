@@ -12,12 +12,13 @@
 #include "include/core/SkTraceMemoryDump.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkDebug.h"
-#include "include/private/base/SkMutex.h"
+#include "src/base/SkSharedMutex.h"
 #include "src/core/SkDescriptor.h"
 #include "src/core/SkStrike.h"
 #include "src/core/SkStrikeSpec.h"
 
 #include <algorithm>
+#include <atomic>
 #include <utility>
 
 class SkScalerContext;
@@ -37,7 +38,14 @@ SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
 }
 
 auto SkStrikeCache::findOrCreateStrike(const SkStrikeSpec& strikeSpec) -> sk_sp<SkStrike> {
-    SkAutoMutexExclusive ac(fLock);
+    {
+        SkAutoSharedMutexShared ac(fLock);
+        if (sk_sp<SkStrike> strike = this->internalFindStrikeShared(strikeSpec.descriptor())) {
+            return strike;
+        }
+    }
+
+    SkAutoSharedMutexExclusive ac(fLock);
     sk_sp<SkStrike> strike = this->internalFindStrikeOrNull(strikeSpec.descriptor());
     if (strike == nullptr) {
         strike = this->internalCreateStrike(strikeSpec);
@@ -90,7 +98,14 @@ void SkStrikeCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
 }
 
 sk_sp<SkStrike> SkStrikeCache::findStrike(const SkDescriptor& desc) {
-    SkAutoMutexExclusive ac(fLock);
+    {
+        SkAutoSharedMutexShared ac(fLock);
+        if (sk_sp<SkStrike> strike = this->internalFindStrikeShared(desc)) {
+            return strike;
+        }
+    }
+
+    SkAutoSharedMutexExclusive ac(fLock);
     sk_sp<SkStrike> result = this->internalFindStrikeOrNull(desc);
     this->internalPurge();
     return result;
@@ -122,11 +137,53 @@ auto SkStrikeCache::internalFindStrikeOrNull(const SkDescriptor& desc) -> sk_sp<
     return sk_ref_sp(strikePtr);
 }
 
+auto SkStrikeCache::internalFindStrikeShared(const SkDescriptor& desc) -> sk_sp<SkStrike> {
+    // Over budget, the caller needs to purge, and that needs the exclusive lock anyway.
+    if (fTotalMemoryUsed > fCacheSizeLimit || fCacheCount > fCacheCountLimit) {
+        return nullptr;
+    }
+
+    if (fHead != nullptr && fHead->getDescriptor() == desc) { return sk_ref_sp(fHead); }
+
+    sk_sp<SkStrike>* strikeHandle = fStrikeLookup.find(desc);
+    if (strikeHandle == nullptr) { return nullptr; }
+    SkStrike* strikePtr = strikeHandle->get();
+    SkASSERT(strikePtr != nullptr);
+    // Check first so that threads sharing a hot strike don't keep writing to it.
+    if (!strikePtr->fRecentlyUsed.load(std::memory_order_relaxed)) {
+        strikePtr->fRecentlyUsed.store(true, std::memory_order_relaxed);
+    }
+    return sk_ref_sp(strikePtr);
+}
+
+void SkStrikeCache::internalPromoteRecentlyUsed() {
+    // Walk from the tail, so that the strikes moved to the head keep their order among themselves.
+    SkStrike* const oldHead = fHead;
+    SkStrike* strike = fTail;
+    while (strike != nullptr) {
+        SkStrike* prev = strike == oldHead ? nullptr : strike->fPrev;
+        SkStrike* next = strike->fNext;
+        if (strike->fRecentlyUsed.exchange(false, std::memory_order_relaxed) && strike != fHead) {
+            strike->fPrev->fNext = next;
+            if (next != nullptr) {
+                next->fPrev = strike->fPrev;
+            } else {
+                fTail = strike->fPrev;
+            }
+            fHead->fPrev = strike;
+            strike->fNext = fHead;
+            strike->fPrev = nullptr;
+            fHead = strike;
+        }
+        strike = prev;
+    }
+}
+
 sk_sp<SkStrike> SkStrikeCache::createStrike(
         const SkStrikeSpec& strikeSpec,
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner) {
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexExclusive ac(fLock);
     return this->internalCreateStrike(strikeSpec, maybeMetrics, std::move(pinner));
 }
 
@@ -142,32 +199,32 @@ auto SkStrikeCache::internalCreateStrike(
 }
 
 void SkStrikeCache::purgePinned(size_t minBytesNeeded) {
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexExclusive ac(fLock);
     this->internalPurge(minBytesNeeded, /* checkPinners= */ true);
 }
 
 void SkStrikeCache::purgeAll() {
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexExclusive ac(fLock);
     this->internalPurge(fTotalMemoryUsed, /* checkPinners= */ true);
 }
 
 size_t SkStrikeCache::getTotalMemoryUsed() const {
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexShared ac(fLock);
     return fTotalMemoryUsed;
 }
 
 int SkStrikeCache::getCacheCountUsed() const {
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexShared ac(fLock);
     return fCacheCount;
 }
 
 int SkStrikeCache::getCacheCountLimit() const {
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexShared ac(fLock);
     return fCacheCountLimit;
 }
 
 size_t SkStrikeCache::setCacheSizeLimit(size_t newLimit) {
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexExclusive ac(fLock);
 
     size_t prevLimit = fCacheSizeLimit;
     fCacheSizeLimit = newLimit;
@@ -176,7 +233,7 @@ size_t SkStrikeCache::setCacheSizeLimit(size_t newLimit) {
 }
 
 size_t  SkStrikeCache::getCacheSizeLimit() const {
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexShared ac(fLock);
     return fCacheSizeLimit;
 }
 
@@ -185,7 +242,7 @@ int SkStrikeCache::setCacheCountLimit(int newCount) {
         newCount = 0;
     }
 
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexExclusive ac(fLock);
 
     int prevCount = fCacheCountLimit;
     fCacheCountLimit = newCount;
@@ -194,7 +251,7 @@ int SkStrikeCache::setCacheCountLimit(int newCount) {
 }
 
 void SkStrikeCache::forEachStrike(std::function<void(const SkStrike&)> visitor) const {
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexShared ac(fLock);
 
     this->validate();
 
@@ -234,6 +291,8 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded, bool checkPinners) {
         return 0;
     }
 
+    this->internalPromoteRecentlyUsed();
+
     size_t  bytesFreed = 0;
     int     countFreed = 0;
 
@@ -10,8 +10,8 @@
 
 #include "include/core/SkRefCnt.h"
 #include "include/private/base/SkLoadUserConfig.h" // IWYU pragma: keep
-#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkThreadAnnotations.h"
+#include "src/base/SkSharedMutex.h"
 #include "src/core/SkStrike.h"
 #include "src/core/SkTHash.h"
 #include "src/text/StrikeForGPU.h"
@@ -78,6 +78,14 @@ private:
     friend class SkStrike;  // for SkStrike::updateDelta
     static constexpr char kGlyphCacheDumpName[] = "skia/sk_glyph_cache";
     sk_sp<SkStrike> internalFindStrikeOrNull(const SkDescriptor& desc) SK_REQUIRES(fLock);
+
+    // Find a strike without reordering the LRU list, so only a shared lock is needed. The strike
+    // is marked as recently used instead, and internalPurge catches the list up before evicting.
+    // Returns nullptr if the strike is missing, or if the cache is over budget and must purge.
+    sk_sp<SkStrike> internalFindStrikeShared(const SkDescriptor& desc) SK_REQUIRES_SHARED(fLock);
+
+    // Move the strikes marked by internalFindStrikeShared to the head of the LRU list.
+    void internalPromoteRecentlyUsed() SK_REQUIRES(fLock);
     sk_sp<SkStrike> internalCreateStrike(
             const SkStrikeSpec& strikeSpec,
             SkFontMetrics* maybeMetrics = nullptr,
@@ -93,11 +101,12 @@ private:
     size_t internalPurge(size_t minBytesNeeded = 0, bool checkPinners = false) SK_REQUIRES(fLock);
 
     // A simple accounting of what each glyph cache reports and the strike cache total.
-    void validate() const SK_REQUIRES(fLock);
+    void validate() const SK_REQUIRES_SHARED(fLock);
 
     void forEachStrike(std::function<void(const SkStrike&)> visitor) const SK_EXCLUDES(fLock);
 
-    mutable SkMutex fLock;
+    // Lookups of strikes that are already cached only take this lock shared.
+    mutable SkSharedMutex fLock;
     SkStrike* fHead SK_GUARDED_BY(fLock) {nullptr};
     SkStrike* fTail SK_GUARDED_BY(fLock) {nullptr};
     struct StrikeTraits {
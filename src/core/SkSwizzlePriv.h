@@ -31,6 +31,22 @@ namespace SkOpts {
                            grayA_to_RGBA,   // i.e. expand to color channels
                            grayA_to_rgbA;   // i.e. expand to color channels and premultiply
 
+    // Swizzle 16-bit big-endian components (as in PNG) into 8888 by keeping their high bytes.
+    extern Swizzle_8888_u8 RGB16_to_RGB1,   // i.e. narrow and insert an opaque alpha
+                           RGB16_to_BGR1,   // i.e. narrow, swap RB and insert an opaque alpha
+                           RGBA16_to_RGBA,  // i.e. just narrow
+                           RGBA16_to_BGRA;  // i.e. narrow and swap RB
+
+    // Look up color table indices.  index_to_8888 reads a byte per index.  small_index_to_8888
+    // reads 1, 2 or 4 bits per index, starting from the most significant bits of src[0], and
+    // only looks at the first (1 << bitsPerIndex) entries of the table.
+    using Swizzle_8888_index = void (*)(uint32_t*, const uint8_t*, int, const uint32_t* table);
+    extern Swizzle_8888_index index_to_8888;
+
+    using Swizzle_8888_small_index = void (*)(uint32_t*, const uint8_t*, int, int bitsPerIndex,
+                                              const uint32_t* table);
+    extern Swizzle_8888_small_index small_index_to_8888;
+
     void Init_Swizzler();
 }  // namespace SkOpts
 
@@ -34,6 +34,11 @@ namespace SkOpts {
         grayA_to_rgbA         = lasx::grayA_to_rgbA;
         inverted_CMYK_to_RGB1 = lasx::inverted_CMYK_to_RGB1;
         inverted_CMYK_to_BGR1 = lasx::inverted_CMYK_to_BGR1;
+        RGB16_to_RGB1         = lasx::RGB16_to_RGB1;
+        RGB16_to_BGR1         = lasx::RGB16_to_BGR1;
+        RGBA16_to_RGBA        = lasx::RGBA16_to_RGBA;
+        RGBA16_to_BGRA        = lasx::RGBA16_to_BGRA;
+        small_index_to_8888   = lasx::small_index_to_8888;
     }
 }  // namespace SkOpts
 
@@ -8,7 +8,8 @@
 
 #include "include/core/SkExecutor.h"
 
-#include <type_traits>
+#include <algorithm>
+#include <thread>
 #include <utility>
 
 SkTaskGroup::SkTaskGroup(SkExecutor& executor) : fPending(0), fExecutor(executor) {}
@@ -21,15 +22,56 @@ void SkTaskGroup::add(std::function<void(void)> fn) {
     });
 }
 
+namespace {
+
+// What every task of one batch() shares.  Each task holds just a pointer to it, so that tasks are
+// small enough for std::function to store without allocating.  Whichever task finishes the last
+// indices frees it.
+struct Batch {
+    SkExecutor*              fExecutor;
+    std::atomic<int32_t>*    fPending;
+    std::function<void(int)> fFn;
+    int                      fGrain;      // Ranges this size or smaller run in a single task.
+    std::atomic<int>         fRemaining;  // Indices not yet run.
+};
+
+}  // namespace
+
+// Runs fn(i) for i in [lo,hi).  Rather than adding every index to the executor up front, we
+// repeatedly hand the lower half of the range back to the executor and keep the upper half,
+// so idle threads pick up (and further split) large chunks while the executor only ever holds
+// O(log N) tasks per thread.  Once a range is down to the batch's grain size it runs in a loop.
+// Under a trivial executor this still runs in ascending order.
+static void run_range(Batch* batch, int lo, int hi) {
+    while (hi - lo > batch->fGrain) {
+        int mid = lo + (hi - lo) / 2;
+        batch->fExecutor->add([batch, lo, mid] { run_range(batch, lo, mid); });
+        lo = mid;
+    }
+    for (int i = lo; i < hi; i++) {
+        batch->fFn(i);
+    }
+
+    // Once fPending reaches zero the group may be gone, so the batch must be freed first.
+    std::atomic<int32_t>* pending = batch->fPending;
+    if (batch->fRemaining.fetch_sub(hi - lo, std::memory_order_acq_rel) == hi - lo) {
+        delete batch;
+    }
+    pending->fetch_add(-(hi - lo), std::memory_order_release);
+}
+
 void SkTaskGroup::batch(int N, std::function<void(int)> fn) {
-    // TODO: I really thought we had some sort of more clever chunking logic.
-    fPending.fetch_add(+N, std::memory_order_relaxed);
-    for (int i = 0; i < N; i++) {
-        fExecutor.add([fn, i, this] {
-            fn(i);
-            fPending.fetch_add(-1, std::memory_order_release);
-        });
+    if (N <= 0) {
+        return;
     }
+    // A few tasks per core is enough to balance the load, and more only adds overhead.
+    static const int kCores = std::max(1, (int)std::thread::hardware_concurrency());
+    static constexpr int kTasksPerCore = 4;
+
+    fPending.fetch_add(+N, std::memory_order_relaxed);
+    auto batch = new Batch{&fExecutor, &fPending, std::move(fn),
+                           std::max(1, N / (kCores * kTasksPerCore)), {N}};
+    fExecutor.add([batch, N] { run_range(batch, 0, N); });
 }
 
 bool SkTaskGroup::done() const {
@@ -41,8 +83,12 @@ void SkTaskGroup::wait() {
     // This lets SkTaskGroups nest arbitrarily deep on a single SkExecutor:
     // no thread ever blocks waiting for others to do its work.
     // (We may end up doing work that's not part of our task group.  That's fine.)
-    while (!this->done()) {
+    for (int spins = 1; !this->done(); spins++) {
         fExecutor.borrow();
+        if (spins % 64 == 0) {
+            // Whatever's left may be running on a thread that's waiting for a core.
+            std::this_thread::yield();
+        }
     }
 }
 
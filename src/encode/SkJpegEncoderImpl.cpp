@@ -11,8 +11,10 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkYUVAInfo.h"
@@ -23,21 +25,28 @@
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkNoncopyable.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
 #include "src/base/SkMSAN.h"
 #include "src/codec/SkJpegConstants.h"
 #include "src/codec/SkJpegPriv.h"
 #include "src/core/SkConvertPixels.h"
 #include "src/core/SkImageInfoPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/encode/SkImageEncoderFns.h"
 #include "src/encode/SkImageEncoderPriv.h"
 #include "src/encode/SkJPEGWriteUtility.h"
 #include "src/image/SkImage_Base.h"
 
+#include <algorithm>
+#include <atomic>
 #include <csetjmp>
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <optional>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 class GrDirectContext;
 class SkColorSpace;
@@ -52,9 +61,11 @@ public:
     /*
      * Create the decode manager
      * Does not take ownership of stream.
+     * If forBands, the output can be joined with other bands of the same image (see
+     * SkJpegEncoderImpl::EncodeInBands()).
      */
-    static std::unique_ptr<SkJpegEncoderMgr> Make(SkWStream* stream) {
-        return std::unique_ptr<SkJpegEncoderMgr>(new SkJpegEncoderMgr(stream));
+    static std::unique_ptr<SkJpegEncoderMgr> Make(SkWStream* stream, bool forBands = false) {
+        return std::unique_ptr<SkJpegEncoderMgr>(new SkJpegEncoderMgr(stream, forBands));
     }
 
     bool initializeRGB(const SkImageInfo&,
@@ -71,10 +82,16 @@ public:
     bool shouldUseColorXform() { return fUseColorXform; }
     bool colorTransformProc(void* dst, const void* src, int width);
 
+    // The height of a row of MCUs, valid once initialized. A single component scan isn't
+    // interleaved, so its MCUs are single blocks.
+    int mcuRowHeight() const {
+        return fCInfo.num_components == 1 ? DCTSIZE : DCTSIZE * fCInfo.max_v_samp_factor;
+    }
+
     ~SkJpegEncoderMgr() { jpeg_destroy_compress(&fCInfo); }
 
 private:
-    SkJpegEncoderMgr(SkWStream* stream) : fDstMgr(stream) {
+    SkJpegEncoderMgr(SkWStream* stream, bool forBands) : fDstMgr(stream), fForBands(forBands) {
         fCInfo.err = jpeg_std_error(&fErrMgr);
         fErrMgr.error_exit = skjpeg_error_exit;
         jpeg_create_compress(&fCInfo);
@@ -85,6 +102,7 @@ private:
     jpeg_compress_struct fCInfo;
     skjpeg_error_mgr fErrMgr;
     skjpeg_destination_mgr fDstMgr;
+    const bool fForBands;
 
     std::optional<SkImageInfo> fSrcInfo;
     std::optional<SkImageInfo> fDstInfo;
@@ -280,10 +298,18 @@ bool SkJpegEncoderMgr::initializeYUV(const SkYUVAPixmapInfo& srcInfo,
 void SkJpegEncoderMgr::initializeCommon(
         const SkJpegEncoder::Options& options,
         const SkJpegMetadataEncoder::SegmentList& metadataSegments) {
-    // Tells libjpeg-turbo to compute optimal Huffman coding tables
-    // for the image.  This improves compression at the cost of
-    // slower encode performance.
-    fCInfo.optimize_coding = TRUE;
+    if (fForBands) {
+        // Bands are joined into one scan, so they must share Huffman tables (the standard ones),
+        // and each MCU row must start a new restart interval so the entropy coder starts afresh
+        // at the top of every band.
+        fCInfo.optimize_coding = FALSE;
+        fCInfo.restart_in_rows = 1;
+    } else {
+        // Tells libjpeg-turbo to compute optimal Huffman coding tables
+        // for the image.  This improves compression at the cost of
+        // slower encode performance.
+        fCInfo.optimize_coding = TRUE;
+    }
 
     jpeg_set_quality(&fCInfo, options.fQuality, TRUE);
     jpeg_start_compress(&fCInfo, TRUE);
@@ -301,11 +327,12 @@ std::unique_ptr<SkEncoder> SkJpegEncoderImpl::MakeYUV(
         const SkYUVAPixmaps& srcYUVA,
         const SkColorSpace* srcYUVAColorSpace,
         const SkJpegEncoder::Options& options,
-        const SkJpegMetadataEncoder::SegmentList& metadataSegments) {
+        const SkJpegMetadataEncoder::SegmentList& metadataSegments,
+        bool forBands) {
     if (!srcYUVA.isValid()) {
         return nullptr;
     }
-    std::unique_ptr<SkJpegEncoderMgr> encoderMgr = SkJpegEncoderMgr::Make(dst);
+    std::unique_ptr<SkJpegEncoderMgr> encoderMgr = SkJpegEncoderMgr::Make(dst, forBands);
     skjpeg_error_mgr::AutoPushJmpBuf jmp(encoderMgr->errorMgr());
     if (setjmp(jmp)) {
         return nullptr;
@@ -322,11 +349,12 @@ std::unique_ptr<SkEncoder> SkJpegEncoderImpl::MakeRGB(
         SkWStream* dst,
         const SkPixmap& src,
         const SkJpegEncoder::Options& options,
-        const SkJpegMetadataEncoder::SegmentList& metadataSegments) {
+        const SkJpegMetadataEncoder::SegmentList& metadataSegments,
+        bool forBands) {
     if (!SkPixmapIsValid(src)) {
         return nullptr;
     }
-    std::unique_ptr<SkJpegEncoderMgr> encoderMgr = SkJpegEncoderMgr::Make(dst);
+    std::unique_ptr<SkJpegEncoderMgr> encoderMgr = SkJpegEncoderMgr::Make(dst, forBands);
     skjpeg_error_mgr::AutoPushJmpBuf jmp(encoderMgr->errorMgr());
     if (setjmp(jmp)) {
         return nullptr;
@@ -399,9 +427,267 @@ bool SkJpegEncoderImpl::onEncodeRows(int numRows) {
     return true;
 }
 
+namespace {
+
+constexpr uint8_t kMarkerSOF0 = 0xC0;
+constexpr uint8_t kMarkerSOF1 = 0xC1;
+constexpr uint8_t kMarkerRST0 = 0xD0;
+constexpr uint8_t kMarkerRST7 = 0xD7;
+
+// Bands are at least this many MCU rows tall, so that joining them stays cheap next to encoding
+// them, and there are at most kMaxBands of them.
+constexpr int kMinBandMcuRows = 16;
+constexpr int kMaxBands = 64;
+
+// Returns the offset of the entropy-coded data that follows the start of scan in a jpeg we wrote,
+// or 0 if it can't be found. If heightOffset is non-null, it's set to the offset of the image
+// height in the frame header.
+size_t find_scan_data(const SkData& jpeg, size_t* heightOffset) {
+    const uint8_t* bytes = jpeg.bytes();
+    size_t offset = kJpegMarkerCodeSize;  // Skip the start of image.
+    while (offset + kJpegMarkerCodeSize + kJpegSegmentParameterLengthSize <= jpeg.size()) {
+        if (bytes[offset] != 0xFF) {
+            return 0;
+        }
+        const uint8_t marker = bytes[offset + 1];
+        const size_t segmentEnd = offset + kJpegMarkerCodeSize + ((bytes[offset + 2] << 8) |
+                                                                  bytes[offset + 3]);
+        if ((marker == kMarkerSOF0 || marker == kMarkerSOF1) && heightOffset) {
+            // The height follows the parameter length and sample precision.
+            *heightOffset = offset + kJpegMarkerCodeSize + kJpegSegmentParameterLengthSize + 1;
+        }
+        if (marker == kJpegMarkerStartOfScan) {
+            return segmentEnd;
+        }
+        offset = segmentEnd;
+    }
+    return 0;
+}
+
+// Returns the offset of each band's entropy-coded data, or nothing if any band isn't a jpeg we
+// wrote for bands. The header, up to the first band's offset, has to have the image height too.
+std::vector<size_t> find_band_scans(const std::vector<sk_sp<SkData>>& bands,
+                                    size_t* heightOffset) {
+    std::vector<size_t> starts(bands.size());
+    for (size_t i = 0; i < bands.size(); i++) {
+        const SkData& band = *bands[i];
+        starts[i] = find_scan_data(band, i == 0 ? heightOffset : nullptr);
+        // Everything but the end of image is joined.
+        const size_t end = band.size() - kJpegMarkerCodeSize;
+        if (!starts[i] || starts[i] > end || band.bytes()[end] != 0xFF ||
+            band.bytes()[end + 1] != kJpegMarkerEndOfImage) {
+            return {};
+        }
+    }
+    if (!*heightOffset) {
+        return {};
+    }
+    return starts;
+}
+
+// Joins bands of an image, encoded by SkJpegEncoderMgrs made forBands, into a single jpeg. The
+// header is the first band's, with the height of the whole image. The scans are concatenated,
+// with a restart marker between each, and all the restart markers renumbered to count up from
+// the top of the image. starts are from find_band_scans(), so all that can fail is writing.
+bool join_bands(SkWStream* dst,
+                const std::vector<sk_sp<SkData>>& bands,
+                const std::vector<size_t>& starts,
+                size_t heightOffset,
+                int height) {
+    const uint8_t heightBytes[2] = {(uint8_t)(height >> 8), (uint8_t)(height & 0xFF)};
+    if (!dst->write(bands[0]->bytes(), heightOffset) ||
+        !dst->write(heightBytes, sizeof(heightBytes)) ||
+        !dst->write(bands[0]->bytes() + heightOffset + 2, starts[0] - heightOffset - 2)) {
+        return false;
+    }
+
+    int restart = 0;
+    auto writeRestart = [&]() {
+        const uint8_t rst[2] = {0xFF, (uint8_t)(kMarkerRST0 + restart)};
+        restart = (restart + 1) % 8;
+        return dst->write(rst, sizeof(rst));
+    };
+    for (size_t i = 0; i < bands.size(); i++) {
+        const uint8_t* bytes = bands[i]->bytes();
+        const size_t start = starts[i];
+        const size_t end = bands[i]->size() - kJpegMarkerCodeSize;
+        if (i > 0 && !writeRestart()) {
+            return false;
+        }
+        // Any 0xFF in the entropy-coded data is followed by a stuffed zero, so every other 0xFF
+        // starts a marker, and libjpeg writes only restart markers in the scan.
+        size_t written = start;
+        for (size_t j = start; j + 1 < end; j++) {
+            if (bytes[j] == 0xFF && kMarkerRST0 <= bytes[j + 1] && bytes[j + 1] <= kMarkerRST7) {
+                if (!dst->write(bytes + written, j - written) || !writeRestart()) {
+                    return false;
+                }
+                written = j + kJpegMarkerCodeSize;
+                j++;
+            }
+        }
+        if (!dst->write(bytes + written, end - written)) {
+            return false;
+        }
+    }
+    const uint8_t eoi[2] = {0xFF, kJpegMarkerEndOfImage};
+    return dst->write(eoi, sizeof(eoi));
+}
+
+// Splits rows [0, height) into bands of whole MCU rows. Returns the first row of each band, then
+// height, or nothing if there would only be one band.
+std::vector<int> choose_bands(int height, int mcuRowHeight) {
+    const int mcuRows = (height + mcuRowHeight - 1) / mcuRowHeight;
+    const int bandMcuRows = std::max(kMinBandMcuRows, (mcuRows + kMaxBands - 1) / kMaxBands);
+    if (mcuRows <= bandMcuRows) {
+        return {};
+    }
+    std::vector<int> tops;
+    for (int row = 0; row < mcuRows; row += bandMcuRows) {
+        tops.push_back(row * mcuRowHeight);
+    }
+    tops.push_back(height);
+    return tops;
+}
+
+// Encodes each band in parallel, with the metadata only in the first, then joins them. Returns
+// std::nullopt, having written nothing, if any band can't be encoded or joined.
+template <typename EncodeBand>
+std::optional<bool> encode_bands(SkWStream* dst,
+                  SkExecutor* executor,
+                  const std::vector<int>& tops,
+                  const SkJpegMetadataEncoder::SegmentList& metadataSegments,
+                  EncodeBand&& encodeBand) {
+    const int bandCount = SkToInt(tops.size()) - 1;
+    std::vector<sk_sp<SkData>> bands(bandCount);
+    std::atomic<bool> failed{false};
+    const SkJpegMetadataEncoder::SegmentList noMetadata;
+    SkTaskGroup(*executor).batch(bandCount, [&](int i) {
+        SkDynamicMemoryWStream stream;
+        if (!encodeBand(&stream, tops[i], tops[i + 1], i == 0 ? metadataSegments : noMetadata)) {
+            failed = true;
+            return;
+        }
+        bands[i] = stream.detachAsData();
+    });
+    if (failed) {
+        return std::nullopt;
+    }
+    size_t heightOffset = 0;
+    const std::vector<size_t> starts = find_band_scans(bands, &heightOffset);
+    if (starts.empty()) {
+        return std::nullopt;
+    }
+    return join_bands(dst, bands, starts, heightOffset, tops.back());
+}
+
+}  // namespace
+
+std::optional<bool> SkJpegEncoderImpl::EncodeInBands(SkWStream* dst,
+                                                     const SkPixmap& src,
+                                                     const SkJpegEncoder::Options& options,
+                                                     const SkJpegMetadataEncoder::SegmentList& metadataSegments) {
+    SkASSERT(options.fExecutor);
+    if (!SkPixmapIsValid(src)) {
+        return std::nullopt;
+    }
+    int mcuRowHeight;
+    {
+        // Set up an encoder for the whole image, just to see how tall its MCUs are.
+        SkNullWStream nullStream;
+        std::unique_ptr<SkJpegEncoderMgr> encoderMgr = SkJpegEncoderMgr::Make(&nullStream, true);
+        skjpeg_error_mgr::AutoPushJmpBuf jmp(encoderMgr->errorMgr());
+        if (setjmp(jmp) || !encoderMgr->initializeRGB(src.info(), options, {})) {
+            return std::nullopt;
+        }
+        mcuRowHeight = encoderMgr->mcuRowHeight();
+    }
+    const std::vector<int> tops = choose_bands(src.height(), mcuRowHeight);
+    if (tops.empty()) {
+        return std::nullopt;
+    }
+    return encode_bands(dst, options.fExecutor, tops, metadataSegments,
+            [&](SkWStream* stream, int top, int bottom,
+                const SkJpegMetadataEncoder::SegmentList& segments) {
+        SkPixmap band;
+        SkAssertResult(src.extractSubset(&band, SkIRect::MakeLTRB(0, top, src.width(), bottom)));
+        auto encoder = MakeRGB(stream, band, options, segments, true);
+        return encoder && encoder->encodeRows(band.height());
+    });
+}
+
+std::optional<bool> SkJpegEncoderImpl::EncodeInBands(SkWStream* dst,
+                                                     const SkYUVAPixmaps& srcYUVA,
+                                                     const SkColorSpace* srcYUVAColorSpace,
+                                                     const SkJpegEncoder::Options& options,
+                                                     const SkJpegMetadataEncoder::SegmentList& metadataSegments) {
+    SkASSERT(options.fExecutor);
+    // Bands are cut from the planes as they're stored, which is only the image's rows when it
+    // isn't rotated.
+    const SkYUVAInfo& yuvaInfo = srcYUVA.yuvaInfo();
+    if (!srcYUVA.isValid() || yuvaInfo.origin() != kTopLeft_SkEncodedOrigin) {
+        return std::nullopt;
+    }
+    int mcuRowHeight;
+    {
+        SkNullWStream nullStream;
+        std::unique_ptr<SkJpegEncoderMgr> encoderMgr = SkJpegEncoderMgr::Make(&nullStream, true);
+        skjpeg_error_mgr::AutoPushJmpBuf jmp(encoderMgr->errorMgr());
+        if (setjmp(jmp) || !encoderMgr->initializeYUV(srcYUVA.pixmapsInfo(), options, {})) {
+            return std::nullopt;
+        }
+        mcuRowHeight = encoderMgr->mcuRowHeight();
+    }
+    const std::vector<int> tops = choose_bands(yuvaInfo.height(), mcuRowHeight);
+    if (tops.empty()) {
+        return std::nullopt;
+    }
+    return encode_bands(dst, options.fExecutor, tops, metadataSegments,
+            [&](SkWStream* stream, int top, int bottom,
+                const SkJpegMetadataEncoder::SegmentList& segments) {
+        const SkYUVAInfo bandInfo({yuvaInfo.width(), bottom - top},
+                                  yuvaInfo.planeConfig(),
+                                  yuvaInfo.subsampling(),
+                                  yuvaInfo.yuvColorSpace(),
+                                  kTopLeft_SkEncodedOrigin,
+                                  yuvaInfo.sitingX(),
+                                  yuvaInfo.sitingY());
+        // Bands start on MCU rows, which start on whole rows of every plane.
+        SkPixmap planes[SkYUVAInfo::kMaxPlanes];
+        for (int i = 0; i < srcYUVA.numPlanes(); i++) {
+            const SkPixmap& plane = srcYUVA.plane(i);
+            const int ssHeight = std::get<1>(yuvaInfo.planeSubsamplingFactors(i));
+            SkASSERT(top % ssHeight == 0);
+            const SkIRect rows = SkIRect::MakeLTRB(0, top / ssHeight, plane.width(),
+                                                   (bottom + ssHeight - 1) / ssHeight);
+            SkAssertResult(plane.extractSubset(&planes[i], rows));
+        }
+        SkYUVAPixmaps band = SkYUVAPixmaps::FromExternalPixmaps(bandInfo, planes);
+        auto encoder = MakeYUV(stream, band, srcYUVAColorSpace, options, segments, true);
+        return encoder && encoder->encodeRows(bottom - top);
+    });
+}
+
 namespace SkJpegEncoder {
 
+static SkJpegMetadataEncoder::SegmentList metadata_segments(const Options& options,
+                                                            const SkColorSpace* colorSpace) {
+    SkJpegMetadataEncoder::SegmentList metadataSegments;
+    SkJpegMetadataEncoder::AppendXMPStandard(metadataSegments, options.xmpMetadata);
+    SkJpegMetadataEncoder::AppendICC(metadataSegments, options, colorSpace);
+    if (options.fOrigin.has_value()) {
+      SkJpegMetadataEncoder::AppendOrigin(metadataSegments, options.fOrigin.value());
+    }
+    return metadataSegments;
+}
+
 bool Encode(SkWStream* dst, const SkPixmap& src, const Options& options) {
+    if (options.fExecutor) {
+        if (std::optional<bool> encoded = SkJpegEncoderImpl::EncodeInBands(
+                    dst, src, options, metadata_segments(options, src.colorSpace()))) {
+            return *encoded;
+        }
+    }
     auto encoder = Make(dst, src, options);
     return encoder.get() && encoder->encodeRows(src.height());
 }
@@ -410,6 +696,12 @@ bool Encode(SkWStream* dst,
             const SkYUVAPixmaps& src,
             const SkColorSpace* srcColorSpace,
             const Options& options) {
+    if (options.fExecutor) {
+        if (std::optional<bool> encoded = SkJpegEncoderImpl::EncodeInBands(
+                    dst, src, srcColorSpace, options, metadata_segments(options, srcColorSpace))) {
+            return *encoded;
+        }
+    }
     auto encoder = Make(dst, src, srcColorSpace, options);
     return encoder.get() && encoder->encodeRows(src.yuvaInfo().height());
 }
@@ -430,26 +722,16 @@ sk_sp<SkData> Encode(GrDirectContext* ctx, const SkImage* img, const Options& op
 }
 
 std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src, const Options& options) {
-    SkJpegMetadataEncoder::SegmentList metadataSegments;
-    SkJpegMetadataEncoder::AppendXMPStandard(metadataSegments, options.xmpMetadata);
-    SkJpegMetadataEncoder::AppendICC(metadataSegments, options, src.colorSpace());
-    if (options.fOrigin.has_value()) {
-      SkJpegMetadataEncoder::AppendOrigin(metadataSegments, options.fOrigin.value());
-    }
-    return SkJpegEncoderImpl::MakeRGB(dst, src, options, metadataSegments);
+    return SkJpegEncoderImpl::MakeRGB(dst, src, options,
+                                      metadata_segments(options, src.colorSpace()));
 }
 
 std::unique_ptr<SkEncoder> Make(SkWStream* dst,
                                 const SkYUVAPixmaps& src,
                                 const SkColorSpace* srcColorSpace,
                                 const Options& options) {
-    SkJpegMetadataEncoder::SegmentList metadataSegments;
-    SkJpegMetadataEncoder::AppendXMPStandard(metadataSegments, options.xmpMetadata);
-    SkJpegMetadataEncoder::AppendICC(metadataSegments, options, srcColorSpace);
-    if (options.fOrigin.has_value()) {
-      SkJpegMetadataEncoder::AppendOrigin(metadataSegments, options.fOrigin.value());
-    }
-    return SkJpegEncoderImpl::MakeYUV(dst, src, srcColorSpace, options, metadataSegments);
+    return SkJpegEncoderImpl::MakeYUV(dst, src, srcColorSpace, options,
+                                      metadata_segments(options, srcColorSpace));
 }
 
 }  // namespace SkJpegEncoder
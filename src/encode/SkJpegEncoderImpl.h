@@ -63,15 +63,34 @@ public:
     // Make an encoder from RGB or YUV data. Encoding options are specified in |options|. Metadata
     // markers are listed in |metadata|. The ICC profile and XMP metadata are read from |metadata|
     // and not from |options|.
+    //
+    // If |forBands|, the encoder uses the standard Huffman tables and ends every MCU row with a
+    // restart marker, so that bands of an image encoded separately can be joined into one.
     static std::unique_ptr<SkEncoder> MakeRGB(SkWStream* dst,
                                               const SkPixmap& src,
                                               const SkJpegEncoder::Options& options,
-                                              const SkJpegMetadataEncoder::SegmentList& metadata);
+                                              const SkJpegMetadataEncoder::SegmentList& metadata,
+                                              bool forBands = false);
     static std::unique_ptr<SkEncoder> MakeYUV(SkWStream* dst,
                                               const SkYUVAPixmaps& srcYUVA,
                                               const SkColorSpace* srcYUVAColorSpace,
                                               const SkJpegEncoder::Options& options,
-                                              const SkJpegMetadataEncoder::SegmentList& metadata);
+                                              const SkJpegMetadataEncoder::SegmentList& metadata,
+                                              bool forBands = false);
+
+    // Encodes |src| in bands on |options.fExecutor|, if it's big enough to be worth it.  Returns
+    // std::nullopt without writing anything if not, or if |src| can't be encoded in bands.
+    // Otherwise returns whether writing the joined bands to |dst| succeeded; once anything has
+    // been written, the caller mustn't fall back to encoding it again.
+    static std::optional<bool> EncodeInBands(SkWStream* dst,
+                                             const SkPixmap& src,
+                                             const SkJpegEncoder::Options& options,
+                                             const SkJpegMetadataEncoder::SegmentList& metadata);
+    static std::optional<bool> EncodeInBands(SkWStream* dst,
+                                             const SkYUVAPixmaps& srcYUVA,
+                                             const SkColorSpace* srcYUVAColorSpace,
+                                             const SkJpegEncoder::Options& options,
+                                             const SkJpegMetadataEncoder::SegmentList& metadata);
 
     ~SkJpegEncoderImpl() override;
 
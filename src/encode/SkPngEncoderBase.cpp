@@ -359,6 +359,48 @@ SkPngEncoderBase::SkPngEncoderBase(TargetInfo targetInfo, const SkPixmap& src)
 #endif //SK_CODEC_ENCODES_PNG_WITH_CONVERT_PIXELS
 }
 
+bool SkPngEncoderBase::TransformRow(const TargetInfo& targetInfo,
+                                    const SkPixmap& src,
+                                    int y,
+                                    void* dst) {
+    const void* srcRow = src.addr(0, y);
+#ifdef SK_CODEC_ENCODES_PNG_WITH_CONVERT_PIXELS
+    if (src.colorType() == kAlpha_8_SkColorType) {
+      // This is a special case where we store kAlpha_8 images as GrayAlpha in png.
+      transform_scanline_A8_to_GrayAlpha((char*)dst,
+                                        (const char*)srcRow,
+                                        src.width(),
+                                        SkColorTypeBytesPerPixel(src.colorType()));
+    } else {
+      SkASSERT(src.width() == targetInfo.fSrcRowInfo->width());
+      if (!SkConvertPixels(targetInfo.fDstRowInfo.value(),
+                          dst,
+                          targetInfo.fDstRowSize,
+                          targetInfo.fSrcRowInfo.value(),
+                          srcRow,
+                          targetInfo.fSrcRowInfo->minRowBytes()))
+      {
+          return false;
+      }
+      // We need to convert from little endian to big endian so we use skcms.
+      if (targetInfo.fDstRowInfo.value().colorType() == kR16G16B16A16_unorm_SkColorType) {
+          if (!skcms_Transform(dst, skcms_PixelFormat_RGBA_16161616LE,
+                              skcms_AlphaFormat_Unpremul, nullptr, dst,
+                              skcms_PixelFormat_RGBA_16161616BE, skcms_AlphaFormat_Unpremul,
+                              nullptr, src.width())) {
+              return false;
+          }
+      }
+    }
+#else
+    targetInfo.fTransformProc((char*)dst,
+                              (const char*)srcRow,
+                              src.width(),
+                              SkColorTypeBytesPerPixel(src.colorType()));
+#endif //SK_CODEC_ENCODES_PNG_WITH_CONVERT_PIXELS
+    return true;
+}
+
 bool SkPngEncoderBase::onEncodeRows(int numRows) {
     // https://www.w3.org/TR/png-3/#11IHDR says that "zero is an invalid value"
     // for width and height.
@@ -379,40 +421,9 @@ bool SkPngEncoderBase::onEncodeRows(int numRows) {
         sk_msan_assert_initialized(srcRow,
                                    (const uint8_t*)srcRow + (fSrc.width() << fSrc.shiftPerPixel()));
 
-#ifdef SK_CODEC_ENCODES_PNG_WITH_CONVERT_PIXELS
-        if (fSrc.colorType() == kAlpha_8_SkColorType) {
-          // This is a special case where we store kAlpha_8 images as GrayAlpha in png.
-          transform_scanline_A8_to_GrayAlpha((char*)fStorage.get(),
-                                            (const char*)srcRow,
-                                            fSrc.width(),
-                                            SkColorTypeBytesPerPixel(fSrc.colorType()));
-        } else {
-          SkASSERT(fSrc.width() == fTargetInfo.fSrcRowInfo->width());
-          if (!SkConvertPixels(fTargetInfo.fDstRowInfo.value(),
-                              (void*)fStorage.get(),
-                              fTargetInfo.fDstRowSize,
-                              fTargetInfo.fSrcRowInfo.value(),
-                              srcRow,
-                              fTargetInfo.fSrcRowInfo->minRowBytes()))
-          {
-              return false;
-          }
-          // We need to convert from little endian to big endian so we use skcms.
-          if (fTargetInfo.fDstRowInfo.value().colorType() == kR16G16B16A16_unorm_SkColorType) {
-              if (!skcms_Transform((char*)fStorage.get(), skcms_PixelFormat_RGBA_16161616LE,
-                                  skcms_AlphaFormat_Unpremul, nullptr, fStorage.get(),
-                                  skcms_PixelFormat_RGBA_16161616BE, skcms_AlphaFormat_Unpremul,
-                                  nullptr, fSrc.width())) {
-                  return false;
-              }
-          }
+        if (!TransformRow(fTargetInfo, fSrc, fCurrRow, fStorage.get())) {
+            return false;
         }
-#else
-        fTargetInfo.fTransformProc((char*)fStorage.get(),
-                                   (const char*)srcRow,
-                                   fSrc.width(),
-                                   SkColorTypeBytesPerPixel(fSrc.colorType()));
-#endif //SK_CODEC_ENCODES_PNG_WITH_CONVERT_PIXELS
         SkSpan<const uint8_t> rowToEncode(fStorage.get(), fTargetInfo.fDstRowSize);
         if (!this->onEncodeRow(rowToEncode)) {
             return false;
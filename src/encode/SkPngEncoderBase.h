@@ -52,6 +52,14 @@ public:
     // Returns `std::nullopt` if `srcInfo` is not supported by the PNG encoder.
     static std::optional<TargetInfo> getTargetInfo(const SkImageInfo& srcInfo);
 
+    // Transforms row `y` of `src` into a ready-to-encode row in `dst`, which
+    // must have room for `targetInfo.fDstRowSize` bytes.  Doesn't touch any
+    // encoder state, so rows may be transformed on any thread.
+    static bool TransformRow(const TargetInfo& targetInfo,
+                             const SkPixmap& src,
+                             int y,
+                             void* dst);
+
 protected:
     SkPngEncoderBase(TargetInfo targetInfo, const SkPixmap& src);
 
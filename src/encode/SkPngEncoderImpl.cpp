@@ -14,6 +14,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
@@ -26,11 +27,15 @@
 #include "include/private/SkGainmapInfo.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkDebug.h"
+#include "include/private/base/SkMath.h"
 #include "include/private/base/SkNoncopyable.h"
+#include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
 #include "modules/skcms/skcms.h"
 #include "src/codec/SkPngPriv.h"
 #include "src/encode/SkImageEncoderFns.h"
 #include "src/encode/SkImageEncoderPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/encode/SkPngEncoderBase.h"
 #include "src/image/SkImage_Base.h"
 
@@ -45,6 +50,7 @@
 
 #include <png.h>
 #include <pngconf.h>
+#include <zlib.h>
 
 class GrDirectContext;
 class SkImage;
@@ -601,8 +607,12 @@ bool SkPngEncoderImpl::onFinishEncoding() {
     return true;
 }
 
-namespace SkPngEncoder {
-std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src, const Options& options) {
+// Sets up libpng to write src, and writes everything in the png that comes before the pixels.
+static std::unique_ptr<SkPngEncoderMgr> make_encoder_mgr(
+        SkWStream* dst,
+        const SkPixmap& src,
+        const SkPngEncoder::Options& options,
+        std::optional<SkPngEncoderBase::TargetInfo>* targetInfo) {
     if (!SkPixmapIsValid(src)) {
         return nullptr;
     }
@@ -612,18 +622,17 @@ std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src, const Optio
         return nullptr;
     }
 
-    std::optional<SkPngEncoderBase::TargetInfo> targetInfo =
-            SkPngEncoderBase::getTargetInfo(src.info());
-    if (!targetInfo.has_value()) {
+    *targetInfo = SkPngEncoderBase::getTargetInfo(src.info());
+    if (!targetInfo->has_value()) {
         return nullptr;
     }
 
 #ifdef SK_CODEC_ENCODES_PNG_WITH_CONVERT_PIXELS
-    if (!encoderMgr->setHeader(targetInfo.value(), src.info(), options)) {
+    if (!encoderMgr->setHeader(targetInfo->value(), src.info(), options)) {
       return nullptr;
     }
 #else
-    if (!encoderMgr->setHeader(targetInfo->fDstInfo, src.info(), options)) {
+    if (!encoderMgr->setHeader((*targetInfo)->fDstInfo, src.info(), options)) {
         return nullptr;
     }
 #endif //SK_CODEC_ENCODES_PNG_WITH_CONVERT_PIXELS
@@ -637,7 +646,7 @@ std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src, const Optio
     }
 
 #ifdef SK_CODEC_ENCODES_PNG_WITH_CONVERT_PIXELS
-    if (!encoderMgr->writeInfo(src.info(), targetInfo.value())) {
+    if (!encoderMgr->writeInfo(src.info(), targetInfo->value())) {
         return nullptr;
     }
 #else
@@ -646,12 +655,331 @@ std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src, const Optio
     }
 #endif //SK_CODEC_ENCODES_PNG_WITH_CONVERT_PIXELS
 
+    return encoderMgr;
+}
+
+// The parallel encoder splits the image into strips of about this many bytes of filtered rows.
+static constexpr size_t kStripBytes = 256 * 1024;
+
+// Deflate can refer back this far, so this much of the previous strip primes each strip.
+static constexpr size_t kDeflateWindow = 32 * 1024;
+
+static uint8_t paeth_predictor(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = std::abs(p - a);
+    int pb = std::abs(p - b);
+    int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return a;
+    }
+    return pb <= pc ? b : c;
+}
+
+// Writes the filter type byte and then row filtered with it to out. prev is the row above, or
+// null for the first row of the image.
+static void filter_row(int filter,
+                       const uint8_t* row,
+                       const uint8_t* prev,
+                       size_t rowBytes,
+                       size_t bpp,
+                       uint8_t* out) {
+    auto up = [&](size_t i) -> int { return prev ? prev[i] : 0; };
+    auto left = [&](size_t i) -> int { return i >= bpp ? row[i - bpp] : 0; };
+    auto upLeft = [&](size_t i) -> int { return prev && i >= bpp ? prev[i - bpp] : 0; };
+
+    uint8_t* dst = out + 1;
+    switch (filter) {
+        case PNG_FILTER_SUB:
+            out[0] = PNG_FILTER_VALUE_SUB;
+            for (size_t i = 0; i < rowBytes; i++) { dst[i] = row[i] - left(i); }
+            break;
+        case PNG_FILTER_UP:
+            out[0] = PNG_FILTER_VALUE_UP;
+            for (size_t i = 0; i < rowBytes; i++) { dst[i] = row[i] - up(i); }
+            break;
+        case PNG_FILTER_AVG:
+            out[0] = PNG_FILTER_VALUE_AVG;
+            for (size_t i = 0; i < rowBytes; i++) { dst[i] = row[i] - ((left(i) + up(i)) >> 1); }
+            break;
+        case PNG_FILTER_PAETH:
+            out[0] = PNG_FILTER_VALUE_PAETH;
+            for (size_t i = 0; i < rowBytes; i++) {
+                dst[i] = row[i] - paeth_predictor(left(i), up(i), upLeft(i));
+            }
+            break;
+        default:
+            out[0] = PNG_FILTER_VALUE_NONE;
+            memcpy(dst, row, rowBytes);
+            break;
+    }
+}
+
+// Filters row with whichever of filters leaves the smallest sum of absolute differences, the same
+// heuristic libpng uses to pick a filter per row.
+static void filter_row_adaptively(int filters,
+                                  const uint8_t* row,
+                                  const uint8_t* prev,
+                                  size_t rowBytes,
+                                  size_t bpp,
+                                  uint8_t* out,
+                                  uint8_t* scratch) {
+    static constexpr int kFilters[] = {
+            PNG_FILTER_NONE, PNG_FILTER_SUB, PNG_FILTER_UP, PNG_FILTER_AVG, PNG_FILTER_PAETH};
+
+    if (SkIsPow2(filters) || filters == 0) {
+        filter_row(filters, row, prev, rowBytes, bpp, out);
+        return;
+    }
+
+    uint64_t bestSum = UINT64_MAX;
+    for (int filter : kFilters) {
+        if (!(filters & filter)) {
+            continue;
+        }
+        filter_row(filter, row, prev, rowBytes, bpp, scratch);
+        uint64_t sum = 0;
+        for (size_t i = 1; i <= rowBytes; i++) {
+            sum += scratch[i] < 128 ? scratch[i] : 256 - scratch[i];
+        }
+        if (sum < bestSum) {
+            bestSum = sum;
+            memcpy(out, scratch, rowBytes + 1);
+        }
+    }
+}
+
+namespace {
+struct Strip {
+    std::vector<uint8_t> fDeflated;
+    uLong fAdler = 1;
+    size_t fFilteredBytes = 0;
+    bool fSucceeded = false;
+};
+}  // namespace
+
+// Filters and deflates the rows [y0, y1) of src into a raw deflate stream. Every strip but the last
+// ends with a sync flush rather than a final block, so that the strips can be concatenated into
+// one stream, as pigz does. Each strip primes deflate with the end of the strip before it, which
+// it filters again for itself, so that strips don't lose much compression to their boundaries.
+static void encode_strip(const SkPngEncoderBase::TargetInfo& targetInfo,
+                         const SkPixmap& src,
+                         int y0, int y1,
+                         size_t pngRowBytes,
+                         int filters,
+                         int zlibLevel,
+                         Strip* strip) {
+    const size_t dstRowBytes = targetInfo.fDstRowSize;
+    const size_t bpp = pngRowBytes / SkToSizeT(src.width());
+    const size_t filteredRowBytes = pngRowBytes + 1;
+    const bool stripFiller = pngRowBytes != dstRowBytes;
+
+    const int dictRows = SkToInt((kDeflateWindow + filteredRowBytes - 1) / filteredRowBytes);
+    const int filterFrom = std::max(0, y0 - dictRows);
+
+    skia_private::AutoTMalloc<uint8_t> rows(2 * dstRowBytes);
+    skia_private::AutoTMalloc<uint8_t> scratch(filteredRowBytes);
+    uint8_t* row = rows.get();
+    uint8_t* prev = rows.get() + dstRowBytes;
+    bool havePrev = false;
+
+    std::vector<uint8_t> filtered(SkToSizeT(y1 - filterFrom) * filteredRowBytes);
+    for (int y = std::max(0, filterFrom - 1); y < y1; y++) {
+        if (!SkPngEncoderBase::TransformRow(targetInfo, src, y, row)) {
+            return;
+        }
+        if (stripFiller) {
+            // libpng would strip the unused filler channel from opaque RGBA rows for us.
+            const size_t sample = (dstRowBytes / SkToSizeT(src.width())) / 4;
+            for (int x = 0; x < src.width(); x++) {
+                memmove(row + x * 3 * sample, row + x * 4 * sample, 3 * sample);
+            }
+        }
+        if (y >= filterFrom) {
+            filter_row_adaptively(filters, row, havePrev ? prev : nullptr, pngRowBytes, bpp,
+                                  filtered.data() + SkToSizeT(y - filterFrom) * filteredRowBytes,
+                                  scratch.get());
+        }
+        std::swap(row, prev);
+        havePrev = true;
+    }
+
+    const size_t dictBytes = std::min(kDeflateWindow,
+                                      SkToSizeT(y0 - filterFrom) * filteredRowBytes);
+    const uint8_t* input = filtered.data() + SkToSizeT(y0 - filterFrom) * filteredRowBytes;
+    const size_t inputBytes = SkToSizeT(y1 - y0) * filteredRowBytes;
+
+    z_stream stream = {};
+    // libpng also prefers Z_FILTERED once rows are filtered.
+    const int strategy = filters == PNG_FILTER_NONE || filters == 0 ? Z_DEFAULT_STRATEGY
+                                                                    : Z_FILTERED;
+    if (deflateInit2(&stream, zlibLevel, Z_DEFLATED, -15, 8, strategy) != Z_OK) {
+        return;
+    }
+    if (dictBytes > 0) {
+        deflateSetDictionary(&stream, input - dictBytes, SkToUInt(dictBytes));
+    }
+
+    const bool last = y1 == src.height();
+    strip->fDeflated.resize(deflateBound(&stream, inputBytes) + 16);
+    stream.next_in = const_cast<Bytef*>(input);
+    stream.avail_in = SkToUInt(inputBytes);
+    stream.next_out = strip->fDeflated.data();
+    stream.avail_out = SkToUInt(strip->fDeflated.size());
+    int result;
+    while ((result = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH)) == Z_OK &&
+           stream.avail_out == 0) {
+        size_t written = strip->fDeflated.size();
+        strip->fDeflated.resize(2 * written);
+        stream.next_out = strip->fDeflated.data() + written;
+        stream.avail_out = SkToUInt(strip->fDeflated.size() - written);
+    }
+    strip->fDeflated.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    strip->fAdler = adler32(1, input, SkToUInt(inputBytes));
+    strip->fFilteredBytes = inputBytes;
+    strip->fSucceeded = last ? result == Z_STREAM_END : result == Z_OK;
+}
+
+// Writes what png_write_end() would once the IDATs are done.  libpng refuses to end a png whose
+// IDATs it didn't write itself, so this can't just call it.  png_write_info() already wrote and
+// marked everything that goes before the pixels, which leaves the text and unknown chunks that
+// were added or placed after them, then IEND.  pngPtr can't be used to write anything after this.
+static void write_end(png_structp pngPtr, png_infop infoPtr) {
+    png_textp texts;
+    int textCount;
+    if (png_get_text(pngPtr, infoPtr, &texts, &textCount)) {
+        static constexpr png_byte kTEXt[5] = {'t', 'E', 'X', 't', '\0'};
+        for (int i = 0; i < textCount; i++) {
+            // Chunks png_write_info() wrote are marked with the *_WR compressions.  We only ever
+            // add uncompressed text.
+            SkASSERT(texts[i].compression == PNG_TEXT_COMPRESSION_NONE_WR ||
+                     texts[i].compression == PNG_TEXT_COMPRESSION_NONE);
+            if (texts[i].compression == PNG_TEXT_COMPRESSION_NONE) {
+                const size_t keyLength = strlen(texts[i].key),
+                             textLength = texts[i].text ? strlen(texts[i].text) : 0;
+                png_write_chunk_start(pngPtr, kTEXt, SkToU32(keyLength + 1 + textLength));
+                png_write_chunk_data(pngPtr, (png_const_bytep)texts[i].key, keyLength + 1);
+                png_write_chunk_data(pngPtr, (png_const_bytep)texts[i].text, textLength);
+                png_write_chunk_end(pngPtr);
+                texts[i].compression = PNG_TEXT_COMPRESSION_NONE_WR;
+            }
+        }
+    }
+
+    png_unknown_chunkp chunks;
+    const int chunkCount = png_get_unknown_chunks(pngPtr, infoPtr, &chunks);
+    for (int i = 0; i < chunkCount; i++) {
+        if (chunks[i].location & PNG_AFTER_IDAT) {
+            png_write_chunk(pngPtr, chunks[i].name, chunks[i].data, chunks[i].size);
+        }
+    }
+
+    static constexpr png_byte kIEND[5] = {'I', 'E', 'N', 'D', '\0'};
+    png_write_chunk(pngPtr, kIEND, nullptr, 0);
+}
+
+static bool write_strips(png_structp pngPtr,
+                         png_infop infoPtr,
+                         const std::vector<Strip>& strips,
+                         const uint8_t zlibHeader[2],
+                         const uint8_t adler[4]) {
+    if (setjmp(png_jmpbuf(pngPtr))) {
+        return false;
+    }
+
+    static constexpr png_byte kIDAT[5] = {'I', 'D', 'A', 'T', '\0'};
+    for (size_t i = 0; i < strips.size(); i++) {
+        const bool first = i == 0,
+                   last  = i == strips.size() - 1;
+        const std::vector<uint8_t>& deflated = strips[i].fDeflated;
+        png_write_chunk_start(pngPtr, kIDAT,
+                              SkToU32(deflated.size() + (first ? 2 : 0) + (last ? 4 : 0)));
+        if (first) {
+            png_write_chunk_data(pngPtr, zlibHeader, 2);
+        }
+        png_write_chunk_data(pngPtr, deflated.data(), deflated.size());
+        if (last) {
+            png_write_chunk_data(pngPtr, adler, 4);
+        }
+        png_write_chunk_end(pngPtr);
+    }
+    write_end(pngPtr, infoPtr);
+    return true;
+}
+
+// Encodes the pixels in strips in parallel on options.fExecutor, once encoderMgr has written
+// everything before them. Returns std::nullopt, having written nothing more, when the image is
+// too small to be worth splitting.
+static std::optional<bool> encode_in_strips(SkPngEncoderMgr* encoderMgr,
+                                            const SkPngEncoderBase::TargetInfo& targetInfo,
+                                            const SkPixmap& src,
+                                            const SkPngEncoder::Options& options) {
+    png_structp pngPtr = encoderMgr->pngPtr();
+    const size_t pngRowBytes = png_get_rowbytes(pngPtr, encoderMgr->infoPtr());
+    if (pngRowBytes != targetInfo.fDstRowSize && 4 * pngRowBytes != 3 * targetInfo.fDstRowSize) {
+        SkDEBUGFAIL("Unexpected png row size.");
+        return std::nullopt;
+    }
+
+    const int rowsPerStrip = SkToInt(std::max<size_t>(1, kStripBytes / (pngRowBytes + 1)));
+    const int stripCount = (src.height() + rowsPerStrip - 1) / rowsPerStrip;
+    if (stripCount < 2) {
+        return std::nullopt;
+    }
+
+    const int filters = (int)options.fFilterFlags & (int)SkPngEncoder::FilterFlag::kAll;
+    const int zlibLevel = std::min(std::max(0, options.fZLibLevel), 9);
+
+    std::vector<Strip> strips(stripCount);
+    SkTaskGroup(*options.fExecutor).batch(stripCount, [&](int i) {
+        encode_strip(targetInfo, src,
+                     i * rowsPerStrip, std::min(src.height(), (i + 1) * rowsPerStrip),
+                     pngRowBytes, filters, zlibLevel, &strips[i]);
+    });
+
+    uLong adler = 1;
+    for (const Strip& strip : strips) {
+        if (!strip.fSucceeded) {
+            return false;
+        }
+        adler = adler32_combine(adler, strip.fAdler, (z_off_t)strip.fFilteredBytes);
+    }
+
+    // A zlib stream is a two byte header, the deflate stream, and a big endian adler32 checksum.
+    // The header is what zlib itself would write for a 32K window at this level.
+    static constexpr uint8_t kLevelFlags[] = {0x01, 0x5E, 0x9C, 0xDA};
+    const uint8_t zlibHeader[2] = {
+            0x78, kLevelFlags[zlibLevel < 2 ? 0 : zlibLevel < 6 ? 1 : zlibLevel == 6 ? 2 : 3]};
+    const uint8_t adlerBytes[4] = {(uint8_t)(adler >> 24), (uint8_t)(adler >> 16),
+                                   (uint8_t)(adler >>  8), (uint8_t)(adler >>  0)};
+    return write_strips(pngPtr, encoderMgr->infoPtr(), strips, zlibHeader, adlerBytes);
+}
+
+namespace SkPngEncoder {
+std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src, const Options& options) {
+    std::optional<SkPngEncoderBase::TargetInfo> targetInfo;
+    std::unique_ptr<SkPngEncoderMgr> encoderMgr = make_encoder_mgr(dst, src, options, &targetInfo);
+    if (!encoderMgr) {
+        return nullptr;
+    }
     return std::make_unique<SkPngEncoderImpl>(std::move(*targetInfo), std::move(encoderMgr), src);
 }
 
 bool Encode(SkWStream* dst, const SkPixmap& src, const Options& options) {
-    auto encoder = Make(dst, src, options);
-    return encoder.get() && encoder->encodeRows(src.height());
+    std::optional<SkPngEncoderBase::TargetInfo> targetInfo;
+    std::unique_ptr<SkPngEncoderMgr> encoderMgr = make_encoder_mgr(dst, src, options, &targetInfo);
+    if (!encoderMgr) {
+        return false;
+    }
+    if (options.fExecutor) {
+        if (std::optional<bool> encoded =
+                    encode_in_strips(encoderMgr.get(), *targetInfo, src, options)) {
+            return *encoded;
+        }
+    }
+    SkPngEncoderImpl encoder(std::move(*targetInfo), std::move(encoderMgr), src);
+    return encoder.encodeRows(src.height());
 }
 
 sk_sp<SkData> Encode(GrDirectContext* ctx, const SkImage* img, const Options& options) {
@@ -11,21 +11,28 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSpan.h"
 #include "include/core/SkStream.h"
 #include "include/encode/SkEncoder.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
 #include "src/core/SkImageInfoPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/encode/SkImageEncoderFns.h"
 #include "src/encode/SkImageEncoderPriv.h"
 #include "src/image/SkImage_Base.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 class GrDirectContext;
 class SkImage;
@@ -87,6 +94,7 @@ static bool preprocess_webp_picture(WebPPicture* pic,
         webp_config->method = 0;
         pic->use_argb = 1;
     }
+    webp_config->thread_level = opts.fMultiThreaded ? 1 : 0;
 
     {
         const SkColorType ct = pixmap.colorType();
@@ -125,6 +133,128 @@ static bool preprocess_webp_picture(WebPPicture* pic,
     return true;
 }
 
+// Returns the bounds of the pixels of cur that differ from prev, with an even left and top, since
+// that's all an ANMF chunk can express.  Returns an empty rect if nothing changed.
+static SkIRect changed_bounds(const SkPixmap& prev, const SkPixmap& cur) {
+    SkASSERT(prev.dimensions() == cur.dimensions());
+    if (prev.info() != cur.info()) {
+        return cur.bounds();
+    }
+    const size_t bpp = cur.info().bytesPerPixel();
+    const size_t rowBytes = cur.info().minRowBytes();
+
+    SkIRect bounds = SkIRect::MakeEmpty();
+    for (int y = 0; y < cur.height(); y++) {
+        const uint8_t* a = static_cast<const uint8_t*>(prev.addr(0, y));
+        const uint8_t* b = static_cast<const uint8_t*>(cur.addr(0, y));
+        if (0 == memcmp(a, b, rowBytes)) {
+            continue;
+        }
+        int left = 0, right = cur.width();
+        while (0 == memcmp(a + left * bpp, b + left * bpp, bpp)) {
+            left++;
+        }
+        while (0 == memcmp(a + (right - 1) * bpp, b + (right - 1) * bpp, bpp)) {
+            right--;
+        }
+        bounds.join(SkIRect::MakeLTRB(left, y, right, y + 1));
+    }
+    if (!bounds.isEmpty()) {
+        bounds.fLeft &= ~1;
+        bounds.fTop &= ~1;
+    }
+    return bounds;
+}
+
+// Encodes each frame on its own, as the pixels that changed since the frame before it, with
+// opts.fExecutor, then puts them together with a WebPMux.
+static bool encode_animated_in_parallel(SkWStream* stream,
+                                        SkSpan<const SkEncoder::Frame> frames,
+                                        const SkWebpEncoder::Options& opts) {
+    const SkISize canvasSize = frames.front().pixmap.dimensions();
+    for (const auto& frame : frames) {
+        if (frame.pixmap.dimensions() != canvasSize) {
+            return false;
+        }
+    }
+
+    const int frameCount = SkToInt(frames.size());
+    std::vector<SkIRect> bounds(frameCount);
+    std::vector<sk_sp<SkData>> encoded(frameCount);
+    std::atomic<bool> failed{false};
+    SkTaskGroup(*opts.fExecutor).batch(frameCount, [&](int i) {
+        if (failed.load(std::memory_order_relaxed)) {
+            return;
+        }
+        bounds[i] = i == 0 ? frames[0].pixmap.bounds()
+                           : changed_bounds(frames[i - 1].pixmap, frames[i].pixmap);
+        if (bounds[i].isEmpty()) {
+            return;
+        }
+
+        SkPixmap subset;
+        WebPConfig webp_config;
+        WebPPicture pic;
+        if (!frames[i].pixmap.extractSubset(&subset, bounds[i]) ||
+            !WebPConfigPreset(&webp_config, WEBP_PRESET_DEFAULT, opts.fQuality) ||
+            !WebPPictureInit(&pic)) {
+            failed = true;
+            return;
+        }
+        SkAutoTCallVProc<WebPPicture, WebPPictureFree> autoPic(&pic);
+
+        SkDynamicMemoryWStream tmp;
+        pic.custom_ptr = &tmp;
+        pic.writer = stream_writer;
+        if (!preprocess_webp_picture(&pic, &webp_config, subset, opts) ||
+            !WebPEncode(&webp_config, &pic)) {
+            failed = true;
+            return;
+        }
+        encoded[i] = tmp.detachAsData();
+    });
+    if (failed) {
+        return false;
+    }
+
+    SkAutoTCallVProc<WebPMux, WebPMuxDelete> mux(WebPMuxNew());
+    if (!mux || WEBP_MUX_OK != WebPMuxSetCanvasSize(mux, canvasSize.width(),
+                                                         canvasSize.height())) {
+        return false;
+    }
+    // The same as WebPAnimEncoder's defaults.
+    const WebPMuxAnimParams animParams = {0xFFFFFFFF, 0};
+    if (WEBP_MUX_OK != WebPMuxSetAnimationParams(mux, &animParams)) {
+        return false;
+    }
+
+    for (int i = 0; i < frameCount;) {
+        WebPMuxFrameInfo info;
+        memset(&info, 0, sizeof(info));
+        info.bitstream = {encoded[i]->bytes(), encoded[i]->size()};
+        info.x_offset = bounds[i].fLeft;
+        info.y_offset = bounds[i].fTop;
+        info.id = WEBP_CHUNK_ANMF;
+        info.dispose_method = WEBP_MUX_DISPOSE_NONE;
+        info.blend_method = WEBP_MUX_NO_BLEND;
+        info.duration = frames[i].duration;
+        // Frames that didn't change just make this one last longer.
+        for (i++; i < frameCount && bounds[i].isEmpty(); i++) {
+            info.duration += frames[i].duration;
+        }
+        if (WEBP_MUX_OK != WebPMuxPushFrame(mux, &info, /*copy_data=*/0)) {
+            return false;
+        }
+    }
+
+    WebPData assembled;
+    SkAutoTCallVProc<WebPData, WebPDataClear> autoWebPData(&assembled);
+    if (WEBP_MUX_OK != WebPMuxAssemble(mux, &assembled)) {
+        return false;
+    }
+    return stream->write(assembled.bytes, assembled.size);
+}
+
 namespace SkWebpEncoder {
 
 bool Encode(SkWStream* stream, const SkPixmap& pixmap, const Options& opts) {
@@ -192,6 +322,9 @@ bool EncodeAnimated(SkWStream* stream, SkSpan<const SkEncoder::Frame> frames, co
     if (!stream || frames.empty()) {
         return false;
     }
+    if (opts.fExecutor) {
+        return encode_animated_in_parallel(stream, frames, opts);
+    }
 
     const int canvasWidth = frames.front().pixmap.width();
     const int canvasHeight = frames.front().pixmap.height();
@@ -225,10 +358,7 @@ bool EncodeAnimated(SkWStream* stream, SkSpan<const SkEncoder::Frame> frames, co
             return false;
         }
 
-        if (!WebPEncode(&webp_config, &pic)) {
-            return false;
-        }
-
+        // WebPAnimEncoderAdd() does the encoding.
         if (!WebPAnimEncoderAdd(enc.get(), &pic, timestamp, &webp_config)) {
             return false;
         }
@@ -122,6 +122,13 @@ bool SkImage_Lazy::getROPixels(GrDirectContext* ctx, SkBitmap* bitmap,
     }
 
     if (SkImage::kAllow_CachingHint == chint) {
+        // If another thread is decoding this already, wait for it rather than decoding it again.
+        SkBitmapCache::DecodeLock decodeLock(desc);
+        if (decodeLock.findAfterWaiting(bitmap)) {
+            check_output_bitmap();
+            return true;
+        }
+
         SkPixmap pmap;
         SkBitmapCache::RecPtr cacheRec = SkBitmapCache::Alloc(desc, this->imageInfo(), &pmap);
         if (!cacheRec) {
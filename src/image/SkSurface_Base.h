@@ -97,6 +97,13 @@ public:
 
     virtual void onWritePixels(const SkPixmap&, int x, int y) = 0;
 
+    /**
+     *  Default implementations read through our canvas.  Surfaces whose canvas doesn't draw
+     *  directly into their pixels override these.
+     */
+    virtual bool onPeekPixels(SkPixmap*);
+    virtual bool onReadPixels(const SkPixmap&, int srcX, int srcY);
+
     /**
      * Default implementation does a rescale/read and then calls the callback.
      */
@@ -151,6 +158,12 @@ public:
      */
     virtual void onRestoreBackingMutability() {}
 
+    /**
+     *  Called before our cached image snapshot is returned.  Surfaces that defer their drawing
+     *  should rasterize anything pending here, so the snapshot reflects all drawing so far.
+     */
+    virtual void onFlushDeferredDraws() {}
+
     /**
      * Caused the current backend 3D API to wait on the passed in semaphores before executing new
      * commands on the gpu. Any previously submitting commands will not be blocked by these
@@ -202,6 +215,7 @@ SkCanvas* SkSurface_Base::getCachedCanvas() {
 }
 
 sk_sp<SkImage> SkSurface_Base::refCachedImage() {
+    this->onFlushDeferredDraws();
     if (fCachedImage) {
         return fCachedImage;
     }
@@ -0,0 +1,367 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/image/SkSurface_RasterThreaded.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkCapabilities.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkMallocPixelRef.h"
+#include "include/core/SkPixelRef.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkScalar.h"
+#include "include/core/SkSurface.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTemplates.h"
+#include "src/core/SkBigPicture.h"
+#include "src/core/SkBitmapDevice.h"
+#include "src/core/SkImagePriv.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkRecordDraw.h"
+#include "src/core/SkRecorder.h"
+#include "src/core/SkRecords.h"
+#include "src/core/SkSurfacePriv.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace skia_private;
+
+namespace {
+
+// How each op affects what a flush can draw and what it has to keep.
+enum class OpKind {
+    kSave,     // Starts a save/restore block.
+    kLayer,    // Starts a block whose draws only reach our pixels when it's restored.
+    kRestore,  // Ends a block.
+    kState,    // Changes the matrix or clip.
+    kOther,    // Draws, and anything else that only needs to be played back once.
+};
+
+struct ClassifyOp {
+    template <typename T>
+    OpKind operator()(const T&) { return OpKind::kOther; }
+    OpKind operator()(const SkRecords::Save&) { return OpKind::kSave; }
+    // SaveBehind copies our pixels at the time and puts them back when it's restored.
+    OpKind operator()(const SkRecords::SaveLayer&) { return OpKind::kLayer; }
+    OpKind operator()(const SkRecords::SaveBehind&) { return OpKind::kLayer; }
+    OpKind operator()(const SkRecords::Restore&) { return OpKind::kRestore; }
+    OpKind operator()(const SkRecords::SetMatrix&) { return OpKind::kState; }
+    OpKind operator()(const SkRecords::SetM44&) { return OpKind::kState; }
+    OpKind operator()(const SkRecords::Concat&) { return OpKind::kState; }
+    OpKind operator()(const SkRecords::Concat44&) { return OpKind::kState; }
+    OpKind operator()(const SkRecords::Translate&) { return OpKind::kState; }
+    OpKind operator()(const SkRecords::Scale&) { return OpKind::kState; }
+    OpKind operator()(const SkRecords::ClipPath&) { return OpKind::kState; }
+    OpKind operator()(const SkRecords::ClipRRect&) { return OpKind::kState; }
+    OpKind operator()(const SkRecords::ClipRect&) { return OpKind::kState; }
+    OpKind operator()(const SkRecords::ClipRegion&) { return OpKind::kState; }
+    OpKind operator()(const SkRecords::ClipShader&) { return OpKind::kState; }
+    OpKind operator()(const SkRecords::ResetClip&) { return OpKind::kState; }
+};
+
+// Copies the ops ClassifyOp calls kSave or kState into another SkRecord.  They only hold values,
+// not pointers into their record's memory.
+struct CopyStateOp {
+    SkRecord* fDst;
+
+    template <typename T>
+    void operator()(const T&) { SkDEBUGFAIL("Only saves, matrices and clips are copied."); }
+    template <typename T>
+    void copy(const T& op) { new (fDst->append<T>()) T(op); }
+
+    void operator()(const SkRecords::Save& op) { this->copy(op); }
+    void operator()(const SkRecords::SetMatrix& op) { this->copy(op); }
+    void operator()(const SkRecords::SetM44& op) { this->copy(op); }
+    void operator()(const SkRecords::Concat& op) { this->copy(op); }
+    void operator()(const SkRecords::Concat44& op) { this->copy(op); }
+    void operator()(const SkRecords::Translate& op) { this->copy(op); }
+    void operator()(const SkRecords::Scale& op) { this->copy(op); }
+    void operator()(const SkRecords::ClipPath& op) { this->copy(op); }
+    void operator()(const SkRecords::ClipRRect& op) { this->copy(op); }
+    void operator()(const SkRecords::ClipRect& op) { this->copy(op); }
+    void operator()(const SkRecords::ClipRegion& op) { this->copy(op); }
+    void operator()(const SkRecords::ClipShader& op) { this->copy(op); }
+    void operator()(const SkRecords::ResetClip& op) { this->copy(op); }
+};
+
+// Layers that start from what's already been drawn read pixels outside any one tile, which may be
+// changing underneath them if other tiles are being drawn at the same time.
+struct ReadsDevice {
+    template <typename T>
+    bool operator()(const T&) { return false; }
+    bool operator()(const SkRecords::SaveLayer& op) {
+        return op.backdrop || (op.saveLayerFlags & SkCanvas::kInitWithPrevious_SaveLayerFlag);
+    }
+    bool operator()(const SkRecords::SaveBehind&) { return true; }
+};
+
+}  // namespace
+
+SkSurface_RasterThreaded::SkSurface_RasterThreaded(const SkImageInfo& info,
+                                                   sk_sp<SkPixelRef> pr,
+                                                   SkExecutor& executor,
+                                                   SkISize tileSize,
+                                                   const SkSurfaceProps* props)
+        : INHERITED(pr->width(), pr->height(), props)
+        , fExecutor(executor)
+        , fTileSize(tileSize)
+        , fRecord(sk_make_sp<SkRecord>()) {
+    fBitmap.setInfo(info, pr->rowBytes());
+    fBitmap.setPixelRef(std::move(pr), 0, 0);
+}
+
+SkSurface_RasterThreaded::~SkSurface_RasterThreaded() = default;
+
+SkCanvas* SkSurface_RasterThreaded::onNewCanvas() {
+    SkASSERT(!fRecorder);
+    fRecorder = new SkRecorder(fRecord.get(), SkRect::Make(fBitmap.bounds()));
+    return fRecorder;
+}
+
+sk_sp<SkSurface> SkSurface_RasterThreaded::onNewSurface(const SkImageInfo& info) {
+    return SkSurfaces::RasterThreaded(info, fExecutor, fTileSize, &this->props());
+}
+
+void SkSurface_RasterThreaded::onFlushDeferredDraws() {
+    if (!fRecorder || fRecord->count() == fFlushedOps || fFlushing) {
+        return;
+    }
+    const SkRecord& record = *fRecord;
+    const int count = record.count();
+
+    // Find the save/restore blocks still open, and the matrix and clip ops in each that are still
+    // in effect.  A layer's draws only reach our pixels, all at once, when it's restored, so we
+    // can only draw up to the first layer still open, just as a raster surface would have.
+    struct Block {
+        int              fOp;
+        bool             fLayer;
+        std::vector<int> fStateOps;
+    };
+    std::vector<Block> blocks = {{-1, false, {}}};  // The canvas's own state, outside any block.
+    for (int i = 0; i < count; i++) {
+        switch (record.visit(i, ClassifyOp{})) {
+            case OpKind::kSave:    blocks.push_back({i, false, {}});    break;
+            case OpKind::kLayer:   blocks.push_back({i, true,  {}});    break;
+            case OpKind::kRestore: if (blocks.size() > 1) { blocks.pop_back(); } break;
+            case OpKind::kState:   blocks.back().fStateOps.push_back(i); break;
+            case OpKind::kOther:   break;
+        }
+    }
+    int drawEnd = count;
+    for (const Block& block : blocks) {
+        if (block.fLayer) {
+            drawEnd = block.fOp;
+            break;
+        }
+    }
+    if (drawEnd <= fFlushedOps) {
+        return;  // Everything new is in an open layer.
+    }
+
+    // We're about to change our pixels, so give any outstanding snapshot a chance to fork them.
+    // (This calls back into onCopyOnWrite(), which asks for our cached image, which flushes.)
+    fFlushing = true;
+    this->notifyContentWillChange(kRetain_ContentChangeMode);
+    fFlushing = false;
+
+    const SkRect bounds = SkRect::Make(fBitmap.bounds());
+
+    SkDrawableList* drawableList = fRecorder->getDrawableList();
+    std::unique_ptr<SkBigPicture::SnapshotArray> drawables{
+        drawableList ? drawableList->newDrawableSnapshot() : nullptr
+    };
+
+    SkISize tileSize = fTileSize;
+    for (int i = 0; i < drawEnd; i++) {
+        if (record.visit(i, ReadsDevice{})) {
+            tileSize = fBitmap.dimensions();
+            break;
+        }
+    }
+    SkRecordTileBins bins;
+    {
+        AutoTArray<SkRect> opBounds(count);
+        AutoTMalloc<SkBBoxHierarchy::Metadata> meta(count);
+        SkRecordFillBounds(bounds, record, opBounds.data(), meta);
+        bins = SkRecordBinOps(opBounds.data(), drawEnd, SkMatrix::I(), fBitmap.bounds(), tileSize);
+    }
+    const SkPixmap& pixmap = fBitmap.pixmap();
+
+    SkTaskGroup(fExecutor).batch(bins.tileCount(), [&](int t) {
+        if (bins.starts[t] == bins.starts[t + 1]) {
+            return;
+        }
+        const SkIRect tile = bins.tileBounds(t);
+
+        // Each tile gets its own device over the whole buffer that may only write to that tile.
+        // Clipping the canvas to the tile instead would chop geometry at the tile edges and
+        // rasterize it differently.  We install the pixels directly rather than sharing fBitmap's
+        // SkPixelRef across threads.
+        SkBitmap bitmap;
+        bitmap.installPixels(pixmap);
+        auto device = sk_make_sp<SkBitmapDevice>(bitmap, this->props());
+        device->setBlitterClip(tile);
+        SkCanvas canvas(device);
+
+        SkRecords::Draw draw(&canvas,
+                             drawables ? drawables->begin() : nullptr,
+                             nullptr,
+                             drawables ? drawables->count() : 0);
+        for (int j = bins.starts[t]; j < bins.starts[t + 1]; j++) {
+            record.visit(bins.ops[j], draw);
+        }
+    });
+    fBitmap.notifyPixelsChanged();
+
+    // All we need to keep from before drawEnd are the saves still open and their matrices and
+    // clips, so the next flush can rebuild the canvas's state.  Ops from drawEnd on haven't been
+    // drawn yet.
+    int kept = 0;
+    for (const Block& block : blocks) {
+        if (block.fOp >= drawEnd) {
+            break;
+        }
+        kept += (block.fOp >= 0) + SkToInt(block.fStateOps.size());
+    }
+    if (drawEnd == count) {
+        // Those are all the ops left, so copy them into a new record, and let go of the memory
+        // the old one held for everything we've drawn.
+        auto newRecord = sk_make_sp<SkRecord>();
+        for (const Block& block : blocks) {
+            if (block.fOp >= 0) {
+                record.visit(block.fOp, CopyStateOp{newRecord.get()});
+            }
+            for (int i : block.fStateOps) {
+                record.visit(i, CopyStateOp{newRecord.get()});
+            }
+        }
+        fRecorder->setRecord(newRecord.get());
+        fRecord = std::move(newRecord);
+    } else {
+        // The ops in the open layer refer to the record's memory and its drawables, so they stay
+        // where they are, and everything drawn before them is removed around them.
+        std::vector<bool> keep(drawEnd, false);
+        for (const Block& block : blocks) {
+            if (block.fOp >= drawEnd) {
+                break;
+            }
+            if (block.fOp >= 0) {
+                keep[block.fOp] = true;
+            }
+            for (int i : block.fStateOps) {
+                keep[i] = true;
+            }
+        }
+        for (int i = 0; i < drawEnd; i++) {
+            if (!keep[i]) {
+                fRecord->replace<SkRecords::NoOp>(i);
+            }
+        }
+        fRecord->defrag();
+    }
+    SkASSERT(kept <= fRecord->count());
+    fFlushedOps = kept;
+}
+
+sk_sp<SkImage> SkSurface_RasterThreaded::onNewImageSnapshot(const SkIRect* subset) {
+    this->onFlushDeferredDraws();
+
+    if (subset) {
+        SkASSERT(SkIRect::MakeWH(fBitmap.width(), fBitmap.height()).contains(*subset));
+        SkBitmap dst;
+        dst.allocPixels(fBitmap.info().makeDimensions(subset->size()));
+        SkAssertResult(fBitmap.readPixels(dst.pixmap(), subset->left(), subset->top()));
+        dst.setImmutable(); // key, so MakeFromBitmap doesn't make a copy of the buffer
+        return dst.asImage();
+    }
+
+    // SkImage_raster requires these pixels are immutable for its full lifetime.
+    // We'll undo this via onRestoreBackingMutability() if we can avoid the COW.
+    if (SkPixelRef* pr = fBitmap.pixelRef()) {
+        pr->setTemporarilyImmutable();
+    }
+    return SkMakeImageFromRasterBitmap(fBitmap, kIfMutable_SkCopyPixelsMode);
+}
+
+void SkSurface_RasterThreaded::onWritePixels(const SkPixmap& src, int x, int y) {
+    this->onFlushDeferredDraws();
+    fBitmap.writePixels(src, x, y);
+}
+
+bool SkSurface_RasterThreaded::onPeekPixels(SkPixmap* pmap) {
+    this->onFlushDeferredDraws();
+    return fBitmap.peekPixels(pmap);
+}
+
+bool SkSurface_RasterThreaded::onReadPixels(const SkPixmap& dst, int srcX, int srcY) {
+    this->onFlushDeferredDraws();
+    return fBitmap.readPixels(dst, srcX, srcY);
+}
+
+void SkSurface_RasterThreaded::onDraw(SkCanvas* canvas, SkScalar x, SkScalar y,
+                                      const SkSamplingOptions& sampling, const SkPaint* paint) {
+    this->onFlushDeferredDraws();
+    canvas->drawImage(fBitmap.asImage().get(), x, y, sampling, paint);
+}
+
+void SkSurface_RasterThreaded::onRestoreBackingMutability() {
+    SkASSERT(!this->hasCachedImage());  // Shouldn't be any snapshots out there.
+    if (SkPixelRef* pr = fBitmap.pixelRef()) {
+        pr->restoreMutability();
+    }
+}
+
+bool SkSurface_RasterThreaded::onCopyOnWrite(ContentChangeMode mode) {
+    // Are we sharing pixelrefs with the image?  Unlike SkSurface_Raster there's no device to
+    // retarget: each flush makes fresh canvases over whatever fBitmap holds at the time.
+    sk_sp<SkImage> cached(this->refCachedImage());
+    SkASSERT(cached);
+    if (SkBitmapImageGetPixelRef(cached.get()) == fBitmap.pixelRef()) {
+        SkBitmap prev(fBitmap);
+        if (!fBitmap.tryAllocPixels()) {
+            return false;
+        }
+        if (kRetain_ContentChangeMode == mode) {
+            SkASSERT(prev.info() == fBitmap.info());
+            SkASSERT(prev.rowBytes() == fBitmap.rowBytes());
+            memcpy(fBitmap.getPixels(), prev.getPixels(), fBitmap.computeByteSize());
+        }
+    }
+    return true;
+}
+
+sk_sp<const SkCapabilities> SkSurface_RasterThreaded::onCapabilities() {
+    return SkCapabilities::RasterBackend();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+namespace SkSurfaces {
+
+sk_sp<SkSurface> RasterThreaded(const SkImageInfo& info,
+                                SkExecutor& executor,
+                                SkISize tileSize,
+                                const SkSurfaceProps* props) {
+    if (!SkSurfaceValidateRasterInfo(info) || tileSize.isEmpty()) {
+        return nullptr;
+    }
+
+    sk_sp<SkPixelRef> pr = SkMallocPixelRef::MakeAllocate(info, 0);
+    if (!pr) {
+        return nullptr;
+    }
+    return sk_make_sp<SkSurface_RasterThreaded>(info, std::move(pr), executor, tileSize, props);
+}
+
+}  // namespace SkSurfaces
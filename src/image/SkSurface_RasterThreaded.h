@@ -0,0 +1,88 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSurface_RasterThreaded_DEFINED
+#define SkSurface_RasterThreaded_DEFINED
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkScalar.h"
+#include "include/core/SkSize.h"
+#include "src/image/SkSurface_Base.h"
+
+#include <memory>
+
+class SkCanvas;
+class SkCapabilities;
+class SkExecutor;
+class SkImage;
+class SkPaint;
+class SkPixelRef;
+class SkPixmap;
+class SkRecord;
+class SkRecorder;
+class SkSurface;
+class SkSurfaceProps;
+struct SkIRect;
+
+/**
+ *  A raster surface whose canvas records draws rather than rasterizing them.  Whenever the
+ *  surface's pixels are needed (snapshots, pixel reads, drawing the surface elsewhere) the
+ *  pending draws are binned into a grid of tiles by SkRecordBinOps(), and each tile is played
+ *  back on the executor into its own disjoint rectangle of the shared pixel buffer.
+ *
+ *  Each tile is rasterized by an SkBitmapDevice over the full pixel buffer whose blitters may
+ *  only write inside that tile, so every draw is scan converted exactly as it would be on a
+ *  single-threaded raster surface and the results are bit-identical.  Draws that span several
+ *  tiles are rasterized once per tile, so tiles should be large relative to typical draws.
+ *  Layers that read back what's beneath them (backdrop filters) force a flush onto one tile.
+ *
+ *  A flush that happens while a saveLayer() is still open draws only what came before the layer,
+ *  which is all a raster surface would have drawn to its pixels by then; the layer is drawn
+ *  whole by the first flush after it's restored.  After each flush only the saves, matrices and
+ *  clips still in effect are kept, along with any draws still waiting for a layer.
+ */
+class SkSurface_RasterThreaded : public SkSurface_Base {
+public:
+    SkSurface_RasterThreaded(const SkImageInfo&, sk_sp<SkPixelRef>, SkExecutor&, SkISize tileSize,
+                             const SkSurfaceProps*);
+    ~SkSurface_RasterThreaded() override;
+
+    // From SkSurface.h
+    SkImageInfo imageInfo() const override { return fBitmap.info(); }
+
+    // From SkSurface_Base.h
+    SkSurface_Base::Type type() const override { return SkSurface_Base::Type::kRaster; }
+
+    SkCanvas* onNewCanvas() override;
+    sk_sp<SkSurface> onNewSurface(const SkImageInfo&) override;
+    sk_sp<SkImage> onNewImageSnapshot(const SkIRect* subset) override;
+    void onWritePixels(const SkPixmap&, int x, int y) override;
+    bool onPeekPixels(SkPixmap*) override;
+    bool onReadPixels(const SkPixmap&, int srcX, int srcY) override;
+    void onDraw(SkCanvas*, SkScalar, SkScalar, const SkSamplingOptions&, const SkPaint*) override;
+    bool onCopyOnWrite(ContentChangeMode) override;
+    void onRestoreBackingMutability() override;
+    void onFlushDeferredDraws() override;
+    sk_sp<const SkCapabilities> onCapabilities() override;
+
+private:
+    SkBitmap    fBitmap;
+    SkExecutor& fExecutor;
+    SkISize     fTileSize;
+
+    sk_sp<SkRecord> fRecord;
+    SkRecorder*     fRecorder = nullptr;   // Owned by SkSurface_Base as our cached canvas.
+    int             fFlushedOps = 0;       // fRecord's ops before this index have been flushed.
+    bool            fFlushing = false;
+
+    using INHERITED = SkSurface_Base;
+};
+
+#endif
@@ -28,6 +28,11 @@ namespace SkOpts {
         just_return_lowp = (StageFn)SK_OPTS_NS::lowp::just_return;
         start_pipeline_lowp = SK_OPTS_NS::lowp::start_pipeline;
     #undef M
+
+    #define M(st) superstages_lowp[(int)SkRasterPipelineSuperstage::st] = \
+                      (StageFn)SK_OPTS_NS::lowp::st;
+        SK_RASTER_PIPELINE_SUPERSTAGES_LOWP(M)
+    #undef M
     }
 }  // namespace SkOpts
 
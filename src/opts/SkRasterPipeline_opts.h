@@ -5106,6 +5106,7 @@ namespace lowp {
     // Having nullptr for every stage will cause SkRasterPipeline to always use the highp stages.
     #define M(st) static void (*st)(void) = nullptr;
         SK_RASTER_PIPELINE_OPS_LOWP(M)
+        SK_RASTER_PIPELINE_SUPERSTAGES_LOWP(M)
     #undef M
     static void (*just_return)(void) = nullptr;
 
@@ -5115,7 +5116,10 @@ namespace lowp {
 
 #else  // We are compiling vector code with Clang... let's make some lowp stages!
 
-#if defined(SKRP_CPU_SKX) || defined(SKRP_CPU_HSW) || defined(SKRP_CPU_LASX)
+#if defined(SKRP_CPU_SKX)
+    // AVX-512BW holds 32 16-bit lanes in one register, so each U16 fills a whole zmm register.
+    template <typename T> using V = Vec<32, T>;
+#elif defined(SKRP_CPU_HSW) || defined(SKRP_CPU_LASX)
     template <typename T> using V = Vec<16, T>;
 #else
     template <typename T> using V = Vec<8, T>;
@@ -5450,8 +5454,9 @@ SI U32 trunc_(F x) { return (U32)cast<I32>(x); }
 // Use approximate instructions and one Newton-Raphson step to calculate 1/x.
 SI F rcp_precise(F x) {
 #if defined(SKRP_CPU_SKX)
-    F e = _mm512_rcp14_ps(x);
-    return _mm512_fnmadd_ps(x, e, _mm512_set1_ps(2.0f)) * e;
+    __m512 lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(SK_OPTS_NS::rcp_precise(lo), SK_OPTS_NS::rcp_precise(hi));
 #elif defined(SKRP_CPU_HSW)
     __m256 lo,hi;
     split(x, &lo,&hi);
@@ -5478,7 +5483,9 @@ SI F rcp_precise(F x) {
 }
 SI F sqrt_(F x) {
 #if defined(SKRP_CPU_SKX)
-    return _mm512_sqrt_ps(x);
+    __m512 lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(_mm512_sqrt_ps(lo), _mm512_sqrt_ps(hi));
 #elif defined(SKRP_CPU_HSW)
     __m256 lo,hi;
     split(x, &lo,&hi);
@@ -5523,7 +5530,9 @@ SI F floor_(F x) {
     split(x, &lo,&hi);
     return join<F>(vrndmq_f32(lo), vrndmq_f32(hi));
 #elif defined(SKRP_CPU_SKX)
-    return _mm512_floor_ps(x);
+    __m512 lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(_mm512_floor_ps(lo), _mm512_floor_ps(hi));
 #elif defined(SKRP_CPU_HSW)
     __m256 lo,hi;
     split(x, &lo,&hi);
@@ -5553,7 +5562,7 @@ SI F floor_(F x) {
 // Note: on neon this is a saturating multiply while the others are not.
 SI I16 scaled_mult(I16 a, I16 b) {
 #if defined(SKRP_CPU_SKX)
-    return (I16)_mm256_mulhrs_epi16((__m256i)a, (__m256i)b);
+    return (I16)_mm512_mulhrs_epi16((__m512i)a, (__m512i)b);
 #elif defined(SKRP_CPU_HSW)
     return (I16)_mm256_mulhrs_epi16((__m256i)a, (__m256i)b);
 #elif defined(SKRP_CPU_SSE41) || defined(SKRP_CPU_AVX)
@@ -5616,10 +5625,12 @@ LOWP_STAGE_GG(seed_shader, NoCtx) {
     y = join<F>(val3, val3);
 #else
     static constexpr float iota[] = {
-        0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f,
-        8.5f, 9.5f,10.5f,11.5f,12.5f,13.5f,14.5f,15.5f,
+         0.5f,  1.5f,  2.5f,  3.5f,  4.5f,  5.5f,  6.5f,  7.5f,
+         8.5f,  9.5f, 10.5f, 11.5f, 12.5f, 13.5f, 14.5f, 15.5f,
+        16.5f, 17.5f, 18.5f, 19.5f, 20.5f, 21.5f, 22.5f, 23.5f,
+        24.5f, 25.5f, 26.5f, 27.5f, 28.5f, 29.5f, 30.5f, 31.5f,
     };
-    static_assert(std::size(iota) >= SkRasterPipelineContexts::kMaxStride);
+    static_assert(std::size(iota) >= SkRasterPipelineContexts::kMaxStride_lowp_skx);
 
     x = cast<F>(I32_(dx)) + sk_unaligned_load<F>(iota);
     y = cast<F>(I32_(dy)) + 0.5f;
@@ -5864,17 +5875,29 @@ SI void store(T* ptr, V v) {
         return V{ ptr[ix[ 0]], ptr[ix[ 1]], ptr[ix[ 2]], ptr[ix[ 3]],
                   ptr[ix[ 4]], ptr[ix[ 5]], ptr[ix[ 6]], ptr[ix[ 7]],
                   ptr[ix[ 8]], ptr[ix[ 9]], ptr[ix[10]], ptr[ix[11]],
-                  ptr[ix[12]], ptr[ix[13]], ptr[ix[14]], ptr[ix[15]], };
+                  ptr[ix[12]], ptr[ix[13]], ptr[ix[14]], ptr[ix[15]],
+                  ptr[ix[16]], ptr[ix[17]], ptr[ix[18]], ptr[ix[19]],
+                  ptr[ix[20]], ptr[ix[21]], ptr[ix[22]], ptr[ix[23]],
+                  ptr[ix[24]], ptr[ix[25]], ptr[ix[26]], ptr[ix[27]],
+                  ptr[ix[28]], ptr[ix[29]], ptr[ix[30]], ptr[ix[31]], };
     }
 
     template<>
     F gather(const float* ptr, U32 ix) {
-        return _mm512_i32gather_ps((__m512i)ix, ptr, 4);
+        __m512i lo, hi;
+        split(ix, &lo, &hi);
+
+        return join<F>(_mm512_i32gather_ps(lo, ptr, 4),
+                       _mm512_i32gather_ps(hi, ptr, 4));
     }
 
     template<>
     U32 gather(const uint32_t* ptr, U32 ix) {
-        return (U32)_mm512_i32gather_epi32((__m512i)ix, ptr, 4);
+        __m512i lo, hi;
+        split(ix, &lo, &hi);
+
+        return join<U32>(_mm512_i32gather_epi32(lo, ptr, 4),
+                         _mm512_i32gather_epi32(hi, ptr, 4));
     }
 
 #elif defined(SKRP_CPU_HSW)
@@ -5924,10 +5947,11 @@ SI void store(T* ptr, V v) {
 
 SI void from_8888(U32 rgba, U16* r, U16* g, U16* b, U16* a) {
 #if defined(SKRP_CPU_SKX)
-    rgba = (U32)_mm512_permutexvar_epi64(_mm512_setr_epi64(0,1,4,5,2,3,6,7), (__m512i)rgba);
+    // AVX-512 narrows 32-bit lanes to 16-bit in order (vpmovdw), so no shuffling is needed.
     auto cast_U16 = [](U32 v) -> U16 {
-        return (U16)_mm256_packus_epi32(_mm512_castsi512_si256((__m512i)v),
-                    _mm512_extracti64x4_epi64((__m512i)v, 1));
+        __m512i lo,hi;
+        split(v, &lo,&hi);
+        return join<U16>(_mm512_cvtepi32_epi16(lo), _mm512_cvtepi32_epi16(hi));
     };
 #elif defined(SKRP_CPU_HSW)
     // Swap the middle 128-bit lanes to make _mm256_packus_epi32() in cast_U16() work out nicely.
@@ -6704,6 +6728,120 @@ LOWP_STAGE_PP(srcover_rgba_8888, const SkRasterPipelineContexts::MemoryCtx* ctx)
     store_8888_(ptr, r,g,b,a);
 }
 
+// ~~~~~~ Superstages ~~~~~~ //
+
+// A superstage runs a chain of the stages above back-to-back as one stage, saving the tail calls
+// between them and letting the compiler keep everything in registers. It calls the very same
+// kernels, so it draws exactly what the chain would. SkRasterPipeline lays out the program just as
+// it would for the chain, with the superstage in the first stage's slot; each kernel reads its
+// context from its own stage's slot, and we skip past the whole chain when we're done.
+#if SKRP_NARROW_STAGES
+    #define LOWP_SUPERSTAGE(name, stages)                                                      \
+        SI void name##_k(SkRasterPipelineStage* program, const size_t dx, const size_t dy,     \
+                         U16&  r, U16&  g, U16&  b, U16&  a,                                   \
+                         U16& dr, U16& dg, U16& db, U16& da);                                  \
+        static void ABI name(Params* params, SkRasterPipelineStage* program,                   \
+                             U16 r, U16 g, U16 b, U16 a) {                                     \
+            name##_k(program, params->dx,params->dy, r,g,b,a,                                  \
+                     params->dr,params->dg,params->db,params->da);                             \
+            program += stages;                                                                 \
+            auto fn = (Stage)program->fn;                                                      \
+            fn(params, program, r,g,b,a);                                                      \
+        }                                                                                      \
+        SI void name##_k(SkRasterPipelineStage* program, const size_t dx, const size_t dy,     \
+                         U16&  r, U16&  g, U16&  b, U16&  a,                                   \
+                         U16& dr, U16& dg, U16& db, U16& da)
+#else
+    #define LOWP_SUPERSTAGE(name, stages)                                                      \
+        SI void name##_k(SkRasterPipelineStage* program, const size_t dx, const size_t dy,     \
+                         U16&  r, U16&  g, U16&  b, U16&  a,                                   \
+                         U16& dr, U16& dg, U16& db, U16& da);                                  \
+        static void ABI name(SkRasterPipelineStage* program,                                   \
+                             const size_t dx, const size_t dy,                                 \
+                             U16  r, U16  g, U16  b, U16  a,                                   \
+                             U16 dr, U16 dg, U16 db, U16 da) {                                 \
+            name##_k(program, dx,dy, r,g,b,a, dr,dg,db,da);                                    \
+            program += stages;                                                                 \
+            auto fn = (Stage)program->fn;                                                      \
+            fn(program, dx,dy, r,g,b,a, dr,dg,db,da);                                          \
+        }                                                                                      \
+        SI void name##_k(SkRasterPipelineStage* program, const size_t dx, const size_t dy,     \
+                         U16&  r, U16&  g, U16&  b, U16&  a,                                   \
+                         U16& dr, U16& dg, U16& db, U16& da)
+#endif
+
+// Shader coordinates.
+LOWP_SUPERSTAGE(seed_shader_matrix_translate, 2) {
+    F x, y;
+    seed_shader_k     (Ctx{program + 0}, dx,dy, x,y);
+    matrix_translate_k(Ctx{program + 1}, dx,dy, x,y);
+    split(x, &r,&g);
+    split(y, &b,&a);
+}
+LOWP_SUPERSTAGE(seed_shader_matrix_scale_translate, 2) {
+    F x, y;
+    seed_shader_k           (Ctx{program + 0}, dx,dy, x,y);
+    matrix_scale_translate_k(Ctx{program + 1}, dx,dy, x,y);
+    split(x, &r,&g);
+    split(y, &b,&a);
+}
+LOWP_SUPERSTAGE(seed_shader_matrix_2x3, 2) {
+    F x, y;
+    seed_shader_k(Ctx{program + 0}, dx,dy, x,y);
+    matrix_2x3_k (Ctx{program + 1}, dx,dy, x,y);
+    split(x, &r,&g);
+    split(y, &b,&a);
+}
+
+// Clamped two-stop linear gradients.
+LOWP_SUPERSTAGE(linear_gradient_2_stop_scale_translate, 4) {
+    F x, y;
+    seed_shader_k                  (Ctx{program + 0}, dx,dy, x,y);
+    matrix_scale_translate_k       (Ctx{program + 1}, dx,dy, x,y);
+    clamp_x_1_k                    (Ctx{program + 2}, dx,dy, x,y);
+    evenly_spaced_2_stop_gradient_k(Ctx{program + 3}, dx,dy, x,y, r,g,b,a);
+}
+LOWP_SUPERSTAGE(linear_gradient_2_stop_2x3, 4) {
+    F x, y;
+    seed_shader_k                  (Ctx{program + 0}, dx,dy, x,y);
+    matrix_2x3_k                   (Ctx{program + 1}, dx,dy, x,y);
+    clamp_x_1_k                    (Ctx{program + 2}, dx,dy, x,y);
+    evenly_spaced_2_stop_gradient_k(Ctx{program + 3}, dx,dy, x,y, r,g,b,a);
+}
+
+// Writing to 8888 destinations.
+LOWP_SUPERSTAGE(clamp_01_store_8888, 2) {
+    clamp_01_k  (Ctx{program + 0}, dx,dy, r,g,b,a, dr,dg,db,da);
+    store_8888_k(Ctx{program + 1}, dx,dy, r,g,b,a, dr,dg,db,da);
+}
+LOWP_SUPERSTAGE(srcover_8888_dst, 3) {
+    load_8888_dst_k(Ctx{program + 0}, dx,dy, r,g,b,a, dr,dg,db,da);
+    srcover_k      (Ctx{program + 1}, dx,dy, r,g,b,a, dr,dg,db,da);
+    store_8888_k   (Ctx{program + 2}, dx,dy, r,g,b,a, dr,dg,db,da);
+}
+LOWP_SUPERSTAGE(scale_1_float_srcover_8888_dst, 4) {
+    scale_1_float_k(Ctx{program + 0}, dx,dy, r,g,b,a, dr,dg,db,da);
+    load_8888_dst_k(Ctx{program + 1}, dx,dy, r,g,b,a, dr,dg,db,da);
+    srcover_k      (Ctx{program + 2}, dx,dy, r,g,b,a, dr,dg,db,da);
+    store_8888_k   (Ctx{program + 3}, dx,dy, r,g,b,a, dr,dg,db,da);
+}
+LOWP_SUPERSTAGE(scale_u8_srcover_8888_dst, 4) {
+    scale_u8_k     (Ctx{program + 0}, dx,dy, r,g,b,a, dr,dg,db,da);
+    load_8888_dst_k(Ctx{program + 1}, dx,dy, r,g,b,a, dr,dg,db,da);
+    srcover_k      (Ctx{program + 2}, dx,dy, r,g,b,a, dr,dg,db,da);
+    store_8888_k   (Ctx{program + 3}, dx,dy, r,g,b,a, dr,dg,db,da);
+}
+LOWP_SUPERSTAGE(lerp_1_float_8888_dst, 3) {
+    load_8888_dst_k(Ctx{program + 0}, dx,dy, r,g,b,a, dr,dg,db,da);
+    lerp_1_float_k (Ctx{program + 1}, dx,dy, r,g,b,a, dr,dg,db,da);
+    store_8888_k   (Ctx{program + 2}, dx,dy, r,g,b,a, dr,dg,db,da);
+}
+LOWP_SUPERSTAGE(lerp_u8_8888_dst, 3) {
+    load_8888_dst_k(Ctx{program + 0}, dx,dy, r,g,b,a, dr,dg,db,da);
+    lerp_u8_k      (Ctx{program + 1}, dx,dy, r,g,b,a, dr,dg,db,da);
+    store_8888_k   (Ctx{program + 2}, dx,dy, r,g,b,a, dr,dg,db,da);
+}
+
 // ~~~~~~ skgpu::Swizzle stage ~~~~~~ //
 
 LOWP_STAGE_PP(swizzle, void* ctx) {
@@ -6879,6 +7017,8 @@ HIGHP_STAGE(debug_y, const SkRasterPipelineContexts::MemoryCtx* ctx) {
 
 /* This gives us SK_OPTS::lowp::N if lowp::N has been set, or SK_OPTS::N if it hasn't. */
 namespace lowp { static constexpr size_t lowp_N = N; }
+static_assert(lowp::lowp_N <= SkRasterPipelineContexts::kMaxStride_lowp_skx);
+static_assert(N <= SkRasterPipelineContexts::kMaxStride_highp);
 
 /** Allow outside code to access the Raster Pipeline pixel stride. */
 constexpr size_t raster_pipeline_lowp_stride() { return lowp::lowp_N; }
@@ -143,3 +143,78 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
 size_t SkDeflateWStream::bytesWritten() const {
     return fImpl->fZStream.total_in + fImpl->fInBufferIndex;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Deflate only looks this far back for matches.
+static constexpr size_t kDeflateWindowSize = 32 * 1024;
+
+struct SkDeflateBlocks::Block {
+    SkDynamicMemoryWStream fOut;
+    uint32_t fAdler = 0;
+};
+
+SkDeflateBlocks::SkDeflateBlocks(sk_sp<SkData> input, int compressionLevel)
+        : fInput(std::move(input))
+        , fCompressionLevel(compressionLevel)
+        , fBlockCount(std::max<int>(1, SkToInt((fInput->size() + kBlockSize - 1) / kBlockSize)))
+        , fBlocks(new Block[fBlockCount]) {
+    SkASSERT(compressionLevel != 0);
+    SkASSERT(compressionLevel <= 9 && compressionLevel >= -1);
+}
+
+SkDeflateBlocks::~SkDeflateBlocks() = default;
+
+void SkDeflateBlocks::compressBlock(int i) {
+    TRACE_EVENT0("skia", TRACE_FUNC);
+    SkASSERT(0 <= i && i < fBlockCount);
+    const size_t start = i * kBlockSize;
+    const size_t size = std::min(kBlockSize, fInput->size() - start);
+    unsigned char* data = const_cast<unsigned char*>(fInput->bytes()) + start;
+    const bool last = i == fBlockCount - 1;
+
+    // Each block is a raw deflate stream.  Sync flushing every block but the last byte-aligns
+    // them, so they can simply be concatenated into one stream.
+    z_stream zStream;
+    zStream.next_in = nullptr;
+    zStream.zalloc = &skia_alloc_func;
+    zStream.zfree = &skia_free_func;
+    zStream.opaque = nullptr;
+    SkDEBUGCODE(int r =) deflateInit2(&zStream, fCompressionLevel, Z_DEFLATED, -15,
+                                      8, Z_DEFAULT_STRATEGY);
+    SkASSERT(Z_OK == r);
+    if (start > 0) {
+        const size_t dictSize = std::min(start, kDeflateWindowSize);
+        deflateSetDictionary(&zStream, data - dictSize, SkToUInt(dictSize));
+    }
+    do_deflate(last ? Z_FINISH : Z_SYNC_FLUSH, &zStream, &fBlocks[i].fOut, data, size);
+    (void)deflateEnd(&zStream);
+
+    fBlocks[i].fAdler = adler32(adler32(0, nullptr, 0), data, SkToUInt(size));
+}
+
+std::unique_ptr<SkStreamAsset> SkDeflateBlocks::detachAsStream() {
+    SkDynamicMemoryWStream out;
+
+    // The zlib header: deflate with a 32KB window, the compression level, and a check value.
+    const int level = fCompressionLevel == -1 ? 6 : fCompressionLevel;
+    const int levelFlags = level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3;
+    unsigned header = (0x78 << 8) | (levelFlags << 6);
+    header += 31 - (header % 31);
+    out.write8(header >> 8);
+    out.write8(header & 0xFF);
+
+    uint32_t adler = adler32(0, nullptr, 0);
+    for (int i = 0; i < fBlockCount; i++) {
+        const size_t size = std::min(kBlockSize, fInput->size() - i * kBlockSize);
+        adler = adler32_combine(adler, fBlocks[i].fAdler, size);
+        fBlocks[i].fOut.writeToAndReset(&out);
+    }
+    const uint8_t trailer[4] = {(uint8_t)(adler >> 24), (uint8_t)(adler >> 16),
+                                (uint8_t)(adler >>  8), (uint8_t)(adler >>  0)};
+    out.write(trailer, sizeof(trailer));
+
+    fInput = nullptr;
+    fBlocks = nullptr;
+    return out.detachAsStream();
+}
@@ -9,6 +9,8 @@
 #ifndef SkFlate_DEFINED
 #define SkFlate_DEFINED
 
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
 #include "include/core/SkStream.h"
 #include <cstddef>
 
@@ -53,4 +55,37 @@ private:
     std::unique_ptr<Impl> fImpl;
 };
 
+/**
+  * Compresses one buffer into the same zlib stream SkDeflateWStream writes
+  * (without gzip), but in fixed size blocks that can be compressed
+  * independently, e.g. on different threads.  Each block is primed with the
+  * 32KB of input before it, so the output is barely larger than compressing
+  * the whole buffer in one go.
+  */
+class SkDeflateBlocks {
+public:
+    static constexpr size_t kBlockSize = 256 * 1024;
+
+    /** @param compressionLevel as for SkDeflateWStream. */
+    SkDeflateBlocks(sk_sp<SkData> input, int compressionLevel);
+    ~SkDeflateBlocks();
+
+    /** Always at least one, even for empty input. */
+    int blockCount() const { return fBlockCount; }
+
+    /** Compress block i.  Distinct blocks may be compressed at the same time. */
+    void compressBlock(int i);
+
+    /** Once every block has been compressed, returns the whole zlib stream. */
+    std::unique_ptr<SkStreamAsset> detachAsStream();
+
+private:
+    struct Block;
+
+    sk_sp<SkData>            fInput;
+    int                      fCompressionLevel;
+    int                      fBlockCount;
+    std::unique_ptr<Block[]> fBlocks;
+};
+
 #endif  // SkFlate_DEFINED
@@ -465,23 +465,30 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
                  "empty stream (%p) when identified as kType1CID_Font "
                  "or kTrueType_Font.\n", &typeface, fontAsset.get());
     } else if (type == SkAdvancedTypefaceMetrics::kTrueType_Font) {
-        sk_sp<SkData> subsetFontData;
-        if (can_subset(metrics)) {
-            SkASSERT(font.firstGlyphID() == 1);
-            subsetFontData = SkPDFSubsetFont(typeface, font.glyphUsage());
-        }
-        std::unique_ptr<SkStreamAsset> subsetFontAsset;
-        if (subsetFontData) {
-            subsetFontAsset = SkMemoryStream::Make(std::move(subsetFontData));
-        } else {
-            // If subsetting fails, fall back to original font data.
-            subsetFontAsset = std::move(fontAsset);
-        }
-        std::unique_ptr<SkPDFDict> streamDict = SkPDFMakeDict();
-        streamDict->insertInt("Length1", subsetFontAsset->getLength());
+        // Subsetting can take as long as compressing the subset, so with an executor each font
+        // is subset there as well.  The font outlives the document's jobs.
+        const bool subset = can_subset(metrics);
+        SkStreamAsset* fontAssetPtr = fontAsset.release();
+        auto makeFontFile = [&font, &typeface, subset, fontAssetPtr](SkPDFDict* streamDict) {
+            std::unique_ptr<SkStreamAsset> fontAsset(fontAssetPtr);
+            sk_sp<SkData> subsetFontData;
+            if (subset) {
+                SkASSERT(font.firstGlyphID() == 1);
+                subsetFontData = SkPDFSubsetFont(typeface, font.glyphUsage());
+            }
+            std::unique_ptr<SkStreamAsset> subsetFontAsset;
+            if (subsetFontData) {
+                subsetFontAsset = SkMemoryStream::Make(std::move(subsetFontData));
+            } else {
+                // If subsetting fails, fall back to original font data.
+                subsetFontAsset = std::move(fontAsset);
+            }
+            streamDict->insertInt("Length1", subsetFontAsset->getLength());
+            return subsetFontAsset;
+        };
         descriptor->insertRef("FontFile2",
-                              SkPDFStreamOut(std::move(streamDict), std::move(subsetFontAsset),
-                                             doc, SkPDFSteamCompressionEnabled::Yes));
+                              SkPDFStreamOutDeferred(SkPDFMakeDict(), std::move(makeFontFile),
+                                                     doc, SkPDFSteamCompressionEnabled::Yes));
     } else if (type == SkAdvancedTypefaceMetrics::kType1CID_Font) {
         std::unique_ptr<SkPDFDict> streamDict = SkPDFMakeDict();
         streamDict->insertName("Subtype", "CIDFontType0C");
@@ -7,6 +7,7 @@
 
 #include "src/pdf/SkPDFTypes.h"
 
+#include "include/core/SkData.h"
 #include "include/core/SkExecutor.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
@@ -21,6 +22,7 @@
 #include "src/pdf/SkPDFUnion.h"
 #include "src/pdf/SkPDFUtils.h"
 
+#include <atomic>
 #include <cstring>
 #include <functional>
 #include <new>
@@ -549,39 +551,105 @@ void SkPDFDict::insertUnion(const char key[], SkPDFUnion&& value) {
 
 
 
-static void serialize_stream(SkPDFDict* origDict,
-                             SkStreamAsset* stream,
+static const size_t kMinimumSavings = strlen("/Filter_/FlateDecode_");
+
+// Streams at least this big are deflated a block at a time, on as many threads as we have.
+static constexpr size_t kMinimumBlockDeflateSize = 4 * SkDeflateBlocks::kBlockSize;
+
+static void emit_stream(SkPDFDict* dict,
+                        SkStreamAsset* stream,
+                        SkPDFDocument* doc,
+                        SkPDFIndirectReference ref) {
+    dict->insertInt("Length", stream->getLength());
+    doc->emitStream(*dict,
+                    [stream](SkWStream* dst) { dst->writeStream(stream, stream->getLength()); },
+                    ref);
+}
+
+static void emit_smaller_stream(SkPDFDict* dict,
+                                SkStreamAsset* stream,
+                                SkStreamAsset* compressed,
+                                SkPDFDocument* doc,
+                                SkPDFIndirectReference ref) {
+    if (stream->getLength() > compressed->getLength() + kMinimumSavings) {
+        dict->insertName("Filter", "FlateDecode");
+        emit_stream(dict, compressed, doc, ref);
+    } else {
+        SkAssertResult(stream->rewind());
+        emit_stream(dict, stream, doc, ref);
+    }
+}
+
+static void deflate_in_blocks(std::unique_ptr<SkPDFDict> dict,
+                              std::unique_ptr<SkStreamAsset> stream,
+                              int compressionLevel,
+                              SkPDFDocument* doc,
+                              SkPDFIndirectReference ref) {
+    SkExecutor* executor = doc->executor();
+    SkASSERT(executor);
+    sk_sp<SkData> data = stream->getData();
+    if (!data) {
+        data = SkCopyStreamToData(stream.get());
+    }
+    stream = nullptr;
+
+    struct Job {
+        Job(std::unique_ptr<SkPDFDict> dict, sk_sp<SkData> data, int compressionLevel)
+                : fDict(std::move(dict)), fData(data), fBlocks(std::move(data), compressionLevel) {}
+
+        std::unique_ptr<SkPDFDict> fDict;
+        sk_sp<SkData>              fData;
+        SkDeflateBlocks            fBlocks;
+        std::atomic<int>           fRemaining{0};
+    };
+    auto job = std::make_shared<Job>(std::move(dict), std::move(data), compressionLevel);
+    const int blockCount = job->fBlocks.blockCount();
+    job->fRemaining = blockCount;
+
+    // Whichever block finishes last emits the stream.  Each block is its own job, so the
+    // document keeps waiting until then.
+    for (int i = 0; i < blockCount; i++) {
+        doc->incrementJobCount();
+        executor->add([job, i, doc, ref]() {
+            job->fBlocks.compressBlock(i);
+            if (job->fRemaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::unique_ptr<SkStreamAsset> compressed = job->fBlocks.detachAsStream();
+                emit_smaller_stream(job->fDict.get(), SkMemoryStream::Make(job->fData).get(),
+                                    compressed.get(), doc, ref);
+            }
+            doc->signalJobComplete();
+        });
+    }
+}
+
+static void serialize_stream(std::unique_ptr<SkPDFDict> dict,
+                             std::unique_ptr<SkStreamAsset> stream,
                              SkPDFSteamCompressionEnabled compress,
                              SkPDFDocument* doc,
                              SkPDFIndirectReference ref) {
     // Code assumes that the stream starts at the beginning.
     SkASSERT(stream && stream->hasLength());
 
-    std::unique_ptr<SkStreamAsset> tmp;
-    SkPDFDict tmpDict;
-    SkPDFDict& dict = origDict ? *origDict : tmpDict;
-    static const size_t kMinimumSavings = strlen("/Filter_/FlateDecode_");
-    if (doc->metadata().fCompressionLevel != SkPDF::Metadata::CompressionLevel::None &&
-        compress == SkPDFSteamCompressionEnabled::Yes &&
-        stream->getLength() > kMinimumSavings)
+    if (!dict) {
+        dict = SkPDFMakeDict();
+    }
+    if (doc->metadata().fCompressionLevel == SkPDF::Metadata::CompressionLevel::None ||
+        compress == SkPDFSteamCompressionEnabled::No ||
+        stream->getLength() <= kMinimumSavings)
     {
-        SkDynamicMemoryWStream compressedData;
-        SkDeflateWStream deflateWStream(&compressedData,SkToInt(doc->metadata().fCompressionLevel));
-        SkStreamCopy(&deflateWStream, stream);
-        deflateWStream.finalize();
-        if (stream->getLength() > compressedData.bytesWritten() + kMinimumSavings) {
-            tmp = compressedData.detachAsStream();
-            stream = tmp.get();
-            dict.insertName("Filter", "FlateDecode");
-        } else {
-            SkAssertResult(stream->rewind());
-        }
-
+        emit_stream(dict.get(), stream.get(), doc, ref);
+        return;
     }
-    dict.insertInt("Length", stream->getLength());
-    doc->emitStream(dict,
-                    [stream](SkWStream* dst) { dst->writeStream(stream, stream->getLength()); },
-                    ref);
+    const int compressionLevel = SkToInt(doc->metadata().fCompressionLevel);
+    if (doc->executor() && stream->getLength() >= kMinimumBlockDeflateSize) {
+        deflate_in_blocks(std::move(dict), std::move(stream), compressionLevel, doc, ref);
+        return;
+    }
+    SkDynamicMemoryWStream compressedData;
+    SkDeflateWStream deflateWStream(&compressedData, compressionLevel);
+    SkStreamCopy(&deflateWStream, stream.get());
+    deflateWStream.finalize();
+    emit_smaller_stream(dict.get(), stream.get(), compressedData.detachAsStream().get(), doc, ref);
 }
 
 SkPDFIndirectReference SkPDFStreamOut(std::unique_ptr<SkPDFDict> dict,
@@ -596,13 +664,37 @@ SkPDFIndirectReference SkPDFStreamOut(std::unique_ptr<SkPDFDict> dict,
         // only be executed once.
         doc->incrementJobCount();
         executor->add([dictPtr, contentPtr, compress, doc, ref]() {
-            serialize_stream(dictPtr, contentPtr, compress, doc, ref);
-            delete dictPtr;
-            delete contentPtr;
+            serialize_stream(std::unique_ptr<SkPDFDict>(dictPtr),
+                             std::unique_ptr<SkStreamAsset>(contentPtr), compress, doc, ref);
+            doc->signalJobComplete();
+        });
+        return ref;
+    }
+    serialize_stream(std::move(dict), std::move(content), compress, doc, ref);
+    return ref;
+}
+
+SkPDFIndirectReference SkPDFStreamOutDeferred(
+        std::unique_ptr<SkPDFDict> dict,
+        std::function<std::unique_ptr<SkStreamAsset>(SkPDFDict*)> makeContent,
+        SkPDFDocument* doc,
+        SkPDFSteamCompressionEnabled compress) {
+    SkPDFIndirectReference ref = doc->reserveRef();
+    if (!dict) {
+        dict = SkPDFMakeDict();
+    }
+    if (SkExecutor* executor = doc->executor()) {
+        SkPDFDict* dictPtr = dict.release();
+        doc->incrementJobCount();
+        executor->add([dictPtr, makeContent = std::move(makeContent), compress, doc, ref]() {
+            std::unique_ptr<SkPDFDict> dict(dictPtr);
+            std::unique_ptr<SkStreamAsset> content = makeContent(dict.get());
+            serialize_stream(std::move(dict), std::move(content), compress, doc, ref);
             doc->signalJobComplete();
         });
         return ref;
     }
-    serialize_stream(dict.get(), content.get(), compress, doc, ref);
+    std::unique_ptr<SkStreamAsset> content = makeContent(dict.get());
+    serialize_stream(std::move(dict), std::move(content), compress, doc, ref);
     return ref;
 }
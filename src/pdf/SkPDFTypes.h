@@ -15,6 +15,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -224,4 +225,13 @@ SkPDFIndirectReference SkPDFStreamOut(
     std::unique_ptr<SkStreamAsset> stream,
     SkPDFDocument* doc,
     SkPDFSteamCompressionEnabled compress = SkPDFSteamCompressionEnabled::Yes);
+
+/** Like SkPDFStreamOut(), but the content is made by makeContent(), which runs on the
+    document's executor if it has one.  makeContent() is called exactly once, and may add
+    entries (like "Length1") to the dict it is passed. */
+SkPDFIndirectReference SkPDFStreamOutDeferred(
+    std::unique_ptr<SkPDFDict> dict,
+    std::function<std::unique_ptr<SkStreamAsset>(SkPDFDict*)> makeContent,
+    SkPDFDocument* doc,
+    SkPDFSteamCompressionEnabled compress = SkPDFSteamCompressionEnabled::Yes);
 #endif
@@ -81,6 +81,23 @@ void sk_fmunmap(const void* addr, size_t length) {
     munmap(const_cast<void*>(addr), length);
 }
 
+void sk_fmadvise(const void* addr, size_t length, SkMmapAdvice advice) {
+    if (!addr || !length) {
+        return;
+    }
+    // madvise() wants a page aligned start.
+    const uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+    const uintptr_t start = reinterpret_cast<uintptr_t>(addr) & ~(pageSize - 1);
+    length += reinterpret_cast<uintptr_t>(addr) - start;
+    int posixAdvice = MADV_NORMAL;
+    switch (advice) {
+        case SkMmapAdvice::kWillNeed:   posixAdvice = MADV_WILLNEED;   break;
+        case SkMmapAdvice::kSequential: posixAdvice = MADV_SEQUENTIAL; break;
+    }
+    // This is only a hint, so there's nothing to do if it fails.
+    (void)madvise(reinterpret_cast<void*>(start), length, posixAdvice);
+}
+
 void* sk_fdmmap(int fd, size_t* size) {
     struct stat status = {};
     if (0 != fstat(fd, &status)) {
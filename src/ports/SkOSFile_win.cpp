@@ -87,6 +87,8 @@ void sk_fmunmap(const void* addr, size_t) {
     UnmapViewOfFile(addr);
 }
 
+void sk_fmadvise(const void*, size_t, SkMmapAdvice) {}
+
 void* sk_fdmmap(int fileno, size_t* length) {
     HANDLE file = (HANDLE)_get_osfhandle(fileno);
     if (INVALID_HANDLE_VALUE == file) {
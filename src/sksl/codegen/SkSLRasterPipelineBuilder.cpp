@@ -9,17 +9,22 @@
 #include <cstdint>
 #include <optional>
 
+#include "include/core/SkData.h"
+#include "include/core/SkSerialProcs.h"
 #include "include/core/SkStream.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTFitsIn.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkSafeMath.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkRasterPipelineContextUtils.h"
 #include "src/core/SkRasterPipelineOpContexts.h"
 #include "src/core/SkRasterPipelineOpList.h"
+#include "src/core/SkReadBuffer.h"
 #include "src/core/SkTHash.h"
+#include "src/core/SkWriteBuffer.h"
 #include "src/sksl/SkSLPosition.h"
 #include "src/sksl/SkSLString.h"
 #include "src/sksl/tracing/SkSLDebugTracePriv.h"
@@ -1412,6 +1417,95 @@ Program::Program(TArray<Instruction> instrs,
 
 Program::~Program() = default;
 
+// Bump this whenever Instruction, or the meaning of an instruction's fields, changes. Reordering or
+// adding ops is caught by instruction_set_hash().
+static constexpr uint32_t kSerializedProgramVersion = 1;
+
+static uint32_t instruction_set_hash() {
+    #define M(op) #op ","
+    static constexpr char kOpNames[] = SK_RASTER_PIPELINE_OPS_ALL(M) SKRP_EXTENDED_OPS(M);
+    #undef M
+    const int numBuilderOps = (int)BuilderOp::unsupported;
+    return SkChecksum::Hash32(kOpNames, sizeof(kOpNames),
+                              SkChecksum::Hash32(&numBuilderOps, sizeof(numBuilderOps)));
+}
+
+sk_sp<SkData> Program::serialize() const {
+    SkBinaryWriteBuffer buffer({});
+    buffer.writeUInt(kSerializedProgramVersion);
+    buffer.writeUInt(instruction_set_hash());
+    buffer.writeInt(fNumValueSlots);
+    buffer.writeInt(fNumUniformSlots);
+    buffer.writeInt(fNumImmutableSlots);
+    buffer.writeInt(fNumLabels);
+    buffer.writeInt(fInstructions.size());
+    for (const Instruction& inst : fInstructions) {
+        for (int32_t field : {(int32_t)inst.fOp, inst.fSlotA, inst.fSlotB, inst.fImmA,
+                              inst.fImmB,        inst.fImmC,  inst.fImmD,  inst.fStackID}) {
+            buffer.writeInt(field);
+        }
+    }
+    return buffer.snapshotAsData();
+}
+
+std::unique_ptr<Program> Program::Deserialize(const void* data, size_t size) {
+    SkReadBuffer buffer(data, size);
+    if (buffer.readUInt() != kSerializedProgramVersion ||
+        buffer.readUInt() != instruction_set_hash()) {
+        return nullptr;
+    }
+    const int numValueSlots = buffer.readInt();
+    const int numUniformSlots = buffer.readInt();
+    const int numImmutableSlots = buffer.readInt();
+    const int numLabels = buffer.readInt();
+    const int numInstructions = buffer.readInt();
+    SkSafeMath safe;
+    const int numSlots = safe.addInt(safe.addInt(numValueSlots, numUniformSlots),
+                                     numImmutableSlots);
+    if (!buffer.validate(numValueSlots >= 0 && numUniformSlots >= 0 && numImmutableSlots >= 0 &&
+                         numLabels >= 0 && numInstructions >= 0 && safe) ||
+        !buffer.validateCanReadN<int32_t>(safe.mul(numInstructions, 8))) {
+        return nullptr;
+    }
+
+    TArray<Instruction> instrs;
+    instrs.reserve_exact(numInstructions);
+    TArray<int> stackDepths;
+    for (int index = 0; index < numInstructions; ++index) {
+        int32_t fields[8];
+        for (int32_t& field : fields) {
+            field = buffer.readInt();
+        }
+        const Instruction& inst = instrs.push_back({(BuilderOp)fields[0], fields[1], fields[2],
+                                                    fields[3], fields[4], fields[5], fields[6],
+                                                    fields[7]});
+        if (fields[0] < 0 || fields[0] >= (int)BuilderOp::unsupported ||
+            inst.fSlotA < NA || inst.fSlotA >= numSlots ||
+            inst.fSlotB < NA || inst.fSlotB >= numSlots ||
+            inst.fStackID < 0 || inst.fStackID > numInstructions) {
+            return nullptr;
+        }
+        // The constructor expects every temp stack to be balanced.
+        if (inst.fStackID >= stackDepths.size()) {
+            stackDepths.push_back_n(inst.fStackID + 1 - stackDepths.size(), 0);
+        }
+        stackDepths[inst.fStackID] += stack_usage(inst);
+        if (stackDepths[inst.fStackID] < 0) {
+            return nullptr;
+        }
+    }
+    for (int depth : stackDepths) {
+        if (depth != 0) {
+            return nullptr;
+        }
+    }
+    if (buffer.available() != 0) {
+        return nullptr;
+    }
+    return std::make_unique<Program>(std::move(instrs), numValueSlots, numUniformSlots,
+                                     numImmutableSlots, numLabels, /*debugTrace=*/nullptr);
+}
+
 static bool immutable_data_is_splattable(int32_t* immutablePtr, int numSlots) {
     // If every value between `immutablePtr[0]` and `immutablePtr[numSlots]` is bit-identical, we
     // can use a splat.
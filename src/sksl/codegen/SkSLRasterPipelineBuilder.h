@@ -10,6 +10,7 @@
 
 #include "include/core/SkTypes.h"
 
+#include "include/core/SkRefCnt.h"
 #include "include/core/SkSpan.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkTArray.h"
@@ -22,6 +23,7 @@
 #include <optional>
 
 class SkArenaAlloc;
+class SkData;
 class SkRasterPipeline;
 class SkWStream;
 using SkRPOffset = uint32_t;
@@ -169,6 +171,14 @@ public:
 
     int numUniforms() const { return fNumUniformSlots; }
 
+    // Flattens the program so it can be kept in an SkRuntimeEffect::RasterProgramCache. The debug
+    // trace, if any, is not included.
+    sk_sp<SkData> serialize() const;
+
+    // Recreates a program from serialize()'s output. Returns null if the data is malformed or was
+    // written by a version of Skia with a different instruction set.
+    static std::unique_ptr<Program> Deserialize(const void* data, size_t size);
+
 private:
     using StackDepths = skia_private::TArray<int>; // [stack index] = depth of stack
 
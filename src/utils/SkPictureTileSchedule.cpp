@@ -0,0 +1,109 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkPictureTileSchedule.h"
+
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPicture.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTemplates.h"
+#include "src/core/SkBigPicture.h"
+#include "src/core/SkPicturePriv.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkRecordDraw.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <utility>
+
+using namespace skia_private;
+
+struct SkPictureTileSchedule::Bins : SkRecordTileBins {
+    explicit Bins(SkRecordTileBins&& bins) : SkRecordTileBins(std::move(bins)) {}
+};
+
+std::unique_ptr<SkPictureTileSchedule> SkPictureTileSchedule::Make(sk_sp<const SkPicture> picture,
+                                                                   const SkMatrix& matrix,
+                                                                   const SkIRect& grid,
+                                                                   SkISize tileSize) {
+    if (!picture || tileSize.isEmpty()) {
+        return nullptr;
+    }
+
+    std::unique_ptr<Bins> bins;
+    if (const SkBigPicture* big = SkPicturePriv::AsSkBigPicture(picture)) {
+        // This is the same pass that builds a BBH at record time, but we don't require a BBH, and
+        // binning all the bounds at once is cheaper than querying a BBH once per tile.
+        const SkRecord& record = *big->record();
+        AutoTArray<SkRect> bounds(record.count());
+        AutoTMalloc<SkBBoxHierarchy::Metadata> meta(record.count());
+        SkRecordFillBounds(big->cullRect(), record, bounds.data(), meta);
+        bins = std::make_unique<Bins>(
+                SkRecordBinOps(bounds.data(), record.count(), matrix, grid, tileSize));
+    } else {
+        // Other pictures are small enough that every tile just plays back the whole thing.
+        bins = std::make_unique<Bins>(SkRecordBinOps(nullptr, 0, matrix, grid, tileSize));
+    }
+    return std::unique_ptr<SkPictureTileSchedule>(
+            new SkPictureTileSchedule(std::move(picture), matrix, std::move(bins)));
+}
+
+SkPictureTileSchedule::SkPictureTileSchedule(sk_sp<const SkPicture> picture,
+                                             const SkMatrix& matrix,
+                                             std::unique_ptr<Bins> bins)
+        : fPicture(std::move(picture))
+        , fMatrix(matrix)
+        , fBins(std::move(bins)) {}
+
+SkPictureTileSchedule::~SkPictureTileSchedule() = default;
+
+int SkPictureTileSchedule::tileCount() const {
+    return fBins->tileCount();
+}
+
+SkIRect SkPictureTileSchedule::tileBounds(int tile) const {
+    return fBins->tileBounds(tile);
+}
+
+int SkPictureTileSchedule::opCount(int tile) const {
+    SkASSERT(0 <= tile && tile < this->tileCount());
+    if (!SkPicturePriv::AsSkBigPicture(fPicture)) {
+        return fPicture->approximateOpCount();
+    }
+    return fBins->starts[tile + 1] - fBins->starts[tile];
+}
+
+void SkPictureTileSchedule::playbackTile(int tile, SkCanvas* canvas) const {
+    SkASSERT(canvas);
+    const SkIRect bounds = this->tileBounds(tile);
+
+    SkAutoCanvasRestore acr(canvas, true);
+    canvas->translate(-bounds.fLeft, -bounds.fTop);
+    canvas->clipIRect(bounds);
+    canvas->concat(fMatrix);
+
+    const SkBigPicture* big = SkPicturePriv::AsSkBigPicture(fPicture);
+    if (!big) {
+        fPicture->playback(canvas);
+        return;
+    }
+
+    const SkRecord& record = *big->record();
+    SkRecords::Draw draw(canvas, big->drawablePicts(), nullptr, big->drawableCount());
+    for (int i = fBins->starts[tile]; i < fBins->starts[tile + 1]; i++) {
+        record.visit(fBins->ops[i], draw);
+    }
+}
+
+void SkPictureTileSchedule::playback(
+        SkExecutor& executor, const std::function<SkCanvas*(int tile)>& canvasForTile) const {
+    SkTaskGroup(executor).batch(this->tileCount(), [&](int tile) {
+        if (SkCanvas* canvas = canvasForTile(tile)) {
+            this->playbackTile(tile, canvas);
+        }
+    });
+}
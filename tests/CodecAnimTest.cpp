@@ -13,6 +13,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -644,4 +645,58 @@ DEF_TEST(AnimCodecPlayer, r) {
     }
 }
 
+DEF_TEST(AnimCodecPlayer_FrameCache, r) {
+    for (const char* file : { "images/required.gif", "images/required.webp",
+                              "images/alphabetAnim.gif", "images/stoplight.webp" }) {
+        sk_sp<SkData> data = GetResourceAsData(file);
+        if (!data) {
+            continue;
+        }
+        auto codec = SkCodec::MakeFromData(data);
+        REPORTER_ASSERT(r, codec);
+        const std::vector<SkCodec::FrameInfo> frameInfos = codec->getFrameInfo();
+        std::vector<uint32_t> startTimes;
+        uint32_t t = 0;
+        for (const SkCodec::FrameInfo& info : frameInfos) {
+            startTimes.push_back(t);
+            t += info.fDuration;
+        }
+
+        // Decode every frame in order, keeping them all.
+        std::vector<sk_sp<SkImage>> expected;
+        SkAnimCodecPlayer reference(std::move(codec));
+        for (uint32_t start : startTimes) {
+            reference.seek(start);
+            expected.push_back(reference.getFrame());
+            REPORTER_ASSERT(r, expected.back());
+        }
+        const size_t frameBytes = expected[0]->imageInfo().computeMinByteSize();
+        REPORTER_ASSERT(r, reference.cachedBytes() == frameBytes * frameInfos.size());
+
+        // Then with room for only a few of them, pre-decoding ahead, in an order that skips
+        // around and plays backward.
+        auto executor = SkExecutor::MakeFIFOThreadPool(2);
+        SkAnimCodecPlayer::Options options;
+        options.fFrameCacheBudget = 3 * frameBytes;
+        options.fExecutor = executor.get();
+        SkAnimCodecPlayer player(SkCodec::MakeFromData(data), data, options);
+
+        const int frameCount = (int)frameInfos.size();
+        std::vector<int> order;
+        for (int i = frameCount - 1; i >= 0; i--) {
+            order.push_back(i);
+        }
+        for (int i = 0; i < 2 * frameCount; i += 3) {
+            order.push_back(i % frameCount);
+        }
+        for (int i : order) {
+            player.seek(startTimes[i]);
+            sk_sp<SkImage> frame = player.getFrame();
+            REPORTER_ASSERT(r, frame && ToolUtils::equal_pixels(frame.get(), expected[i].get()),
+                            "%s frame %d", file, i);
+            REPORTER_ASSERT(r, player.cachedBytes() <= options.fFrameCacheBudget);
+        }
+    }
+}
+
 #endif
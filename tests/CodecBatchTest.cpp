@@ -0,0 +1,155 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/codec/SkCodec.h"
+#include "include/codec/SkCodecBatch.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkStream.h"
+#include "include/encode/SkJpegEncoder.h"
+#include "include/encode/SkPngEncoder.h"
+#include "src/base/SkRandom.h"
+#include "src/codec/SkCodecScratch.h"
+#include "tests/Test.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// Icons of assorted sizes, alternately PNG and JPEG, with enough noise that there are several
+// runs' worth of data.
+static std::vector<sk_sp<SkData>> make_icons(int count) {
+    SkRandom rand;
+    std::vector<sk_sp<SkData>> icons;
+    for (int i = 0; i < count; i++) {
+        SkBitmap bitmap;
+        bitmap.allocPixels(SkImageInfo::Make(8 + i % 41, 8 + i % 29, kRGBA_8888_SkColorType,
+                                             kPremul_SkAlphaType));
+        for (int y = 0; y < bitmap.height(); y++) {
+            for (int x = 0; x < bitmap.width(); x++) {
+                *bitmap.getAddr32(x, y) = rand.nextU() | 0xFF000000;
+            }
+        }
+        SkDynamicMemoryWStream stream;
+        if (i % 2) {
+            SkAssertResult(SkJpegEncoder::Encode(&stream, bitmap.pixmap(), {}));
+        } else {
+            SkAssertResult(SkPngEncoder::Encode(&stream, bitmap.pixmap(), {}));
+        }
+        icons.push_back(stream.detachAsData());
+    }
+    return icons;
+}
+
+DEF_TEST(CodecBatch_MatchesGetPixels, r) {
+    std::vector<sk_sp<SkData>> icons = make_icons(300);
+    icons[17] = nullptr;
+    icons[42] = SkData::MakeWithCString("not an image");
+
+    std::vector<SkBitmap> expected(icons.size());
+    std::vector<SkCodec::Result> expectedResults(icons.size(), SkCodec::kInvalidInput);
+    for (size_t i = 0; i < icons.size(); i++) {
+        std::unique_ptr<SkCodec> codec;
+        if (icons[i]) {
+            codec = SkCodec::MakeFromStream(SkMemoryStream::Make(icons[i]), &expectedResults[i]);
+        }
+        expected[i].allocPixels(SkImageInfo::MakeN32Premul(codec ? codec->dimensions()
+                                                                 : SkISize{4, 4}));
+        if (codec) {
+            expectedResults[i] = codec->getPixels(expected[i].pixmap());
+        }
+    }
+    REPORTER_ASSERT(r, expectedResults[42] != SkCodec::kSuccess);
+
+    auto executor = SkExecutor::MakeWorkStealingThreadPool(4);
+    for (SkExecutor* e : {(SkExecutor*)nullptr, executor.get()}) {
+        std::vector<SkBitmap> bitmaps(icons.size());
+        std::vector<SkPixmap> pixmaps;
+        for (size_t i = 0; i < icons.size(); i++) {
+            bitmaps[i].allocPixels(expected[i].info());
+            pixmaps.push_back(bitmaps[i].pixmap());
+        }
+
+        SkCodecBatch::Options options;
+        options.fExecutor = e;
+        std::vector<SkCodec::Result> results = SkCodecBatch::Decode(icons, pixmaps, options);
+        REPORTER_ASSERT(r, results.size() == icons.size());
+        for (size_t i = 0; i < icons.size(); i++) {
+            REPORTER_ASSERT(r, results[i] == expectedResults[i], "image %zu", i);
+            if (results[i] == SkCodec::kSuccess) {
+                REPORTER_ASSERT(r, 0 == memcmp(bitmaps[i].getPixels(), expected[i].getPixels(),
+                                               expected[i].computeByteSize()),
+                                "image %zu", i);
+            }
+        }
+    }
+}
+
+DEF_TEST(CodecBatch_Resampling, r) {
+    std::vector<sk_sp<SkData>> icons = make_icons(20);
+    SkBitmap atlas;
+    atlas.allocPixels(SkImageInfo::MakeN32Premul(16, 16 * (int)icons.size()));
+    std::vector<SkPixmap> slots;
+    for (int i = 0; i < (int)icons.size(); i++) {
+        SkPixmap slot;
+        SkAssertResult(atlas.pixmap().extractSubset(&slot, SkIRect::MakeXYWH(0, 16 * i, 16, 16)));
+        slots.push_back(slot);
+    }
+
+    // Without resampling only the 16x16 icon fits.
+    for (SkCodec::Result result : SkCodecBatch::Decode(icons, slots)) {
+        REPORTER_ASSERT(r, result == SkCodec::kSuccess || result == SkCodec::kInvalidScale);
+    }
+
+    const SkSamplingOptions sampling(SkCubicResampler::Mitchell());
+    SkCodecBatch::Options options;
+    options.fResampling = &sampling;
+    for (SkCodec::Result result : SkCodecBatch::Decode(icons, slots, options)) {
+        REPORTER_ASSERT(r, result == SkCodec::kSuccess);
+    }
+}
+
+DEF_TEST(CodecBatch_ScratchReuse, r) {
+    // Decoding the same images again with a scratch attached should take no more memory from the
+    // heap: every buffer and decoder the second pass needs is left over from the first.
+    const std::vector<sk_sp<SkData>> icons = make_icons(6);
+    SkCodecScratch scratch;
+    size_t reserved = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        SkCodecScratch::AutoAttach attach(&scratch);
+        REPORTER_ASSERT(r, SkCodecScratch::Get() == &scratch);
+        for (const sk_sp<SkData>& icon : icons) {
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromStream(SkMemoryStream::Make(icon));
+            REPORTER_ASSERT(r, codec);
+            if (!codec) {
+                return;
+            }
+            SkBitmap bitmap;
+            bitmap.allocPixels(SkImageInfo::MakeN32Premul(codec->dimensions()));
+            REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(bitmap.pixmap()));
+        }
+        if (pass == 0) {
+            reserved = scratch.bytesReserved();
+            REPORTER_ASSERT(r, reserved > 0);
+        } else {
+            REPORTER_ASSERT(r, scratch.bytesReserved() == reserved,
+                            "%zu bytes, then %zu", reserved, scratch.bytesReserved());
+        }
+    }
+    REPORTER_ASSERT(r, SkCodecScratch::Get() == nullptr);
+
+    // The JPEG decoder's context was given back for the next decode.
+    std::unique_ptr<SkCodecScratch::Cached> jpeg =
+            scratch.take(SkCodecScratch::Kind::kJpegDecompress);
+    REPORTER_ASSERT(r, jpeg);
+}
@@ -507,3 +507,106 @@ DEF_TEST(Codec_incomplete, r) {
         }
     }
 }
+
+// A HaltingStream for data that is streamed in, and so can be peeked but not rewound.
+class StreamedStream : public HaltingStream {
+public:
+    StreamedStream(sk_sp<SkData> data, size_t initialLimit)
+        : HaltingStream(data, initialLimit), fData(std::move(data)) {}
+
+    size_t peek(void* buffer, size_t size) const override {
+        const size_t position = this->getPosition();
+        size = std::min(size, this->getLength() - position);
+        memcpy(buffer, fData->bytes() + position, size);
+        return size;
+    }
+
+    bool rewind() override { return false; }
+    bool move(long) override { return false; }
+    bool seek(size_t) override { return false; }
+
+private:
+    sk_sp<SkData> fData;
+};
+
+// Decode a JPEG as it arrives, with previews of progressive JPEGs after each scan.
+static void test_jpeg_previews(skiatest::Reporter* r, const char* name, float scale,
+                               bool expectPreviews, bool rewindable) {
+    sk_sp<SkData> file = GetResourceAsData(name);
+    if (!file) {
+        SkDebugf("missing resource %s\n", name);
+        return;
+    }
+
+    std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(file));
+    if (!codec) {
+        ERRORF(r, "Failed to create codec for %s", name);
+        return;
+    }
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(codec->getScaledDimensions(scale));
+    SkBitmap truth;
+    truth.allocPixels(info);
+    REPORTER_ASSERT(r, SkCodec::kSuccess ==
+                       codec->getPixels(info, truth.getPixels(), truth.rowBytes()));
+
+    // Enough for the header, but not for the first scan.
+    HaltingStream* stream = rewindable ? new HaltingStream(file, 1000)
+                                       : new StreamedStream(file, 1000);
+    auto partialCodec = SkCodec::MakeFromStream(std::unique_ptr<SkStream>(stream));
+    if (!partialCodec) {
+        ERRORF(r, "Failed to create codec for %s with 1000 bytes", name);
+        return;
+    }
+    SkBitmap incremental;
+    incremental.allocPixels(info);
+
+    // Without asking for previews, JPEG leaves incremental decoding to scanline decoding.
+    REPORTER_ASSERT(r, SkCodec::kUnimplemented ==
+                       partialCodec->startIncrementalDecode(info, incremental.getPixels(),
+                                                            incremental.rowBytes()));
+
+    SkCodec::Options options;
+    options.fProgressivePreviews = true;
+    if (SkCodec::kSuccess != partialCodec->startIncrementalDecode(info, incremental.getPixels(),
+                                                                  incremental.rowBytes(),
+                                                                  &options)) {
+        ERRORF(r, "Failed to start incremental decode of %s", name);
+        return;
+    }
+
+    // An increment that doesn't line up with anything, so the decoder suspends all over.
+    constexpr size_t kIncrement = 777;
+    int previews = 0;
+    int lastRows = 0;
+    while (true) {
+        int rows = 0;
+        const SkCodec::Result result = partialCodec->incrementalDecode(&rows);
+        if (result == SkCodec::kSuccess) {
+            break;
+        }
+        REPORTER_ASSERT(r, result == SkCodec::kIncompleteInput);
+        REPORTER_ASSERT(r, rows >= lastRows && rows <= info.height());
+        lastRows = rows;
+        if (rows == info.height()) {
+            previews++;
+        }
+
+        if (stream->isAllDataReceived()) {
+            ERRORF(r, "Failed to completely decode %s", name);
+            return;
+        }
+        stream->addNewData(kIncrement);
+    }
+    REPORTER_ASSERT(r, (previews > 0) == expectPreviews, "%s %d previews", name, previews);
+
+    compare_bitmaps(r, truth, incremental);
+}
+
+DEF_TEST(Codec_jpegProgressivePreviews, r) {
+    for (float scale : {1.0f, 0.25f, 0.125f}) {
+        for (bool rewindable : {true, false}) {
+            test_jpeg_previews(r, "images/brickwork-texture.jpg", scale, true, rewindable);
+            test_jpeg_previews(r, "images/mandrill_512_q075.jpg", scale, false, rewindable);
+        }
+    }
+}
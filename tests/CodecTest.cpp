@@ -19,12 +19,14 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageGenerator.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSamplingOptions.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
@@ -60,6 +62,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <initializer_list>
 #include <memory>
@@ -717,6 +720,47 @@ DEF_TEST(Codec_png_plte_trns_gama, r) {
     t(r, "plte_trns_gama.png", kBGRA_8888_SkColorType, kPremul_SkAlphaType, {57, 49, 40, 64});
 }
 
+// Codecs read streams that are backed by memory in place. Make sure that decodes exactly what
+// reading the same bytes through read() does, including after rewinding and seeking to frames.
+DEF_TEST(Codec_ReadMemoryInPlace, r) {
+    for (const char* path : {"images/mandrill_512.png",
+                             "images/plane_interlaced.png",
+                             "images/test640x479.gif",
+                             "images/randPixelsAnim.gif",
+                             "images/required.gif"}) {
+        sk_sp<SkData> data = GetResourceAsData(path);
+        if (!data) {
+            continue;
+        }
+        // HaltingStream doesn't expose its memory, so codecs have to read() it.
+        std::unique_ptr<SkCodec> inPlace = SkCodec::MakeFromStream(
+                std::make_unique<SkMemoryStream>(data));
+        std::unique_ptr<SkCodec> copied = SkCodec::MakeFromStream(
+                std::make_unique<HaltingStream>(data, data->size()));
+        if (!inPlace || !copied) {
+            ERRORF(r, "Could not create codecs for %s", path);
+            continue;
+        }
+        REPORTER_ASSERT(r, inPlace->getFrameCount() == copied->getFrameCount(), "%s", path);
+
+        const SkImageInfo info = inPlace->getInfo().makeColorType(kN32_SkColorType)
+                                                   .makeAlphaType(kPremul_SkAlphaType);
+        // Decode the last frame first, to seek forward past the others before going back.
+        for (int i = inPlace->getFrameCount() - 1; i >= 0; i--) {
+            SkCodec::Options options;
+            options.fFrameIndex = i;
+            SkBitmap expected, actual;
+            expected.allocPixels(info);
+            actual.allocPixels(info);
+            REPORTER_ASSERT(r, SkCodec::kSuccess == copied->getPixels(expected.pixmap(), &options));
+            REPORTER_ASSERT(r, SkCodec::kSuccess == inPlace->getPixels(actual.pixmap(), &options));
+            REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                           expected.computeByteSize()),
+                            "%s frame %d", path, i);
+        }
+    }
+}
+
 // Disable RAW tests for Win32.
 #if defined(SK_CODEC_DECODES_RAW) && !defined(_WIN32)
 DEF_TEST(Codec_raw, r) {
@@ -1204,6 +1248,199 @@ DEF_TEST(Codec_jpeg_rewind, r) {
     REPORTER_ASSERT(r, SkCodec::kIncompleteInput == result);
 }
 
+static bool same_pixels(const SkBitmap& a, const SkBitmap& b, int bx = 0, int by = 0) {
+    for (int y = 0; y < a.height(); y++) {
+        if (0 != memcmp(a.getAddr(0, y), b.getAddr(bx, by + y), a.info().minRowBytes())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+DEF_TEST(Codec_jpeg_restart_markers, r) {
+    // A copy of mandrill_512_q075.jpg with a restart marker after every MCU row.
+    const char* path = "images/mandrill_512_q075_restart.jpg";
+    sk_sp<SkData> data(GetResourceAsData(path));
+    if (!data) {
+        return;
+    }
+    std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(data));
+    if (!codec) {
+        ERRORF(r, "Unable to create codec '%s'.", path);
+        return;
+    }
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    // Decoding strips at the same time should produce exactly what decoding in order does.
+    for (float scale : {1.0f, 0.5f, 0.375f}) {
+        for (auto cs : {sk_sp<SkColorSpace>(nullptr), SkColorSpace::MakeSRGBLinear()}) {
+            SkImageInfo info = codec->getInfo().makeDimensions(codec->getScaledDimensions(scale))
+                                               .makeColorType(kN32_SkColorType)
+                                               .makeColorSpace(cs);
+            SkBitmap expected, actual;
+            expected.allocPixels(info);
+            actual.allocPixels(info);
+            REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(expected.pixmap()));
+
+            SkCodec::Options opts;
+            opts.fExecutor = executor.get();
+            REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(actual.pixmap(), &opts));
+            REPORTER_ASSERT(r, same_pixels(expected, actual), "scale %g", scale);
+        }
+    }
+
+    SkBitmap full;
+    full.allocPixels(codec->getInfo().makeColorType(kN32_SkColorType));
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(full.pixmap()));
+
+    // Skipping scanlines may start again from a restart marker, which shouldn't change the rows
+    // we read after skipping.
+    for (int skip : {8, 40, 200, 300}) {
+        SkBitmap rows;
+        rows.allocPixels(full.info().makeWH(full.width(), 64));
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->startScanlineDecode(full.info()));
+        REPORTER_ASSERT(r, codec->skipScanlines(skip));
+        REPORTER_ASSERT(r, 32 == codec->getScanlines(rows.getPixels(), 32, rows.rowBytes()));
+        REPORTER_ASSERT(r, codec->skipScanlines(100));
+        REPORTER_ASSERT(r, 32 == codec->getScanlines(rows.getAddr(0, 32), 32, rows.rowBytes()));
+
+        SkBitmap first, second;
+        REPORTER_ASSERT(r, rows.extractSubset(&first, SkIRect::MakeWH(full.width(), 32)));
+        REPORTER_ASSERT(r, rows.extractSubset(&second, SkIRect::MakeXYWH(0, 32, full.width(), 32)));
+        REPORTER_ASSERT(r, same_pixels(first, full, 0, skip), "skip %d", skip);
+        REPORTER_ASSERT(r, same_pixels(second, full, 0, skip + 132), "skip %d", skip);
+    }
+
+    // Region decodes seek the same way.  Crops don't upsample their edges quite like full
+    // decodes do, so compare with the same region of the image without restart markers.
+    std::unique_ptr<SkAndroidCodec> restartCodec(SkAndroidCodec::MakeFromData(data));
+    std::unique_ptr<SkAndroidCodec> plainCodec(
+            SkAndroidCodec::MakeFromData(GetResourceAsData("images/mandrill_512_q075.jpg")));
+    for (SkIRect subset : {SkIRect::MakeXYWH(64, 300, 128, 100),
+                           SkIRect::MakeXYWH(0, 480, 512, 32)}) {
+        SkImageInfo info = full.info().makeDimensions(subset.size());
+        SkAndroidCodec::AndroidOptions opts;
+        opts.fSubset = &subset;
+        SkBitmap expected, actual;
+        expected.allocPixels(info);
+        actual.allocPixels(info);
+        REPORTER_ASSERT(r, SkCodec::kSuccess == plainCodec->getAndroidPixels(
+                info, expected.getPixels(), expected.rowBytes(), &opts));
+        REPORTER_ASSERT(r, SkCodec::kSuccess == restartCodec->getAndroidPixels(
+                info, actual.getPixels(), actual.rowBytes(), &opts));
+        REPORTER_ASSERT(r, same_pixels(expected, actual));
+    }
+}
+
+static std::unique_ptr<SkCodec> encode_and_make_codec(const SkBitmap& bm) {
+    SkDynamicMemoryWStream stream;
+    SkASSERT_RELEASE(SkPngEncoder::Encode(&stream, bm.pixmap(), {}));
+    return SkCodec::MakeFromData(stream.detachAsData());
+}
+
+DEF_TEST(Codec_resample_box, r) {
+    SkBitmap src;
+    src.allocPixels(SkImageInfo::MakeN32(64, 48, kOpaque_SkAlphaType));
+    SkRandom rand;
+    for (int y = 0; y < src.height(); y++) {
+        for (int x = 0; x < src.width(); x++) {
+            *src.getAddr32(x, y) = rand.nextU() | 0xFF000000;
+        }
+    }
+    std::unique_ptr<SkCodec> codec = encode_and_make_codec(src);
+    REPORTER_ASSERT(r, codec);
+
+    // Halving with a box filter averages each 2x2 block.
+    SkSamplingOptions sampling;
+    SkCodec::Options opts;
+    opts.fResampling = &sampling;
+    SkBitmap dst;
+    dst.allocPixels(src.info().makeWH(32, 24));
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(dst.pixmap(), &opts));
+    for (int y = 0; y < dst.height(); y++) {
+        for (int x = 0; x < dst.width(); x++) {
+            for (int shift : {0, 8, 16}) {
+                int sum = 0;
+                for (auto [dx, dy] : {std::pair{0, 0}, {1, 0}, {0, 1}, {1, 1}}) {
+                    sum += (*src.getAddr32(2*x + dx, 2*y + dy) >> shift) & 0xFF;
+                }
+                const int actual = (*dst.getAddr32(x, y) >> shift) & 0xFF;
+                REPORTER_ASSERT(r, std::abs(4 * actual - sum) <= 4,
+                                "(%d, %d) expected %g, got %d", x, y, sum / 4.0f, actual);
+            }
+        }
+    }
+
+    // Without fResampling, only the codec's own sizes are allowed.
+    opts.fResampling = nullptr;
+    REPORTER_ASSERT(r, SkCodec::kInvalidScale == codec->getPixels(dst.pixmap(), &opts));
+}
+
+DEF_TEST(Codec_resample_solid, r) {
+    SkBitmap src;
+    src.allocPixels(SkImageInfo::MakeN32Premul(50, 40));
+    src.eraseColor(SkColorSetARGB(0x80, 0x20, 0x60, 0xA0));
+    std::unique_ptr<SkCodec> codec = encode_and_make_codec(src);
+
+    // However they're filtered, the pixels of a solid image should stay the same color.
+    for (SkSamplingOptions sampling : {SkSamplingOptions(SkCubicResampler::Mitchell()),
+                                       SkSamplingOptions(SkCubicResampler::CatmullRom()),
+                                       SkSamplingOptions(SkFilterMode::kLinear),
+                                       SkSamplingOptions()}) {
+        for (SkISize size : {SkISize{17, 61}, SkISize{97, 3}, SkISize{1, 1}}) {
+            SkCodec::Options opts;
+            opts.fResampling = &sampling;
+            SkBitmap dst;
+            dst.allocPixels(src.info().makeDimensions(size));
+            REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(dst.pixmap(), &opts));
+            for (int y = 0; y < size.height(); y++) {
+                for (int x = 0; x < size.width(); x++) {
+                    REPORTER_ASSERT(r, *dst.getAddr32(x, y) == *src.getAddr32(0, 0),
+                                    "%dx%d (%d, %d): %08x", size.width(), size.height(), x, y,
+                                    *dst.getAddr32(x, y));
+                }
+            }
+        }
+    }
+}
+
+DEF_TEST(Codec_resample_jpeg, r) {
+    const char* path = "images/mandrill_512_q075.jpg";
+    sk_sp<SkData> data(GetResourceAsData(path));
+    if (!data) {
+        return;
+    }
+    std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(data));
+    std::unique_ptr<SkAndroidCodec> androidCodec(SkAndroidCodec::MakeFromData(data));
+    if (!codec || !androidCodec) {
+        ERRORF(r, "Unable to create codecs '%s'.", path);
+        return;
+    }
+
+    const SkSamplingOptions sampling(SkCubicResampler::Mitchell());
+    const SkImageInfo info = codec->getInfo().makeWH(100, 90).makeColorType(kN32_SkColorType);
+    SkBitmap expected, actual;
+    expected.allocPixels(info);
+    actual.allocPixels(info);
+
+    SkCodec::Options opts;
+    opts.fResampling = &sampling;
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(expected.pixmap(), &opts));
+
+    // SkAndroidCodec passes the request straight through, whatever the sample size.
+    SkAndroidCodec::AndroidOptions androidOpts;
+    androidOpts.fResampling = &sampling;
+    androidOpts.fSampleSize = 3;
+    REPORTER_ASSERT(r, SkCodec::kSuccess == androidCodec->getAndroidPixels(
+            info, actual.getPixels(), actual.rowBytes(), &androidOpts));
+    REPORTER_ASSERT(r, same_pixels(expected, actual));
+
+    // Subsets aren't supported.
+    SkIRect subset = SkIRect::MakeWH(256, 256);
+    opts.fSubset = &subset;
+    REPORTER_ASSERT(r, SkCodec::kUnimplemented == codec->getPixels(actual.pixmap(), &opts));
+}
+
 static void check_color_xform(skiatest::Reporter* r, const char* path) {
     std::unique_ptr<SkAndroidCodec> codec(SkAndroidCodec::MakeFromStream(GetResourceAsStream(path)));
 
@@ -10,14 +10,21 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceProps.h"
+#include "src/base/SkArenaAlloc.h"
 #include "src/core/SkBlitter.h"
 #include "src/core/SkCoreBlitters.h"
 #include "src/core/SkMask.h"
 
+#include <cstring>
 #include <memory>
 
+extern bool gSkUseRasterPipelineBlitterCache;
+extern thread_local int gSkRasterPipelineBlitterCacheMisses;
+
 static bool all_pixels_same_color(uint32_t* buffer, size_t len) {
     for (size_t i = 1; i < len; ++i) {
         if (buffer[0] != buffer[i]) {
@@ -197,3 +204,118 @@ DEF_TEST(SkARGB32Blitter_MaskAndAntiHDrawTheSame, r) {
         }
     }
 }
+
+DEF_TEST(SkRasterPipelineBlitter_SolidColorCache, r) {
+    const sk_sp<SkColorSpace> p3 = SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB,
+                                                         SkNamedGamut::kDisplayP3),
+                              linear = SkColorSpace::MakeSRGBLinear();
+    // None of these can be drawn by the legacy blitters.
+    const SkImageInfo infos[] = {
+            SkImageInfo::MakeN32Premul(64, 48, p3),
+            SkImageInfo::Make(64, 48, kRGBA_F16_SkColorType, kPremul_SkAlphaType, linear),
+            SkImageInfo::Make(64, 48, kRGB_565_SkColorType, kOpaque_SkAlphaType),
+            SkImageInfo::Make(64, 48, kRGBA_8888_SkColorType, kUnpremul_SkAlphaType, p3),
+            SkImageInfo::Make(64, 48, kGray_8_SkColorType, kOpaque_SkAlphaType),
+    };
+    const SkColor4f colors[] = {
+            SkColors::kBlack, SkColors::kWhite, SkColors::kTransparent,
+            {0.2f, 0.4f, 0.6f, 1.0f},
+            {0.9f, 0.1f, 0.3f, 0.5f},
+            {0.1f, 0.7f, 0.2f, 0.25f},
+            {1.5f, -0.2f, 0.5f, 0.8f},  // Out of gamut, so it's clamped unless the dst is float.
+    };
+    const SkBlendMode modes[] = {
+            SkBlendMode::kSrcOver, SkBlendMode::kSrc, SkBlendMode::kMultiply, SkBlendMode::kPlus,
+    };
+    const SkPath circle = SkPath::Circle(7.5f, 6.3f, 5.2f);
+
+    // Cached blitters are reused with new colors and destinations, and must draw just like
+    // blitters built from scratch.
+    auto draw = [&](const SkImageInfo& info, bool cache) {
+        SkBitmap bitmap;
+        bitmap.allocPixels(info);
+        bitmap.eraseColor(SK_ColorGRAY);
+        SkCanvas canvas(bitmap);
+
+        const bool useCache = gSkUseRasterPipelineBlitterCache;
+        gSkUseRasterPipelineBlitterCache = cache;
+        int i = 0;
+        for (SkBlendMode mode : modes) {
+            for (const SkColor4f& color : colors) {
+                SkPaint paint(color);
+                paint.setBlendMode(mode);
+                const float x = (i % 4) * 16, y = (i / 4 % 4) * 12;
+                canvas.drawRect(SkRect::MakeXYWH(x, y, 8, 6), paint);
+                paint.setAntiAlias(true);
+                canvas.drawRect(SkRect::MakeXYWH(x + 4.5f, y + 3.25f, 9, 7.5f), paint);
+                canvas.save();
+                canvas.translate(x, y);
+                canvas.drawPath(circle, paint);
+                canvas.restore();
+                i++;
+            }
+        }
+        gSkUseRasterPipelineBlitterCache = useCache;
+        return bitmap;
+    };
+    for (const SkImageInfo& info : infos) {
+        const SkBitmap cached = draw(info, true),
+                       uncached = draw(info, false);
+        REPORTER_ASSERT(r, 0 == memcmp(cached.getPixels(), uncached.getPixels(),
+                                       cached.computeByteSize()),
+                        "color type %d, alpha type %d", info.colorType(), info.alphaType());
+    }
+
+    // Two blitters alive at once can't share a cache entry.
+    uint32_t pixels1[4] = {}, pixels2[4] = {};
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(4, 1, p3);
+    const SkPixmap dst1(info, pixels1, info.minRowBytes()),
+                   dst2(info, pixels2, info.minRowBytes());
+    SkPaint paint1(SkColor4f{0.2f, 0.4f, 0.6f, 1.0f}),
+            paint2(SkColor4f{0.6f, 0.4f, 0.2f, 1.0f});
+    SkSTArenaAlloc<256> alloc1, alloc2;
+    SkBlitter* blitter1 = SkCreateRasterPipelineBlitter(dst1, paint1, SkMatrix::I(), &alloc1,
+                                                        nullptr, SkSurfaceProps());
+    SkBlitter* blitter2 = SkCreateRasterPipelineBlitter(dst2, paint2, SkMatrix::I(), &alloc2,
+                                                        nullptr, SkSurfaceProps());
+    REPORTER_ASSERT(r, blitter1 && blitter2 && blitter1 != blitter2);
+    blitter1->blitH(0, 0, 4);
+    blitter2->blitH(0, 0, 4);
+    REPORTER_ASSERT(r, pixels1[0] != pixels2[0]);
+    REPORTER_ASSERT(r, pixels1[0] == pixels1[3] && pixels2[0] == pixels2[3]);
+}
+
+DEF_TEST(SkRasterPipelineBlitter_SolidColorCacheAlternatingKeys, r) {
+    // Draws that switch between keys should each find their own entry, not evict each other.
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(4, 1, SkColorSpace::MakeRGB(
+            SkNamedTransferFn::kSRGB, SkNamedGamut::kDisplayP3));
+    uint32_t pixels[4] = {};
+    const SkPixmap dst(info, pixels, info.minRowBytes());
+
+    SkPaint opaque(SkColor4f{0.2f, 0.4f, 0.6f, 1.0f}),
+            translucent(SkColor4f{0.2f, 0.4f, 0.6f, 0.5f}),
+            black(SkColors::kBlack),
+            multiply(SkColor4f{0.2f, 0.4f, 0.6f, 1.0f});
+    multiply.setBlendMode(SkBlendMode::kMultiply);
+    const SkPaint* paints[] = {&opaque, &translucent, &black, &multiply};
+
+    const bool useCache = gSkUseRasterPipelineBlitterCache;
+    gSkUseRasterPipelineBlitterCache = true;
+    auto drawAll = [&] {
+        for (const SkPaint* paint : paints) {
+            SkSTArenaAlloc<256> alloc;
+            SkBlitter* blitter = SkCreateRasterPipelineBlitter(dst, *paint, SkMatrix::I(), &alloc,
+                                                               nullptr, SkSurfaceProps());
+            REPORTER_ASSERT(r, blitter);
+            blitter->blitH(0, 0, 4);
+        }
+    };
+    drawAll();
+    const int misses = gSkRasterPipelineBlitterCacheMisses;
+    for (int i = 0; i < 10; i++) {
+        drawAll();
+    }
+    REPORTER_ASSERT(r, gSkRasterPipelineBlitterCacheMisses == misses,
+                    "%d misses", gSkRasterPipelineBlitterCacheMisses - misses);
+    gSkUseRasterPipelineBlitterCache = useCache;
+}
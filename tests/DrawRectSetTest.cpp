@@ -0,0 +1,255 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkShader.h"
+#include "include/core/SkSurface.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkCanvasPriv.h"
+#include "tests/Test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+extern bool gSkForceRasterPipelineBlitter;
+
+namespace {
+
+constexpr int kSize = 67;  // Odd, so rows aren't a whole number of SIMD lanes.
+
+struct Batch {
+    std::vector<SkRect>    fRects;
+    std::vector<SkRRect>   fRRects;
+    std::vector<SkColor4f> fColors;
+};
+
+Batch make_batch(SkRandom* rand, int count, bool extended) {
+    Batch batch;
+    for (int i = 0; i < count; i++) {
+        // Some shapes hang off the canvas, some are thinner than a pixel.
+        const float x = rand->nextRangeF(-10, kSize),
+                    y = rand->nextRangeF(-10, kSize),
+                    w = rand->nextBool() ? rand->nextRangeF(0.1f, 1.5f)
+                                         : rand->nextRangeF(1, 40),
+                    h = rand->nextBool() ? rand->nextRangeF(0.1f, 1.5f)
+                                         : rand->nextRangeF(1, 40);
+        batch.fRects.push_back(SkRect::MakeXYWH(x, y, w, h));
+
+        const SkRect r = SkRect::MakeXYWH(x, y, w + 4, h + 4);
+        const SkVector radii[4] = {{rand->nextRangeF(0, 8), rand->nextRangeF(0, 8)},
+                                   {rand->nextRangeF(0, 8), rand->nextRangeF(0, 8)},
+                                   {rand->nextRangeF(0, 8), rand->nextRangeF(0, 8)},
+                                   {rand->nextRangeF(0, 8), rand->nextRangeF(0, 8)}};
+        SkRRect rrect;
+        rrect.setRectRadii(r, radii);
+        batch.fRRects.push_back(rrect);
+
+        SkColor4f color = SkColor4f::FromColor(rand->nextU());
+        if (rand->nextU() % 4 == 0) {
+            color.fA = 1;
+        }
+        if (extended && rand->nextBool()) {
+            color.fR = rand->nextRangeF(-0.5f, 1.5f);
+        }
+        batch.fColors.push_back(color);
+    }
+    return batch;
+}
+
+using Draw = std::function<void(SkCanvas*)>;
+
+// Draws into two surfaces, first with the setup then the batch, and second with the setup then
+// each shape one at a time.  Returns how many channels of their pixels differ by more than
+// tolerance, and how far apart the farthest are.
+int draw_both(const SkImageInfo& info, const Draw& setup, const Draw& batch, const Draw& each,
+              float tolerance, float* maxDiff) {
+    const SkImageInfo readInfo = info.makeColorType(kRGBA_F32_SkColorType)
+                                     .makeAlphaType(kPremul_SkAlphaType);
+    std::vector<float> pixels[2];
+    for (int i = 0; i < 2; i++) {
+        auto surface = SkSurfaces::Raster(info);
+        SkCanvas* canvas = surface->getCanvas();
+        canvas->clear(SK_ColorWHITE);
+        setup(canvas);
+        (i == 0 ? batch : each)(canvas);
+        pixels[i].resize(readInfo.computeMinByteSize() / sizeof(float));
+        surface->readPixels(readInfo, pixels[i].data(), readInfo.minRowBytes(), 0, 0);
+    }
+
+    int differ = 0;
+    *maxDiff = 0;
+    for (size_t i = 0; i < pixels[0].size(); i++) {
+        const float diff = std::fabs(pixels[0][i] - pixels[1][i]);
+        *maxDiff = std::max(*maxDiff, diff);
+        differ += diff > tolerance;
+    }
+    return differ;
+}
+
+const std::vector<std::pair<const char*, Draw>>& setups() {
+    static const std::vector<std::pair<const char*, Draw>> kSetups = {
+        {"none", [](SkCanvas*) {}},
+        {"translate", [](SkCanvas* c) { c->translate(3.25f, -2.5f); }},
+        {"scale", [](SkCanvas* c) { c->scale(1.5f, 0.75f); }},
+        {"rotate", [](SkCanvas* c) { c->rotate(20); }},  // Not drawn in a single pass.
+        {"rect clip", [](SkCanvas* c) { c->clipRect(SkRect::MakeLTRB(5, 7, 50, 44)); }},
+        {"aa clip", [](SkCanvas* c) {
+            c->clipPath(SkPath::Circle(30, 30, 25), true);
+        }},
+        {"complex clip", [](SkCanvas* c) {
+            c->clipRect(SkRect::MakeLTRB(10, 10, 40, 40), SkClipOp::kDifference);
+            c->clipRect(SkRect::MakeLTRB(0, 20, 60, 30), SkClipOp::kDifference);
+        }},
+    };
+    return kSetups;
+}
+
+}  // namespace
+
+DEF_TEST(DrawRectSet_MatchesDrawRect, reporter) {
+    // The legacy blitters color pixels slightly differently than the raster pipeline, so make
+    // both draws use the same blitter.
+    const bool forced = gSkForceRasterPipelineBlitter;
+    gSkForceRasterPipelineBlitter = true;
+
+    const SkImageInfo infos[] = {
+        SkImageInfo::MakeN32Premul(kSize, kSize),
+        SkImageInfo::MakeN32Premul(kSize, kSize, SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB,
+                                                                       SkNamedGamut::kDisplayP3)),
+        SkImageInfo::Make(kSize, kSize, kRGBA_F16_SkColorType, kPremul_SkAlphaType,
+                          SkColorSpace::MakeSRGBLinear()),
+        SkImageInfo::Make(kSize, kSize, kRGB_565_SkColorType, kOpaque_SkAlphaType),
+    };
+    const SkBlendMode modes[] = {SkBlendMode::kSrcOver, SkBlendMode::kSrc,
+                                 SkBlendMode::kMultiply};
+
+    SkRandom rand;
+    for (const SkImageInfo& info : infos) {
+        const bool extended = info.colorType() == kRGBA_F16_SkColorType;
+        for (bool aa : {false, true}) {
+            for (SkBlendMode mode : modes) {
+                for (const auto& [setupName, setup] : setups()) {
+                    const Batch b = make_batch(&rand, 60, extended);
+                    const int count = (int)b.fRects.size();
+                    SkPaint paint;
+                    paint.setAntiAlias(aa);
+                    paint.setBlendMode(mode);
+
+                    // Complex clips split rects up where the clip's rects meet.  The edges of
+                    // each piece are covered a hair differently than the batch covers them,
+                    // which can round to the next step of 565's 5-bit channels.
+                    const float tolerance = strcmp(setupName, "complex clip") ? 0 : 1 / 16.0f;
+                    float maxDiff;
+                    const int differ = draw_both(info, setup,
+                              [&](SkCanvas* c) {
+                                  SkCanvasPriv::DrawRectSet(c, b.fRects.data(), b.fColors.data(),
+                                                            count, paint);
+                              },
+                              [&](SkCanvas* c) {
+                                  SkPaint p(paint);
+                                  for (int i = 0; i < count; i++) {
+                                      p.setColor4f(b.fColors[i]);
+                                      c->drawRect(b.fRects[i], p);
+                                  }
+                              },
+                              tolerance, &maxDiff);
+                    REPORTER_ASSERT(reporter, differ == 0,
+                                    "colorType %d aa %d mode %d setup %s max diff %g",
+                                    info.colorType(), aa, (int)mode, setupName, maxDiff);
+                }
+            }
+        }
+    }
+
+    gSkForceRasterPipelineBlitter = forced;
+}
+
+DEF_TEST(DrawRectSet_Shader, reporter) {
+    // Shaded paints are drawn one rect at a time, each rect's alpha modulating the shader.
+    SkRandom rand;
+    const Batch b = make_batch(&rand, 20, false);
+    const int count = (int)b.fRects.size();
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setShader(SkShaders::Color(SK_ColorBLUE));
+
+    float maxDiff;
+    const int differ = draw_both(
+            SkImageInfo::MakeN32Premul(kSize, kSize), [](SkCanvas*) {},
+            [&](SkCanvas* c) {
+                SkCanvasPriv::DrawRectSet(c, b.fRects.data(), b.fColors.data(), count, paint);
+            },
+            [&](SkCanvas* c) {
+                SkPaint p(paint);
+                for (int i = 0; i < count; i++) {
+                    p.setColor4f(b.fColors[i]);
+                    c->drawRect(b.fRects[i], p);
+                }
+            },
+            0, &maxDiff);
+    REPORTER_ASSERT(reporter, differ == 0, "max diff %g", maxDiff);
+}
+
+DEF_TEST(DrawRRectSet_MatchesDrawRRect, reporter) {
+    const bool forced = gSkForceRasterPipelineBlitter;
+    gSkForceRasterPipelineBlitter = true;
+
+    const SkImageInfo infos[] = {
+        SkImageInfo::MakeN32Premul(kSize, kSize),
+        SkImageInfo::Make(kSize, kSize, kRGBA_F16_SkColorType, kPremul_SkAlphaType,
+                          SkColorSpace::MakeSRGBLinear()),
+        // Rows wide enough that the sweep's bands are a few rows tall, so most rrects cross
+        // several of them.
+        SkImageInfo::Make(4096, kSize, kRGBA_F16_SkColorType, kPremul_SkAlphaType,
+                          SkColorSpace::MakeSRGBLinear()),
+    };
+    SkRandom rand;
+    for (const SkImageInfo& info : infos) {
+        for (bool aa : {false, true}) {
+            for (const auto& [setupName, setup] : setups()) {
+                const Batch b = make_batch(&rand, 30, false);
+                const int count = (int)b.fRRects.size();
+                SkPaint paint;
+                paint.setAntiAlias(aa);
+
+                // As for rects, complex clips split the straight sides up where the clip's rects
+                // meet, which can round to the next step of 565's 5-bit channels.
+                float maxDiff;
+                const int differ = draw_both(info, setup,
+                          [&](SkCanvas* c) {
+                              SkCanvasPriv::DrawRRectSet(c, b.fRRects.data(), b.fColors.data(),
+                                                         count, paint);
+                          },
+                          [&](SkCanvas* c) {
+                              SkPaint p(paint);
+                              for (int i = 0; i < count; i++) {
+                                  p.setColor4f(b.fColors[i]);
+                                  c->drawRRect(b.fRRects[i], p);
+                              }
+                          },
+                          0, &maxDiff);
+                REPORTER_ASSERT(reporter, differ == 0,
+                                "colorType %d aa %d setup %s %d channels differ, max diff %g",
+                                info.colorType(), aa, setupName, differ, maxDiff);
+            }
+        }
+    }
+
+    gSkForceRasterPipelineBlitter = forced;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkPath.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkAnalyticEdge.h"
+#include "src/core/SkEdge.h"
+#include "src/core/SkEdgeBuilder.h"
+#include "src/core/SkLineClipper.h"
+#include "src/core/SkPathPriv.h"
+#include "tests/Test.h"
+
+#include <array>
+#include <vector>
+
+namespace {
+
+// A chart-like polyline, closed along the bottom.  x only increases, so none of its lines are
+// vertical, and no edges get combined.  Some points land on whole pixels and on the clip's
+// edges, to make zero-height lines and lines that just touch the clip.
+SkPath make_polyline(SkRandom* rand, int count) {
+    SkPath path;
+    float x = rand->nextRangeF(0, 4);
+    path.moveTo(x, 60);
+    for (int i = 0; i < count; i++) {
+        float y = rand->nextRangeF(-5, 65);
+        switch (rand->nextU() % 4) {
+            case 0: y = (float)(int)y; break;
+            case 1: y = rand->nextBool() ? 10 : 50; break;
+            default: break;
+        }
+        x += rand->nextRangeF(0.125f, 2);
+        path.lineTo(x, y);
+    }
+    path.lineTo(x + 1, 60);
+    return path;
+}
+
+// The lines a polygon edge builder should make edges for, clipped as SkLineClipper clips them.
+std::vector<std::array<SkPoint, 2>> path_lines(const SkPath& path, const SkRect* clip) {
+    std::vector<std::array<SkPoint, 2>> lines;
+    SkPathEdgeIter iter(path);
+    while (auto e = iter.next()) {
+        if (!clip) {
+            lines.push_back({e.fPts[0], e.fPts[1]});
+            continue;
+        }
+        SkPoint clipped[SkLineClipper::kMaxPoints];
+        const int count = SkLineClipper::ClipLine(e.fPts, *clip, clipped, true);
+        for (int i = 0; i < count; i++) {
+            lines.push_back({clipped[i], clipped[i + 1]});
+        }
+    }
+    return lines;
+}
+
+}  // namespace
+
+DEF_TEST(EdgeBuilder_PolyLines, reporter) {
+    // Edges for all-line paths are set up in batches; they should be the same edges that setting
+    // up each line on its own makes.
+    SkRandom rand;
+    const SkIRect clip = SkIRect::MakeLTRB(0, 10, 1000, 50);
+    for (int count : {1, 7, 8, 9, 100, 1000}) {
+        const SkPath path = make_polyline(&rand, count);
+        for (bool clipped : {false, true}) {
+            for (int shift : {0, 2}) {
+                const SkIRect shiftedClip = {clip.fLeft << shift, clip.fTop << shift,
+                                             clip.fRight << shift, clip.fBottom << shift};
+                const SkRect clipRect = SkRect::Make(clip);
+                const auto lines = path_lines(path, clipped ? &clipRect : nullptr);
+
+                SkBasicEdgeBuilder builder(shift);
+                const int edgeCount = builder.buildEdges(path, clipped ? &shiftedClip : nullptr);
+                SkEdge** edges = builder.edgeList();
+                int e = 0;
+                for (const auto& line : lines) {
+                    SkEdge expected;
+                    if (!expected.setLine(line[0], line[1], shift)) {
+                        continue;
+                    }
+                    REPORTER_ASSERT(reporter, e < edgeCount);
+                    if (e >= edgeCount) {
+                        return;
+                    }
+                    const SkEdge* edge = edges[e++];
+                    REPORTER_ASSERT(reporter, edge->fX       == expected.fX &&
+                                              edge->fDX      == expected.fDX &&
+                                              edge->fFirstY  == expected.fFirstY &&
+                                              edge->fLastY   == expected.fLastY &&
+                                              edge->fWinding == expected.fWinding,
+                                    "count %d clipped %d shift %d edge %d",
+                                    count, clipped, shift, e - 1);
+                }
+                REPORTER_ASSERT(reporter, e == edgeCount);
+            }
+
+            const SkRect clipRect = SkRect::Make(clip);
+            const auto lines = path_lines(path, clipped ? &clipRect : nullptr);
+
+            SkAnalyticEdgeBuilder builder;
+            const int edgeCount = builder.buildEdges(path, clipped ? &clip : nullptr);
+            SkAnalyticEdge** edges = builder.analyticEdgeList();
+            int e = 0;
+            for (const auto& line : lines) {
+                SkAnalyticEdge expected;
+                if (!expected.setLine(line[0], line[1])) {
+                    continue;
+                }
+                REPORTER_ASSERT(reporter, e < edgeCount);
+                if (e >= edgeCount) {
+                    return;
+                }
+                const SkAnalyticEdge* edge = edges[e++];
+                REPORTER_ASSERT(reporter, edge->fX       == expected.fX &&
+                                          edge->fDX      == expected.fDX &&
+                                          edge->fUpperY  == expected.fUpperY &&
+                                          edge->fLowerY  == expected.fLowerY &&
+                                          edge->fDY      == expected.fDY &&
+                                          edge->fWinding == expected.fWinding,
+                                "count %d clipped %d analytic edge %d", count, clipped, e - 1);
+            }
+            REPORTER_ASSERT(reporter, e == edgeCount);
+        }
+    }
+}
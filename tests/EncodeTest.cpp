@@ -15,6 +15,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
@@ -22,6 +23,8 @@
 #include "include/core/SkStream.h"
 #include "include/core/SkSurface.h"
 #include "include/core/SkTypes.h"
+#include "include/core/SkYUVAInfo.h"
+#include "include/core/SkYUVAPixmaps.h"
 #include "include/encode/SkEncoder.h"
 #include "include/encode/SkJpegEncoder.h"
 #include "include/encode/SkPngEncoder.h"
@@ -32,6 +35,7 @@
 #include "modules/skcms/src/skcms_public.h"
 #include "src/core/SkColorPriv.h"
 #include "src/core/SkConvertPixels.h"
+#include "src/base/SkRandom.h"
 #include "src/core/SkImageInfoPriv.h"
 #include "tests/Test.h"
 #include "tools/DecodeUtils.h"
@@ -54,6 +58,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <initializer_list>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <vector>
@@ -398,6 +403,127 @@ DEF_TEST(Encode_JpegDownsample, r) {
     REPORTER_ASSERT(r, almost_equals(bm1, bm2, 60));
 }
 
+DEF_TEST(Encode_JpegThreaded, r) {
+    // Tall enough to be split into several bands, with a height that isn't a whole number of MCU
+    // rows, and noise so that the entropy-coded data has plenty of 0xFF bytes to stuff.
+    constexpr int kWidth = 301, kHeight = 777;
+    SkBitmap src;
+    src.allocPixels(SkImageInfo::Make(kWidth, kHeight, kRGBA_8888_SkColorType,
+                                      kOpaque_SkAlphaType));
+    SkRandom rand;
+    for (int y = 0; y < kHeight; y++) {
+        for (int x = 0; x < kWidth; x++) {
+            *src.getAddr32(x, y) = SkColorSetARGB(255, x & 0xFF, y & 0xFF, (x ^ y) & 0xFF) ^
+                                   (rand.nextU() & 0x001F1F1F);
+        }
+    }
+
+    auto executor = SkExecutor::MakeWorkStealingThreadPool(4);
+    auto decode = [&](sk_sp<SkData> data) {
+        SkBitmap bitmap;
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(std::move(data));
+        REPORTER_ASSERT(r, codec);
+        if (codec) {
+            REPORTER_ASSERT(r, codec->getOrigin() == kRightTop_SkEncodedOrigin);
+            bitmap.allocPixels(codec->getInfo().makeColorType(kRGBA_8888_SkColorType));
+            REPORTER_ASSERT(r, codec->getPixels(bitmap.pixmap()) == SkCodec::kSuccess);
+        }
+        return bitmap;
+    };
+    // Huffman tables and restart markers don't change the coefficients, so the bands must decode
+    // to exactly the pixels of the serial encode.
+    auto check = [&](auto&& encode, const char* name) {
+        SkJpegEncoder::Options options;
+        options.fOrigin = kRightTop_SkEncodedOrigin;
+        SkDynamicMemoryWStream serialStream, threadedStream;
+        REPORTER_ASSERT(r, encode(&serialStream, options));
+        options.fExecutor = executor.get();
+        REPORTER_ASSERT(r, encode(&threadedStream, options));
+        sk_sp<SkData> serial = serialStream.detachAsData(),
+                      threaded = threadedStream.detachAsData();
+
+        SkBitmap expected = decode(serial),
+                 actual   = decode(threaded);
+        REPORTER_ASSERT(r, expected.dimensions() == SkISize::Make(kWidth, kHeight));
+        REPORTER_ASSERT(r, expected.computeByteSize() == actual.computeByteSize(), "%s", name);
+        REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                       expected.computeByteSize()), "%s", name);
+        // Only the bands have restart intervals.
+        const uint8_t kDRI[] = {0xFF, 0xDD};
+        auto has_dri = [&](const sk_sp<SkData>& data) {
+            return std::search(data->bytes(), data->bytes() + data->size(),
+                               std::begin(kDRI), std::end(kDRI)) != data->bytes() + data->size();
+        };
+        REPORTER_ASSERT(r, !has_dri(serial), "%s", name);
+        REPORTER_ASSERT(r, has_dri(threaded), "%s", name);
+    };
+
+    for (auto downsample : {SkJpegEncoder::Downsample::k420,
+                            SkJpegEncoder::Downsample::k422,
+                            SkJpegEncoder::Downsample::k444}) {
+        check([&](SkWStream* dst, SkJpegEncoder::Options options) {
+            options.fDownsample = downsample;
+            return SkJpegEncoder::Encode(dst, src.pixmap(), options);
+        }, "rgba");
+    }
+
+    SkBitmap gray;
+    gray.allocPixels(src.info().makeColorType(kGray_8_SkColorType));
+    REPORTER_ASSERT(r, src.readPixels(gray.pixmap()));
+    check([&](SkWStream* dst, const SkJpegEncoder::Options& options) {
+        return SkJpegEncoder::Encode(dst, gray.pixmap(), options);
+    }, "gray");
+
+    for (auto config : {SkYUVAInfo::PlaneConfig::kY_U_V, SkYUVAInfo::PlaneConfig::kY_UV}) {
+        for (auto subsampling : {SkYUVAInfo::Subsampling::k420, SkYUVAInfo::Subsampling::k422,
+                                 SkYUVAInfo::Subsampling::k444}) {
+            SkYUVAInfo yuvaInfo({kWidth, kHeight}, config, subsampling,
+                                kJPEG_Full_SkYUVColorSpace);
+            SkYUVAPixmaps yuva = SkYUVAPixmaps::Allocate(
+                    SkYUVAPixmapInfo(yuvaInfo, SkYUVAPixmapInfo::DataType::kUnorm8, nullptr));
+            for (int i = 0; i < yuva.numPlanes(); i++) {
+                const SkPixmap& plane = yuva.plane(i);
+                for (int y = 0; y < plane.height(); y++) {
+                    uint8_t* row = static_cast<uint8_t*>(plane.writable_addr(0, y));
+                    for (size_t x = 0; x < plane.info().minRowBytes(); x++) {
+                        row[x] = (uint8_t)(x * (i + 1) + y) ^ (rand.nextU() & 0x1F);
+                    }
+                }
+            }
+            check([&](SkWStream* dst, const SkJpegEncoder::Options& options) {
+                return SkJpegEncoder::Encode(dst, yuva, nullptr, options);
+            }, "yuva");
+        }
+    }
+
+    // Once the joined bands have started to be written, a failed write mustn't fall back to
+    // encoding the image again after them, even if the stream takes later writes.
+    class FailOnceWStream : public SkDynamicMemoryWStream {
+    public:
+        explicit FailOnceWStream(size_t limit) : fLimit(limit) {}
+        bool write(const void* buffer, size_t size) override {
+            if (!fFailed && this->bytesWritten() + size > fLimit) {
+                fFailed = true;
+                return false;
+            }
+            return this->SkDynamicMemoryWStream::write(buffer, size);
+        }
+
+    private:
+        const size_t fLimit;
+        bool fFailed = false;
+    };
+    SkJpegEncoder::Options options;
+    options.fExecutor = executor.get();
+    FailOnceWStream failing(1000);
+    REPORTER_ASSERT(r, !SkJpegEncoder::Encode(&failing, src.pixmap(), options));
+    sk_sp<SkData> partial = failing.detachAsData();
+    const uint8_t kSOI[] = {0xFF, 0xD8};
+    REPORTER_ASSERT(r, std::search(partial->bytes() + 2, partial->bytes() + partial->size(),
+                                   std::begin(kSOI), std::end(kSOI)) ==
+                       partial->bytes() + partial->size());
+}
+
 static inline void pushComment(
         std::vector<std::string>& comments, const char* keyword, const char* text) {
     comments.push_back(keyword);
@@ -512,6 +638,98 @@ DEF_TEST(Encode_PngOptions, r) {
     REPORTER_ASSERT(r, almost_equals(bm0, bm2, 0));
 }
 
+static SkBitmap decode_png(skiatest::Reporter* r, sk_sp<SkData> data, SkColorType ct) {
+    SkBitmap bitmap;
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(std::move(data));
+    REPORTER_ASSERT(r, codec);
+    if (codec) {
+        bitmap.allocPixels(codec->getInfo().makeColorType(ct));
+        REPORTER_ASSERT(r, codec->getPixels(bitmap.pixmap()) == SkCodec::kSuccess);
+    }
+    return bitmap;
+}
+
+DEF_TEST(Encode_PngThreaded, r) {
+    // Tall enough to be split into several strips, with smooth areas and noisy areas so that
+    // different rows pick different filters.
+    SkBitmap src;
+    src.allocPixels(SkImageInfo::Make(531, 777, kRGBA_8888_SkColorType, kUnpremul_SkAlphaType));
+    SkRandom rand;
+    for (int y = 0; y < src.height(); y++) {
+        for (int x = 0; x < src.width(); x++) {
+            uint32_t noise = (y / 50) % 2 ? rand.nextU() : 0;
+            *src.getAddr32(x, y) = SkColorSetARGB(255 - (y & 0x7F), x & 0xFF, y & 0xFF,
+                                                  (x ^ y) & 0xFF) ^ (noise & 0x0F0F0F0F);
+        }
+    }
+
+    auto executor = SkExecutor::MakeWorkStealingThreadPool(4);
+    auto encode = [&](const SkPixmap& pixmap, SkPngEncoder::Options options, bool threaded) {
+        options.fExecutor = threaded ? executor.get() : nullptr;
+        SkDynamicMemoryWStream stream;
+        REPORTER_ASSERT(r, SkPngEncoder::Encode(&stream, pixmap, options));
+        return stream.detachAsData();
+    };
+
+    for (SkColorType ct : {kRGBA_8888_SkColorType, kBGRA_8888_SkColorType, kRGBA_F16_SkColorType,
+                           kGray_8_SkColorType}) {
+        for (SkAlphaType at : {kUnpremul_SkAlphaType, kOpaque_SkAlphaType}) {
+            SkBitmap converted;
+            converted.allocPixels(src.info().makeColorType(ct).makeAlphaType(
+                    ct == kGray_8_SkColorType ? kOpaque_SkAlphaType : at));
+            REPORTER_ASSERT(r, src.readPixels(converted.pixmap()));
+
+            for (auto filters : {SkPngEncoder::FilterFlag::kAll,
+                                 SkPngEncoder::FilterFlag::kNone,
+                                 SkPngEncoder::FilterFlag::kSub | SkPngEncoder::FilterFlag::kPaeth}) {
+                for (int level : {0, 1, 6, 9}) {
+                    SkPngEncoder::Options options;
+                    options.fFilterFlags = filters;
+                    options.fZLibLevel = level;
+                    sk_sp<SkData> serial = encode(converted.pixmap(), options, false);
+                    sk_sp<SkData> threaded = encode(converted.pixmap(), options, true);
+
+                    SkBitmap expected = decode_png(r, serial, ct),
+                             actual   = decode_png(r, threaded, ct);
+                    REPORTER_ASSERT(r, expected.computeByteSize() == actual.computeByteSize());
+                    REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                                   expected.computeByteSize()),
+                                    "ct=%d at=%d filters=%d level=%d",
+                                    ct, at, (int)filters, level);
+                    if (level > 0) {
+                        // Splitting the image shouldn't cost much compression.
+                        REPORTER_ASSERT(r, threaded->size() < serial->size() * 11 / 10,
+                                        "%zu vs %zu", threaded->size(), serial->size());
+                    }
+                }
+            }
+        }
+    }
+
+    // Everything but the IDATs should be written the same way, comments included, and only once.
+    auto non_idat_chunks = [](const sk_sp<SkData>& png) {
+        std::string chunks;
+        const uint8_t* bytes = png->bytes();
+        for (size_t offset = 8; offset + 12 <= png->size();) {
+            const size_t length = (size_t)bytes[offset] << 24 | bytes[offset + 1] << 16 |
+                                  bytes[offset + 2] << 8 | bytes[offset + 3];
+            if (memcmp(bytes + offset + 4, "IDAT", 4) != 0) {
+                chunks.append((const char*)bytes + offset, length + 12);
+            }
+            offset += length + 12;
+        }
+        return chunks;
+    };
+    SkPngEncoder::Options options;
+    const char* comments[] = {"Title", "Threaded", "Author", "Skia"};
+    const size_t commentLengths[] = {6, 9, 7, 5};
+    options.fComments = SkDataTable::MakeCopyArrays((void const* const*)comments,
+                                                    commentLengths, 4);
+    sk_sp<SkData> serial = encode(src.pixmap(), options, false),
+                  threaded = encode(src.pixmap(), options, true);
+    REPORTER_ASSERT(r, non_idat_chunks(serial) == non_idat_chunks(threaded));
+}
+
 #ifndef SK_BUILD_FOR_GOOGLE3
 DEF_TEST(Encode_WebpQuality, r) {
     SkBitmap bm;
@@ -670,6 +888,60 @@ DEF_TEST(Encode_WebpAnimated, r) {
     }
 }
 
+DEF_TEST(Encode_WebpAnimated_Executor, r) {
+    const int width = 17;
+    const int height = 13;
+    auto info = SkImageInfo::MakeN32Premul(width, height);
+    // The third frame is the same as the second, so it should just make the second last longer.
+    const SkIRect changes[] = {SkIRect::MakeWH(width, height),
+                               SkIRect::MakeLTRB(3, 5, 9, 8),
+                               SkIRect::MakeEmpty(),
+                               SkIRect::MakeLTRB(16, 12, 17, 13),
+                               SkIRect::MakeLTRB(0, 1, 4, 2)};
+    const SkColor colors[] = {SK_ColorRED, SK_ColorBLUE, SK_ColorBLUE, 0x8000FF00, SK_ColorYELLOW};
+    const int frameCount = std::size(changes);
+
+    std::vector<SkBitmap> bitmaps(frameCount);
+    std::vector<SkEncoder::Frame> frames(frameCount);
+    for (int i = 0; i < frameCount; i++) {
+        bitmaps[i].allocPixels(info);
+        if (i > 0) {
+            bitmaps[i].writePixels(bitmaps[i - 1].pixmap());
+        }
+        bitmaps[i].erase(colors[i], changes[i]);
+        REPORTER_ASSERT(r, bitmaps[i].peekPixels(&frames[i].pixmap));
+        frames[i].duration = 10 * (i + 1);
+    }
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(2);
+    SkWebpEncoder::Options options;
+    options.fCompression = SkWebpEncoder::Compression::kLossless;
+    options.fExecutor = executor.get();
+    SkDynamicMemoryWStream stream;
+    REPORTER_ASSERT(r, SkWebpEncoder::EncodeAnimated(&stream, frames, options));
+
+    auto codec = SkCodec::MakeFromData(stream.detachAsData());
+    REPORTER_ASSERT(r, codec);
+    std::vector<SkCodec::FrameInfo> frameInfos = codec->getFrameInfo();
+    const int expected[] = {0, 1, 3, 4};
+    const int durations[] = {10, 20 + 30, 40, 50};
+    REPORTER_ASSERT(r, frameInfos.size() == std::size(expected));
+
+    for (size_t i = 0; i < frameInfos.size() && i < std::size(expected); i++) {
+        SkBitmap bitmap;
+        bitmap.allocPixels(info);
+        SkCodec::Options codecOptions;
+        codecOptions.fFrameIndex = (int)i;
+        auto result = codec->getPixels(info, bitmap.getPixels(), bitmap.rowBytes(), &codecOptions);
+        if (result != SkCodec::kSuccess) {
+            ERRORF(r, "error in frame %zu: %s", i, SkCodec::ResultToString(result));
+        }
+        // Allow for rounding the translucent frame to unpremul and back.
+        REPORTER_ASSERT(r, almost_equals(bitmap, bitmaps[expected[i]], 1), "frame %zu", i);
+        REPORTER_ASSERT(r, frameInfos[i].fDuration == durations[i]);
+    }
+}
+
 DEF_TEST(Encode_WebpAnimated_FrameUnmatched, r) {
     // Create two frames with unmatched sizes and verify the encode should fail.
     SkEncoder::Frame frame1;
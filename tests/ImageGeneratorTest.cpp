@@ -17,6 +17,7 @@
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkYUVAInfo.h"
 #include "include/core/SkYUVAPixmaps.h"
@@ -24,7 +25,10 @@
 #include "src/image/SkImageGeneratorPriv.h"
 #include "tests/Test.h"
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <thread>
 
 #if defined(SK_BUILD_FOR_MAC) || defined(SK_BUILD_FOR_IOS)
     #include "include/ports/SkImageGeneratorCG.h"
@@ -133,3 +137,59 @@ DEF_TEST(PictureImageGenerator, reporter) {
     }
 }
 
+
+namespace {
+// Takes its time making a solid color, and counts how many times it was asked to.
+class SlowGenerator : public SkImageGenerator {
+public:
+    explicit SlowGenerator(std::atomic<int>* count)
+            : SkImageGenerator(SkImageInfo::MakeN32Premul(64, 64)), fCount(count) {}
+
+protected:
+    bool onGetPixels(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                     const Options&) override {
+        fCount->fetch_add(1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        SkPixmap(info, pixels, rowBytes).erase(SK_ColorGREEN);
+        return true;
+    }
+
+private:
+    std::atomic<int>* fCount;
+};
+}  // namespace
+
+DEF_TEST(ImageGenerator_SingleFlightDecode, reporter) {
+    std::atomic<int> count{0};
+    sk_sp<SkImage> image =
+            SkImages::DeferredFromGenerator(std::make_unique<SlowGenerator>(&count));
+    REPORTER_ASSERT(reporter, image);
+
+    const size_t decodes = SkGraphics::GetImageDecodeCount(),
+                 shared = SkGraphics::GetSharedImageDecodeCount();
+
+    constexpr int kThreads = 8;
+    std::atomic<int> correct{0};
+    std::thread threads[kThreads];
+    for (std::thread& thread : threads) {
+        thread = std::thread([&] {
+            SkPMColor pixel;
+            const SkImageInfo info = SkImageInfo::MakeN32Premul(1, 1);
+            if (image->readPixels(nullptr, info, &pixel, sizeof(pixel), 32, 32,
+                                  SkImage::kAllow_CachingHint) &&
+                pixel == SkPreMultiplyColor(SK_ColorGREEN)) {
+                correct.fetch_add(1);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // Everyone got the pixels, but only one of them made them: the others either waited for it
+    // or came along after it was in the cache.
+    REPORTER_ASSERT(reporter, correct == kThreads);
+    REPORTER_ASSERT(reporter, count == 1, "%d", count.load());
+    REPORTER_ASSERT(reporter, SkGraphics::GetImageDecodeCount() - decodes >= 1);
+    REPORTER_ASSERT(reporter, SkGraphics::GetSharedImageDecodeCount() - shared <= kThreads - 1);
+}
@@ -10,6 +10,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
@@ -21,12 +22,16 @@
 #include "include/core/SkSurface.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkMalloc.h"
+#include "src/base/SkHalf.h"
 #include "src/base/SkRandom.h"
 #include "src/core/SkMipmap.h"
 #include "src/core/SkMipmapBuilder.h"
 #include "tests/Test.h"
 #include "tools/DecodeUtils.h"
 
+#include <cstring>
+#include <memory>
+
 static void make_bitmap(SkBitmap* bm, int width, int height) {
     bm->allocN32Pixels(width, height);
     bm->eraseColor(SK_ColorWHITE);
@@ -235,6 +240,114 @@ DEF_TEST(MipMap_F16, reporter) {
     sk_sp<SkMipmap> mipmap(SkMipmap::Build(bmp, nullptr));
 }
 
+// Returns the src pixels dst pixel i is filtered from, along one axis, and their weights.
+static int src_taps(int i, int srcSize, int taps[3], int weights[3]) {
+    if (srcSize == 1) {
+        taps[0] = 0;
+        weights[0] = 1;
+        return 1;
+    }
+    taps[0] = 2 * i;
+    taps[1] = 2 * i + 1;
+    taps[2] = 2 * i + 2;
+    if (srcSize & 1) {
+        weights[0] = 1; weights[1] = 2; weights[2] = 1;
+        return 3;
+    }
+    weights[0] = 1; weights[1] = 1;
+    return 2;
+}
+
+// Checks every byte of dst against the filter of src that SkMipmap promises, one channel at a time.
+static bool matches_filter(const SkPixmap& dst, const SkPixmap& src) {
+    const int bpp = dst.info().bytesPerPixel();
+    for (int y = 0; y < dst.height(); y++) {
+        int ys[3], yw[3];
+        const int rows = src_taps(y, src.height(), ys, yw);
+        for (int x = 0; x < dst.width(); x++) {
+            int xs[3], xw[3];
+            const int cols = src_taps(x, src.width(), xs, xw);
+            for (int c = 0; c < bpp; c++) {
+                int sum = 0, weight = 0;
+                for (int j = 0; j < rows; j++) {
+                    for (int i = 0; i < cols; i++) {
+                        auto p = static_cast<const uint8_t*>(src.addr(xs[i], ys[j]));
+                        sum += p[c] * xw[i] * yw[j];
+                        weight += xw[i] * yw[j];
+                    }
+                }
+                if (static_cast<const uint8_t*>(dst.addr(x, y))[c] != sum / weight) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static bool same_pixels(const SkPixmap& a, const SkPixmap& b) {
+    for (int y = 0; y < a.height(); y++) {
+        if (0 != memcmp(a.addr(0, y), b.addr(0, y), a.info().minRowBytes())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+DEF_TEST(MipMap_Filtering, reporter) {
+    // A mix of even and odd sizes, wide enough to exercise both the vectorized kernels and their
+    // tails, and big enough to be split into bands when there's an executor.
+    const SkISize sizes[] = {
+        {64, 64}, {67, 67}, {130, 67}, {67, 130}, {257, 3}, {3, 257}, {1, 100}, {100, 1},
+        {1100, 903}, {903, 1100}, {1024, 1024},
+    };
+    auto executor = SkExecutor::MakeWorkStealingThreadPool(4);
+
+    SkRandom rand;
+    for (SkColorType ct : {kRGBA_8888_SkColorType, kBGRA_8888_SkColorType,
+                           kAlpha_8_SkColorType, kRGBA_F16_SkColorType}) {
+        for (SkISize size : sizes) {
+            SkBitmap bm;
+            bm.allocPixels(SkImageInfo::Make(size, ct, kPremul_SkAlphaType));
+            for (int y = 0; y < size.height(); y++) {
+                if (ct == kRGBA_F16_SkColorType) {
+                    // Random bits would make all sorts of NaNs.
+                    auto row = static_cast<uint16_t*>(bm.getAddr(0, y));
+                    for (int i = 0; i < 4 * size.width(); i++) {
+                        row[i] = SkFloatToHalf(rand.nextF());
+                    }
+                    continue;
+                }
+                auto row = static_cast<uint8_t*>(bm.getAddr(0, y));
+                for (size_t i = 0; i < bm.info().minRowBytes(); i++) {
+                    row[i] = rand.nextU() & 0xFF;
+                }
+            }
+
+            sk_sp<SkMipmap> serial(SkMipmap::Build(bm.pixmap(), nullptr)),
+                            threaded(SkMipmap::Build(bm.pixmap(), nullptr, true, executor.get()));
+            REPORTER_ASSERT(reporter, serial && threaded);
+            if (!serial || !threaded) {
+                return;
+            }
+
+            SkPixmap src = bm.pixmap();
+            for (int i = 0; i < serial->countLevels(); i++) {
+                SkMipmap::Level level, threadedLevel;
+                SkAssertResult(serial->getLevel(i, &level));
+                SkAssertResult(threaded->getLevel(i, &threadedLevel));
+                if (ct != kRGBA_F16_SkColorType) {
+                    REPORTER_ASSERT(reporter, matches_filter(level.fPixmap, src),
+                                    "ct %d, %dx%d, level %d", ct, size.width(), size.height(), i);
+                }
+                REPORTER_ASSERT(reporter, same_pixels(level.fPixmap, threadedLevel.fPixmap),
+                                "ct %d, %dx%d, level %d", ct, size.width(), size.height(), i);
+                src = level.fPixmap;
+            }
+        }
+    }
+}
+
 static void fill_in_mips(SkMipmapBuilder* builder, sk_sp<SkImage> img) {
     int count = builder->countLevels();
     for (int i = 0; i < count; ++i) {
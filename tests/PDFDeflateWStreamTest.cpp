@@ -8,6 +8,8 @@
 #include "include/core/SkTypes.h"
 
 #ifdef SK_SUPPORT_PDF
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/private/base/SkDebug.h"
@@ -15,12 +17,15 @@
 #include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkRandom.h"
+#include "src/core/SkStreamPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/pdf/SkDeflate.h"
 #include "tests/Test.h"
 
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 
 #include "zlib.h"
@@ -177,4 +182,47 @@ DEF_TEST(SkPDF_DeflateWStream, r) {
     REPORTER_ASSERT(r, !emptyDeflateWStream.writeText("FOO"));
 }
 
+DEF_TEST(SkPDF_DeflateBlocks, r) {
+    // Compressible, but with matches that reach back across block boundaries.
+    SkRandom random(654321);
+    const size_t kSize = 3 * SkDeflateBlocks::kBlockSize + 1234;
+    sk_sp<SkData> input = SkData::MakeUninitialized(kSize);
+    uint8_t* bytes = static_cast<uint8_t*>(input->writable_data());
+    for (size_t i = 0; i < kSize; ++i) {
+        bytes[i] = i < 1000 ? random.nextU() & 0xff : bytes[i - 1000 + random.nextULessThan(3)];
+    }
+    auto executor = SkExecutor::MakeWorkStealingThreadPool(4);
+
+    for (size_t size : {(size_t)0, (size_t)100, SkDeflateBlocks::kBlockSize, kSize}) {
+        for (int level : {-1, 1, 9}) {
+            SkDeflateBlocks blocks(SkData::MakeSubset(input.get(), 0, size), level);
+            REPORTER_ASSERT(r, blocks.blockCount() ==
+                    std::max<int>(1, (size + SkDeflateBlocks::kBlockSize - 1) /
+                                     SkDeflateBlocks::kBlockSize));
+            SkTaskGroup(*executor).batch(blocks.blockCount(),
+                                         [&](int i) { blocks.compressBlock(i); });
+            std::unique_ptr<SkStreamAsset> compressed = blocks.detachAsStream();
+
+            SkDynamicMemoryWStream serial;
+            {
+                SkDeflateWStream deflateWStream(&serial, level);
+                deflateWStream.write(bytes, size);
+            }
+            // Splitting the input up only costs a little compression.
+            REPORTER_ASSERT(r, compressed->getLength() <= serial.bytesWritten() * 21 / 20 + 16,
+                            "%zu vs %zu", compressed->getLength(), serial.bytesWritten());
+
+            std::unique_ptr<SkStreamAsset> decompressed = stream_inflate(r, compressed.get());
+            if (!decompressed) {
+                ERRORF(r, "Decompression failed (size %zu, level %d).", size, level);
+                continue;
+            }
+            sk_sp<SkData> result = SkCopyStreamToData(decompressed.get());
+            REPORTER_ASSERT(r, result->size() == size);
+            REPORTER_ASSERT(r, size == 0 || 0 == memcmp(result->data(), bytes, size),
+                            "size %zu, level %d", size, level);
+        }
+    }
+}
+
 #endif
@@ -13,6 +13,7 @@
 #include "include/core/SkFont.h"
 #include "include/core/SkImage.h" // IWYU pragma: keep
 #include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
@@ -273,3 +274,43 @@ DEF_TEST(SkPDF_abort_jobs, rep) {
     doc->abort();
 }
 
+
+static void draw_rects_page(SkDocument* doc, int rects) {
+    SkCanvas* canvas = doc->beginPage(612, 792);
+    SkPaint paint;
+    for (int i = 0; i < rects; ++i) {
+        paint.setColor(SkColorSetARGB(0xFF, i & 0xFF, (i >> 3) & 0xFF, 0x80));
+        canvas->drawRect(SkRect::MakeXYWH(i % 600, (i / 600) % 780, 1.5f, 2.5f), paint);
+    }
+    SkFont font = ToolUtils::DefaultPortableFont();
+    canvas->drawString("Hello, parallel world.", 20, 40, font, paint);
+    doc->endPage();
+}
+
+DEF_TEST(SkPDF_executor_large_content, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_executor_large_content, r);
+    // Enough content that the first page is deflated in blocks across the executor's threads.
+    constexpr int kRects = 40000;
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    auto make_pdf = [&](SkExecutor* executor, SkPDF::Metadata::CompressionLevel level) {
+        SkPDF::Metadata metadata = SkPDF::JPEG::MetadataWithCallbacks();
+        metadata.fExecutor = executor;
+        metadata.fCompressionLevel = level;
+        SkDynamicMemoryWStream stream;
+        auto doc = SkPDF::MakeDocument(&stream, metadata);
+        draw_rects_page(doc.get(), kRects);
+        draw_rects_page(doc.get(), 10);
+        doc->close();
+        return stream.detachAsData();
+    };
+    using Level = SkPDF::Metadata::CompressionLevel;
+    sk_sp<SkData> uncompressed = make_pdf(nullptr, Level::None);
+    sk_sp<SkData> serial = make_pdf(nullptr, Level::Default);
+    sk_sp<SkData> parallel = make_pdf(executor.get(), Level::Default);
+
+    REPORTER_ASSERT(r, uncompressed->size() > 1 << 20);
+    REPORTER_ASSERT(r, serial->size() < uncompressed->size() / 4);
+    REPORTER_ASSERT(r, parallel->size() < serial->size() * 21 / 20,
+                    "%zu vs %zu", parallel->size(), serial->size());
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSize.h"
+#include "include/utils/SkPictureTileSchedule.h"
+#include "tests/Test.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+static sk_sp<SkPicture> make_picture() {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(400, 300));
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    canvas->drawColor(SK_ColorWHITE);
+    for (int i = 0; i < 40; i++) {
+        paint.setColor(SkColorSetARGB(0xC0, (37 * i) & 0xFF, 255 - 5 * i, (91 * i) & 0xFF));
+        canvas->save();
+        canvas->translate(10.0f * i, 7.0f * i);
+        canvas->rotate(3.0f * i);
+        canvas->drawRect(SkRect::MakeXYWH(0, 0, 30, 20), paint);
+        canvas->restore();
+    }
+    canvas->saveLayerAlphaf(nullptr, 0.5f);
+    paint.setColor(SK_ColorBLUE);
+    canvas->drawCircle(200, 150, 80, paint);
+    canvas->restore();
+    return recorder.finishRecordingAsPicture();
+}
+
+static bool same_pixels(const SkBitmap& a, const SkBitmap& b) {
+    for (int y = 0; y < a.height(); y++) {
+        if (0 != memcmp(a.getAddr(0, y), b.getAddr(0, y), a.info().minRowBytes())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+DEF_TEST(PictureTileSchedule_MatchesPlayback, r) {
+    sk_sp<SkPicture> picture = make_picture();
+    const SkMatrix matrix = SkMatrix::Scale(0.75f, 0.75f);
+    const SkIRect grid = SkIRect::MakeWH(300, 225);
+    const SkISize tileSize = {64, 48};
+
+    auto schedule = SkPictureTileSchedule::Make(picture, matrix, grid, tileSize);
+    REPORTER_ASSERT(r, schedule);
+    REPORTER_ASSERT(r, schedule->tileCount() == 5 * 5);
+    REPORTER_ASSERT(r, schedule->tileBounds(24) == SkIRect::MakeLTRB(256, 192, 300, 225));
+
+    std::vector<SkBitmap> tiles(schedule->tileCount());
+    std::vector<std::unique_ptr<SkCanvas>> canvases(schedule->tileCount());
+    auto executor = SkExecutor::MakeWorkStealingThreadPool(4);
+    schedule->playback(*executor, [&](int t) {
+        tiles[t].allocPixels(SkImageInfo::MakeN32Premul(schedule->tileBounds(t).size()));
+        canvases[t] = std::make_unique<SkCanvas>(tiles[t]);
+        return canvases[t].get();
+    });
+
+    for (int t = 0; t < schedule->tileCount(); t++) {
+        // Compare against drawing the whole picture into the same tile the usual way.
+        const SkIRect bounds = schedule->tileBounds(t);
+        SkBitmap expected;
+        expected.allocPixels(tiles[t].info());
+        SkCanvas canvas(expected);
+        canvas.translate(-bounds.fLeft, -bounds.fTop);
+        canvas.clipIRect(bounds);
+        canvas.concat(matrix);
+        picture->playback(&canvas);
+
+        REPORTER_ASSERT(r, same_pixels(expected, tiles[t]), "tile %d", t);
+        REPORTER_ASSERT(r, schedule->opCount(t) < picture->approximateOpCount());
+    }
+}
+
+DEF_TEST(PictureTileSchedule_Culling, r) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(100, 100));
+    canvas->drawRect(SkRect::MakeXYWH(10, 10, 10, 10), SkPaint());
+    canvas->drawRect(SkRect::MakeXYWH(60, 60, 30, 30), SkPaint());
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+    auto schedule = SkPictureTileSchedule::Make(picture, SkMatrix::I(),
+                                                SkIRect::MakeWH(100, 100), {50, 50});
+    REPORTER_ASSERT(r, schedule->tileCount() == 4);
+    REPORTER_ASSERT(r, schedule->opCount(0) == 1);
+    REPORTER_ASSERT(r, schedule->opCount(1) == 0);
+    REPORTER_ASSERT(r, schedule->opCount(2) == 0);
+    REPORTER_ASSERT(r, schedule->opCount(3) == 1);
+
+    REPORTER_ASSERT(r, !SkPictureTileSchedule::Make(picture, SkMatrix::I(),
+                                                    SkIRect::MakeWH(100, 100), {0, 50}));
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkExecutor.h"
+#include "src/core/SkTaskGroup.h"
+#include "tests/Test.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+static void test_executor(skiatest::Reporter* r, SkExecutor& executor) {
+    static constexpr int kOuter = 257;
+    static constexpr int kInner = 33;
+
+    std::atomic<int> hits[kOuter];
+    for (auto& h : hits) {
+        h = 0;
+    }
+
+    SkTaskGroup tg(executor);
+    tg.batch(kOuter, [&](int i) {
+        // Nested task groups must make progress on the same executor without deadlocking.
+        SkTaskGroup nested(executor);
+        nested.batch(kInner, [&](int) { hits[i].fetch_add(1, std::memory_order_relaxed); });
+        nested.add([&] { hits[i].fetch_add(1, std::memory_order_relaxed); });
+    });
+    tg.wait();
+
+    for (int i = 0; i < kOuter; i++) {
+        REPORTER_ASSERT(r, hits[i].load() == kInner + 1, "index %d ran %d times", i, hits[i].load());
+    }
+}
+
+DEF_TEST(SkExecutor_ThreadPools, r) {
+    for (int threads : {1, 2, 7}) {
+        test_executor(r, *SkExecutor::MakeFIFOThreadPool(threads));
+        test_executor(r, *SkExecutor::MakeLIFOThreadPool(threads));
+        test_executor(r, *SkExecutor::MakeWorkStealingThreadPool(threads));
+    }
+}
+
+DEF_TEST(SkTaskGroup_BatchOrderOnInlineExecutor, r) {
+    struct InlineExecutor final : public SkExecutor {
+        void add(std::function<void(void)> work) override { work(); }
+    } executor;
+
+    // An executor that runs work right away should still see batch() visit indices in order.
+    int next = 0;
+    SkTaskGroup(executor).batch(100, [&](int i) {
+        REPORTER_ASSERT(r, i == next);
+        next++;
+    });
+    REPORTER_ASSERT(r, next == 100);
+
+    // Empty batches are fine too.
+    SkTaskGroup(executor).batch(0, [&](int) { REPORTER_ASSERT(r, false); });
+}
+
+DEF_TEST(SkTaskGroup_BatchRunsEachIndexOnce, r) {
+    // Indices are run in ranges, which must cover each index exactly once for any N, and the
+    // batch's fn must be gone by the time wait() returns.
+    struct Tracker {
+        std::atomic<int>* fLive;
+        explicit Tracker(std::atomic<int>* live) : fLive(live) { fLive->fetch_add(1); }
+        Tracker(const Tracker& that) : Tracker(that.fLive) {}
+        ~Tracker() { fLive->fetch_sub(1); }
+    };
+
+    for (auto make : {SkExecutor::MakeFIFOThreadPool,
+                      SkExecutor::MakeLIFOThreadPool,
+                      SkExecutor::MakeWorkStealingThreadPool}) {
+        std::unique_ptr<SkExecutor> executor = make(3, true);
+        for (int N : {1, 2, 3, 31, 100, 1001, 20000}) {
+            std::unique_ptr<std::atomic<int>[]> hits(new std::atomic<int>[N]);
+            for (int i = 0; i < N; i++) {
+                hits[i] = 0;
+            }
+            std::atomic<int> live{0};
+            {
+                SkTaskGroup tg(*executor);
+                tg.batch(N, [&, tracker = Tracker(&live)](int i) {
+                    hits[i].fetch_add(1, std::memory_order_relaxed);
+                });
+                tg.wait();
+                REPORTER_ASSERT(r, live.load() == 0, "N %d", N);
+            }
+            for (int i = 0; i < N; i++) {
+                if (hits[i].load() != 1) {
+                    ERRORF(r, "N %d index %d ran %d times", N, i, hits[i].load());
+                    break;
+                }
+            }
+        }
+    }
+}
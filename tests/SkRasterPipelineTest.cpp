@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkColor.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkHalf.h"
 #include "src/base/SkUtils.h"
@@ -16,10 +17,14 @@
 #include "tests/Test.h"
 
 #include <cmath>
+#include <cstring>
+#include <initializer_list>
 #include <numeric>
 
 using namespace skia_private;
 
+extern bool gDisableRasterPipelineSuperstages;
+
 DEF_TEST(SkRasterPipeline, r) {
     // Build and run a simple pipeline to exercise SkRasterPipeline,
     // drawing 50% transparent blue over opaque red in half-floats.
@@ -3450,3 +3455,70 @@ DEF_TEST(SkRasterPipeline_stack_rewind, r) {
         stack.validate(r);
     }
 }
+
+DEF_TEST(SkRasterPipeline_Superstages, r) {
+    // Each lowp superstage must draw exactly what the chain of stages it replaces would draw.
+    // Three rows of 37 pixels cover full strides and a tail at every stride we use.
+    constexpr int kW = 37, kH = 3;
+    uint32_t src[kW * kH], dst[kW * kH];
+    uint8_t coverage[kW * kH];
+    uint32_t seed = 0x12345678;
+    for (int i = 0; i < kW * kH; i++) {
+        seed = seed * 1664525 + 1013904223;
+        const SkColor c = seed;
+        src[i] = SkPreMultiplyColor(c);
+        dst[i] = SkPreMultiplyColor(SkColorSetA(~c, SkColorGetR(c)));
+        coverage[i] = seed >> 24;
+    }
+
+    float scale = 0.3f;
+    float translate[2] = {3.5f, -2.0f};
+    float scaleTranslate[4] = {0.02f, 0.03f, -0.1f, 0.2f};
+    float matrix[9] = {0.02f, 0.01f, -0.1f, -0.005f, 0.03f, 0.2f, 0, 0, 1};
+    SkRasterPipelineContexts::EvenlySpaced2StopGradientCtx gradient = {
+        {0.9f, -0.5f, 0.25f, 0.0f}, {0.05f, 0.6f, 0.5f, 1.0f}};
+    SkRasterPipelineContexts::MemoryCtx srcCtx = {src, kW}, coverageCtx = {coverage, kW};
+
+    struct Stage {
+        SkRasterPipelineOp op;
+        void* ctx;
+    };
+    auto check = [&](std::initializer_list<Stage> stages) {
+        uint32_t chained[kW * kH], fused[kW * kH];
+        for (bool superstages : {false, true}) {
+            uint32_t* out = superstages ? fused : chained;
+            memcpy(out, dst, sizeof(dst));
+            SkRasterPipelineContexts::MemoryCtx dstCtx = {out, kW};
+
+            SkRasterPipeline_<256> p;
+            for (const Stage& stage : stages) {
+                p.append(stage.op, stage.ctx ? stage.ctx : &dstCtx);
+            }
+            gDisableRasterPipelineSuperstages = !superstages;
+            p.run(0, 0, kW, kH);
+            gDisableRasterPipelineSuperstages = false;
+        }
+        REPORTER_ASSERT(r, 0 == memcmp(chained, fused, sizeof(fused)));
+    };
+
+    // Stages that write to the destination get a nullptr context here.
+    using Op = SkRasterPipelineOp;
+    for (Stage matrixStage : {Stage{Op::matrix_translate, translate},
+                              Stage{Op::matrix_scale_translate, scaleTranslate},
+                              Stage{Op::matrix_2x3, matrix}}) {
+        check({{Op::seed_shader, nullptr}, matrixStage, {Op::clamp_x_1, nullptr},
+               {Op::evenly_spaced_2_stop_gradient, &gradient}, {Op::clamp_01, nullptr},
+               {Op::store_8888, nullptr}});
+        check({{Op::seed_shader, nullptr}, matrixStage,
+               {Op::evenly_spaced_2_stop_gradient, &gradient},
+               {Op::load_8888_dst, nullptr}, {Op::srcover, nullptr}, {Op::store_8888, nullptr}});
+    }
+    check({{Op::load_8888, &srcCtx}, {Op::scale_1_float, &scale},
+           {Op::load_8888_dst, nullptr}, {Op::srcover, nullptr}, {Op::store_8888, nullptr}});
+    check({{Op::load_8888, &srcCtx}, {Op::scale_u8, &coverageCtx},
+           {Op::load_8888_dst, nullptr}, {Op::srcover, nullptr}, {Op::store_8888, nullptr}});
+    check({{Op::load_8888, &srcCtx},
+           {Op::load_8888_dst, nullptr}, {Op::lerp_1_float, &scale}, {Op::store_8888, nullptr}});
+    check({{Op::load_8888, &srcCtx},
+           {Op::load_8888_dst, nullptr}, {Op::lerp_u8, &coverageCtx}, {Op::store_8888, nullptr}});
+}
@@ -9,6 +9,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -24,10 +25,13 @@
 #include "src/core/SkCachedData.h"
 #include "src/core/SkMipmap.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/image/SkImage_Base.h"
 #include "src/lazy/SkDiscardableMemoryPool.h"
 #include "tests/Test.h"
 
+#include <atomic>
+
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -306,3 +310,73 @@ DEF_TEST(ResourceCache_purge, reporter) {
         }
     }
 }
+
+DEF_TEST(ResourceCache_globalThreaded, reporter) {
+    // Hammer the global cache from several threads, with keys that land in every shard.
+    static constexpr int kSharedID = 0x5ead;
+    static constexpr int kThreads = 8, kKeysPerThread = 500;
+    auto executor = SkExecutor::MakeWorkStealingThreadPool(kThreads);
+    std::atomic<int> found{0};
+
+    SkTaskGroup(*executor).batch(kThreads, [&](int thread) {
+        int flags = 0;
+        for (int i = 0; i < kKeysPerThread; ++i) {
+            const int data = thread * kKeysPerThread + i;
+            auto rec = new TestRec(kSharedID, data, &flags);
+            rec->fCanBePurged = true;
+            SkResourceCache::Add(rec);
+            REPORTER_ASSERT(reporter, flags & TestRec::kDidInstall);
+
+            auto visitor = [](const SkResourceCache::Rec&, void*) { return true; };
+            if (SkResourceCache::Find(TestKey(kSharedID, data), visitor, nullptr)) {
+                found++;
+            }
+        }
+    });
+    REPORTER_ASSERT(reporter, found > 0);
+
+    auto count = [] {
+        int recs = 0;
+        SkResourceCache::VisitAll([](const SkResourceCache::Rec& rec, void* ctx) {
+            if (rec.getKey().getSharedID() == kSharedID) {
+                *static_cast<int*>(ctx) += 1;
+            }
+        }, &recs);
+        return recs;
+    };
+    const int remaining = count();
+    REPORTER_ASSERT(reporter, 0 < remaining && remaining <= kThreads * kKeysPerThread);
+
+    // Purging by ID reaches every shard.
+    SkResourceCache::PostPurgeSharedID(kSharedID);
+    SkResourceCache::CheckMessages();
+    REPORTER_ASSERT(reporter, count() == 0);
+}
+
+DEF_TEST(ResourceCache_globalBudget, reporter) {
+    // The shards of the global cache share its budget, but a shard never purges the rec it just
+    // added to make room for the others' recs, and between them they stay within the budget.
+    static constexpr int kSharedID = 0xb0d6e7;
+    static constexpr size_t kLimit = 64 * 1024;  // 64 TestRecs
+    SkResourceCache::PurgeAll();
+    const size_t prevLimit = SkResourceCache::SetTotalByteLimit(kLimit);
+    REPORTER_ASSERT(reporter, SkResourceCache::GetTotalByteLimit() == kLimit);
+
+    int flags = 0, missing = 0;
+    for (int i = 0; i < 2000; ++i) {
+        auto rec = new TestRec(kSharedID, i, &flags);
+        rec->fCanBePurged = true;
+        SkResourceCache::Add(rec);
+
+        auto visitor = [](const SkResourceCache::Rec&, void*) { return true; };
+        if (!SkResourceCache::Find(TestKey(kSharedID, i), visitor, nullptr)) {
+            missing++;
+        }
+        REPORTER_ASSERT(reporter, SkResourceCache::GetTotalBytesUsed() <= kLimit);
+    }
+    REPORTER_ASSERT(reporter, missing == 0);
+
+    SkResourceCache::SetTotalByteLimit(prevLimit);
+    SkResourceCache::PostPurgeSharedID(kSharedID);
+    SkResourceCache::CheckMessages();
+}
@@ -6,6 +6,7 @@
  */
 
 #include "include/core/SkAlphaType.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkBlender.h"
 #include "include/core/SkCanvas.h"
@@ -54,6 +55,7 @@
 #include "src/sksl/SkSLString.h"
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
+#include "tools/ToolUtils.h"
 
 #include <array>
 #include <cstdint>
@@ -907,6 +909,69 @@ DEF_TEST(SkRuntimeColorFilterLimitedToES2, r) {
     }
 }
 
+DEF_TEST(SkRuntimeEffectRasterProgramCache, r) {
+    struct MemoryCache : SkRuntimeEffect::RasterProgramCache {
+        sk_sp<SkData> load(const SkData& key) override {
+            ++fLoads;
+            return fKey && fKey->equals(&key) ? fData : nullptr;
+        }
+        void store(const SkData& key, const SkData& data) override {
+            ++fStores;
+            fKey = SkData::MakeWithCopy(key.data(), key.size());
+            fData = SkData::MakeWithCopy(data.data(), data.size());
+        }
+        sk_sp<SkData> fKey, fData;
+        int fLoads = 0, fStores = 0;
+    };
+
+    static constexpr char kSkSL[] = R"(
+        uniform half4 color;
+        half4 tint(half4 c, float t) { return mix(c, color, saturate(t)); }
+        half4 main(float2 p) {
+            half4 c = half4(0);
+            for (int i = 0; i < 4; i++) {
+                c += tint(half4(half(i) / 4, 0, 1, 1), (p.x + p.y + float(i)) / 40);
+            }
+            return c / 4;
+        }
+    )";
+    auto draw = [&](SkBitmap* bitmap) {
+        auto effect = SkRuntimeEffect::MakeForShader(SkString(kSkSL)).effect;
+        REPORTER_ASSERT(r, effect);
+        const SkColor4f color = {0.25f, 0.5f, 0.75f, 1.0f};
+        SkPaint paint;
+        paint.setShader(effect->makeShader(SkData::MakeWithCopy(&color, sizeof(color)), {}));
+        bitmap->allocN32Pixels(32, 16);
+        SkCanvas(*bitmap).drawPaint(paint);
+    };
+
+    SkBitmap expected;
+    draw(&expected);
+
+    MemoryCache cache;
+    SkRuntimeEffect::RasterProgramCache* previous = SkRuntimeEffect::SetRasterProgramCache(&cache);
+
+    // The first draw misses the cache and fills it in...
+    SkBitmap actual;
+    draw(&actual);
+    REPORTER_ASSERT(r, cache.fLoads == 1 && cache.fStores == 1);
+    REPORTER_ASSERT(r, cache.fData);
+    REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual));
+
+    // ... and a new effect with the same source then draws with the cached program.
+    draw(&actual);
+    REPORTER_ASSERT(r, cache.fLoads == 2 && cache.fStores == 1);
+    REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual));
+
+    // Data that doesn't deserialize is recompiled and replaced.
+    cache.fData = SkData::MakeSubset(cache.fData.get(), 0, cache.fData->size() - 4);
+    draw(&actual);
+    REPORTER_ASSERT(r, cache.fLoads == 3 && cache.fStores == 2);
+    REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual));
+
+    REPORTER_ASSERT(r, SkRuntimeEffect::SetRasterProgramCache(previous) == &cache);
+}
+
 DEF_TEST(SkRuntimeEffectTraceShader, r) {
     for (int imageSize : {2, 80}) {
         TestEffect effect(r, /*grContext=*/nullptr, /*graphite=*/nullptr,
@@ -5,6 +5,10 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkMatrix.h"
@@ -16,10 +20,14 @@
 #include "src/core/SkStrike.h"  // IWYU pragma: keep
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkStrikeSpec.h"
+#include "src/core/SkTaskGroup.h"
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#include <cstring>
+#include <vector>
+
 DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
     SkStrikeCache cache;
 
@@ -58,6 +66,95 @@ DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
         REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() == 0);
     }
     REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() == 0);
+}
+
+DEF_TEST(SkStrikeCache_SharedLookupKeepsStrike, Reporter) {
+    SkStrikeCache cache;
+    cache.setCacheCountLimit(4);
+
+    SkFont font;
+    font.setTypeface(ToolUtils::CreatePortableTypeface("serif", SkFontStyle()));
+    auto specForSize = [&](SkScalar size) {
+        font.setSize(size);
+        return SkStrikeSpec::MakeMask(
+                font, SkPaint(), SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                SkScalerContextFlags::kNone, SkMatrix::I());
+    };
+
+    // Fill the cache, leaving the size 10 strike least recently used.
+    for (SkScalar size : {10, 11, 12, 13}) {
+        (void)specForSize(size).findOrCreateStrike(&cache);
+    }
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 4);
+
+    // Finding the size 10 strike again only marks it as used, but it should still be kept over
+    // the size 11 strike when adding another strike makes the cache evict one.
+    (void)specForSize(10).findOrCreateStrike(&cache);
+    (void)specForSize(14).findOrCreateStrike(&cache);
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 4);
+    REPORTER_ASSERT(Reporter, cache.findStrike(specForSize(10).descriptor()) != nullptr);
+    REPORTER_ASSERT(Reporter, cache.findStrike(specForSize(11).descriptor()) == nullptr);
+}
+
+DEF_TEST(SkStrikeCache_SharedLookupKeepsOrder, Reporter) {
+    SkStrikeCache cache;
+    cache.setCacheCountLimit(4);
+
+    SkFont font;
+    font.setTypeface(ToolUtils::CreatePortableTypeface("serif", SkFontStyle()));
+    auto specForSize = [&](SkScalar size) {
+        font.setSize(size);
+        return SkStrikeSpec::MakeMask(
+                font, SkPaint(), SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                SkScalerContextFlags::kNone, SkMatrix::I());
+    };
 
+    for (SkScalar size : {10, 11, 12, 13}) {
+        (void)specForSize(size).findOrCreateStrike(&cache);
+    }
 
+    // Both found strikes move ahead of 12 and 13, but 11 should stay ahead of 10, so 10 is the
+    // first of them evicted.
+    (void)specForSize(10).findOrCreateStrike(&cache);
+    (void)specForSize(11).findOrCreateStrike(&cache);
+    for (SkScalar size : {14, 15, 16, 17}) {
+        (void)specForSize(size).findOrCreateStrike(&cache);
+    }
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 4);
+    REPORTER_ASSERT(Reporter, cache.findStrike(specForSize(10).descriptor()) == nullptr);
+    REPORTER_ASSERT(Reporter, cache.findStrike(specForSize(11).descriptor()) != nullptr);
+}
+
+DEF_TEST(SkStrikeCache_ThreadedDraw, Reporter) {
+    static constexpr int kThreadCount = 4;
+    static constexpr char kText[] = "Sphinx of black quartz, judge my vow.";
+
+    SkFont font;
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setSubpixel(true);
+    font.setSize(17.5f);
+    font.setTypeface(ToolUtils::CreatePortableTypeface("sans-serif", SkFontStyle::Bold()));
+
+    auto draw = [&](SkBitmap* bitmap, int frame) {
+        bitmap->allocN32Pixels(320, 32);
+        SkCanvas canvas(*bitmap);
+        canvas.clear(SK_ColorWHITE);
+        canvas.drawSimpleText(kText, strlen(kText), SkTextEncoding::kUTF8,
+                              2 + 0.25f * (frame % 4), 22, font, SkPaint());
+    };
+
+    // Every thread draws every frame, mostly finding the glyphs another thread has just added.
+    static constexpr int kFrames = 16;
+    std::vector<SkBitmap> threaded(kThreadCount * kFrames);
+    auto executor = SkExecutor::MakeWorkStealingThreadPool(kThreadCount);
+    SkTaskGroup(*executor).batch(kThreadCount * kFrames, [&](int i) {
+        draw(&threaded[i], i / kThreadCount);
+    });
+
+    for (int i = 0; i < kThreadCount * kFrames; i++) {
+        SkBitmap expected;
+        draw(&expected, i / kThreadCount);
+        REPORTER_ASSERT(Reporter, 0 == memcmp(expected.getPixels(), threaded[i].getPixels(),
+                                              expected.computeByteSize()), "draw %d", i);
+    }
 }
@@ -21,10 +21,10 @@
 #include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
-#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/base/SkSharedMutex.h"
 #include "src/base/SkZip.h"
 #include "src/core/SkGlyph.h"
 #include "src/core/SkMask.h"
@@ -190,7 +190,7 @@ public:
 class SkStrikeTestingPeer {
 public:
     static SkGlyph* GetGlyph(SkStrike* strike, SkPackedGlyphID packedID) {
-        SkAutoMutexExclusive m{strike->fStrikeLock};
+        SkAutoSharedMutexExclusive m{strike->fStrikeLock};
         return strike->glyph(packedID);
     }
 };
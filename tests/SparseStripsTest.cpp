@@ -0,0 +1,282 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkClipOp.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkGraphics.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPathBuilder.h"
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkRect.h"
+#include "include/effects/SkGradientShader.h"
+#include "src/base/SkRandom.h"
+#include "tests/Test.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <utility>
+
+extern bool gSkUseSparseStrips;
+
+static SkBitmap draw(const SkPath& path, bool sparseStrips,
+                     const std::function<void(SkCanvas*)>& clip = nullptr) {
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::MakeA8(200, 150));
+    bitmap.eraseColor(SK_ColorTRANSPARENT);
+
+    SkCanvas canvas(bitmap);
+    const bool useSparseStrips = gSkUseSparseStrips;
+    gSkUseSparseStrips = sparseStrips;
+    if (clip) {
+        clip(&canvas);
+    }
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    canvas.drawPath(path, paint);
+    gSkUseSparseStrips = useSparseStrips;
+    return bitmap;
+}
+
+// The coverage of each pixel, found by sampling each one 16x16 times.
+static SkBitmap draw_reference(const SkPath& path) {
+    constexpr int kScale = 16;
+    SkBitmap samples;
+    samples.allocPixels(SkImageInfo::MakeA8(200 * kScale, 150 * kScale));
+    samples.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(samples);
+    canvas.scale(kScale, kScale);
+    canvas.drawPath(path, SkPaint());
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::MakeA8(200, 150));
+    for (int y = 0; y < bitmap.height(); y++) {
+        for (int x = 0; x < bitmap.width(); x++) {
+            int covered = 0;
+            for (int j = 0; j < kScale; j++) {
+                for (int i = 0; i < kScale; i++) {
+                    covered += *samples.getAddr8(x * kScale + i, y * kScale + j) ? 1 : 0;
+                }
+            }
+            *bitmap.getAddr8(x, y) = (covered * 255 + kScale * kScale / 2) / (kScale * kScale);
+        }
+    }
+    return bitmap;
+}
+
+static float mean_difference(const SkBitmap& a, const SkBitmap& b) {
+    long total = 0;
+    for (int y = 0; y < a.height(); y++) {
+        for (int x = 0; x < a.width(); x++) {
+            total += std::abs(*a.getAddr8(x, y) - *b.getAddr8(x, y));
+        }
+    }
+    return (float)total / (a.width() * a.height());
+}
+
+DEF_TEST(SparseStrips_ExactCoverage, r) {
+    const SkBitmap bitmap = draw(SkPath::Rect({10.5f, 10.25f, 30, 20.75f}), true);
+    auto check = [&](int x, int y, int expected) {
+        const int alpha = *bitmap.getAddr8(x, y);
+        REPORTER_ASSERT(r, std::abs(alpha - expected) <= 1,
+                        "(%d, %d): expected %d, got %d", x, y, expected, alpha);
+    };
+    check(20, 15, 255);
+    check(10, 15, 128);
+    check(20, 10, 191);
+    check(20, 20, 191);
+    check(10, 10,  96);
+    check(29, 15, 255);
+    check(30, 15,   0);
+    check( 9, 15,   0);
+    check(20,  9,   0);
+    check(20, 21,   0);
+
+    // A triangle covering exactly half of each pixel on its diagonal.
+    const SkBitmap triangle = draw(SkPath::Polygon({{0, 0}, {100, 100}, {0, 100}}, true), true);
+    for (int i = 1; i < 99; i++) {
+        const int diagonal = *triangle.getAddr8(i, i),
+                  inside = *triangle.getAddr8(i - 1, i),
+                  outside = *triangle.getAddr8(i + 1, i);
+        REPORTER_ASSERT(r, std::abs(diagonal - 128) <= 1, "diagonal %d: %d", i, diagonal);
+        REPORTER_ASSERT(r, inside == 255 && outside == 0, "%d: %d %d", i, inside, outside);
+    }
+}
+
+DEF_TEST(SparseStrips_Paths, r) {
+    SkRandom rand;
+    SkPathBuilder star, curves, tiny;
+    for (int i = 0; i < 5; i++) {
+        star.lineTo(100 + 70 * SkScalarCos(i * 4 * SK_ScalarPI / 5),
+                    75 + 70 * SkScalarSin(i * 4 * SK_ScalarPI / 5));
+    }
+    for (int i = 0; i < 20; i++) {
+        const SkPoint c = {rand.nextRangeF(-20, 220), rand.nextRangeF(-20, 170)};
+        const float radius = rand.nextRangeF(1, 40);
+        curves.addCircle(c.fX, c.fY, radius, i & 1 ? SkPathDirection::kCW : SkPathDirection::kCCW);
+        curves.moveTo(c.fX, c.fY);
+        curves.cubicTo(c.fX + rand.nextRangeF(-60, 60), c.fY + rand.nextRangeF(-60, 60),
+                       c.fX + rand.nextRangeF(-60, 60), c.fY + rand.nextRangeF(-60, 60),
+                       c.fX + rand.nextRangeF(-60, 60), c.fY + rand.nextRangeF(-60, 60));
+        curves.conicTo(c.fX + rand.nextRangeF(-60, 60), c.fY + rand.nextRangeF(-60, 60),
+                       c.fX, c.fY, 0.5f);
+    }
+    for (int i = 0; i < 200; i++) {
+        const SkPoint p = {rand.nextRangeF(0, 200), rand.nextRangeF(0, 150)};
+        tiny.moveTo(p);
+        tiny.lineTo(p.fX + rand.nextRangeF(-0.5f, 0.5f), p.fY + rand.nextRangeF(-0.5f, 0.5f));
+        tiny.lineTo(p.fX + rand.nextRangeF(-0.5f, 0.5f), p.fY + rand.nextRangeF(-0.5f, 0.5f));
+    }
+    // Far off the left and right, so lines are clipped and moved to the left edge.
+    const SkPath wide = SkPath::Polygon({{-1000, 10}, {1500, 40}, {2000, 140}, {-5000, 90}}, true);
+
+    struct {
+        const char* name;
+        SkPath path;
+    } paths[] = {
+        {"star", star.detach()},
+        {"curves", curves.detach()},
+        {"tiny", tiny.detach()},
+        {"wide", wide},
+        {"rect", SkPath::Rect({20.3f, 30.6f, 170.1f, 121.9f})},
+    };
+
+    // Where edges cross inside a pixel, adding up their areas before applying the fill rule isn't
+    // exact, and AAA isn't either, so we hold sparse strips to about the same error.
+    for (auto& [name, path] : paths) {
+        for (SkPathFillType fillType : {SkPathFillType::kWinding,
+                                        SkPathFillType::kEvenOdd,
+                                        SkPathFillType::kInverseWinding,
+                                        SkPathFillType::kInverseEvenOdd}) {
+            path.setFillType(fillType);
+            const SkBitmap reference = draw_reference(path);
+            const float aaaError = mean_difference(draw(path, false), reference),
+                        error = mean_difference(draw(path, true), reference);
+            REPORTER_ASSERT(r, error <= aaaError + 0.05f,
+                            "%s, fill type %d: mean error %g, AAA's %g",
+                            name, (int)fillType, error, aaaError);
+        }
+    }
+}
+
+DEF_TEST(SparseStrips_Clips, r) {
+    SkPathBuilder builder;
+    for (int i = 0; i < 5; i++) {
+        builder.addCircle(40 + 30 * i, 75, 25 + 5 * i);
+    }
+    SkPath path = builder.detach();
+
+    const std::function<void(SkCanvas*)> clips[] = {
+        [](SkCanvas* canvas) { canvas->clipRect(SkRect::MakeLTRB(33, 21, 151, 97)); },
+        // A clip made of many rects is applied by SkRgnClipBlitter.
+        [](SkCanvas* canvas) {
+            canvas->clipPath(SkPath::Circle(90, 70, 50), /*doAntiAlias=*/false);
+        },
+        // Antialiased clips are rasterized into an SkAAClip, one row at a time.
+        [](SkCanvas* canvas) {
+            canvas->clipPath(SkPath::Circle(110, 80, 55.5f), /*doAntiAlias=*/true);
+        },
+        [](SkCanvas* canvas) {
+            canvas->clipPath(SkPath::Circle(110, 80, 55.5f), SkClipOp::kDifference, true);
+        },
+    };
+
+    for (SkPathFillType fillType : {SkPathFillType::kWinding, SkPathFillType::kInverseEvenOdd}) {
+        path.setFillType(fillType);
+        for (const auto& clip : clips) {
+            const SkBitmap aaa = draw(path, false, clip),
+                           strips = draw(path, true, clip);
+            REPORTER_ASSERT(r, mean_difference(aaa, strips) <= 0.5f);
+        }
+    }
+}
+
+DEF_TEST(SparseStrips_Bands, r) {
+    constexpr int kW = 1100, kH = 900;  // Big enough to be split into bands.
+    SkRandom rand;
+    SkPathBuilder builder;
+    for (int i = 0; i < 400; i++) {
+        const SkPoint c = {rand.nextRangeF(-50, kW + 50), rand.nextRangeF(-50, kH + 50)};
+        builder.moveTo(c);
+        for (int j = 0; j < 5; j++) {
+            builder.quadTo(c.fX + rand.nextRangeF(-80, 80), c.fY + rand.nextRangeF(-80, 80),
+                           c.fX + rand.nextRangeF(-80, 80), c.fY + rand.nextRangeF(-80, 80));
+        }
+        builder.close();
+    }
+    SkPath path = builder.detach();
+
+    const SkPoint pts[] = {{0, 0}, {kW, kH}};
+    const SkColor colors[] = {SK_ColorBLUE, SK_ColorRED};
+    SkPaint gradient;
+    gradient.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2, SkTileMode::kClamp));
+
+    const std::function<void(SkCanvas*)> clips[] = {
+        [](SkCanvas*) {},
+        [](SkCanvas* canvas) { canvas->clipRect(SkRect::MakeLTRB(100.5f, 37, 1000, 801)); },
+        [](SkCanvas* canvas) { canvas->clipPath(SkPath::Circle(500, 450, 420), false); },
+        [](SkCanvas* canvas) { canvas->clipPath(SkPath::Circle(500, 450, 420.5f), true); },
+    };
+
+    // Counts the work drawing hands to the thread pool.
+    struct CountingExecutor final : public SkExecutor {
+        std::unique_ptr<SkExecutor> fPool = SkExecutor::MakeWorkStealingThreadPool(4);
+        std::atomic<int>            fAdded{0};
+
+        void add(std::function<void(void)> work) override {
+            fAdded.fetch_add(1, std::memory_order_relaxed);
+            fPool->add(std::move(work));
+        }
+        void borrow() override { fPool->borrow(); }
+    } executor;
+
+    // Drawn through the public settings, as a client would.
+    auto draw_big = [&](const SkPaint& paint, const std::function<void(SkCanvas*)>& clip,
+                        bool sparseStrips, bool banded) {
+        SkBitmap bitmap;
+        bitmap.allocPixels(SkImageInfo::MakeN32Premul(kW, kH));
+        bitmap.eraseColor(SK_ColorWHITE);
+        SkCanvas canvas(bitmap);
+        clip(&canvas);
+
+        const bool useSparseStrips = SkGraphics::SetUseSparseStripRasterizer(sparseStrips);
+        SkExecutor* previous = SkGraphics::SetPathRasterExecutor(banded ? &executor : nullptr);
+        executor.fAdded = 0;
+        canvas.drawPath(path, paint);
+        // Only sparse strips are drawn in bands.
+        REPORTER_ASSERT(r, (executor.fAdded > 0) == (sparseStrips && banded),
+                        "sparse strips %d banded %d", sparseStrips, banded);
+        SkGraphics::SetPathRasterExecutor(previous);
+        SkGraphics::SetUseSparseStripRasterizer(useSparseStrips);
+        return bitmap;
+    };
+
+    for (SkPaint paint : {SkPaint(), gradient}) {
+        paint.setAntiAlias(true);
+        for (SkPathFillType fillType : {SkPathFillType::kWinding, SkPathFillType::kEvenOdd}) {
+            path.setFillType(fillType);
+            for (const auto& clip : clips) {
+                // Setting an executor mustn't change what either rasterizer draws.
+                for (bool sparseStrips : {true, false}) {
+                    const SkBitmap serial = draw_big(paint, clip, sparseStrips, false),
+                                   banded = draw_big(paint, clip, sparseStrips, true);
+                    REPORTER_ASSERT(r, 0 == memcmp(serial.getPixels(), banded.getPixels(),
+                                                   serial.computeByteSize()),
+                                    "sparse strips %d", sparseStrips);
+                }
+            }
+        }
+    }
+}
@@ -9,8 +9,12 @@
 #include "include/core/SkAlphaType.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkSwizzle.h"
+#include "include/private/SkEncodedInfo.h"
+#include "src/base/SkRandom.h"
 #include "src/codec/SkSampler.h"
+#include "src/codec/SkSwizzler.h"
 #include "src/core/SkSwizzlePriv.h"
 #include "tests/Test.h"
 
@@ -160,6 +164,110 @@ DEF_TEST(PublicSwizzleOpts, r) {
     REPORTER_ASSERT(r, dst == 0xFA04B0CE);
 }
 
+DEF_TEST(SwizzleOpts_16BitAndIndexed, r) {
+    static constexpr int kMaxCount = 70;  // Long enough for a few vectors and every tail.
+    SkRandom rand;
+    uint8_t src[8 * kMaxCount];
+    for (uint8_t& b : src) {
+        b = rand.nextU() & 0xFF;
+    }
+    uint32_t table[256];
+    for (uint32_t& c : table) {
+        c = rand.nextU();
+    }
+
+    for (int count = 0; count <= kMaxCount; count++) {
+        uint32_t dst[kMaxCount], expected[kMaxCount];
+        auto check = [&](const char* name) {
+            REPORTER_ASSERT(r, 0 == memcmp(dst, expected, count * sizeof(uint32_t)),
+                            "%s, count %d", name, count);
+        };
+
+        for (int i = 0; i < count; i++) {
+            const uint8_t* p = src + 6 * i;
+            expected[i] = 0xFF000000 | (p[4] << 16) | (p[2] << 8) | p[0];
+        }
+        SkOpts::RGB16_to_RGB1(dst, src, count);
+        check("RGB16_to_RGB1");
+
+        for (int i = 0; i < count; i++) {
+            const uint8_t* p = src + 6 * i;
+            expected[i] = 0xFF000000 | (p[0] << 16) | (p[2] << 8) | p[4];
+        }
+        SkOpts::RGB16_to_BGR1(dst, src, count);
+        check("RGB16_to_BGR1");
+
+        for (int i = 0; i < count; i++) {
+            const uint8_t* p = src + 8 * i;
+            expected[i] = ((uint32_t)p[6] << 24) | (p[4] << 16) | (p[2] << 8) | p[0];
+        }
+        SkOpts::RGBA16_to_RGBA(dst, src, count);
+        check("RGBA16_to_RGBA");
+
+        for (int i = 0; i < count; i++) {
+            const uint8_t* p = src + 8 * i;
+            expected[i] = ((uint32_t)p[6] << 24) | (p[0] << 16) | (p[2] << 8) | p[4];
+        }
+        SkOpts::RGBA16_to_BGRA(dst, src, count);
+        check("RGBA16_to_BGRA");
+
+        for (int i = 0; i < count; i++) {
+            expected[i] = table[src[i]];
+        }
+        SkOpts::index_to_8888(dst, src, count, table);
+        check("index_to_8888");
+
+        for (int bits : {1, 2, 4}) {
+            for (int i = 0; i < count; i++) {
+                const int bit = i * bits;
+                expected[i] = table[(src[bit / 8] >> (8 - bits - bit % 8)) & ((1 << bits) - 1)];
+            }
+            SkOpts::small_index_to_8888(dst, src, count, bits, table);
+            check(bits == 1 ? "small_index_to_8888, 1 bit"
+                            : bits == 2 ? "small_index_to_8888, 2 bits"
+                                        : "small_index_to_8888, 4 bits");
+        }
+    }
+}
+
+// Subsets of images with fewer than 8 bits per pixel can start in the middle of a byte.
+DEF_TEST(Swizzler_SmallIndexSubset, r) {
+    static constexpr int kWidth = 100;
+    SkRandom rand;
+    uint8_t src[kWidth / 2];
+    for (uint8_t& b : src) {
+        b = rand.nextU() & 0xFF;
+    }
+    SkPMColor table[16];
+    for (SkPMColor& c : table) {
+        c = rand.nextU() | 0xFF000000;
+    }
+
+    for (int bits : {1, 2, 4}) {
+        const SkEncodedInfo info = SkEncodedInfo::Make(kWidth, 1, SkEncodedInfo::kPalette_Color,
+                                                       SkEncodedInfo::kOpaque_Alpha, bits);
+        for (int left = 0; left < 9; left++) {
+            const SkIRect subset = SkIRect::MakeLTRB(left, 0, kWidth, 1);
+            SkCodec::Options options;
+            options.fSubset = &subset;
+            const SkImageInfo dstInfo = SkImageInfo::MakeN32Premul(subset.width(), 1);
+            std::unique_ptr<SkSwizzler> swizzler =
+                    SkSwizzler::Make(info, table, dstInfo, options);
+            REPORTER_ASSERT(r, swizzler);
+
+            SkPMColor dst[kWidth];
+            swizzler->swizzle(dst, src);
+            for (int x = left; x < kWidth; x++) {
+                const int bit = x * bits;
+                const SkPMColor expected =
+                        table[(src[bit / 8] >> (8 - bits - bit % 8)) & ((1 << bits) - 1)];
+                REPORTER_ASSERT(r, dst[x - left] == expected,
+                                "%d bits, left %d, x %d", bits, left, x);
+            }
+        }
+    }
+}
+
 using fn_reciprocal = float (*)(float);
 static void test_reciprocal_alpha(
         skiatest::Reporter* reporter,
@@ -0,0 +1,250 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkBlurTypes.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMaskFilter.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkShader.h"
+#include "include/core/SkSize.h"
+#include "include/core/SkSurface.h"
+#include "include/effects/SkGradientShader.h"
+#include "include/effects/SkImageFilters.h"
+#include "tests/Test.h"
+
+#include <cstring>
+#include <memory>
+
+static constexpr int kW = 301, kH = 257;
+
+static void draw_scene(SkCanvas* canvas, int frame) {
+    SkPaint paint;
+    paint.setAntiAlias(true);
+
+    canvas->drawColor(SK_ColorWHITE);
+
+    const SkPoint pts[] = {{0, 0}, {kW, kH}};
+    const SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+    paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2, SkTileMode::kClamp));
+    canvas->drawRect(SkRect::MakeXYWH(10.5f, 12.25f, 200, 90), paint);
+    paint.setShader(nullptr);
+
+    canvas->save();
+    canvas->translate(150, 130);
+    canvas->rotate(17.0f + frame);
+    paint.setColor(0x8000C000);
+    for (int i = 0; i < 6; i++) {
+        canvas->drawCircle(30.0f * i - 80, 0, 20 + 3.0f * i, paint);
+    }
+    canvas->restore();
+
+    SkPath star;
+    for (int i = 0; i < 7; i++) {
+        SkScalar angle = i * 3 * SK_ScalarPI * 2 / 7;
+        SkPoint p = {150 + 120 * SkScalarCos(angle), 128 + 120 * SkScalarSin(angle)};
+        i == 0 ? star.moveTo(p) : star.lineTo(p);
+    }
+    star.close();
+    paint.setColor(0x60FF8000);
+    canvas->drawPath(star, paint);
+
+    paint.setColor(SK_ColorBLACK);
+    paint.setStyle(SkPaint::kStroke_Style);
+    paint.setStrokeWidth(3);
+    canvas->drawLine(0, kH, kW, 0, paint);
+    paint.setStyle(SkPaint::kFill_Style);
+
+    paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 6));
+    paint.setColor(SK_ColorMAGENTA);
+    canvas->drawRoundRect(SkRect::MakeXYWH(180, 150, 90, 70), 12, 12, paint);
+    paint.setMaskFilter(nullptr);
+
+    SkPaint layerPaint;
+    layerPaint.setAlphaf(0.5f);
+    layerPaint.setImageFilter(SkImageFilters::Blur(3, 3, nullptr));
+    canvas->saveLayer(nullptr, &layerPaint);
+    paint.setColor(SK_ColorCYAN);
+    canvas->drawOval(SkRect::MakeXYWH(20, 150, 120, 90), paint);
+    canvas->restore();
+
+    canvas->clipRect(SkRect::MakeXYWH(50.5f, 60.5f, 180, 120), true);
+    paint.setBlendMode(SkBlendMode::kMultiply);
+    paint.setColor(0xFF808080);
+    canvas->drawPaint(paint);
+}
+
+static void check_same(skiatest::Reporter* r, const SkPixmap& a, const SkPixmap& b) {
+    REPORTER_ASSERT(r, a.dimensions() == b.dimensions());
+    for (int y = 0; y < a.height(); y++) {
+        if (0 != memcmp(a.addr(0, y), b.addr(0, y), a.info().minRowBytes())) {
+            ERRORF(r, "Row %d differs between threaded and serial raster surfaces.", y);
+            return;
+        }
+    }
+}
+
+DEF_TEST(ThreadedRasterSurface_MatchesRaster, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(kW, kH);
+    auto executor = SkExecutor::MakeWorkStealingThreadPool(4);
+
+    auto serial = SkSurfaces::Raster(info);
+    draw_scene(serial->getCanvas(), 0);
+    SkPixmap expected;
+    REPORTER_ASSERT(r, serial->peekPixels(&expected));
+
+    for (SkISize tileSize : {SkISize{256, 256}, SkISize{64, 64}, SkISize{37, 29}, SkISize{kW, 1}}) {
+        auto threaded = SkSurfaces::RasterThreaded(info, *executor, tileSize);
+        REPORTER_ASSERT(r, threaded);
+        draw_scene(threaded->getCanvas(), 0);
+
+        SkBitmap actual;
+        actual.allocPixels(info);
+        REPORTER_ASSERT(r, threaded->readPixels(actual, 0, 0));
+        check_same(r, expected, actual.pixmap());
+    }
+}
+
+DEF_TEST(ThreadedRasterSurface_FlushMidRecording, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(kW, kH);
+    auto executor = SkExecutor::MakeWorkStealingThreadPool(3);
+
+    auto serial = SkSurfaces::Raster(info);
+    auto threaded = SkSurfaces::RasterThreaded(info, *executor, {50, 40});
+
+    for (auto surface : {serial, threaded}) {
+        SkCanvas* canvas = surface->getCanvas();
+        canvas->clear(SK_ColorWHITE);
+        canvas->save();
+        canvas->translate(20, 10);
+        canvas->clipRect(SkRect::MakeWH(200, 200));
+
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setColor(SK_ColorRED);
+        canvas->drawCircle(60, 60, 50, paint);
+
+        // Snapshot with a save, matrix and clip outstanding, then keep drawing on top.
+        sk_sp<SkImage> snap = surface->makeImageSnapshot();
+        REPORTER_ASSERT(r, snap);
+
+        paint.setColor(0x800000FF);
+        canvas->drawCircle(120, 90, 70, paint);
+        canvas->restore();
+        paint.setColor(SK_ColorGREEN);
+        canvas->drawRect(SkRect::MakeXYWH(250, 200, 100, 100), paint);
+    }
+
+    SkPixmap expected;
+    REPORTER_ASSERT(r, serial->peekPixels(&expected));
+    SkPixmap actual;
+    REPORTER_ASSERT(r, threaded->peekPixels(&actual));
+    check_same(r, expected, actual);
+}
+
+DEF_TEST(ThreadedRasterSurface_FlushInLayer, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(kW, kH);
+    auto executor = SkExecutor::MakeWorkStealingThreadPool(3);
+
+    auto serial = SkSurfaces::Raster(info);
+    auto threaded = SkSurfaces::RasterThreaded(info, *executor, {50, 40});
+
+    // Snapshots taken inside a layer see only what's beneath it, and the layer's contents are
+    // composited all together when it's restored, however many flushes happen in between.
+    sk_sp<SkImage> snaps[2][3];
+    int s = 0;
+    for (auto surface : {serial, threaded}) {
+        SkCanvas* canvas = surface->getCanvas();
+        // A transform that's never undone has to be rebuilt by every flush.
+        canvas->scale(1.5f, 1.25f);
+        canvas->drawColor(SK_ColorWHITE);
+
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (int frame = 0; frame < 20; frame++) {
+            paint.setColor(SkColorSetARGB(0x80, 10 * frame, 0, 255 - 10 * frame));
+            canvas->drawCircle(10.0f * frame, 8.0f * frame, 15, paint);
+            SkPixmap pm;
+            REPORTER_ASSERT(r, surface->peekPixels(&pm));
+        }
+
+        SkPaint layerPaint;
+        layerPaint.setAlphaf(0.6f);
+        layerPaint.setBlendMode(SkBlendMode::kMultiply);
+        canvas->saveLayer(nullptr, &layerPaint);
+        canvas->translate(10, 5);
+        paint.setColor(SK_ColorRED);
+        canvas->drawCircle(80, 80, 60, paint);
+        snaps[s][0] = surface->makeImageSnapshot();
+        paint.setColor(SK_ColorGREEN);
+        canvas->drawCircle(120, 90, 60, paint);
+        snaps[s][1] = surface->makeImageSnapshot();
+        canvas->restore();
+        snaps[s][2] = surface->makeImageSnapshot();
+        s++;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        SkPixmap expected, actual;
+        REPORTER_ASSERT(r, snaps[0][i]->peekPixels(&expected));
+        REPORTER_ASSERT(r, snaps[1][i]->peekPixels(&actual));
+        check_same(r, expected, actual);
+    }
+}
+
+DEF_TEST(ThreadedRasterSurface_Backdrop, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(kW, kH);
+    auto executor = SkExecutor::MakeWorkStealingThreadPool(4);
+
+    auto serial = SkSurfaces::Raster(info);
+    auto threaded = SkSurfaces::RasterThreaded(info, *executor, {32, 32});
+
+    for (auto surface : {serial, threaded}) {
+        SkCanvas* canvas = surface->getCanvas();
+        draw_scene(canvas, 1);
+
+        const SkRect bounds = SkRect::MakeXYWH(40, 40, 200, 150);
+        auto blur = SkImageFilters::Blur(5, 5, nullptr);
+        canvas->saveLayer(SkCanvas::SaveLayerRec(&bounds, nullptr, blur.get(), 0));
+        canvas->restore();
+    }
+
+    SkPixmap expected;
+    REPORTER_ASSERT(r, serial->peekPixels(&expected));
+    SkPixmap actual;
+    REPORTER_ASSERT(r, threaded->peekPixels(&actual));
+    check_same(r, expected, actual);
+}
+
+DEF_TEST(ThreadedRasterSurface_SnapshotIsCopyOnWrite, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(16, 16);
+    auto executor = SkExecutor::MakeWorkStealingThreadPool(2);
+    auto surface = SkSurfaces::RasterThreaded(info, *executor, {8, 8});
+
+    surface->getCanvas()->clear(SK_ColorRED);
+    sk_sp<SkImage> red = surface->makeImageSnapshot();
+    surface->getCanvas()->clear(SK_ColorBLUE);
+    sk_sp<SkImage> blue = surface->makeImageSnapshot();
+
+    SkPixmap pm;
+    REPORTER_ASSERT(r, red->peekPixels(&pm));
+    REPORTER_ASSERT(r, pm.getColor(5, 5) == SK_ColorRED);
+    REPORTER_ASSERT(r, blue->peekPixels(&pm));
+    REPORTER_ASSERT(r, pm.getColor(5, 5) == SK_ColorBLUE);
+
+    REPORTER_ASSERT(r, !SkSurfaces::RasterThreaded(info, *executor, {0, 8}));
+}
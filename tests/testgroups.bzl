@@ -39,6 +39,8 @@ CORE_TESTS = [
     "DescriptorTest.cpp",
     "DrawBitmapRectTest.cpp",
     "DrawPathTest.cpp",
+    "DrawRectSetTest.cpp",
+    "EdgeBuilderTest.cpp",
     "EmptyPathTest.cpp",
     "F16StagesTest.cpp",
     "FillPathTest.cpp",
@@ -88,6 +90,7 @@ CORE_TESTS = [
     "PathMeasureTest.cpp",
     "PictureBBHTest.cpp",
     "PictureShaderTest.cpp",
+    "PictureTileScheduleTest.cpp",
     "PixelRefTest.cpp",
     "Point3Test.cpp",
     "PointTest.cpp",
@@ -117,6 +120,7 @@ CORE_TESTS = [
     "SkContainersTest.cpp",
     "SkDOMTest.cpp",
     "SkEnumBitMaskTest.cpp",
+    "SkExecutorTest.cpp",
     "SkGaussFilterTest.cpp",
     "SkGlyphTest.cpp",
     "SkImageTest.cpp",
@@ -134,6 +138,7 @@ CORE_TESTS = [
     "SkVxTest.cpp",
     "SkXmpTest.cpp",
     "SortTest.cpp",
+    "SparseStripsTest.cpp",
     "SrcOverTest.cpp",
     "StreamTest.cpp",
     "StringTest.cpp",
@@ -142,6 +147,7 @@ CORE_TESTS = [
     "TDPQueueTest.cpp",
     "TLazyTest.cpp",
     "TemplatesTest.cpp",
+    "ThreadedSurfaceTest.cpp",
     "TracingTest.cpp",
     "UtilsTest.cpp",
     "VerticesTest.cpp",
@@ -52,6 +52,8 @@
 #include <cmath>
 #include <vector>
 
+extern bool gSkUseSparseStrips;
+
 /**
  * This is a minimalist program whose sole purpose is to open a .skp or .svg file, benchmark it on a
  * single config, and exit. It is intended to be used through skpbench.py rather than invoked
@@ -85,6 +87,8 @@ static DEFINE_int(verbosity, 4, "level of verbosity (0=none to 5=debug)");
 static DEFINE_bool(suppressHeader, false, "don't print a header row before the results");
 static DEFINE_double(scale, 1, "Scale the size of the canvas and the zoom level by this factor.");
 static DEFINE_bool(dumpSamples, false, "print the individual samples to stdout");
+static DEFINE_bool(sparseStrips, false,
+                   "rasterize software path masks with sparse strips instead of AAA");
 
 static const char header[] =
 "   accum    median       max       min   stddev  samples  sample_ms  clock  metric  config    bench";
@@ -504,6 +508,7 @@ int main(int argc, char** argv) {
     if (FLAGS_duration <= 0) {
         exit(0); // This can be used to print the header and quit.
     }
+    gSkUseSparseStrips = FLAGS_sparseStrips;
 
     // Parse the config.
     const SkCommandLineConfigGpu* config = nullptr; // Initialize for spurious warning.
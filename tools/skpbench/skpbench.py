@@ -64,6 +64,9 @@ __argparse.add_argument('--cc',
   action='store_true', help="allow coverage counting shortcuts to render paths")
 __argparse.add_argument('--nocache',
   action='store_true', help="disable caching of path mask textures")
+__argparse.add_argument('--sparseStrips',
+  action='store_true',
+  help="rasterize software path masks with sparse strips instead of AAA")
 __argparse.add_argument('--allPathsVolatile',
   action='store_true',
   help="Causes all GPU paths to be processed as if 'setIsVolatile' had been called.")
@@ -153,6 +156,8 @@ class SKPBench:
     ARGV.extend(['--cachePathMasks', 'false'])
   if FLAGS.allPathsVolatile:
     ARGV.extend(['--allPathsVolatile', 'true'])
+  if FLAGS.sparseStrips:
+    ARGV.extend(['--sparseStrips', 'true'])
   if FLAGS.gpuThreads != -1:
     ARGV.extend(['--gpuThreads', str(FLAGS.gpuThreads)])
   if FLAGS.internalSamples != -1: